@@ -0,0 +1,475 @@
+// Benchmark driver that runs the library stages (construction, queries,
+// cached queries, k-ring, for_each) and app kernels (VertexNormal and
+// GaussianCurvature) over a corpus of meshes with warm-up and repetitions.
+// The timing of every stage is written to one Report with its median,
+// percentiles, and confidence interval. If a baseline report is given, the
+// driver fails (non-zero exit code) when a stage regresses beyond a threshold
+// or when a baseline stage was not run (unless -allow_missing is given). The
+// driver also fails if a mesh of the corpus can not be read
+
+#include <cuda_profiler_api.h>
+#include <algorithm>
+#include <filesystem>
+#include <set>
+#include <sstream>
+
+#include "rxmesh/attribute.h"
+#include "rxmesh/rxmesh_static.h"
+#include "rxmesh/util/benchmark.h"
+#include "rxmesh/util/import_mesh.h"
+#include "rxmesh/util/report.h"
+#include "rxmesh/util/timer.h"
+
+// used by the GaussianCurvature kernel
+constexpr double PI = 3.1415926535897932384626433832795028841971693993751058209;
+
+#include "GaussianCurvature/gaussian_curvature_kernel.cuh"
+#include "VertexNormal/vertex_normal_kernel.cuh"
+
+struct arg
+{
+    std::string input         = STRINGIFY(INPUT_DIR) "sphere3.obj";
+    std::string output_folder = STRINGIFY(OUTPUT_DIR);
+    std::string stages        = "all";
+    std::string baseline      = "";
+    std::string save_baseline = "";
+    bool        allow_missing = false;
+    uint32_t    num_warmup    = 2;
+    uint32_t    num_run       = 10;
+    double      threshold     = 0.05;
+    double      confidence    = 0.95;
+    uint32_t    device_id     = 0;
+    char**      argv;
+    int         argc;
+} Arg;
+
+constexpr uint32_t blockThreads = 256;
+
+/**
+ * @brief true if the stage is selected with -stages
+ */
+bool is_selected(const std::string& stage)
+{
+    static std::set<std::string> selected;
+    if (selected.empty()) {
+        std::stringstream ss(Arg.stages);
+        std::string       s;
+        while (std::getline(ss, s, ',')) {
+            if (!s.empty()) {
+                selected.insert(s);
+            }
+        }
+    }
+    return selected.count("all") > 0 || selected.count(stage) > 0;
+}
+
+/**
+ * @brief the meshes of the corpus i.e., the input file or every mesh file in
+ * the input directory (sorted by name)
+ */
+std::vector<std::string> get_corpus(const std::string& input)
+{
+    std::vector<std::string> corpus;
+    if (!std::filesystem::is_directory(input)) {
+        corpus.push_back(input);
+        return corpus;
+    }
+
+    for (const auto& entry : std::filesystem::directory_iterator(input)) {
+        const std::string ext = entry.path().extension().string();
+        if (entry.is_regular_file() &&
+            (ext == ".obj" || ext == ".ply" || ext == ".stl")) {
+            corpus.push_back(entry.path().string());
+        }
+    }
+    std::sort(corpus.begin(), corpus.end());
+    return corpus;
+}
+
+/**
+ * @brief time the query op on the device. If cached is true, the query reads
+ * the adjacency cache (see RXMeshStatic::build_adjacency_cache)
+ */
+template <rxmesh::Op op, typename InputHandleT, typename OutputHandleT>
+void bench_query(rxmesh::Benchmark&    bench,
+                 rxmesh::RXMeshStatic& rx,
+                 const std::string&    mesh_name,
+                 const bool            cached = false)
+{
+    using namespace rxmesh;
+
+    const std::string stage = op_to_string(op) + (cached ? "_cached" : "");
+    if (!is_selected(stage)) {
+        return;
+    }
+
+    auto count = rx.add_attribute<uint32_t, InputHandleT>("count", 1, DEVICE);
+
+    auto query = [count = *count] __device__(
+                     const InputHandleT&            h,
+                     const Iterator<OutputHandleT>& iter) {
+        uint32_t c = 0;
+        for (uint16_t i = 0; i < iter.size(); ++i) {
+            if (iter[i].is_valid()) {
+                c++;
+            }
+        }
+        count(h) = c;
+    };
+
+    LaunchBox<blockThreads> launch_box;
+    rx.prepare_launch_box(
+        {op},
+        launch_box,
+        (void*)detail::query_kernel<blockThreads, op, decltype(query)>);
+
+    if (cached) {
+        rx.build_adjacency_cache(op);
+    }
+
+    bench.run(mesh_name + "/" + stage, [&]() {
+        GPUTimer timer;
+        timer.start();
+        rx.run_query_kernel<op>(launch_box, query);
+        timer.stop();
+        CUDA_ERROR(cudaDeviceSynchronize());
+        CUDA_ERROR(cudaGetLastError());
+        return timer.elapsed_millis();
+    });
+
+    if (cached) {
+        rx.release_adjacency_cache(op);
+    }
+    rx.remove_attribute("count");
+}
+
+/**
+ * @brief run all selected stages on one mesh of the corpus
+ * @return false if the mesh can not be read
+ */
+bool bench_mesh(rxmesh::Benchmark& bench, const std::string& file_name)
+{
+    using namespace rxmesh;
+    using T = float;
+
+    const std::string mesh_name = extract_file_name(file_name);
+
+    std::vector<T>        vertices;
+    std::vector<uint32_t> fv;
+    if (!import_mesh(file_name, vertices, fv)) {
+        RXMESH_ERROR("bench_mesh() can not read {}", file_name);
+        return false;
+    }
+    const uint32_t num_faces    = static_cast<uint32_t>(fv.size() / 3);
+    const uint32_t num_vertices = static_cast<uint32_t>(vertices.size() / 3);
+
+    // construction (patching and building the host and device data
+    // structures) from in-memory buffers i.e., without the file I/O
+    if (is_selected("build")) {
+        bench.run(mesh_name + "/build", [&]() {
+            CPUTimer timer;
+            timer.start();
+            RXMeshStatic rx(
+                fv.data(), num_faces, vertices.data(), num_vertices);
+            CUDA_ERROR(cudaDeviceSynchronize());
+            timer.stop();
+            return timer.elapsed_millis();
+        });
+    }
+
+    RXMeshStatic rx(fv.data(), num_faces, vertices.data(), num_vertices);
+
+    auto coords = rx.get_input_vertex_coordinates();
+
+    // queries
+    bench_query<Op::VV, VertexHandle, VertexHandle>(bench, rx, mesh_name);
+    bench_query<Op::VE, VertexHandle, EdgeHandle>(bench, rx, mesh_name);
+    bench_query<Op::VF, VertexHandle, FaceHandle>(bench, rx, mesh_name);
+    bench_query<Op::EV, EdgeHandle, VertexHandle>(bench, rx, mesh_name);
+    bench_query<Op::EF, EdgeHandle, FaceHandle>(bench, rx, mesh_name);
+    bench_query<Op::FV, FaceHandle, VertexHandle>(bench, rx, mesh_name);
+    bench_query<Op::FE, FaceHandle, EdgeHandle>(bench, rx, mesh_name);
+    bench_query<Op::FF, FaceHandle, FaceHandle>(bench, rx, mesh_name);
+
+    // queries that read the adjacency cache
+    bench_query<Op::VV, VertexHandle, VertexHandle>(bench, rx, mesh_name, true);
+    bench_query<Op::FF, FaceHandle, FaceHandle>(bench, rx, mesh_name, true);
+
+    // query on the host (patches are load-balanced over the host threads by
+    // the work-stealing HostScheduler)
+    if (is_selected("VV_host")) {
+        auto count = rx.add_vertex_attribute<uint32_t>("count", 1, HOST);
+        bench.run(mesh_name + "/VV_host", [&]() {
+            rx.run_query_kernel<Op::VV, blockThreads>(
+                HOST, [&](const VertexHandle& vh, const VertexIterator& iter) {
+                    (*count)(vh) = iter.size();
+                });
+        });
+        rx.remove_attribute("count");
+    }
+
+    // building the k-ring
+    if (is_selected("k_ring")) {
+        bench.run(mesh_name + "/k_ring", [&]() {
+            rx.release_k_ring();
+            CPUTimer timer;
+            timer.start();
+            rx.build_k_ring(2);
+            timer.stop();
+            return timer.elapsed_millis();
+        });
+        rx.release_k_ring();
+    }
+
+    // for_each on the device
+    if (is_selected("for_each")) {
+        auto sum = rx.add_vertex_attribute<T>("sum", 1, DEVICE);
+
+        // defined outside of the timed lambda since an extended lambda can
+        // not be enclosed by a function with a deduced return type
+        auto sum_coords = [coords = *coords, sum = *sum] __device__(
+                              const VertexHandle vh) {
+            sum(vh) = coords(vh, 0) + coords(vh, 1) + coords(vh, 2);
+        };
+
+        bench.run(mesh_name + "/for_each", [&]() {
+            GPUTimer timer;
+            timer.start();
+            rx.for_each_vertex(DEVICE, sum_coords);
+            timer.stop();
+            CUDA_ERROR(cudaDeviceSynchronize());
+            CUDA_ERROR(cudaGetLastError());
+            return timer.elapsed_millis();
+        });
+        rx.remove_attribute("sum");
+    }
+
+    // apps
+    if (is_selected("VertexNormal")) {
+        auto v_normals = rx.add_vertex_attribute<T>("v_normals", 3, DEVICE);
+
+        LaunchBox<blockThreads> launch_box;
+        rx.prepare_launch_box({Op::FV},
+                              launch_box,
+                              (void*)compute_vertex_normal<T, blockThreads>);
+
+        bench.run(mesh_name + "/VertexNormal", [&]() {
+            v_normals->reset(0, DEVICE);
+            GPUTimer timer;
+            timer.start();
+            compute_vertex_normal<T, blockThreads>
+                <<<launch_box.blocks,
+                   launch_box.num_threads,
+                   launch_box.smem_bytes_dyn>>>(
+                    rx.get_context(), *coords, *v_normals);
+            timer.stop();
+            CUDA_ERROR(cudaDeviceSynchronize());
+            CUDA_ERROR(cudaGetLastError());
+            return timer.elapsed_millis();
+        });
+        rx.remove_attribute("v_normals");
+    }
+
+    if (is_selected("GaussianCurvature")) {
+        auto v_gc   = rx.add_vertex_attribute<T>("v_gc", 1, DEVICE);
+        auto v_amix = rx.add_vertex_attribute<T>("v_amix", 1, DEVICE);
+
+        LaunchBox<blockThreads> launch_box;
+        rx.prepare_launch_box(
+            {Op::FV},
+            launch_box,
+            (void*)compute_gaussian_curvature<T, blockThreads>);
+
+        bench.run(mesh_name + "/GaussianCurvature", [&]() {
+            v_gc->reset(2 * PI, DEVICE);
+            v_amix->reset(0, DEVICE);
+            GPUTimer timer;
+            timer.start();
+            compute_gaussian_curvature<T, blockThreads>
+                <<<launch_box.blocks,
+                   launch_box.num_threads,
+                   launch_box.smem_bytes_dyn>>>(
+                    rx.get_context(), *coords, *v_gc, *v_amix);
+            timer.stop();
+            CUDA_ERROR(cudaDeviceSynchronize());
+            CUDA_ERROR(cudaGetLastError());
+            return timer.elapsed_millis();
+        });
+        rx.remove_attribute("v_gc");
+        rx.remove_attribute("v_amix");
+    }
+    return true;
+}
+
+int main(int argc, char** argv)
+{
+    using namespace rxmesh;
+    Log::init();
+
+    Arg.argc = argc;
+    Arg.argv = argv;
+    if (argc > 1) {
+        if (cmd_option_exists(argv, argc + argv, "-h")) {
+            // clang-format off
+            RXMESH_INFO("\nUsage: Benchmark.exe < -option X>\n"
+                        " -h:              Display this massage and exit\n"
+                        " -input:          Input mesh file or a directory of mesh files (the corpus). Default is {} \n"
+                        " -o:              JSON file output folder. Default is {} \n"
+                        " -stages:         Comma-separated stages to run (build, VV, VE, VF, EV, EF, FV, FE, FF, VV_cached, FF_cached, VV_host, k_ring, for_each, VertexNormal, GaussianCurvature) or all. Default is {} \n"
+                        " -num_warmup:     Number of untimed runs per stage. Default is {} \n"
+                        " -num_run:        Number of timed runs per stage. Default is {} \n"
+                        " -confidence:     Confidence level of the median confidence interval. Default is {} \n"
+                        " -baseline:       Baseline JSON report to compare against. The driver fails if a stage regresses or a baseline stage was not run \n"
+                        " -threshold:      Relative slowdown of the median that is tolerated. Default is {} \n"
+                        " -allow_missing:  Do not fail on baseline stages that were not run (e.g., with -stages)\n"
+                        " -save_baseline:  Also write the report to this JSON file (to be used as a baseline)\n"
+                        " -device_id:      GPU device ID. Default is {}",
+            Arg.input, Arg.output_folder, Arg.stages, Arg.num_warmup, Arg.num_run, Arg.confidence, Arg.threshold, Arg.device_id);
+            // clang-format on
+            exit(EXIT_SUCCESS);
+        }
+
+        if (cmd_option_exists(argv, argc + argv, "-input")) {
+            Arg.input =
+                std::string(get_cmd_option(argv, argv + argc, "-input"));
+        }
+        if (cmd_option_exists(argv, argc + argv, "-o")) {
+            Arg.output_folder =
+                std::string(get_cmd_option(argv, argv + argc, "-o"));
+        }
+        if (cmd_option_exists(argv, argc + argv, "-stages")) {
+            Arg.stages =
+                std::string(get_cmd_option(argv, argv + argc, "-stages"));
+        }
+        if (cmd_option_exists(argv, argc + argv, "-num_warmup")) {
+            Arg.num_warmup =
+                atoi(get_cmd_option(argv, argv + argc, "-num_warmup"));
+        }
+        if (cmd_option_exists(argv, argc + argv, "-num_run")) {
+            Arg.num_run = atoi(get_cmd_option(argv, argv + argc, "-num_run"));
+        }
+        if (cmd_option_exists(argv, argc + argv, "-confidence")) {
+            Arg.confidence =
+                atof(get_cmd_option(argv, argv + argc, "-confidence"));
+        }
+        if (cmd_option_exists(argv, argc + argv, "-baseline")) {
+            Arg.baseline =
+                std::string(get_cmd_option(argv, argv + argc, "-baseline"));
+        }
+        if (cmd_option_exists(argv, argc + argv, "-threshold")) {
+            Arg.threshold =
+                atof(get_cmd_option(argv, argv + argc, "-threshold"));
+        }
+        if (cmd_option_exists(argv, argc + argv, "-allow_missing")) {
+            Arg.allow_missing = true;
+        }
+        if (cmd_option_exists(argv, argc + argv, "-save_baseline")) {
+            Arg.save_baseline = std::string(
+                get_cmd_option(argv, argv + argc, "-save_baseline"));
+        }
+        if (cmd_option_exists(argv, argc + argv, "-device_id")) {
+            Arg.device_id =
+                atoi(get_cmd_option(argv, argv + argc, "-device_id"));
+        }
+    }
+
+    RXMESH_INFO("input= {}", Arg.input);
+    RXMESH_INFO("output_folder= {}", Arg.output_folder);
+    RXMESH_INFO("stages= {}", Arg.stages);
+    RXMESH_INFO("num_warmup= {}", Arg.num_warmup);
+    RXMESH_INFO("num_run= {}", Arg.num_run);
+    RXMESH_INFO("confidence= {}", Arg.confidence);
+    RXMESH_INFO("baseline= {}", Arg.baseline);
+    RXMESH_INFO("threshold= {}", Arg.threshold);
+    RXMESH_INFO("allow_missing= {}", Arg.allow_missing);
+    RXMESH_INFO("device_id= {}", Arg.device_id);
+
+    cuda_query(Arg.device_id);
+
+    // read the baseline first so a wrong path fails before the runs
+    std::map<std::string, std::vector<float>> baseline;
+    if (!Arg.baseline.empty() &&
+        !Benchmark::load_baseline(Arg.baseline, baseline)) {
+        return EXIT_FAILURE;
+    }
+
+    const std::vector<std::string> corpus = get_corpus(Arg.input);
+    if (corpus.empty()) {
+        RXMESH_ERROR("main() no mesh found in {}", Arg.input);
+        return EXIT_FAILURE;
+    }
+
+    Benchmark bench(Arg.num_warmup, Arg.num_run, Arg.confidence);
+
+    uint32_t num_failed_meshes = 0;
+    for (const std::string& file_name : corpus) {
+        RXMESH_INFO("Benchmarking {}", file_name);
+        if (!bench_mesh(bench, file_name)) {
+            num_failed_meshes++;
+        }
+    }
+
+    Report report("Benchmark_RXMesh");
+    report.command_line(Arg.argc, Arg.argv);
+    report.device();
+    report.system();
+    report.add_member("num_meshes", static_cast<uint32_t>(corpus.size()));
+    report.add_member("num_failed_meshes", num_failed_meshes);
+    report.add_member("num_warmup", Arg.num_warmup);
+    report.add_member("num_run", Arg.num_run);
+    report.add_member("confidence", Arg.confidence);
+    report.add_benchmark(bench);
+
+    uint32_t num_regressed = 0;
+    uint32_t num_missing   = 0;
+    if (!Arg.baseline.empty()) {
+        const std::vector<BenchmarkComparison> cmp =
+            bench.compare(baseline, Arg.threshold);
+
+        for (const BenchmarkComparison& c : cmp) {
+            if (c.regressed) {
+                num_regressed++;
+            }
+            if (c.missing) {
+                num_missing++;
+            }
+        }
+
+        report.add_member("baseline", Arg.baseline);
+        report.add_member("threshold", Arg.threshold);
+        report.add_member("num_compared",
+                          static_cast<uint32_t>(cmp.size()) - num_missing);
+        report.add_member("num_regressed", num_regressed);
+        report.add_member("num_missing", num_missing);
+    }
+
+    report.write(Arg.output_folder + "/rxmesh", "Benchmark_RXMesh");
+
+    if (!Arg.save_baseline.empty()) {
+        const std::filesystem::path path(Arg.save_baseline);
+        report.write(path.has_parent_path() ? path.parent_path().string() : ".",
+                     path.filename().string(),
+                     false);
+    }
+
+    bool failed = false;
+    if (num_failed_meshes > 0) {
+        RXMESH_ERROR("main() {} mesh(es) could not be benchmarked",
+                     num_failed_meshes);
+        failed = true;
+    }
+    if (num_regressed > 0) {
+        RXMESH_ERROR("main() {} stage(s) regressed beyond {:.1f}%",
+                     num_regressed,
+                     Arg.threshold * 100);
+        failed = true;
+    }
+    if (num_missing > 0 && !Arg.allow_missing) {
+        RXMESH_ERROR(
+            "main() {} baseline stage(s) were not run (use -allow_missing to "
+            "ignore them)",
+            num_missing);
+        failed = true;
+    }
+    return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
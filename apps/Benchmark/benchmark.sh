@@ -0,0 +1,25 @@
+#!/bin/bash
+echo "Please make sure to first compile the source code and then enter the input OBJ files directory."
+read -p "OBJ files directory (no trailing slash): " input_dir
+read -p "Baseline JSON file (leave empty to only record a new baseline): " baseline
+
+echo "Input directory= $input_dir"
+exe="../../build/bin/Benchmark"
+
+if [ ! -f $exe ]; then 
+	echo "The code has not been compiled. Please compile Benchmark and retry!"
+	exit 1
+fi
+
+num_warmup=2
+num_run=10
+threshold=0.05
+device_id=0
+
+if [ -z "$baseline" ]; then
+	echo $exe -input "$input_dir" -num_warmup $num_warmup -num_run $num_run -device_id $device_id -save_baseline baseline.json
+	$exe -input "$input_dir" -num_warmup $num_warmup -num_run $num_run -device_id $device_id -save_baseline baseline.json
+else
+	echo $exe -input "$input_dir" -num_warmup $num_warmup -num_run $num_run -device_id $device_id -baseline "$baseline" -threshold $threshold
+	$exe -input "$input_dir" -num_warmup $num_warmup -num_run $num_run -device_id $device_id -baseline "$baseline" -threshold $threshold
+fi
@@ -64,13 +64,9 @@ void filtering_rxmesh(const std::string                  file_path,
         filter_launch_box,
         (void*)bilateral_filtering<T, filter_block_threads, maxVVSize>);
 
-    // double buffer
-    VertexAttribute<T>* double_buffer[2] = {coords.get(), filtered_coord.get()};
-
     CUDA_ERROR(cudaProfilerStart());
     GPUTimer timer;
     timer.start();
-    uint32_t d = 0;
 
     for (uint32_t itr = 0; itr < Arg.num_filter_iter; ++itr) {
         vertex_normal->reset(0, rxmesh::DEVICE);
@@ -80,17 +76,19 @@ void filtering_rxmesh(const std::string                  file_path,
             <<<vn_launch_box.blocks,
                vn_block_threads,
                vn_launch_box.smem_bytes_dyn>>>(
-                rx.get_context(), *double_buffer[d], *vertex_normal);
+                rx.get_context(), *coords, *vertex_normal);
 
         bilateral_filtering<T, filter_block_threads, maxVVSize>
             <<<filter_launch_box.blocks,
                filter_block_threads,
                filter_launch_box.smem_bytes_dyn>>>(rx.get_context(),
-                                                   *double_buffer[d],
-                                                   *double_buffer[!d],
+                                                   *coords,
+                                                   *filtered_coord,
                                                    *vertex_normal);
 
-        d = !d;
+        // the filtered coordinates become the input of the next iteration
+        // (double buffering without copying)
+        coords->swap(*filtered_coord);
         CUDA_ERROR(cudaDeviceSynchronize());
     }
 
@@ -102,7 +100,7 @@ void filtering_rxmesh(const std::string                  file_path,
                  timer.elapsed_millis() / float(Arg.num_filter_iter));
 
     // move output to host
-    coords->copy_from(*double_buffer[d], rxmesh::DEVICE, rxmesh::HOST);
+    coords->move(rxmesh::DEVICE, rxmesh::HOST);
 
     // output to obj
     // rx.export_obj(STRINGIFY(OUTPUT_DIR) "output_rxmesh" +
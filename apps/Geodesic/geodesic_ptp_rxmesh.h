@@ -41,40 +41,34 @@ inline void geodesic_rxmesh(rxmesh::RXMeshStatic&        rx,
 
 
     // Geodesic distance attribute for all vertices (seeds set to zero
-    // and infinity otherwise)
-    auto rxmesh_geo = rx.add_vertex_attribute<T>("geo", 1u);
-    rxmesh_geo->reset(std::numeric_limits<T>::infinity(), rxmesh::HOST);
+    // and infinity otherwise) double buffered where every iteration reads
+    // the front and writes the back
+    auto rxmesh_geo = rx.add_ping_pong_attribute<T, VertexHandle>("geo", 1u);
+    auto& geo       = rxmesh_geo.front();
+    geo.reset(std::numeric_limits<T>::infinity(), rxmesh::HOST);
     rx.for_each_vertex(rxmesh::HOST, [&](const VertexHandle vh) {
         uint32_t v_id = rx.map_to_global(vh);
         for (uint32_t s : h_seeds) {
             if (s == v_id) {
-                (*rxmesh_geo)(vh) = 0;
+                geo(vh) = 0;
                 break;
             }
         }
     });
-    rxmesh_geo->move(rxmesh::HOST, rxmesh::DEVICE);
+    geo.move(rxmesh::HOST, rxmesh::DEVICE);
 
-    // second buffer for geodesic distance for double buffering
-    auto rxmesh_geo_2 = rx.add_vertex_attribute<T>("geo2", 1u, rxmesh::DEVICE);
-
-    rxmesh_geo_2->copy_from(*rxmesh_geo, rxmesh::DEVICE, rxmesh::DEVICE);
+    rxmesh_geo.back().copy_from(geo, rxmesh::DEVICE, rxmesh::DEVICE);
 
 
     // Error
     uint32_t *d_error(nullptr), h_error(0);
     CUDA_ERROR(cudaMalloc((void**)&d_error, sizeof(uint32_t)));
 
-    // double buffer
-    VertexAttribute<T>* double_buffer[2] = {rxmesh_geo.get(),
-                                            rxmesh_geo_2.get()};
-
     // start time
     GPUTimer timer;
     timer.start();
 
     // actual computation
-    uint32_t d = 0;
     uint32_t i(1), j(2);
     uint32_t iter     = 0;
     uint32_t max_iter = 2 * h_limits.size();
@@ -89,8 +83,8 @@ inline void geodesic_rxmesh(rxmesh::RXMeshStatic&        rx,
             <<<launch_box.blocks, blockThreads, launch_box.smem_bytes_dyn>>>(
                 rx.get_context(),
                 *input_coord,
-                *double_buffer[!d],
-                *double_buffer[d],
+                rxmesh_geo.back(),
+                rxmesh_geo.front(),
                 *d_toplesets,
                 i,
                 j,
@@ -112,7 +106,7 @@ inline void geodesic_rxmesh(rxmesh::RXMeshStatic&        rx,
             j++;
         }
 
-        d = !d;
+        rxmesh_geo.swap();
     }
 
     timer.stop();
@@ -120,7 +114,7 @@ inline void geodesic_rxmesh(rxmesh::RXMeshStatic&        rx,
     CUDA_ERROR(cudaGetLastError());
     CUDA_ERROR(cudaProfilerStop());
 
-    rxmesh_geo->copy_from(*double_buffer[d], rxmesh::DEVICE, rxmesh::HOST);
+    geo.move(rxmesh::DEVICE, rxmesh::HOST);
 
     RXMESH_TRACE("Geodesic_RXMesh took {} (ms) -- #iter= {}",
                  timer.elapsed_millis(),
@@ -128,7 +122,7 @@ inline void geodesic_rxmesh(rxmesh::RXMeshStatic&        rx,
 
 #if USE_POLYSCOPE
     auto ps_mesh = rx.get_polyscope_mesh();
-    ps_mesh->addVertexScalarQuantity("geodesic", *rxmesh_geo);
+    ps_mesh->addVertexScalarQuantity("geodesic", geo);
     polyscope::show();
 #endif
 
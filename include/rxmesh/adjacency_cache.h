@@ -0,0 +1,68 @@
+#pragma once
+
+#include <stdint.h>
+
+#include "rxmesh/types.h"
+#include "rxmesh/util/macros.h"
+
+namespace rxmesh {
+
+/**
+ * @brief number of query operations (i.e., entries in the adjacency cache)
+ */
+constexpr int ADJACENCY_CACHE_NUM_OPS = static_cast<int>(Op::EVDiamond) + 1;
+
+/**
+ * @brief the materialized output of one query operation for all patches. The
+ * output of a patch is stored exactly as the query writes it in shared memory
+ * i.e., a per-patch CSR of local indices where offset(p) is the row offset
+ * (num_src_in_patch + 1 entries) and value(p) is the column (local) indices.
+ * Operations with fixed number of output per element (EV, FV, FE, EE, and
+ * EVDiamond) have no offset. The offset and value of all patches are stored in
+ * one buffer (data) at offset_start[p] and value_start[p]. The cache is built
+ * and managed by RXMeshStatic (see RXMeshStatic::build_adjacency_cache) and
+ * read by the query dispatchers (on the host and the device) through the
+ * Context instead of computing the query from scratch
+ */
+struct AdjacencyCache
+{
+    __host__ __device__ AdjacencyCache()
+        : oriented(false),
+          offset_start(nullptr),
+          value_start(nullptr),
+          data(nullptr)
+    {
+    }
+
+    /**
+     * @brief true if the cache holds the output of a query operation
+     */
+    __host__ __device__ __inline__ bool is_valid() const
+    {
+        return data != nullptr;
+    }
+
+    /**
+     * @brief the row offset of the output of patch p
+     */
+    __host__ __device__ __inline__ const uint16_t* offset(
+        const uint32_t p) const
+    {
+        return data + offset_start[p];
+    }
+
+    /**
+     * @brief the (local) indices of the output of patch p
+     */
+    __host__ __device__ __inline__ const uint16_t* value(const uint32_t p) const
+    {
+        return data + value_start[p];
+    }
+
+    bool            oriented;
+    const uint32_t* offset_start;
+    const uint32_t* value_start;
+    const uint16_t* data;
+};
+
+}  // namespace rxmesh
@@ -4,8 +4,26 @@
 
 namespace rxmesh {
 
+#ifdef RX_CPU_ONLY
+/**
+ * @brief host replacement of cub::KeyValuePair with the same members
+ */
+template <typename HandleT, typename T>
+struct KeyValuePair
+{
+    HandleT key;
+    T       value;
+
+    KeyValuePair() = default;
+
+    KeyValuePair(const HandleT& k, const T& v) : key(k), value(v)
+    {
+    }
+};
+#else
 template <typename HandleT, typename T>
 using KeyValuePair = cub::KeyValuePair<HandleT, T>;
+#endif
 
 namespace detail {
 
@@ -17,7 +35,7 @@ struct ArgMaxOp
         return std::numeric_limits<T>::lowest();
     }
 
-    __device__ __forceinline__ KeyValuePair<HandleT, T> operator()(
+    __host__ __device__ __forceinline__ KeyValuePair<HandleT, T> operator()(
         const KeyValuePair<HandleT, T>& a,
         const KeyValuePair<HandleT, T>& b) const
     {
@@ -34,7 +52,7 @@ struct ArgMinOp
         return std::numeric_limits<T>::max();
     }
 
-    __device__ __forceinline__ KeyValuePair<HandleT, T> operator()(
+    __host__ __device__ __forceinline__ KeyValuePair<HandleT, T> operator()(
         const KeyValuePair<HandleT, T>& a,
         const KeyValuePair<HandleT, T>& b) const
     {
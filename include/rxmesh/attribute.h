@@ -1,17 +1,24 @@
 #pragma once
 
 #include <assert.h>
+#include <cstring>
+#include <memory>
 #include <utility>
 
 #include "rxmesh/handle.h"
+#ifndef RX_CPU_ONLY
 #include "rxmesh/kernels/attribute.cuh"
 #include "rxmesh/kernels/collective.cuh"
+#endif
 #include "rxmesh/kernels/util.cuh"
 #include "rxmesh/patch_info.h"
 #include "rxmesh/rxmesh.h"
 #include "rxmesh/types.h"
 #include "rxmesh/util/cuda_query.h"
 #include "rxmesh/util/log.h"
+#include "rxmesh/util/host_parallel.h"
+#include "rxmesh/util/timer.h"
+#include "rxmesh/util/transfer_engine.h"
 #include "rxmesh/util/util.h"
 
 #include "rxmesh/matrix/dense_matrix.h"
@@ -84,9 +91,14 @@ class Attribute : public AttributeBase
           m_h_attr(nullptr),
           m_h_ptr_on_device(nullptr),
           m_d_attr(nullptr),
+          m_h_slab(nullptr),
+          m_d_slab(nullptr),
+          m_slab_offset(nullptr),
           m_max_num_patches(0),
           m_layout(AoS),
-          m_memory_mega_bytes(0)
+          m_memory_mega_bytes(0),
+          m_allocation_time_ms(0),
+          m_transfer_time_ms(0)
     {
 
         this->m_name    = (char*)malloc(sizeof(char) * 1);
@@ -117,9 +129,14 @@ class Attribute : public AttributeBase
           m_h_attr(nullptr),
           m_h_ptr_on_device(nullptr),
           m_d_attr(nullptr),
+          m_h_slab(nullptr),
+          m_d_slab(nullptr),
+          m_slab_offset(nullptr),
           m_max_num_patches(rxmesh->get_max_num_patches()),
           m_layout(layout),
-          m_memory_mega_bytes(0)
+          m_memory_mega_bytes(0),
+          m_allocation_time_ms(0),
+          m_transfer_time_ms(0)
     {
         if (name != nullptr) {
             this->m_name = (char*)malloc(sizeof(char) * (strlen(name) + 1));
@@ -134,29 +151,91 @@ class Attribute : public AttributeBase
     }
 
 
+    /**
+     * @brief access the attribute of the i-th mesh element on the host where
+     * i is the RXMesh global index (see RXMesh::map_to_local_vertex). The
+     * mapping from i to the element handle is a constant-time table lookup
+     */
     T& operator()(size_t i, size_t j = 0)
+    {
+        return this->operator()(map_to_local(i), j);
+    }
+
+    T& operator()(size_t i, size_t j = 0) const
+    {
+        return this->operator()(map_to_local(i), j);
+    }
+
+    /**
+     * @brief map the RXMesh global index of a mesh element to its handle
+     */
+    HandleT map_to_local(size_t i) const
     {
         if constexpr (std::is_same_v<HandleT, VertexHandle>) {
-            return this->operator()(m_rxmesh->map_to_local_vertex(i), j);
+            return m_rxmesh->map_to_local_vertex(i);
         }
         if constexpr (std::is_same_v<HandleT, EdgeHandle>) {
-            return this->operator()(m_rxmesh->map_to_local_edge(i), j);
+            return m_rxmesh->map_to_local_edge(i);
         }
         if constexpr (std::is_same_v<HandleT, FaceHandle>) {
-            return this->operator()(m_rxmesh->map_to_local_face(i), j);
+            return m_rxmesh->map_to_local_face(i);
         }
     }
 
-    T& operator()(size_t i, size_t j = 0) const
+    /**
+     * @brief copy the attribute (on the host) into a flat host array indexed
+     * by the RXMesh global index i.e., attribute j of the i-th element is
+     * written to arr[i * cols() + j]
+     * @param arr host array of at least rows() * cols() elements
+     */
+    void gather(T* arr) const
     {
-        if constexpr (std::is_same_v<HandleT, VertexHandle>) {
-            return this->operator()(m_rxmesh->map_to_local_vertex(i), j);
+        if (!is_host_allocated()) {
+            RXMESH_ERROR(
+                "Attribute::gather() Attribute {} is not allocated on the "
+                "host",
+                m_name);
+            return;
         }
-        if constexpr (std::is_same_v<HandleT, EdgeHandle>) {
-            return this->operator()(m_rxmesh->map_to_local_edge(i), j);
+
+        const int64_t  num_elements = rows();
+        const uint32_t num_attr     = get_num_attributes();
+
+#pragma omp parallel for
+        for (int64_t i = 0; i < num_elements; ++i) {
+            const HandleT h = map_to_local(i);
+            for (uint32_t j = 0; j < num_attr; ++j) {
+                arr[i * num_attr + j] = this->operator()(h, j);
+            }
         }
-        if constexpr (std::is_same_v<HandleT, FaceHandle>) {
-            return this->operator()(m_rxmesh->map_to_local_face(i), j);
+    }
+
+    /**
+     * @brief copy a flat host array indexed by the RXMesh global index into
+     * this attribute on the host, i.e., the inverse of gather(). The device
+     * side is not updated
+     * @param arr host array of at least rows() * cols() elements where
+     * arr[i * cols() + j] is attribute j of the i-th element
+     */
+    void scatter(const T* arr)
+    {
+        if (!is_host_allocated()) {
+            RXMESH_ERROR(
+                "Attribute::scatter() Attribute {} is not allocated on the "
+                "host",
+                m_name);
+            return;
+        }
+
+        const int64_t  num_elements = rows();
+        const uint32_t num_attr     = get_num_attributes();
+
+#pragma omp parallel for
+        for (int64_t i = 0; i < num_elements; ++i) {
+            const HandleT h = map_to_local(i);
+            for (uint32_t j = 0; j < num_attr; ++j) {
+                this->operator()(h, j) = arr[i * num_attr + j];
+            }
         }
     }
 
@@ -334,6 +413,26 @@ class Attribute : public AttributeBase
         return m_memory_mega_bytes;
     }
 
+    /**
+     * @brief return the total time (in milliseconds) spent allocating the
+     * attribute memory on the host and the device
+     */
+    double get_allocation_time() const
+    {
+        return m_allocation_time_ms;
+    }
+
+    /**
+     * @brief return the total host time (in milliseconds) spent in move() and
+     * copy_from(). Copies that involve the device are issued asynchronously on
+     * the given stream and so this is the time to issue them which, for
+     * pageable host memory, includes the time of the copy itself
+     */
+    double get_transfer_time() const
+    {
+        return m_transfer_time_ms;
+    }
+
     /**
      * @brief get the number of attributes per mesh element
      */
@@ -385,6 +484,10 @@ class Attribute : public AttributeBase
     void reset(const T value, locationT location, cudaStream_t stream = NULL)
     {
         if (((location & DEVICE) == DEVICE) && is_device_allocated()) {
+#ifdef RX_CPU_ONLY
+            // the device shares the host slab
+            location = location | HOST;
+#else
             const int threads = 256;
             detail::template memset_attribute<T>
                 <<<m_rxmesh->get_num_patches(), threads, 0, stream>>>(
@@ -392,17 +495,29 @@ class Attribute : public AttributeBase
                     value,
                     m_rxmesh->get_num_patches(),
                     m_num_attributes);
+#endif
         }
 
 
         if (((location & HOST) == HOST) && is_host_allocated()) {
 
-#pragma omp parallel for
-            for (int p = 0; p < static_cast<int>(m_rxmesh->get_num_patches());
-                 ++p) {
-                for (uint32_t e = 0; e < capacity(p); ++e) {
+            auto reset_patch = [&](uint32_t p) {
+                const uint32_t n = capacity(p) * m_num_attributes;
+                for (uint32_t e = 0; e < n; ++e) {
                     m_h_attr[p][e] = value;
                 }
+            };
+
+            if (const detail::HostAffinity* affinity =
+                    m_rxmesh->get_host_affinity()) {
+                affinity->run(m_rxmesh->get_num_patches(), reset_patch);
+            } else {
+#pragma omp parallel for
+                for (int p = 0;
+                     p < static_cast<int>(m_rxmesh->get_num_patches());
+                     ++p) {
+                    reset_patch(p);
+                }
             }
         }
     }
@@ -413,10 +528,11 @@ class Attribute : public AttributeBase
      * allocated, it will be allocated first before copying the memory.
      * @param source the source location
      * @param target the destination location
-     * @param stream to be used to launch the kernel
-     * TODO it is better to launch a kernel that do the memcpy than relying on
-     * the host API from CUDA since all these small memcpy will be enqueued in
-     * the same stream and so serialized
+     * @param stream the stream on which the copies are enqueued. The copy is
+     * staged through the pinned buffer of TransferEngine::get_default(). Moving
+     * to the device returns once the host data is staged (so the copy
+     * overlaps with the host and with work on other streams) while moving to
+     * the host returns once the data is on the host
      */
     void move(locationT source, locationT target, cudaStream_t stream = NULL)
     {
@@ -449,25 +565,22 @@ class Attribute : public AttributeBase
             return;
         }
 
+#ifndef RX_CPU_ONLY
+        CPUTimer timer;
+        timer.start();
+
+        // all patches are stored contiguously so a single copy moves them all
         if (source == HOST && target == DEVICE) {
-            for (uint32_t p = 0; p < m_rxmesh->get_num_patches(); ++p) {
-                CUDA_ERROR(
-                    cudaMemcpyAsync(m_h_ptr_on_device[p],
-                                    m_h_attr[p],
-                                    sizeof(T) * capacity(p) * m_num_attributes,
-                                    cudaMemcpyHostToDevice,
-                                    stream));
-            }
+            TransferEngine::get_default().to_device(
+                m_d_slab, m_h_slab, slab_num_bytes(), stream);
         } else if (source == DEVICE && target == HOST) {
-            for (uint32_t p = 0; p < m_rxmesh->get_num_patches(); ++p) {
-                CUDA_ERROR(
-                    cudaMemcpyAsync(m_h_attr[p],
-                                    m_h_ptr_on_device[p],
-                                    sizeof(T) * capacity(p) * m_num_attributes,
-                                    cudaMemcpyDeviceToHost,
-                                    stream));
-            }
+            TransferEngine::get_default().to_host(
+                m_h_slab, m_d_slab, slab_num_bytes(), stream);
         }
+
+        timer.stop();
+        m_transfer_time_ms += timer.elapsed_millis();
+#endif
     }
 
     /**
@@ -476,21 +589,36 @@ class Attribute : public AttributeBase
      */
     void release(locationT location = LOCATION_ALL)
     {
+#ifdef RX_CPU_ONLY
+        // the device slab is the host slab and so it goes with it
+        if ((location & HOST) == HOST) {
+            location = location | DEVICE;
+        }
+#endif
         if (((location & HOST) == HOST) && is_host_allocated()) {
-            for (uint32_t p = 0; p < m_rxmesh->get_max_num_patches(); ++p) {
-                free(m_h_attr[p]);
-            }
+            free(m_h_slab);
             free(m_h_attr);
+            m_h_slab    = nullptr;
             m_h_attr    = nullptr;
             m_allocated = m_allocated & (~HOST);
         }
 
         if (((location & DEVICE) == DEVICE) && is_device_allocated()) {
-            for (uint32_t p = 0; p < m_rxmesh->get_max_num_patches(); ++p) {
-                GPU_FREE(m_h_ptr_on_device[p]);
-            }
+#ifdef RX_CPU_ONLY
+            m_d_slab = nullptr;
+            m_d_attr = nullptr;
+#else
+            GPU_FREE(m_d_slab);
             GPU_FREE(m_d_attr);
-            m_allocated = m_allocated & (~DEVICE);
+#endif
+            free(m_h_ptr_on_device);
+            m_h_ptr_on_device = nullptr;
+            m_allocated       = m_allocated & (~DEVICE);
+        }
+
+        if (m_allocated == LOCATION_NONE) {
+            free(m_slab_offset);
+            m_slab_offset = nullptr;
         }
     }
 
@@ -537,6 +665,14 @@ class Attribute : public AttributeBase
             return;
         }
 
+        // both attributes have the same type, number of attributes, and
+        // layout on the same mesh and so their slabs have the same per-patch
+        // offsets which let us copy all patches at once
+        const size_t num_bytes = slab_num_bytes();
+
+        CPUTimer timer;
+        timer.start();
+
         // 1) copy from HOST to HOST
         if ((source_flag & HOST) == HOST && (dst_flag & HOST) == HOST) {
             if ((source_flag & source.m_allocated) != source_flag) {
@@ -552,11 +688,7 @@ class Attribute : public AttributeBase
                 return;
             }
 
-            for (uint32_t p = 0; p < m_rxmesh->get_num_patches(); ++p) {
-                std::memcpy(m_h_attr[p],
-                            source.m_h_attr[p],
-                            sizeof(T) * capacity(p) * m_num_attributes);
-            }
+            detail::host_parallel_memcpy(m_h_slab, source.m_h_slab, num_bytes);
         }
 
 
@@ -575,14 +707,11 @@ class Attribute : public AttributeBase
                 return;
             }
 
-            for (uint32_t p = 0; p < m_rxmesh->get_num_patches(); ++p) {
-                CUDA_ERROR(
-                    cudaMemcpyAsync(m_h_ptr_on_device[p],
-                                    source.m_h_ptr_on_device[p],
-                                    sizeof(T) * capacity(p) * m_num_attributes,
-                                    cudaMemcpyDeviceToDevice,
-                                    stream));
-            }
+            CUDA_ERROR(cudaMemcpyAsync(m_d_slab,
+                                       source.m_d_slab,
+                                       num_bytes,
+                                       cudaMemcpyDeviceToDevice,
+                                       stream));
         }
 
 
@@ -602,14 +731,8 @@ class Attribute : public AttributeBase
             }
 
 
-            for (uint32_t p = 0; p < m_rxmesh->get_num_patches(); ++p) {
-                CUDA_ERROR(
-                    cudaMemcpyAsync(m_h_attr[p],
-                                    source.m_h_ptr_on_device[p],
-                                    sizeof(T) * capacity(p) * m_num_attributes,
-                                    cudaMemcpyDeviceToHost,
-                                    stream));
-            }
+            TransferEngine::get_default().to_host(
+                m_h_slab, source.m_d_slab, num_bytes, stream);
         }
 
 
@@ -629,15 +752,51 @@ class Attribute : public AttributeBase
             }
 
 
-            for (uint32_t p = 0; p < m_rxmesh->get_num_patches(); ++p) {
-                CUDA_ERROR(
-                    cudaMemcpyAsync(m_h_ptr_on_device[p],
-                                    source.m_h_attr[p],
-                                    sizeof(T) * capacity(p) * m_num_attributes,
-                                    cudaMemcpyHostToDevice,
-                                    stream));
-            }
+            TransferEngine::get_default().to_device(
+                m_d_slab, source.m_h_slab, num_bytes, stream);
         }
+
+        timer.stop();
+        m_transfer_time_ms += timer.elapsed_millis();
+    }
+
+    /**
+     * @brief Exchange the memory (on the host and the device) of this
+     * attribute with another attribute in O(1) without touching the data. Both
+     * attributes should be defined on the same mesh with the same number of
+     * attributes and layout. Every attribute keeps its name so anything that
+     * refers to this attribute (e.g., copy_from or exporters) sees the
+     * other's data after the swap. Copies of the attribute made before the
+     * swap (e.g., one captured by a lambda) still point to the old memory
+     * @param other the attribute to swap memory with
+     */
+    void swap(Attribute<T, HandleT>& other)
+    {
+        if (this == &other) {
+            return;
+        }
+
+        if (m_rxmesh != other.m_rxmesh ||
+            m_num_attributes != other.m_num_attributes ||
+            m_layout != other.m_layout ||
+            m_max_num_patches != other.m_max_num_patches) {
+            RXMESH_ERROR(
+                "Attribute::swap() can not swap attribute {} with attribute "
+                "{} since they are defined on different mesh, number of "
+                "attributes, or layout",
+                m_name,
+                other.m_name);
+            return;
+        }
+
+        std::swap(m_allocated, other.m_allocated);
+        std::swap(m_h_attr, other.m_h_attr);
+        std::swap(m_h_ptr_on_device, other.m_h_ptr_on_device);
+        std::swap(m_d_attr, other.m_d_attr);
+        std::swap(m_h_slab, other.m_h_slab);
+        std::swap(m_d_slab, other.m_d_slab);
+        std::swap(m_slab_offset, other.m_slab_offset);
+        std::swap(m_memory_mega_bytes, other.m_memory_mega_bytes);
     }
 
     /**
@@ -794,52 +953,124 @@ class Attribute : public AttributeBase
 
    protected:
     /**
-     * @brief allocate internal memory
+     * @brief the number of bytes of the slab that hold the patches currently
+     * in the mesh (i.e., excluding the extra patches reserved for
+     * RXMeshDynamic)
+     */
+    size_t slab_num_bytes() const
+    {
+        return m_slab_offset[m_rxmesh->get_num_patches()];
+    }
+
+    /**
+     * @brief compute the byte offset of every patch in the slab. Every patch
+     * starts at a 256-byte boundary (similar to what cudaMalloc would give)
+     * so accessing a patch in a kernel is as aligned as it was when patches
+     * were allocated separately
+     */
+    void compute_slab_offset()
+    {
+        constexpr size_t alignment = 256;
+
+        m_slab_offset = static_cast<size_t*>(
+            malloc(sizeof(size_t) * (m_max_num_patches + 1)));
+
+        m_slab_offset[0] = 0;
+        for (uint32_t p = 0; p < m_max_num_patches; ++p) {
+            const size_t num_bytes = sizeof(T) * capacity(p) * m_num_attributes;
+            m_slab_offset[p + 1] =
+                m_slab_offset[p] +
+                ROUND_UP_TO_NEXT_MULTIPLE(num_bytes, alignment);
+        }
+    }
+
+    /**
+     * @brief allocate internal memory. The attribute of all patches is stored
+     * in one contiguous slab (one on the host and one on the device) where
+     * every patch is located at a fixed offset. So, allocation is a single
+     * malloc/cudaMalloc and transfers are a single memcpy. In a CPU-only build,
+     * the host and the device share one slab
      */
     void allocate(locationT location)
     {
         if (m_max_num_patches != 0) {
+#ifdef RX_CPU_ONLY
+            if ((location & DEVICE) == DEVICE || is_device_allocated()) {
+                location = location | HOST | DEVICE;
+            }
+#endif
+
+            CPUTimer timer;
+            timer.start();
 
             if ((location & HOST) == HOST) {
                 release(HOST);
+            }
+            if ((location & DEVICE) == DEVICE) {
+                release(DEVICE);
+            }
+
+            if (m_slab_offset == nullptr) {
+                compute_slab_offset();
+            }
+
+            const size_t num_bytes = m_slab_offset[m_max_num_patches];
+
+            if ((location & HOST) == HOST) {
+                m_h_slab = static_cast<char*>(malloc(num_bytes));
 
                 m_h_attr =
                     static_cast<T**>(malloc(sizeof(T*) * m_max_num_patches));
 
                 for (uint32_t p = 0; p < m_max_num_patches; ++p) {
-                    m_h_attr[p] = static_cast<T*>(
-                        malloc(sizeof(T) * capacity(p) * m_num_attributes));
+                    m_h_attr[p] =
+                        reinterpret_cast<T*>(m_h_slab + m_slab_offset[p]);
+                }
+
+                // first touch every patch's part of the slab from the patch's
+                // home thread so its pages are placed on that thread's node
+                if (const detail::HostAffinity* affinity =
+                        m_rxmesh->get_host_affinity()) {
+                    affinity->run(m_max_num_patches, [&](uint32_t p) {
+                        std::memset(m_h_slab + m_slab_offset[p],
+                                    0,
+                                    m_slab_offset[p + 1] - m_slab_offset[p]);
+                    });
                 }
 
                 m_allocated = m_allocated | HOST;
             }
 
             if ((location & DEVICE) == DEVICE) {
-                release(DEVICE);
-
-
+#ifdef RX_CPU_ONLY
+                m_d_slab = m_h_slab;
+                m_d_attr = m_h_attr;
+#else
                 CUDA_ERROR(cudaMalloc((void**)&(m_d_attr),
                                       sizeof(T*) * m_max_num_patches));
                 m_memory_mega_bytes +=
                     BYTES_TO_MEGABYTES(sizeof(T*) * m_max_num_patches);
 
+                CUDA_ERROR(cudaMalloc((void**)&(m_d_slab), num_bytes));
+                m_memory_mega_bytes += BYTES_TO_MEGABYTES(num_bytes);
+
                 m_h_ptr_on_device =
                     static_cast<T**>(malloc(sizeof(T*) * m_max_num_patches));
 
                 for (uint32_t p = 0; p < m_max_num_patches; ++p) {
-                    CUDA_ERROR(
-                        cudaMalloc((void**)&(m_h_ptr_on_device[p]),
-                                   sizeof(T) * capacity(p) * m_num_attributes));
-
-                    m_memory_mega_bytes += BYTES_TO_MEGABYTES(
-                        sizeof(T) * capacity(p) * m_num_attributes);
+                    m_h_ptr_on_device[p] =
+                        reinterpret_cast<T*>(m_d_slab + m_slab_offset[p]);
                 }
                 CUDA_ERROR(cudaMemcpy(m_d_attr,
                                       m_h_ptr_on_device,
                                       sizeof(T*) * m_max_num_patches,
                                       cudaMemcpyHostToDevice));
+#endif
                 m_allocated = m_allocated | DEVICE;
             }
+
+            timer.stop();
+            m_allocation_time_ms += timer.elapsed_millis();
         }
     }
 
@@ -852,9 +1083,14 @@ class Attribute : public AttributeBase
     T**              m_h_attr;
     T**              m_h_ptr_on_device;
     T**              m_d_attr;
+    char*            m_h_slab;
+    char*            m_d_slab;
+    size_t*          m_slab_offset;
     uint32_t         m_max_num_patches;
     layoutT          m_layout;
     double           m_memory_mega_bytes;
+    double           m_allocation_time_ms;
+    double           m_transfer_time_ms;
 
     constexpr static uint32_t m_block_size = 256;
 };
@@ -868,6 +1104,78 @@ using EdgeAttribute = Attribute<T, EdgeHandle>;
 template <class T>
 using FaceAttribute = Attribute<T, FaceHandle>;
 
+/**
+ * @brief A pair of attributes for iterative (Jacobi-style) algorithms that read
+ * from one buffer and write to the other. front() is the current solution and
+ * back() is where the next one is written. swap() makes the back the front
+ * in O(1) by exchanging the memory of the two attributes (see
+ * Attribute::swap()) so front() always refers to the same Attribute with the
+ * latest data and no copy is needed between iterations. Created using
+ * RXMeshStatic::add_ping_pong_attribute()
+ */
+template <class T, typename HandleT>
+class PingPongAttribute
+{
+   public:
+    using HandleType = HandleT;
+    using Type       = T;
+
+    PingPongAttribute() = default;
+
+    PingPongAttribute(std::shared_ptr<Attribute<T, HandleT>> front,
+                      std::shared_ptr<Attribute<T, HandleT>> back)
+        : m_front(front), m_back(back)
+    {
+    }
+
+    /**
+     * @brief the buffer that holds the current solution
+     */
+    Attribute<T, HandleT>& front()
+    {
+        return *m_front;
+    }
+
+    const Attribute<T, HandleT>& front() const
+    {
+        return *m_front;
+    }
+
+    /**
+     * @brief the buffer the next solution is written to
+     */
+    Attribute<T, HandleT>& back()
+    {
+        return *m_back;
+    }
+
+    const Attribute<T, HandleT>& back() const
+    {
+        return *m_back;
+    }
+
+    /**
+     * @brief make the back buffer the front and vice versa without copying
+     */
+    void swap()
+    {
+        m_front->swap(*m_back);
+    }
+
+   private:
+    std::shared_ptr<Attribute<T, HandleT>> m_front;
+    std::shared_ptr<Attribute<T, HandleT>> m_back;
+};
+
+template <class T>
+using VertexPingPongAttribute = PingPongAttribute<T, VertexHandle>;
+
+template <class T>
+using EdgePingPongAttribute = PingPongAttribute<T, EdgeHandle>;
+
+template <class T>
+using FacePingPongAttribute = PingPongAttribute<T, FaceHandle>;
+
 /**
  * @brief Attribute container used to manage a collection of attributes by
  * RXMeshStatic
@@ -0,0 +1,528 @@
+#pragma once
+
+#include <algorithm>
+#include <functional>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#include "rxmesh/attribute.h"
+#ifndef RX_CPU_ONLY
+#include "rxmesh/kernels/attribute.cuh"
+#endif
+#include "rxmesh/rxmesh.h"
+#include "rxmesh/util/host_reduce.h"
+
+namespace rxmesh {
+
+/**
+ * Lazily evaluated arithmetic on attributes. Arithmetic operators on
+ * attributes (and scalars) do not compute anything. Instead they build an
+ * expression that is evaluated element-wise, for every attribute component,
+ * only once it is assigned with assign() (or reduced with reduce_sum()) in
+ * evaluate(). All the assignments and reductions given to one evaluate() run
+ * in a single pass over the patches: one kernel on the device or one parallel
+ * loop on the host. For example, one CG update could be written as
+ *
+ *  T delta = reduce_handle.evaluate(rx, DEVICE, stream,
+ *                                   assign(X, X + alpha * P),
+ *                                   assign(R, R - alpha * S),
+ *                                   reduce_sum(R * R));
+ *
+ * which reads every attribute once instead of three passes (two axpy and one
+ * dot product). Terms are applied in order on every element component so a
+ * term sees what the previous terms wrote to the same element component.
+ * Expressions are strictly element-wise, i.e., an element does not read other
+ * elements.
+ */
+
+namespace detail {
+
+// tag of all expression nodes
+struct AttrExprBase
+{
+};
+
+template <typename T>
+struct is_attribute : std::false_type
+{
+};
+
+template <typename T, typename HandleT>
+struct is_attribute<Attribute<T, HandleT>> : std::true_type
+{
+};
+
+template <typename X>
+constexpr bool is_expr_operand_v =
+    is_attribute<X>::value || std::is_base_of_v<AttrExprBase, X>;
+
+template <typename L, typename R>
+constexpr bool is_expr_args_v =
+    (is_expr_operand_v<L> &&
+     (is_expr_operand_v<R> || std::is_arithmetic_v<R>)) ||
+    (std::is_arithmetic_v<L> && is_expr_operand_v<R>);
+
+/**
+ * @brief leaf that reads an attribute
+ */
+template <typename T, typename HandleT>
+struct AttrLeafExpr : public AttrExprBase
+{
+    using Type       = T;
+    using HandleType = HandleT;
+
+    AttrLeafExpr(const Attribute<T, HandleT>& a) : attr(a)
+    {
+    }
+
+    __host__ __device__ __forceinline__ T operator()(const uint32_t p,
+                                                     const uint16_t i,
+                                                     const uint32_t j) const
+    {
+        return attr(p, i, j);
+    }
+
+    uint32_t num_attributes() const
+    {
+        return attr.get_num_attributes();
+    }
+
+    bool is_compatible(const uint32_t n) const
+    {
+        return attr.get_num_attributes() == n;
+    }
+
+    Attribute<T, HandleT> attr;
+};
+
+/**
+ * @brief leaf that broadcasts a scalar to all elements and components
+ */
+template <typename T>
+struct ScalarExpr : public AttrExprBase
+{
+    using Type       = T;
+    using HandleType = void;
+
+    ScalarExpr(const T v) : value(v)
+    {
+    }
+
+    __host__ __device__ __forceinline__ T operator()(const uint32_t,
+                                                     const uint16_t,
+                                                     const uint32_t) const
+    {
+        return value;
+    }
+
+    uint32_t num_attributes() const
+    {
+        return 0;
+    }
+
+    bool is_compatible(const uint32_t) const
+    {
+        return true;
+    }
+
+    T value;
+};
+
+struct PlusOp
+{
+    template <typename T>
+    __host__ __device__ __forceinline__ static T apply(const T a, const T b)
+    {
+        return a + b;
+    }
+};
+
+struct MinusOp
+{
+    template <typename T>
+    __host__ __device__ __forceinline__ static T apply(const T a, const T b)
+    {
+        return a - b;
+    }
+};
+
+struct MultipliesOp
+{
+    template <typename T>
+    __host__ __device__ __forceinline__ static T apply(const T a, const T b)
+    {
+        return a * b;
+    }
+};
+
+struct DividesOp
+{
+    template <typename T>
+    __host__ __device__ __forceinline__ static T apply(const T a, const T b)
+    {
+        return a / b;
+    }
+};
+
+template <typename OpT, typename L, typename R>
+struct BinaryExpr : public AttrExprBase
+{
+    using Type = std::common_type_t<typename L::Type, typename R::Type>;
+    using HandleType =
+        std::conditional_t<std::is_void_v<typename L::HandleType>,
+                           typename R::HandleType,
+                           typename L::HandleType>;
+
+    static_assert(std::is_void_v<typename L::HandleType> ||
+                      std::is_void_v<typename R::HandleType> ||
+                      std::is_same_v<typename L::HandleType,
+                                     typename R::HandleType>,
+                  "Attribute expressions can not mix attributes of different "
+                  "mesh elements");
+
+    BinaryExpr(const L& l_, const R& r_) : l(l_), r(r_)
+    {
+    }
+
+    __host__ __device__ __forceinline__ Type operator()(const uint32_t p,
+                                                        const uint16_t i,
+                                                        const uint32_t j) const
+    {
+        return OpT::apply(Type(l(p, i, j)), Type(r(p, i, j)));
+    }
+
+    uint32_t num_attributes() const
+    {
+        return std::max(l.num_attributes(), r.num_attributes());
+    }
+
+    bool is_compatible(const uint32_t n) const
+    {
+        return l.is_compatible(n) && r.is_compatible(n);
+    }
+
+    L l;
+    R r;
+};
+
+template <typename E>
+struct NegateExpr : public AttrExprBase
+{
+    using Type       = typename E::Type;
+    using HandleType = typename E::HandleType;
+
+    NegateExpr(const E& e_) : e(e_)
+    {
+    }
+
+    __host__ __device__ __forceinline__ Type operator()(const uint32_t p,
+                                                        const uint16_t i,
+                                                        const uint32_t j) const
+    {
+        return -e(p, i, j);
+    }
+
+    uint32_t num_attributes() const
+    {
+        return e.num_attributes();
+    }
+
+    bool is_compatible(const uint32_t n) const
+    {
+        return e.is_compatible(n);
+    }
+
+    E e;
+};
+
+/**
+ * @brief turn an attribute, an expression, or a scalar into an expression. A
+ * scalar takes the value type of the other operand
+ */
+template <typename OtherT, typename X>
+auto to_expr(const X& x)
+{
+    if constexpr (is_attribute<X>::value) {
+        return AttrLeafExpr<typename X::Type, typename X::HandleType>(x);
+    } else if constexpr (std::is_base_of_v<AttrExprBase, X>) {
+        return x;
+    } else {
+        using T = typename OtherT::Type;
+        return ScalarExpr<T>(static_cast<T>(x));
+    }
+}
+
+template <typename OpT, typename L, typename R>
+auto make_binary_expr(const L& l, const R& r)
+{
+    auto le = to_expr<R>(l);
+    auto re = to_expr<L>(r);
+    return BinaryExpr<OpT, decltype(le), decltype(re)>(le, re);
+}
+
+/**
+ * @brief dst = expr
+ */
+template <typename T, typename HandleT, typename ExprT>
+struct AssignTerm
+{
+    using Type       = T;
+    using HandleType = HandleT;
+
+    static constexpr bool is_reduction = false;
+
+    template <typename AccT>
+    __host__ __device__ __forceinline__ void apply(const uint32_t p,
+                                                   const uint16_t i,
+                                                   const uint32_t j,
+                                                   AccT&) const
+    {
+        dst(p, i, j) = static_cast<T>(expr(p, i, j));
+    }
+
+    uint32_t num_attributes() const
+    {
+        return dst.get_num_attributes();
+    }
+
+    bool is_compatible(const uint32_t n) const
+    {
+        return dst.get_num_attributes() == n && expr.is_compatible(n);
+    }
+
+    Attribute<T, HandleT> dst;
+    ExprT                 expr;
+};
+
+/**
+ * @brief sum of expr over all owned elements and components
+ */
+template <typename ExprT>
+struct SumTerm
+{
+    using Type       = typename ExprT::Type;
+    using HandleType = typename ExprT::HandleType;
+
+    static constexpr bool is_reduction = true;
+
+    template <typename AccT>
+    __host__ __device__ __forceinline__ void apply(const uint32_t p,
+                                                   const uint16_t i,
+                                                   const uint32_t j,
+                                                   AccT&          acc) const
+    {
+        acc += static_cast<AccT>(expr(p, i, j));
+    }
+
+    uint32_t num_attributes() const
+    {
+        return expr.num_attributes();
+    }
+
+    bool is_compatible(const uint32_t n) const
+    {
+        return expr.is_compatible(n);
+    }
+
+    ExprT expr;
+};
+
+/**
+ * @brief evaluate the terms in one pass over the patches of rx. Returns the
+ * sum of the reduction terms. d_partial (device) and h_partial (host) are
+ * per-patch scratch space for reductions and could be null if there are no
+ * reduction terms
+ */
+template <typename T, typename HandleT, typename... TermsT>
+T evaluate_expr(const RXMesh&   rx,
+                locationT       location,
+                cudaStream_t    stream,
+                T*              d_partial,
+                std::vector<T>* h_partial,
+                const TermsT&... terms)
+{
+    static_assert(sizeof...(TermsT) > 0, "evaluate() needs at least one term");
+    static_assert((std::is_same_v<typename TermsT::HandleType, HandleT> && ...),
+                  "All terms in evaluate() should be defined on the same mesh "
+                  "element (vertices, edges, or faces)");
+
+    const uint32_t num_attributes = std::max({terms.num_attributes()...});
+    if (num_attributes == 0 || !(terms.is_compatible(num_attributes) && ...)) {
+        RXMESH_ERROR(
+            "evaluate() all attributes in the terms should have the same "
+            "number of attributes");
+        return T(0);
+    }
+
+    const uint32_t num_patches = rx.get_num_patches();
+    if (h_partial != nullptr) {
+        h_partial->resize(num_patches);
+    }
+
+#ifdef RX_CPU_ONLY
+    location = cpu_location(location);
+#endif
+
+    if ((location & HOST) == HOST) {
+        auto run = [&](uint32_t p) {
+            const PatchInfo& pi = rx.get_patch(p);
+
+            const T sum = host_masked_sum<T>(
+                pi.get_owned_mask<HandleT>(),
+                pi.get_active_mask<HandleT>(),
+                pi.get_num_elements<HandleT>()[0],
+                [&](uint32_t i) {
+                    T acc = 0;
+                    for (uint32_t j = 0; j < num_attributes; ++j) {
+                        (terms.apply(p, static_cast<uint16_t>(i), j, acc), ...);
+                    }
+                    return acc;
+                });
+
+            if (h_partial != nullptr) {
+                (*h_partial)[p] = sum;
+            }
+        };
+
+        if (const HostAffinity* affinity = rx.get_host_affinity()) {
+            affinity->run(num_patches, run);
+        } else {
+#pragma omp parallel for schedule(dynamic)
+            for (int p = 0; p < static_cast<int>(num_patches); ++p) {
+                run(p);
+            }
+        }
+
+        if (h_partial == nullptr) {
+            return T(0);
+        }
+        return host_tree_reduce(*h_partial, num_patches, std::plus<T>(), T(0));
+    }
+
+#ifndef RX_CPU_ONLY
+    if ((location & DEVICE) == DEVICE) {
+        constexpr uint32_t blockSize = 256;
+
+        evaluate_expr_kernel<T, blockSize, HandleT>
+            <<<num_patches, blockSize, 0, stream>>>(
+                num_patches,
+                rx.get_context().m_patches_info,
+                num_attributes,
+                (h_partial != nullptr) ? d_partial : nullptr,
+                terms...);
+
+        if (h_partial == nullptr || d_partial == nullptr) {
+            return T(0);
+        }
+
+        // the per-patch partials are combined on the host with the same
+        // fixed-order tree as the host path
+        CUDA_ERROR(cudaMemcpyAsync(h_partial->data(),
+                                   d_partial,
+                                   num_patches * sizeof(T),
+                                   cudaMemcpyDeviceToHost,
+                                   stream));
+        CUDA_ERROR(cudaStreamSynchronize(stream));
+
+        return host_tree_reduce(*h_partial, num_patches, std::plus<T>(), T(0));
+    }
+#endif
+    return T(0);
+}
+}  // namespace detail
+
+template <typename L,
+          typename R,
+          std::enable_if_t<detail::is_expr_args_v<L, R>, bool> = true>
+auto operator+(const L& l, const R& r)
+{
+    return detail::make_binary_expr<detail::PlusOp>(l, r);
+}
+
+template <typename L,
+          typename R,
+          std::enable_if_t<detail::is_expr_args_v<L, R>, bool> = true>
+auto operator-(const L& l, const R& r)
+{
+    return detail::make_binary_expr<detail::MinusOp>(l, r);
+}
+
+template <typename L,
+          typename R,
+          std::enable_if_t<detail::is_expr_args_v<L, R>, bool> = true>
+auto operator*(const L& l, const R& r)
+{
+    return detail::make_binary_expr<detail::MultipliesOp>(l, r);
+}
+
+template <typename L,
+          typename R,
+          std::enable_if_t<detail::is_expr_args_v<L, R>, bool> = true>
+auto operator/(const L& l, const R& r)
+{
+    return detail::make_binary_expr<detail::DividesOp>(l, r);
+}
+
+template <typename E,
+          std::enable_if_t<detail::is_expr_operand_v<E>, bool> = true>
+auto operator-(const E& e)
+{
+    auto ex = detail::to_expr<E>(e);
+    return detail::NegateExpr<decltype(ex)>(ex);
+}
+
+/**
+ * @brief a term of evaluate() that writes expr to dst. The expression could
+ * read dst itself, e.g., assign(X, X + alpha * P)
+ */
+template <typename T, typename HandleT, typename E>
+auto assign(Attribute<T, HandleT>& dst, const E& expr)
+{
+    static_assert(detail::is_expr_operand_v<E> || std::is_arithmetic_v<E>,
+                  "assign() expects an attribute, an attribute expression, or "
+                  "a scalar");
+    auto ex = detail::to_expr<Attribute<T, HandleT>>(expr);
+    return detail::AssignTerm<T, HandleT, decltype(ex)>{dst, ex};
+}
+
+/**
+ * @brief a term of ReduceHandle::evaluate() that sums expr over all (owned)
+ * elements and all components e.g., reduce_sum(R * R) is the squared norm of
+ * R
+ */
+template <typename E,
+          std::enable_if_t<detail::is_expr_operand_v<E>, bool> = true>
+auto reduce_sum(const E& expr)
+{
+    auto ex = detail::to_expr<E>(expr);
+    return detail::SumTerm<decltype(ex)>{ex};
+}
+
+/**
+ * @brief evaluate assign() terms in one pass over all patches on the HOST or
+ * on the DEVICE (as one kernel). Use ReduceHandle::evaluate() to also fuse
+ * reductions (reduce_sum()) into the same pass
+ * @param rx the mesh the attributes are defined on
+ * @param location HOST or DEVICE
+ * @param stream the stream on which the kernel is launched
+ * @param terms one or more assign()
+ */
+template <typename... TermsT>
+void evaluate(const RXMesh& rx,
+              locationT     location,
+              cudaStream_t  stream,
+              const TermsT&... terms)
+{
+    static_assert(!(TermsT::is_reduction || ...),
+                  "evaluate() does not return reductions. Use "
+                  "ReduceHandle::evaluate() with reduce_sum() terms");
+
+    using FirstT = std::tuple_element_t<0, std::tuple<TermsT...>>;
+
+    detail::evaluate_expr<typename FirstT::Type,
+                          typename FirstT::HandleType>(
+        rx, location, stream, nullptr, nullptr, terms...);
+}
+
+}  // namespace rxmesh
@@ -1,6 +1,8 @@
 #pragma once
 
+#ifndef RX_CPU_ONLY
 #include <cooperative_groups.h>
+#endif
 #include <stdint.h>
 
 #include "rxmesh/kernels/loader.cuh"
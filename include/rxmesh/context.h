@@ -1,6 +1,7 @@
 #pragma once
 
 #include <stdint.h>
+#include "rxmesh/adjacency_cache.h"
 #include "rxmesh/patch_info.h"
 #include "rxmesh/patch_scheduler.cuh"
 #include "rxmesh/util/macros.h"
@@ -37,7 +38,9 @@ class Context
           m_h_face_prefix(nullptr),
           m_patches_info(nullptr),
           m_capacity_factor(0.0f),
-          m_max_num_patches(0)
+          m_max_num_patches(0),
+          m_d_adjacency_cache(nullptr),
+          m_h_adjacency_cache(nullptr)
     {
     }
 
@@ -154,6 +157,36 @@ class Context
         }
     }
 
+    /**
+     * @brief the adjacency cache of the query operation op or nullptr if op is
+     * not cached (see RXMeshStatic::build_adjacency_cache)
+     * @param oriented if the query is oriented. The cache of an oriented query
+     * (VV and VE) only serves oriented queries and vice versa
+     */
+    template <Op op>
+    __device__ __host__ __inline__ const AdjacencyCache* adjacency_cache(
+        const bool oriented) const
+    {
+#ifdef __CUDA_ARCH__
+        const AdjacencyCache* cache = m_d_adjacency_cache;
+#else
+        const AdjacencyCache* cache = m_h_adjacency_cache;
+#endif
+        if (cache == nullptr) {
+            return nullptr;
+        }
+        cache += static_cast<int>(op);
+        if (!cache->is_valid()) {
+            return nullptr;
+        }
+        if constexpr (op == Op::VV || op == Op::VE) {
+            if (cache->oriented != oriented) {
+                return nullptr;
+            }
+        }
+        return cache;
+    }
+
     /**
      * @brief get the owner handle of a given mesh element handle
      * @param handle the mesh element handle
@@ -351,5 +384,8 @@ class Context
     float          m_capacity_factor;
     uint32_t       m_max_num_patches;
     PatchScheduler m_patch_scheduler;
+    // indexed by Op. Entries are null (i.e., not valid) for queries that are
+    // not cached
+    AdjacencyCache *m_d_adjacency_cache, *m_h_adjacency_cache;
 };
 }  // namespace rxmesh
\ No newline at end of file
@@ -16,8 +16,11 @@
  */
 
 #pragma once
-#include <cuda_runtime.h>
 #include <stdint.h>
+#include "rxmesh/util/macros.h"
+#ifndef RX_CPU_ONLY
+#include <cuda_runtime.h>
+#endif
 
 namespace rxmesh {
 struct MarsRng32
@@ -14,7 +14,7 @@ struct Iterator
     using LocalT = typename HandleT::LocalT;
     using Handle = HandleT;
 
-    __device__ __inline__ Iterator()
+    __device__ __host__ __inline__ Iterator()
         : m_context(Context()),
           m_local_id(INVALID16),
           m_patch_output(nullptr),
@@ -30,9 +30,9 @@ struct Iterator
     {
     }
 
-    __device__ __inline__ Iterator(const Context& context,
-                                   const uint16_t local_id,
-                                   const uint32_t patch_id)
+    __device__ __host__ __inline__ Iterator(const Context& context,
+                                            const uint16_t local_id,
+                                            const uint32_t patch_id)
         : m_context(context),
           m_local_id(local_id),
           m_patch_output(nullptr),
@@ -48,17 +48,18 @@ struct Iterator
     {
     }
 
-    __device__ __inline__ Iterator(const Context&     context,
-                                   const uint16_t     local_id,
-                                   const LocalT*      patch_output,
-                                   const uint16_t*    patch_offset,
-                                   const uint32_t     offset_size,
-                                   const uint32_t     patch_id,
-                                   const uint32_t*    output_owned_bitmask,
-                                   const LPHashTable& output_lp_hashtable,
-                                   const LPPair*      s_table,
-                                   const PatchStash   patch_stash,
-                                   int                shift = 0)
+    __device__ __host__ __inline__ Iterator(
+        const Context&     context,
+        const uint16_t     local_id,
+        const LocalT*      patch_output,
+        const uint16_t*    patch_offset,
+        const uint32_t     offset_size,
+        const uint32_t     patch_id,
+        const uint32_t*    output_owned_bitmask,
+        const LPHashTable& output_lp_hashtable,
+        const LPPair*      s_table,
+        const PatchStash   patch_stash,
+        int                shift = 0)
         : m_context(context),
           m_local_id(local_id),
           m_patch_output(patch_output),
@@ -75,12 +76,12 @@ struct Iterator
     Iterator(const Iterator& orig) = default;
 
 
-    __device__ __inline__ uint16_t size() const
+    __device__ __host__ __inline__ uint16_t size() const
     {
         return m_end - m_begin;
     }
 
-    __device__ __inline__ HandleT operator[](const uint16_t i) const
+    __device__ __host__ __inline__ HandleT operator[](const uint16_t i) const
     {
         if (i + m_begin >= m_end) {
             return HandleT();
@@ -96,7 +97,10 @@ struct Iterator
             HandleT ret(m_patch_id, lid);
             return ret;
         } else {
+#ifdef __CUDA_ARCH__
+            // on the host, the lookup goes directly to the patch's hashtable
             assert(m_s_table);
+#endif
             LPPair lp = m_output_lp_hashtable.find(lid, m_s_table);
             if (lp.is_sentinel()) {
                 return HandleT();
@@ -108,7 +112,7 @@ struct Iterator
         }
     }
 
-    __device__ __inline__ uint16_t local(const uint16_t i) const
+    __device__ __host__ __inline__ uint16_t local(const uint16_t i) const
     {
         if (i + m_begin >= m_end) {
             return INVALID16;
@@ -119,12 +123,12 @@ struct Iterator
         return lid;
     }
 
-    __device__ __inline__ HandleT back() const
+    __device__ __host__ __inline__ HandleT back() const
     {
         return ((*this)[size() - 1]);
     }
 
-    __device__ __inline__ HandleT front() const
+    __device__ __host__ __inline__ HandleT front() const
     {
         return ((*this)[0]);
     }
@@ -144,9 +148,9 @@ struct Iterator
     uint16_t          m_current;
     int               m_shift;
 
-    __device__ void set(const uint16_t  local_id,
-                        const uint32_t  offset_size,
-                        const uint16_t* patch_offset)
+    __device__ __host__ void set(const uint16_t  local_id,
+                                 const uint32_t  offset_size,
+                                 const uint16_t* patch_offset)
     {
         m_current = 0;
         if (offset_size == 0) {
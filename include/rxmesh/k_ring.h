@@ -0,0 +1,182 @@
+#pragma once
+
+#include <assert.h>
+#include <stdint.h>
+
+#include "rxmesh/handle.h"
+#include "rxmesh/util/macros.h"
+
+namespace rxmesh {
+
+/**
+ * @brief iterate over (part of) the k-ring of a vertex as stored in KRing.
+ * Unlike Iterator, the neighbors are stored as (owner) VertexHandle and so
+ * there is no lookup on access
+ */
+struct KRingIterator
+{
+    __host__ __device__ KRingIterator() : m_begin(nullptr), m_size(0)
+    {
+    }
+
+    __host__ __device__ KRingIterator(const VertexHandle* begin,
+                                      const uint32_t      size)
+        : m_begin(begin), m_size(size)
+    {
+    }
+
+    __host__ __device__ __inline__ uint32_t size() const
+    {
+        return m_size;
+    }
+
+    __host__ __device__ __inline__ VertexHandle operator[](
+        const uint32_t i) const
+    {
+        assert(i < m_size);
+        return m_begin[i];
+    }
+
+    __host__ __device__ __inline__ const VertexHandle* begin() const
+    {
+        return m_begin;
+    }
+
+    __host__ __device__ __inline__ const VertexHandle* end() const
+    {
+        return m_begin + m_size;
+    }
+
+   private:
+    const VertexHandle* m_begin;
+    uint32_t            m_size;
+};
+
+/**
+ * @brief the k-ring neighborhood of every vertex in the mesh stored in a
+ * compact CSR. Vertices are indexed by their patch and local index i.e.,
+ * the vertex (p, v) is at slot start[p] + v. For every slot, the CSR stores
+ * num_rings row offsets (one per ring) and so ring r (1-based) of slot s is
+ * value[offset[s * num_rings + r - 1], offset[s * num_rings + r]). Neighbors
+ * are stored as owner handles ordered by ring where the 1st ring follows the
+ * order of the VV query. Only owned vertices have a k-ring; other slots are
+ * empty. KRing is a light-weight view (similar to Attribute) that can be
+ * passed by value to kernels. The memory is owned and released by
+ * RXMeshStatic (see RXMeshStatic::build_k_ring) and so a KRing (and every
+ * KRingIterator taken from it) is invalidated once the k-ring is released or
+ * rebuilt with a larger k. A new view should be obtained from build_k_ring()
+ * after that
+ */
+struct KRing
+{
+    __host__ __device__ KRing()
+        : m_k(0),
+          m_num_rings(0),
+          m_h_start(nullptr),
+          m_h_offset(nullptr),
+          m_h_value(nullptr),
+          m_d_start(nullptr),
+          m_d_offset(nullptr),
+          m_d_value(nullptr)
+    {
+    }
+
+    /**
+     * @brief the number of rings accessible through this view
+     */
+    __host__ __device__ __inline__ uint32_t get_k() const
+    {
+        return m_k;
+    }
+
+    /**
+     * @brief true if the k-ring has been built
+     */
+    __host__ __device__ __inline__ bool is_valid() const
+    {
+        return m_k > 0;
+    }
+
+    /**
+     * @brief the k-ring of an owned vertex i.e., the vertices in the 1st up
+     * to the k-th ring
+     * @param vh the input (owned) vertex
+     */
+    __host__ __device__ __inline__ KRingIterator operator()(
+        const VertexHandle& vh) const
+    {
+        const uint32_t  s      = slot(vh);
+        const uint32_t* offset = get_offset();
+        const uint32_t  begin  = offset[s * m_num_rings];
+        return KRingIterator(get_value() + begin,
+                             offset[s * m_num_rings + m_k] - begin);
+    }
+
+    /**
+     * @brief one ring (1-based) of the k-ring of an owned vertex
+     * @param vh the input (owned) vertex
+     * @param ring the ring which should be in [1, k]
+     */
+    __host__ __device__ __inline__ KRingIterator operator()(
+        const VertexHandle& vh,
+        const uint32_t      ring) const
+    {
+        if (ring == 0 || ring > m_k) {
+            return KRingIterator();
+        }
+        const uint32_t  s      = slot(vh);
+        const uint32_t* offset = get_offset();
+        const uint32_t  begin  = offset[s * m_num_rings + ring - 1];
+        return KRingIterator(get_value() + begin,
+                             offset[s * m_num_rings + ring] - begin);
+    }
+
+    uint32_t            m_k;
+    uint32_t            m_num_rings;
+    const uint32_t*     m_h_start;
+    const uint32_t*     m_h_offset;
+    const VertexHandle* m_h_value;
+    const uint32_t*     m_d_start;
+    const uint32_t*     m_d_offset;
+    const VertexHandle* m_d_value;
+
+   private:
+    __host__ __device__ __inline__ uint32_t slot(const VertexHandle& vh) const
+    {
+        assert(is_valid());
+        assert(vh.is_valid());
+        const auto     pl = vh.unpack();
+        const uint32_t s  = get_start()[pl.first] + pl.second;
+        assert(s < get_start()[pl.first + 1]);
+        return s;
+    }
+
+    __host__ __device__ __inline__ const uint32_t* get_start() const
+    {
+#ifdef __CUDA_ARCH__
+        return m_d_start;
+#else
+        return m_h_start;
+#endif
+    }
+
+    __host__ __device__ __inline__ const uint32_t* get_offset() const
+    {
+#ifdef __CUDA_ARCH__
+        return m_d_offset;
+#else
+        return m_h_offset;
+#endif
+    }
+
+    __host__ __device__ __inline__ const VertexHandle* get_value() const
+    {
+#ifdef __CUDA_ARCH__
+        return m_d_value;
+#else
+        return m_h_value;
+#endif
+    }
+};
+
+}  // namespace rxmesh
@@ -1,5 +1,6 @@
 #pragma once
 #include <cub/block/block_reduce.cuh>
+#include "rxmesh/patch_info.h"
 #include "rxmesh/util/macros.h"
 
 #include "rxmesh/arg_ops.h"
@@ -191,6 +192,44 @@ __launch_bounds__(blockSize) __global__
 }
 
 
+/**
+ * @brief evaluate fused attribute expression terms (see attribute_expr.h) over
+ * the owned elements of every patch in one pass. Every term is applied to an
+ * element component in order so later terms see what earlier terms wrote. If
+ * d_block_output is not null, the sum of the reduction terms of every patch is
+ * written to d_block_output[patch]
+ */
+template <class T, uint32_t blockSize, typename HandleT, typename... TermsT>
+__launch_bounds__(blockSize) __global__
+    void evaluate_expr_kernel(const uint32_t   num_patches,
+                              const PatchInfo* patches_info,
+                              const uint32_t   num_attributes,
+                              T*               d_block_output,
+                              TermsT... terms)
+{
+    using LocalT = typename HandleT::LocalT;
+
+    uint32_t p_id = blockIdx.x;
+    if (p_id < num_patches) {
+        const PatchInfo& pi = patches_info[p_id];
+
+        const uint16_t element_per_patch = pi.get_num_elements<HandleT>()[0];
+        T              thread_val        = 0;
+        for (uint16_t i = threadIdx.x; i < element_per_patch; i += blockSize) {
+            if (pi.is_owned(LocalT(i)) && !pi.is_deleted(LocalT(i))) {
+                for (uint32_t j = 0; j < num_attributes; ++j) {
+                    (terms.apply(p_id, i, j, thread_val), ...);
+                }
+            }
+        }
+
+        if (d_block_output != nullptr) {
+            cub_block_sum<blockSize>(thread_val, d_block_output);
+        }
+    }
+}
+
+
 template <typename T, typename HandleT>
 __global__ void memset_attribute(const Attribute<T, HandleT> attr,
                                  const T                     value,
@@ -1,6 +1,8 @@
 #pragma once
-#include <cuda_runtime.h>
 #include "rxmesh/util/macros.h"
+#ifndef RX_CPU_ONLY
+#include <cuda_runtime.h>
+#endif
 
 namespace rxmesh {
 __global__ static void get_cude_arch_k(int* d_arch)
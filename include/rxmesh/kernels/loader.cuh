@@ -3,8 +3,10 @@
 #include <assert.h>
 #include <stdint.h>
 
+#ifndef RX_CPU_ONLY
 #include <cooperative_groups.h>
 #include <cooperative_groups/memcpy_async.h>
+#endif
 #include "rxmesh/kernels/shmem_allocator.cuh"
 #include "rxmesh/local.h"
 #include "rxmesh/types.h"
@@ -23,6 +23,8 @@ namespace detail {
 
 /**
  * query_block_dispatcher()
+ * @param cache if not null, the output of the query is read from the adjacency
+ * cache (in global memory) instead of being computed in shared memory
  */
 template <Op op, uint32_t blockThreads, typename activeSetT>
 __device__ __inline__ void query_block_dispatcher(
@@ -38,7 +40,8 @@ __device__ __inline__ void query_block_dispatcher(
     uint32_t*&                        s_output_owned_bitmask,
     LPHashTable&                      output_lp_hashtable,
     LPPair*&                          s_table,
-    bool                              allow_not_owned = false)
+    bool                              allow_not_owned = false,
+    const AdjacencyCache*             cache           = nullptr)
 {
     num_src_in_patch                = 0;
     uint16_t    num_output_in_patch = 0;
@@ -152,13 +155,19 @@ __device__ __inline__ void query_block_dispatcher(
     }
 
 
-    // Perform the query operation
-    query<blockThreads, op>(block,
-                            patch_info,
-                            shrd_alloc,
-                            s_output_offset,
-                            s_output_value,
-                            oriented);
+    // Perform the query operation or use its materialized output
+    if (cache != nullptr) {
+        const uint32_t p = patch_info.patch_id;
+        s_output_offset  = const_cast<uint16_t*>(cache->offset(p));
+        s_output_value   = const_cast<uint16_t*>(cache->value(p));
+    } else {
+        query<blockThreads, op>(block,
+                                patch_info,
+                                shrd_alloc,
+                                s_output_offset,
+                                s_output_value,
+                                oriented);
+    }
 
     block.sync();
     alloc_then_load_table(true);
@@ -220,6 +229,9 @@ __device__ __inline__ void query_block_dispatcher(
     LPHashTable output_lp_hashtable;
     LPPair*     s_table;
 
+    const AdjacencyCache* cache =
+        context.template adjacency_cache<op>(oriented);
+
     query_block_dispatcher<op, blockThreads>(block,
                                              shrd_alloc,
                                              context.m_patches_info[patch_id],
@@ -231,7 +243,9 @@ __device__ __inline__ void query_block_dispatcher(
                                              s_participant_bitmask,
                                              s_output_owned_bitmask,
                                              output_lp_hashtable,
-                                             s_table);
+                                             s_table,
+                                             false,
+                                             cache);
 
     // Call compute on the output in shared memory by looping over all
     // source elements in this patch.
@@ -239,7 +253,8 @@ __device__ __inline__ void query_block_dispatcher(
         ((op == Op::EV) ? 2 :
                           ((op == Op::FV || op == Op::FE) ?
                                3 :
-                               ((op == Op::EVDiamond) ? 4 : 0)));
+                               ((op == Op::EVDiamond || op == Op::EE) ? 4 :
+                                                                        0)));
 
     for (uint16_t local_id = threadIdx.x; local_id < num_src_in_patch;
          local_id += blockThreads) {
@@ -535,7 +550,9 @@ __device__ __inline__ void higher_query_block_dispatcher(
             s_participant_bitmask,
             s_output_owned_bitmask,
             output_lp_hashtable,
-            s_table);
+            s_table,
+            false,
+            context.template adjacency_cache<op>(oriented));
 
 
         if (pl.first == patch_id) {
@@ -544,7 +561,9 @@ __device__ __inline__ void higher_query_block_dispatcher(
                 ((op == Op::EV) ? 2 :
                                   ((op == Op::FV || op == Op::FE) ?
                                        3 :
-                                       ((op == Op::EVDiamond) ? 4 : 0)));
+                                       ((op == Op::EVDiamond || op == Op::EE) ?
+                                            4 :
+                                            0)));
 
             ComputeIteratorT iter(
                 context,
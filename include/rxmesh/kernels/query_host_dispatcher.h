@@ -0,0 +1,156 @@
+#pragma once
+#include <assert.h>
+#include <stdint.h>
+#include <type_traits>
+#include <vector>
+
+#include "rxmesh/context.h"
+#include "rxmesh/handle.h"
+#include "rxmesh/iterator.cuh"
+#include "rxmesh/kernels/rxmesh_queries_host.h"
+#include "rxmesh/types.h"
+#include "rxmesh/util/bitmask_util.h"
+#include "rxmesh/util/meta.h"
+
+namespace rxmesh {
+
+namespace detail {
+
+/**
+ * query_host_dispatcher()
+ * @brief host counterpart of query_block_dispatcher. Runs the query
+ * operation op on a single patch using its host PatchInfo (or reads its
+ * output from the adjacency cache if op is cached) and then call compute_op on
+ * every participant element. offset and value are scratch buffers that could
+ * be reused across patches processed by the same thread
+ */
+template <Op op, typename computeT, typename activeSetT>
+inline void query_host_dispatcher(const Context&         context,
+                                  const PatchInfo&       patch_info,
+                                  computeT               compute_op,
+                                  activeSetT             compute_active_set,
+                                  const bool             oriented,
+                                  const bool             allow_not_owned,
+                                  std::vector<uint16_t>& offset,
+                                  std::vector<uint16_t>& value)
+{
+    // Extract the type of the input parameters of the compute lambda function.
+    // The first parameter should be Vertex/Edge/FaceHandle and second parameter
+    // should be RXMeshVertex/Edge/FaceIterator
+    using ComputeTraits    = detail::FunctionTraits<computeT>;
+    using ComputeHandleT   = typename ComputeTraits::template arg<0>::type;
+    using ComputeIteratorT = typename ComputeTraits::template arg<1>::type;
+    using LocalT           = typename ComputeIteratorT::LocalT;
+
+    using ActiveSetTraits  = detail::FunctionTraits<activeSetT>;
+    using ActiveSetHandleT = typename ActiveSetTraits::template arg<0>::type;
+    static_assert(
+        std::is_same_v<ActiveSetHandleT, ComputeHandleT>,
+        "First argument of compute_op lambda function should match the first "
+        "argument of active_set lambda function ");
+
+    if (patch_info.patch_id == INVALID32) {
+        return;
+    }
+
+    uint16_t        num_src_in_patch = 0;
+    const uint32_t* input_active_mask(nullptr);
+    const uint32_t* input_owned_mask(nullptr);
+    const uint32_t* output_owned_mask(nullptr);
+    LPHashTable     output_lp_hashtable;
+
+    if constexpr (op == Op::VV || op == Op::VE || op == Op::VF) {
+        num_src_in_patch  = patch_info.num_vertices[0];
+        input_active_mask = patch_info.active_mask_v;
+        input_owned_mask  = patch_info.owned_mask_v;
+    }
+    if constexpr (op == Op::EV || op == Op::EE || op == Op::EF ||
+                  op == Op::EVDiamond) {
+        num_src_in_patch  = patch_info.num_edges[0];
+        input_active_mask = patch_info.active_mask_e;
+        input_owned_mask  = patch_info.owned_mask_e;
+    }
+    if constexpr (op == Op::FV || op == Op::FE || op == Op::FF) {
+        num_src_in_patch  = patch_info.num_faces[0];
+        input_active_mask = patch_info.active_mask_f;
+        input_owned_mask  = patch_info.owned_mask_f;
+    }
+
+    if constexpr (op == Op::VV || op == Op::EV || op == Op::FV ||
+                  op == Op::EVDiamond) {
+        output_owned_mask   = patch_info.owned_mask_v;
+        output_lp_hashtable = patch_info.lp_v;
+    }
+    if constexpr (op == Op::VE || op == Op::EE || op == Op::FE) {
+        output_owned_mask   = patch_info.owned_mask_e;
+        output_lp_hashtable = patch_info.lp_e;
+    }
+    if constexpr (op == Op::VF || op == Op::EF || op == Op::FF) {
+        output_owned_mask   = patch_info.owned_mask_f;
+        output_lp_hashtable = patch_info.lp_f;
+    }
+
+    auto is_participant = [&](const uint16_t local_id) {
+        return !is_deleted(local_id, input_active_mask) &&
+               (allow_not_owned || is_owned(local_id, input_owned_mask)) &&
+               compute_active_set({patch_info.patch_id, local_id});
+    };
+
+    // skip the query if this patch has no work to do
+    bool any_participant = false;
+    for (uint16_t local_id = 0; local_id < num_src_in_patch; ++local_id) {
+        if (is_participant(local_id)) {
+            any_participant = true;
+            break;
+        }
+    }
+    if (!any_participant) {
+        return;
+    }
+
+    // Perform the query operation or use its materialized output
+    const uint16_t* output_offset(nullptr);
+    const uint16_t* output_value(nullptr);
+    if (const AdjacencyCache* cache =
+            context.template adjacency_cache<op>(oriented)) {
+        output_offset = cache->offset(patch_info.patch_id);
+        output_value  = cache->value(patch_info.patch_id);
+    } else {
+        query_host<op>(patch_info, offset, value, oriented);
+        output_offset = offset.data();
+        output_value  = value.data();
+    }
+
+    constexpr uint32_t fixed_offset =
+        ((op == Op::EV) ? 2 :
+                          ((op == Op::FV || op == Op::FE) ?
+                               3 :
+                               ((op == Op::EVDiamond || op == Op::EE) ? 4 :
+                                                                        0)));
+
+    for (uint16_t local_id = 0; local_id < num_src_in_patch; ++local_id) {
+
+        if (is_participant(local_id)) {
+
+            // the hashtable lookup is done directly on the patch's (host)
+            // table since there is no shared memory copy of it
+            ComputeHandleT   handle(patch_info.patch_id, local_id);
+            ComputeIteratorT iter(context,
+                                  local_id,
+                                  reinterpret_cast<const LocalT*>(output_value),
+                                  output_offset,
+                                  fixed_offset,
+                                  patch_info.patch_id,
+                                  output_owned_mask,
+                                  output_lp_hashtable,
+                                  nullptr,
+                                  patch_info.patch_stash,
+                                  int(op == Op::FE));
+
+            compute_op(handle, iter);
+        }
+    }
+}
+
+}  // namespace detail
+}  // namespace rxmesh
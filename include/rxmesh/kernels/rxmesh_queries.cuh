@@ -304,7 +304,7 @@ __device__ __forceinline__ void e_e_manifold(
 
             for (int cur = 0; cur < 3; ++cur) {
                 const int nxt = (cur + 1) % 3;
-                const int prv = (cur - 1) % 3;
+                const int prv = (cur + 2) % 3;
 
                 const uint16_t cur_e = f_e[cur];
                 const uint16_t nxt_e = f_e[nxt];
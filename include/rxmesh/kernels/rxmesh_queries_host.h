@@ -0,0 +1,495 @@
+#pragma once
+
+#include <assert.h>
+#include <stdint.h>
+#include <algorithm>
+#include <vector>
+
+#include "rxmesh/context.h"
+#include "rxmesh/patch_info.h"
+#include "rxmesh/types.h"
+#include "rxmesh/util/bitmask_util.h"
+
+namespace rxmesh {
+namespace detail {
+
+/**
+ * @brief host counterpart of block_mat_transpose. Transpose a matrix with
+ * fixed number of non-zeros per row (rowOffset) into CSR format where offset
+ * is of size num_cols + 1. Deleted rows and INVALID16 entries are skipped.
+ */
+template <uint32_t rowOffset>
+inline void host_mat_transpose(const uint32_t         num_rows,
+                               const uint32_t         num_cols,
+                               const uint16_t*        mat,
+                               std::vector<uint16_t>& offset,
+                               std::vector<uint16_t>& value,
+                               const uint32_t*        row_active_mask,
+                               int                    shift)
+{
+    offset.assign(num_cols + 1, 0);
+
+    for (uint32_t r = 0; r < num_rows; ++r) {
+        if (is_deleted(r, row_active_mask)) {
+            continue;
+        }
+        for (uint32_t i = 0; i < rowOffset; ++i) {
+            const uint16_t c = mat[r * rowOffset + i];
+            if (c == INVALID16) {
+                continue;
+            }
+            assert((c >> shift) < num_cols);
+            offset[(c >> shift) + 1]++;
+        }
+    }
+
+    for (uint32_t c = 0; c < num_cols; ++c) {
+        offset[c + 1] += offset[c];
+    }
+
+    value.resize(std::max<uint32_t>(offset[num_cols], 1));
+
+    // reuse the offset as a running insertion pointer and then shift it back
+    for (uint32_t r = 0; r < num_rows; ++r) {
+        if (is_deleted(r, row_active_mask)) {
+            continue;
+        }
+        for (uint32_t i = 0; i < rowOffset; ++i) {
+            const uint16_t c = mat[r * rowOffset + i];
+            if (c == INVALID16) {
+                continue;
+            }
+            value[offset[c >> shift]++] = r;
+        }
+    }
+
+    for (uint32_t c = num_cols; c > 0; --c) {
+        offset[c] = offset[c - 1];
+    }
+    offset[0] = 0;
+}
+
+
+/**
+ * @brief host counterpart of e_f_manifold. ef should be of size 2*num_edges
+ */
+inline void host_e_f_manifold(const PatchInfo&       patch_info,
+                              std::vector<uint16_t>& ef)
+{
+    const uint16_t num_edges = patch_info.num_edges[0];
+    const uint16_t num_faces = patch_info.num_faces[0];
+
+    ef.assign(2 * num_edges, INVALID16);
+
+    for (uint16_t f = 0; f < num_faces; ++f) {
+        if (is_deleted(f, patch_info.active_mask_f)) {
+            continue;
+        }
+        for (int i = 0; i < 3; ++i) {
+            const uint16_t edge = patch_info.fe[3 * f + i].id >> 1;
+            assert(edge < num_edges);
+            if (ef[2 * edge] == INVALID16) {
+                ef[2 * edge] = f;
+            } else {
+                assert(ef[2 * edge + 1] == INVALID16);
+                ef[2 * edge + 1] = f;
+            }
+        }
+    }
+}
+
+
+/**
+ * @brief host counterpart of orient_edges_around_vertices. Re-order the
+ * edges incident to each vertex (the output of VE) such that consecutive edges
+ * share a face
+ */
+inline void host_orient_edges_around_vertices(
+    const PatchInfo&             patch_info,
+    const std::vector<uint16_t>& offset,
+    std::vector<uint16_t>&       value)
+{
+    const uint16_t num_vertices = patch_info.num_vertices[0];
+
+    std::vector<uint16_t> ef;
+    host_e_f_manifold(patch_info, ef);
+
+    const LocalEdgeT* fe = patch_info.fe;
+
+    // the edge that follows e_0 in face f
+    auto candid = [&](uint16_t f, uint16_t e_0) -> uint16_t {
+        uint16_t ret = INVALID16;
+        if (f != INVALID16) {
+            if ((fe[3 * f + 0].id >> 1) == e_0) {
+                ret = fe[3 * f + 2].id >> 1;
+            }
+            if ((fe[3 * f + 1].id >> 1) == e_0) {
+                ret = fe[3 * f + 0].id >> 1;
+            }
+            if ((fe[3 * f + 2].id >> 1) == e_0) {
+                ret = fe[3 * f + 1].id >> 1;
+            }
+        }
+        return ret;
+    };
+
+    for (uint16_t v = 0; v < num_vertices; ++v) {
+        if (patch_info.is_deleted(LocalVertexT(v))) {
+            continue;
+        }
+
+        const int start = int(offset[v]);
+        const int end   = int(offset[v + 1]);
+
+        if (end == start) {
+            continue;
+        }
+
+        // if the mesh is not closed, pick a boundary edge as starting point
+        int start_id = start;
+        for (int e_id = start; e_id < end; ++e_id) {
+            const uint16_t e_0 = value[e_id];
+            if (ef[2 * e_0] == INVALID16 || ef[2 * e_0 + 1] == INVALID16) {
+                start_id = e_id;
+                break;
+            }
+        }
+
+        int e_id        = start_id;
+        int edges_count = 0;
+        while (true) {
+            const uint16_t e_0        = value[e_id];
+            const uint16_t e_candid_0 = candid(ef[2 * e_0], e_0);
+            const uint16_t e_candid_1 = candid(ef[2 * e_0 + 1], e_0);
+
+            for (int vn = e_id + 1; vn < end; ++vn) {
+                const uint16_t e_winning_candid = value[vn];
+                if (e_candid_0 == e_winning_candid ||
+                    e_candid_1 == e_winning_candid) {
+                    std::swap(value[e_id + 1], value[vn]);
+                    break;
+                }
+            }
+
+            edges_count++;
+            if (edges_count > end - start - 1) {
+                break;
+            }
+            e_id = ((e_id - start + 1) % (end - start)) + start;
+        }
+    }
+}
+
+
+/**
+ * @brief host counterpart of v_e
+ */
+inline void host_v_e(const PatchInfo&       patch_info,
+                     std::vector<uint16_t>& offset,
+                     std::vector<uint16_t>& value,
+                     const bool             oriented)
+{
+    host_mat_transpose<2u>(patch_info.num_edges[0],
+                           patch_info.num_vertices[0],
+                           reinterpret_cast<const uint16_t*>(patch_info.ev),
+                           offset,
+                           value,
+                           patch_info.active_mask_e,
+                           0);
+    if (oriented) {
+        host_orient_edges_around_vertices(patch_info, offset, value);
+    }
+}
+
+
+/**
+ * @brief host counterpart of v_v. Compute VE and then replace each edge with
+ * the other end vertex
+ */
+inline void host_v_v(const PatchInfo&       patch_info,
+                     std::vector<uint16_t>& offset,
+                     std::vector<uint16_t>& value,
+                     const bool             oriented)
+{
+    host_v_e(patch_info, offset, value, oriented);
+
+    const uint16_t num_vertices = patch_info.num_vertices[0];
+
+    for (uint16_t v = 0; v < num_vertices; ++v) {
+        if (is_deleted(v, patch_info.active_mask_v)) {
+            continue;
+        }
+        for (uint16_t e = offset[v]; e < offset[v + 1]; ++e) {
+            const uint16_t edge = value[e];
+            const uint16_t v0   = patch_info.ev[2 * edge + 0].id;
+            const uint16_t v1   = patch_info.ev[2 * edge + 1].id;
+            assert(v0 == v || v1 == v);
+            value[e] = (v0 == v) ? v1 : v0;
+        }
+    }
+}
+
+
+/**
+ * @brief host counterpart of f_v. value is of size 3*num_faces
+ */
+inline void host_f_v(const PatchInfo& patch_info, std::vector<uint16_t>& value)
+{
+    const uint16_t num_faces = patch_info.num_faces[0];
+
+    value.resize(std::max(3 * num_faces, 1));
+
+    for (uint16_t f = 0; f < num_faces; ++f) {
+        if (is_deleted(f, patch_info.active_mask_f)) {
+            for (uint32_t i = 0; i < 3; ++i) {
+                value[3 * f + i] = INVALID16;
+            }
+            continue;
+        }
+        for (uint32_t i = 0; i < 3; ++i) {
+            uint16_t e = patch_info.fe[3 * f + i].id;
+            if (e == INVALID16) {
+                value[3 * f + i] = INVALID16;
+                continue;
+            }
+            flag_t e_dir(0);
+            Context::unpack_edge_dir(e, e, e_dir);
+            // if the direction is flipped, we take the second vertex
+            value[3 * f + i] = patch_info.ev[2 * e + e_dir].id;
+        }
+    }
+}
+
+
+/**
+ * @brief host counterpart of v_f i.e., transpose of FV
+ */
+inline void host_v_f(const PatchInfo&       patch_info,
+                     std::vector<uint16_t>& offset,
+                     std::vector<uint16_t>& value)
+{
+    std::vector<uint16_t> fv;
+    host_f_v(patch_info, fv);
+    host_mat_transpose<3u>(patch_info.num_faces[0],
+                           patch_info.num_vertices[0],
+                           fv.data(),
+                           offset,
+                           value,
+                           patch_info.active_mask_f,
+                           0);
+}
+
+
+/**
+ * @brief host counterpart of e_f i.e., transpose of FE
+ */
+inline void host_e_f(const PatchInfo&       patch_info,
+                     std::vector<uint16_t>& offset,
+                     std::vector<uint16_t>& value)
+{
+    host_mat_transpose<3u>(patch_info.num_faces[0],
+                           patch_info.num_edges[0],
+                           reinterpret_cast<const uint16_t*>(patch_info.fe),
+                           offset,
+                           value,
+                           patch_info.active_mask_f,
+                           1);
+}
+
+
+/**
+ * @brief host counterpart of f_f. Computed via EF where every face collects
+ * the faces incident to its three edges (excluding itself)
+ */
+inline void host_f_f(const PatchInfo&       patch_info,
+                     std::vector<uint16_t>& offset,
+                     std::vector<uint16_t>& value)
+{
+    const uint16_t num_faces = patch_info.num_faces[0];
+
+    std::vector<uint16_t> ef_offset, ef_value;
+    host_e_f(patch_info, ef_offset, ef_value);
+
+    offset.assign(num_faces + 1, 0);
+    for (uint16_t f = 0; f < num_faces; ++f) {
+        uint16_t num_neighbour_faces = 0;
+        if (!is_deleted(f, patch_info.active_mask_f)) {
+            for (int e = 0; e < 3; ++e) {
+                const uint16_t edge = patch_info.fe[3 * f + e].id >> 1;
+                num_neighbour_faces +=
+                    ef_offset[edge + 1] - ef_offset[edge] - 1;
+            }
+        }
+        offset[f + 1] = offset[f] + num_neighbour_faces;
+    }
+
+    value.resize(std::max<uint16_t>(offset[num_faces], 1));
+
+    for (uint16_t f = 0; f < num_faces; ++f) {
+        if (is_deleted(f, patch_info.active_mask_f)) {
+            continue;
+        }
+        uint16_t o = offset[f];
+        for (int e = 0; e < 3; ++e) {
+            const uint16_t edge = patch_info.fe[3 * f + e].id >> 1;
+            for (uint16_t ef = ef_offset[edge]; ef < ef_offset[edge + 1];
+                 ++ef) {
+                const uint16_t n_face = ef_value[ef];
+                if (n_face != f) {
+                    value[o++] = n_face;
+                }
+            }
+        }
+        assert(o == offset[f + 1]);
+    }
+}
+
+
+/**
+ * @brief host counterpart of e_v_diamond. The output for edge e is
+ * [v0, opposite vertex, v1, opposite vertex]
+ */
+inline void host_e_v_diamond(const PatchInfo&       patch_info,
+                             std::vector<uint16_t>& value)
+{
+    const uint16_t num_edges = patch_info.num_edges[0];
+    const uint16_t num_faces = patch_info.num_faces[0];
+
+    value.assign(std::max(4 * num_edges, 1), INVALID16);
+
+    for (uint16_t e = 0; e < num_edges; ++e) {
+        value[4 * e + 0] = patch_info.ev[2 * e + 0].id;
+        value[4 * e + 2] = patch_info.ev[2 * e + 1].id;
+    }
+
+    for (uint16_t face = 0; face < num_faces; ++face) {
+        if (is_deleted(face, patch_info.active_mask_f)) {
+            continue;
+        }
+        for (uint16_t local_e = 0; local_e < 3; ++local_e) {
+            uint16_t edge_i = INVALID16;
+            flag_t   dir_i  = 0;
+            Context::unpack_edge_dir(
+                patch_info.fe[3 * face + local_e].id, edge_i, dir_i);
+
+            // the vertex at the end of this edge
+            const uint16_t vertex_i = value[4 * edge_i + 2 * dir_i];
+
+            // the edge where vertex_i is opposite to it
+            uint16_t edge_i1 = INVALID16;
+            flag_t   dir_i1  = 0;
+            Context::unpack_edge_dir(
+                patch_info.fe[3 * face + (local_e + 1) % 3].id,
+                edge_i1,
+                dir_i1);
+            value[4 * edge_i1 + 1 + 2 * dir_i1] = vertex_i;
+        }
+    }
+}
+
+
+/**
+ * @brief host counterpart of e_e_manifold. Every edge is incident to 4 other
+ * edges (or 2 for boundary edges)
+ */
+inline void host_e_e_manifold(const PatchInfo&       patch_info,
+                              std::vector<uint16_t>& value)
+{
+    const uint16_t num_edges = patch_info.num_edges[0];
+    const uint16_t num_faces = patch_info.num_faces[0];
+
+    value.assign(std::max(4 * num_edges, 1), INVALID16);
+
+    for (uint16_t f = 0; f < num_faces; ++f) {
+        if (is_deleted(f, patch_info.active_mask_f)) {
+            continue;
+        }
+
+        uint16_t f_e[3];
+        flag_t   f_dir[3];
+        for (int i = 0; i < 3; ++i) {
+            Context::unpack_edge_dir(
+                patch_info.fe[3 * f + i].id, f_e[i], f_dir[i]);
+        }
+
+        for (int cur = 0; cur < 3; ++cur) {
+            const int nxt = (cur + 1) % 3;
+            const int prv = (cur + 2) % 3;
+
+            const uint16_t cur_e = f_e[cur];
+
+            int nxt_i = 4 * cur_e + 2 * f_dir[cur] + 0;
+            int prv_i = 4 * cur_e + 2 * f_dir[cur] + 1;
+
+            if (value[nxt_i] != INVALID16) {
+                nxt_i = 4 * cur_e + 2 * (f_dir[cur] ^ 1) + 0;
+                prv_i = 4 * cur_e + 2 * (f_dir[cur] ^ 1) + 1;
+            }
+            assert(value[nxt_i] == INVALID16);
+            assert(value[prv_i] == INVALID16);
+
+            value[nxt_i] = f_e[nxt];
+            value[prv_i] = f_e[prv];
+        }
+    }
+}
+
+
+/**
+ * @brief host counterpart of query(). Compute the query operation op on a
+ * single patch. The output is written to offset/value the same way the
+ * device query writes it in shared memory
+ */
+template <Op op>
+inline void query_host(const PatchInfo&       patch_info,
+                       std::vector<uint16_t>& offset,
+                       std::vector<uint16_t>& value,
+                       const bool             oriented)
+{
+    if constexpr (op == Op::VV) {
+        host_v_v(patch_info, offset, value, oriented);
+    }
+
+    if constexpr (op == Op::VE) {
+        host_v_e(patch_info, offset, value, oriented);
+    }
+
+    if constexpr (op == Op::VF) {
+        host_v_f(patch_info, offset, value);
+    }
+
+    if constexpr (op == Op::EV) {
+        const uint16_t  num_edges = patch_info.num_edges[0];
+        const uint16_t* ev = reinterpret_cast<const uint16_t*>(patch_info.ev);
+        value.assign(ev, ev + 2 * num_edges);
+    }
+
+    if constexpr (op == Op::EF) {
+        host_e_f(patch_info, offset, value);
+    }
+
+    if constexpr (op == Op::FV) {
+        host_f_v(patch_info, value);
+    }
+
+    if constexpr (op == Op::FE) {
+        const uint16_t  num_faces = patch_info.num_faces[0];
+        const uint16_t* fe = reinterpret_cast<const uint16_t*>(patch_info.fe);
+        value.assign(fe, fe + 3 * num_faces);
+    }
+
+    if constexpr (op == Op::FF) {
+        host_f_f(patch_info, offset, value);
+    }
+
+    if constexpr (op == Op::EVDiamond) {
+        host_e_v_diamond(patch_info, value);
+    }
+
+    if constexpr (op == Op::EE) {
+        host_e_e_manifold(patch_info, value);
+    }
+}
+
+}  // namespace detail
+}  // namespace rxmesh
@@ -1,8 +1,11 @@
 #pragma once
 #include <assert.h>
-#include <cuda_runtime.h>
 #include <stdint.h>
 #include <cstdio>
+#include "rxmesh/util/macros.h"
+#ifndef RX_CPU_ONLY
+#include <cuda_runtime.h>
+#endif
 
 namespace rxmesh {
 
@@ -88,8 +91,10 @@ struct ShmemAllocator
      */
     __device__ __forceinline__ uint32_t get_max_size_bytes() const
     {
-        uint32_t ret;
+        uint32_t ret = 0;
+#ifdef __CUDA_ARCH__
         asm("mov.u32 %0, %dynamic_smem_size;" : "=r"(ret));
+#endif
         return ret;
     }
 
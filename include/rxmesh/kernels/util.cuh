@@ -1,6 +1,9 @@
 #pragma once
-#include <cuda_runtime.h>
 #include <stdint.h>
+#include "rxmesh/util/macros.h"
+#ifndef RX_CPU_ONLY
+#include <cuda_runtime.h>
+#endif
 
 namespace rxmesh {
 
@@ -184,8 +187,10 @@ __device__ __forceinline__ unsigned short int atomicCAS(
 
 __device__ __forceinline__ unsigned dynamic_smem_size()
 {
-    unsigned ret;
+    unsigned ret = 0;
+#ifdef __CUDA_ARCH__
     asm volatile("mov.u32 %0, %dynamic_smem_size;" : "=r"(ret));
+#endif
     return ret;
 }
 
@@ -224,16 +229,20 @@ __device__ __forceinline__ void device_swap(T*& a, T*& b)
 
 __forceinline__ __device__ unsigned lane_id()
 {
-    unsigned ret;
+    unsigned ret = 0;
+#ifdef __CUDA_ARCH__
     asm volatile("mov.u32 %0, %laneid;" : "=r"(ret));
+#endif
     return ret;
 }
 
 __forceinline__ __device__ unsigned warp_id()
 {
     // this is not equal to threadIdx.x / 32
-    unsigned ret;
+    unsigned ret = 0;
+#ifdef __CUDA_ARCH__
     asm volatile("mov.u32 %0, %warpid;" : "=r"(ret));
+#endif
     return ret;
 }
 
@@ -16,7 +16,9 @@
  */
 
 #pragma once
+#ifndef RX_CPU_ONLY
 #include <cooperative_groups.h>
+#endif
 
 #include <algorithm>
 #include <random>
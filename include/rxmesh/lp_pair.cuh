@@ -1,8 +1,10 @@
 #pragma once
 #include <assert.h>
-#include <cuda_runtime.h>
 #include <stdint.h>
 #include <numeric>
+#ifndef RX_CPU_ONLY
+#include <cuda_runtime.h>
+#endif
 
 #include "rxmesh/util/bitmask_util.h"
 
@@ -2,6 +2,7 @@
 #include "rxmesh/matrix/iterative_solver.h"
 
 #include "rxmesh/attribute.h"
+#include "rxmesh/attribute_expr.h"
 #include "rxmesh/matrix/dense_matrix.h"
 #include "rxmesh/reduce_handle.h"
 
@@ -53,10 +54,13 @@ struct CGMatFreeAttrSolver : public IterativeSolver<T, Attribute<T, HandleT>>
         // init S
         m_mat_vec(X, S, stream);
 
-        init_PR(B, S, R, P, stream);
-
-        delta_new = reduce_handle.norm2(R, INVALID32, stream);
-        delta_new *= delta_new;
+        // R = B - S, P = R, and delta_new = <R,R> in one pass
+        delta_new = reduce_handle.evaluate(*m_rx,
+                                           DEVICE,
+                                           stream,
+                                           assign(R, B - S),
+                                           assign(P, R),
+                                           reduce_sum(R * R));
     }
 
     virtual void solve(AttributeT&  B,
@@ -68,6 +72,8 @@ struct CGMatFreeAttrSolver : public IterativeSolver<T, Attribute<T, HandleT>>
         this->m_iter_taken = 0;
 
         while (this->m_iter_taken < this->m_max_iter) {
+            RXMESH_TRACE_SCOPE("CGMatFreeAttr::iteration");
+
             // s = Ap
             m_mat_vec(P, S, stream);
 
@@ -75,29 +81,33 @@ struct CGMatFreeAttrSolver : public IterativeSolver<T, Attribute<T, HandleT>>
             alpha = reduce_handle.dot(S, P, INVALID32, stream);
             alpha = delta_new / alpha;
 
-            // X =  alpha*P + X
-            axpy(X, P, alpha, T(1.), stream);
+            // delta_old = delta_new
+            delta_old = delta_new;
 
             // reset residual
             if (this->m_iter_taken > 0 &&
                 this->m_iter_taken % m_reset_residual_freq == 0) {
+                // X =  alpha*P + X
+                axpy(X, P, alpha, T(1.), stream);
                 // s= Ax
                 m_mat_vec(X, S, stream);
                 // r = b-s
                 subtract(R, B, S, stream);
+
+                // delta_new = <r,r>
+                delta_new = reduce_handle.norm2(R, INVALID32, stream);
+                delta_new *= delta_new;
             } else {
-                // r = - alpha*s + r
-                axpy(R, S, -alpha, T(1.), stream);
+                // X =  alpha*P + X, r = - alpha*s + r, and delta_new = <r,r>
+                // in one pass
+                delta_new = reduce_handle.evaluate(*m_rx,
+                                                   DEVICE,
+                                                   stream,
+                                                   assign(X, X + alpha * P),
+                                                   assign(R, R - alpha * S),
+                                                   reduce_sum(R * R));
             }
 
-            // delta_old = delta_new
-            CUDA_ERROR(cudaStreamSynchronize(stream));
-            delta_old = delta_new;
-
-            // delta_new = <r,r>
-            delta_new = reduce_handle.norm2(R, INVALID32, stream);
-            delta_new *= delta_new;
-
             // exit if error is getting too low across three coordinates
             if (this->is_converged(this->m_start_residual, delta_new)) {
                 this->m_final_residual = delta_new;
@@ -134,16 +144,7 @@ struct CGMatFreeAttrSolver : public IterativeSolver<T, Attribute<T, HandleT>>
               const T           beta,
               cudaStream_t      stream)
     {
-        int num_attr = y.get_num_attributes();
-
-        m_rx->for_each<HandleT>(
-            DEVICE,
-            [y, x, alpha, beta, num_attr] __device__(const HandleT vh) mutable {
-                for (int i = 0; i < num_attr; ++i) {
-                    y(vh, i) = alpha * x(vh, i) + beta * y(vh, i);
-                }
-            },
-            stream);
+        evaluate(*m_rx, DEVICE, stream, assign(y, alpha * x + beta * y));
     }
 
     /**
@@ -154,16 +155,7 @@ struct CGMatFreeAttrSolver : public IterativeSolver<T, Attribute<T, HandleT>>
                   const AttributeT& s,
                   cudaStream_t      stream)
     {
-        int num_attr = r.get_num_attributes();
-
-        m_rx->for_each<HandleT>(
-            DEVICE,
-            [r, b, s, num_attr] __device__(const HandleT vh) mutable {
-                for (int i = 0; i < num_attr; ++i) {
-                    r(vh, i) = b(vh, i) - s(vh, i);
-                }
-            },
-            stream);
+        evaluate(*m_rx, DEVICE, stream, assign(r, b - s));
     }
 
 
@@ -176,17 +168,7 @@ struct CGMatFreeAttrSolver : public IterativeSolver<T, Attribute<T, HandleT>>
                  AttributeT&       P,
                  cudaStream_t      stream = NULL)
     {
-        int num_attr = R.get_num_attributes();
-
-        m_rx->for_each<HandleT>(
-            DEVICE,
-            [B, S, R, P, num_attr] __device__(const HandleT vh) mutable {
-                for (int i = 0; i < num_attr; ++i) {
-                    R(vh, i) = B(vh, i) - S(vh, i);
-                    P(vh, i) = R(vh, i);
-                }
-            },
-            stream);
+        evaluate(*m_rx, DEVICE, stream, assign(R, B - S), assign(P, R));
     };
 
    protected:
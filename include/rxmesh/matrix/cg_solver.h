@@ -62,6 +62,8 @@ struct CGSolver : public IterativeSolver<T, DenseMatrix<T, DenseMatOrder>>
         this->m_iter_taken = 0;
 
         while (this->m_iter_taken < this->m_max_iter) {
+            RXMESH_TRACE_SCOPE("CG::iteration");
+
             // s = Ap
             mat_vec(P, S, stream);
 
@@ -1,7 +1,9 @@
 #pragma once
 #include <vector>
+#ifndef RX_CPU_ONLY
 #include "cublas_v2.h"
 #include "cusparse.h"
+#endif
 
 #include "rxmesh/attribute.h"
 #include "rxmesh/context.h"
@@ -17,6 +19,13 @@
 #endif
 
 namespace rxmesh {
+
+#ifdef RX_CPU_ONLY
+// there is no cuSPARSE/cuBLAS on the host. The handles are never created
+using cusparseDnMatDescr_t = void*;
+using cublasHandle_t       = void*;
+#endif
+
 /**
  * @brief dense matrix use for device and host, inside is a array.
  * The dense matrix is initialized as col major on device.
@@ -24,6 +33,8 @@ namespace rxmesh {
  * cusparse and cusolver wants. However, there is a limited number of operations
  * defined on row major matrices.
  * Order define the storage order of the matrix.
+ * In a CPU-only build (RX_CPU_ONLY), host and device share one buffer and the
+ * cuBLAS operations are computed on the host with Eigen for float and double.
  */
 template <typename T, int Order = Eigen::ColMajor>
 struct DenseMatrix
@@ -174,10 +185,14 @@ struct DenseMatrix
                                        cudaMemcpyHostToDevice,
                                        stream));
         } else if (do_device) {
+#ifdef RX_CPU_ONLY
+            std::fill_n(m_d_val, rows() * cols(), val);
+#else
             const int    threads = 512;
             const IndexT nnz     = rows() * cols();
             memset<<<DIVIDE_UP(nnz, threads), threads, 0, stream>>>(
                 m_d_val, val, nnz);
+#endif
         } else if (do_host) {
             std::fill_n(m_h_val, rows() * cols(), val);
         }
@@ -343,6 +358,7 @@ struct DenseMatrix
         m_num_rows = new_num_rows;
         m_num_cols = new_num_cols;
 
+#ifndef RX_CPU_ONLY
         // make sure that cuSparse knows about these changes
         // just in case we used this matrix to multiply with a sparse matrix
         if (std::is_floating_point_v<T> || std::is_same_v<T, int> ||
@@ -356,6 +372,7 @@ struct DenseMatrix
                                                cuda_type<T>(),
                                                CUSPARSE_ORDER_COL));
         }
+#endif
     }
 
 
@@ -369,6 +386,7 @@ struct DenseMatrix
     }
 #endif
 
+#ifndef RX_CPU_ONLY
     /**
      * @brief compute the sum of the absolute value of all elements in the
      * matrix. For complex types (cuComples and cuDoubleComplex), we sum the
@@ -789,6 +807,153 @@ struct DenseMatrix
                 m_cublas_handle, rows() * cols(), m_d_val, 1, X.m_d_val, 1));
         }
     }
+#else
+    /**
+     * @brief compute the sum of the absolute value of all elements in the
+     * matrix. Only float and double are supported in a CPU-only build
+     */
+    __host__ BaseTypeT<T> abs_sum(cudaStream_t stream = NULL)
+    {
+        if constexpr (!std::is_same_v<T, float> && !std::is_same_v<T, double>) {
+            RXMESH_ERROR(
+                "DenseMatrix::abs_sum() only float and double are supported "
+                "in a CPU-only build!");
+            return BaseTypeT<T>(0);
+        } else {
+            return to_eigen().cwiseAbs().sum();
+        }
+    }
+
+    /**
+     * @brief compute Y = alpha * X + Y where Y is this dense matrix. Only float
+     * and double are supported in a CPU-only build
+     */
+    __host__ void axpy(DenseMatrix<T, Order>& X,
+                       T                      alpha,
+                       cudaStream_t           stream = NULL)
+    {
+        if constexpr (!std::is_same_v<T, float> && !std::is_same_v<T, double>) {
+            RXMESH_ERROR(
+                "DenseMatrix::axpy() only float and double are supported in a "
+                "CPU-only build!");
+            return;
+        } else {
+            if (rows() != X.rows() || cols() != X.cols()) {
+                RXMESH_ERROR(
+                    "DenseMatrix::axpy() The input matrices size does not "
+                    "match. This matrix size is {},{} while X size is {},{}",
+                    rows(),
+                    cols(),
+                    X.rows(),
+                    X.cols());
+                return;
+            }
+            to_eigen() += alpha * X.to_eigen();
+        }
+    }
+
+    /**
+     * @brief compute the dot produce with another dense matrix, i.e., the sum
+     * of the element-wise multiplication. Only float and double are supported
+     * in a CPU-only build
+     */
+    __host__ T dot(const DenseMatrix<T, Order>& x,
+                   bool                         use_conjugate = false,
+                   cudaStream_t                 stream        = NULL) const
+    {
+        if constexpr (!std::is_same_v<T, float> && !std::is_same_v<T, double>) {
+            RXMESH_ERROR(
+                "DenseMatrix::dot() only float and double are supported in a "
+                "CPU-only build!");
+            return T(0);
+        } else {
+            using ConstMap = Eigen::Map<const EigenDenseMatrix>;
+            return ConstMap(m_h_val, rows(), cols())
+                .cwiseProduct(ConstMap(x.m_h_val, x.rows(), x.cols()))
+                .sum();
+        }
+    }
+
+    /**
+     * @brief compute the (Frobenius) norm of the dense matrix. Only float and
+     * double are supported in a CPU-only build
+     */
+    __host__ BaseTypeT<T> norm2(cudaStream_t stream = NULL)
+    {
+        if constexpr (!std::is_same_v<T, float> && !std::is_same_v<T, double>) {
+            RXMESH_ERROR(
+                "DenseMatrix::norm2() only float and double are supported in "
+                "a CPU-only build!");
+            return BaseTypeT<T>(0);
+        } else {
+            return to_eigen().norm();
+        }
+    }
+
+    /**
+     * @brief return the absolute max value in the matrix
+     */
+    __host__ T abs_max(cudaStream_t stream = NULL)
+    {
+        if constexpr (!std::is_same_v<T, float> && !std::is_same_v<T, double>) {
+            RXMESH_ERROR(
+                "DenseMatrix::max() only float and double are supported for "
+                "this function!");
+            return T(0);
+        } else {
+            return to_eigen().cwiseAbs().maxCoeff();
+        }
+    }
+
+    /**
+     * @brief return the absolute min value in the matrix
+     */
+    __host__ T abs_min(cudaStream_t stream = NULL)
+    {
+        if constexpr (!std::is_same_v<T, float> && !std::is_same_v<T, double>) {
+            RXMESH_ERROR(
+                "DenseMatrix::min() only float and double are supported for "
+                "this function!");
+            return T(0);
+        } else {
+            return to_eigen().cwiseAbs().minCoeff();
+        }
+    }
+
+    /**
+     * @brief multiply all entries in the dense matrix by a scalar. Only float
+     * and double are supported in a CPU-only build
+     */
+    template <typename U>
+    __host__ void multiply(U scalar, cudaStream_t stream = NULL)
+    {
+        if constexpr (!std::is_same_v<T, float> && !std::is_same_v<T, double>) {
+            RXMESH_ERROR(
+                "DenseMatrix::multiply() only float and double are supported "
+                "in a CPU-only build!");
+        } else {
+            to_eigen() *= static_cast<T>(scalar);
+        }
+    }
+
+    /**
+     * @brief swap the content of this dense matrix with another dense matrix
+     */
+    __host__ void swap(DenseMatrix<T, Order>& X, cudaStream_t stream = NULL)
+    {
+        if (rows() != X.rows() || cols() != X.cols()) {
+            RXMESH_ERROR(
+                "DenseMatrix::swap() The input matrices size does not match. "
+                "This matrix size is {},{} while X size is {},{}",
+                rows(),
+                cols(),
+                X.rows(),
+                X.cols());
+            return;
+        }
+        std::swap_ranges(m_h_val, m_h_val + rows() * cols(), X.m_h_val);
+    }
+#endif
 
     /**
      * @brief return the row index corresponding to specific vertex/edge/face
@@ -1065,7 +1230,16 @@ struct DenseMatrix
     __host__ void release(locationT location = LOCATION_ALL)
     {
         if (!m_user_managed) {
-
+#ifdef RX_CPU_ONLY
+            // host and device share one buffer which is freed once neither of
+            // them is allocated
+            m_allocated = m_allocated & (~location);
+            if (m_allocated == LOCATION_NONE) {
+                free(m_h_val);
+                m_h_val = nullptr;
+                m_d_val = nullptr;
+            }
+#else
             if (((location & HOST) == HOST) && ((m_allocated & HOST) == HOST)) {
                 free(m_h_val);
                 m_h_val     = nullptr;
@@ -1077,6 +1251,7 @@ struct DenseMatrix
                 GPU_FREE(m_d_val);
                 m_allocated = m_allocated & (~DEVICE);
             }
+#endif
 
 #ifdef USE_CUDSS
             if (std::is_floating_point_v<T> || std::is_same_v<T, cuComplex> ||
@@ -1086,11 +1261,13 @@ struct DenseMatrix
 #endif
         }
 
+#ifndef RX_CPU_ONLY
         if ((location & LOCATION_ALL) == LOCATION_ALL) {
             if (m_dendescr) {
                 CUSPARSE_ERROR(cusparseDestroyDnMat(m_dendescr));
             }
         }
+#endif
     }
 
    private:
@@ -1099,6 +1276,15 @@ struct DenseMatrix
      */
     void allocate(locationT location)
     {
+#ifdef RX_CPU_ONLY
+        // host and device share one buffer
+        if (((location & HOST) == HOST || (location & DEVICE) == DEVICE) &&
+            m_h_val == nullptr) {
+            m_h_val = static_cast<T*>(malloc(bytes()));
+        }
+        m_d_val     = m_h_val;
+        m_allocated = m_allocated | location;
+#else
         if ((location & HOST) == HOST) {
             // release(HOST);
 
@@ -1114,6 +1300,7 @@ struct DenseMatrix
 
             m_allocated = m_allocated | DEVICE;
         }
+#endif
     }
 
 
@@ -1138,6 +1325,7 @@ struct DenseMatrix
      */
     __host__ void init_cublas()
     {
+#ifndef RX_CPU_ONLY
         if (std::is_floating_point_v<T> || std::is_same_v<T, int> ||
             std::is_same_v<T, cuComplex> ||
             std::is_same_v<T, cuDoubleComplex>) {
@@ -1153,6 +1341,7 @@ struct DenseMatrix
         CUBLAS_ERROR(cublasCreate(&m_cublas_handle));
         CUBLAS_ERROR(
             cublasSetPointerMode(m_cublas_handle, CUBLAS_POINTER_MODE_HOST));
+#endif
     }
 
 
@@ -221,6 +221,8 @@ struct GMGSolver : public IterativeSolver<T, DenseMatrix<T>>
 
         this->m_iter_taken = 0;
         while (this->m_iter_taken < this->m_max_iter) {
+            RXMESH_TRACE_SCOPE("GMG::iteration");
+
             m_v_cycle->cycle(0, m_gmg, *m_A, B, X, *m_rx);
             // current_res = m_v_cycle.m_r[0].norm2();
 
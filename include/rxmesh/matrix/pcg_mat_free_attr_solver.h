@@ -71,6 +71,8 @@ struct PCGMatFreeAttrSolver : public CGMatFreeAttrSolver<T, HandleT>
         this->m_iter_taken = 0;
 
         while (this->m_iter_taken < this->m_max_iter) {
+            RXMESH_TRACE_SCOPE("PCGMatFreeAttr::iteration");
+
             // s = Ap
             this->m_mat_vec(this->P, this->S, stream);
 
@@ -79,19 +81,22 @@ struct PCGMatFreeAttrSolver : public CGMatFreeAttrSolver<T, HandleT>
                 this->reduce_handle.dot(this->S, this->P, INVALID32, stream);
             this->alpha = this->delta_new / this->alpha;
 
-            // X =  alpha*P + X
-            this->axpy(X, this->P, this->alpha, T(1.), stream);
-
             // reset residual
             if (this->m_iter_taken > 0 &&
                 this->m_iter_taken % this->m_reset_residual_freq == 0) {
+                // X =  alpha*P + X
+                this->axpy(X, this->P, this->alpha, T(1.), stream);
                 // s= Ax
                 this->m_mat_vec(X, this->S, stream);
                 // r = b-s
                 this->subtract(this->R, B, this->S, stream);
             } else {
-                // r = - alpha*s + r
-                this->axpy(this->R, this->S, -this->alpha, T(1.), stream);
+                // X =  alpha*P + X and r = - alpha*s + r in one pass
+                evaluate(*this->m_rx,
+                         DEVICE,
+                         stream,
+                         assign(X, X + this->alpha * this->P),
+                         assign(this->R, this->R - this->alpha * this->S));
             }
 
             // S = inv(M) *R
@@ -140,16 +145,7 @@ struct PCGMatFreeAttrSolver : public CGMatFreeAttrSolver<T, HandleT>
                 AttributeT&       R,
                 cudaStream_t      stream = NULL)
     {
-        int num_attr = R.get_num_attributes();
-
-        this->m_rx->template for_each<HandleT>(
-            DEVICE,
-            [B, S, R, num_attr] __device__(const HandleT vh) mutable {
-                for (int i = 0; i < num_attr; ++i) {
-                    R(vh, i) = B(vh, i) - S(vh, i);
-                }
-            },
-            stream);
+        evaluate(*this->m_rx, DEVICE, stream, assign(R, B - S));
     };
 
    protected:
@@ -77,6 +77,8 @@ struct PCGSolver : public CGSolver<T, DenseMatOrder>
         this->m_iter_taken = 0;
 
         while (this->m_iter_taken < this->m_max_iter) {
+            RXMESH_TRACE_SCOPE("PCG::iteration");
+
             // s = Ap
             this->A->multiply(this->P, this->S, false, false, 1, 0, stream);
 
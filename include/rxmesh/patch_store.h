@@ -0,0 +1,1131 @@
+#pragma once
+#include <assert.h>
+#include <stdint.h>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include "rxmesh/handle.h"
+#include "rxmesh/kernels/rxmesh_queries_host.h"
+#include "rxmesh/patch_info.h"
+#include "rxmesh/util/bitmask_util.h"
+#include "rxmesh/util/log.h"
+#include "rxmesh/util/lru_cache.h"
+#include "rxmesh/util/macros.h"
+
+namespace rxmesh {
+
+/**
+ * @brief the host data of a single patch as stored in a PatchStore i.e., the
+ * patch topology (in local indices), the local-to-global maps, the neighbor
+ * patches, and the owner of every mesh element in the patch. Local indices
+ * are the same as in the RXMesh the store was written from and so handles
+ * (patch id, local id) are interchangeable between the two
+ */
+struct PatchRecord
+{
+    uint32_t patch_id = INVALID32;
+
+    uint16_t num_vertices = 0, num_edges = 0, num_faces = 0;
+
+    // neighbor patches i.e., the patch stash without the unused slots
+    std::vector<uint32_t> stash;
+
+    // local-to-global maps where the global index is the input index
+    std::vector<uint32_t> ltog_v, ltog_e, ltog_f;
+
+    // edge incident vertices (two per edge) and face incident edges (three
+    // per face) where every face edge is stored as (local edge << 1 | dir)
+    std::vector<uint16_t> ev, fe;
+
+    // owner patch and the local index in the owner patch for every mesh
+    // element. INVALID32 marks a deleted element
+    std::vector<uint32_t> owner_v, owner_e, owner_f;
+    std::vector<uint16_t> owner_local_v, owner_local_e, owner_local_f;
+
+    template <typename HandleT>
+    uint16_t get_num_elements() const
+    {
+        if constexpr (std::is_same_v<HandleT, VertexHandle>) {
+            return num_vertices;
+        }
+        if constexpr (std::is_same_v<HandleT, EdgeHandle>) {
+            return num_edges;
+        }
+        if constexpr (std::is_same_v<HandleT, FaceHandle>) {
+            return num_faces;
+        }
+    }
+
+    /**
+     * @brief true if the local element l is owned by this patch
+     */
+    template <typename HandleT>
+    bool is_owned(const uint16_t l) const
+    {
+        return owner<HandleT>()[l] == patch_id;
+    }
+
+    /**
+     * @brief true if the local element l is deleted
+     */
+    template <typename HandleT>
+    bool is_deleted(const uint16_t l) const
+    {
+        return owner<HandleT>()[l] == INVALID32;
+    }
+
+    /**
+     * @brief the handle of the local element l in its owner patch
+     */
+    template <typename HandleT>
+    HandleT get_owner_handle(const uint16_t l) const
+    {
+        using LocalT = typename HandleT::LocalT;
+        if (is_deleted<HandleT>(l)) {
+            return HandleT();
+        }
+        return HandleT(owner<HandleT>()[l], LocalT(owner_local<HandleT>()[l]));
+    }
+
+    /**
+     * @brief the global (input) index of the local element l
+     */
+    template <typename HandleT>
+    uint32_t get_global_id(const uint16_t l) const
+    {
+        if constexpr (std::is_same_v<HandleT, VertexHandle>) {
+            return ltog_v[l];
+        }
+        if constexpr (std::is_same_v<HandleT, EdgeHandle>) {
+            return ltog_e[l];
+        }
+        if constexpr (std::is_same_v<HandleT, FaceHandle>) {
+            return ltog_f[l];
+        }
+    }
+
+    /**
+     * @brief the three local vertices of the local face f
+     */
+    void get_fv(const uint16_t f, uint16_t (&v)[3]) const
+    {
+        for (int i = 0; i < 3; ++i) {
+            const uint16_t e   = fe[3 * f + i] >> 1;
+            const uint16_t dir = fe[3 * f + i] & 1;
+            v[i]               = ev[2 * e + dir];
+        }
+    }
+
+    /**
+     * @brief the two local vertices of the local edge e
+     */
+    void get_ev(const uint16_t e, uint16_t (&v)[2]) const
+    {
+        v[0] = ev[2 * e];
+        v[1] = ev[2 * e + 1];
+    }
+
+    /**
+     * @brief compute the query operation op on this patch. The output is in
+     * local indices of this patch and has the same layout as the host query
+     * of RXMeshStatic i.e., for ops with fixed number of output per element
+     * (EV, FV, FE, EE, and EVDiamond), offset is empty and the output of
+     * element l starts at value[l * stride]. Otherwise, the output of element
+     * l is value[offset[l]] to value[offset[l + 1]]. For FE, the value also
+     * holds the edge direction in its first bit
+     */
+    template <Op op>
+    void query(std::vector<uint16_t>& offset,
+               std::vector<uint16_t>& value,
+               const bool             oriented = false) const
+    {
+        // a PatchInfo view over this record so that the host queries could be
+        // used as they are. The active masks are built from the owners since
+        // the record marks deleted elements with INVALID32 owner
+        std::vector<uint32_t> active_v, active_e, active_f;
+        make_active_mask<VertexHandle>(active_v);
+        make_active_mask<EdgeHandle>(active_e);
+        make_active_mask<FaceHandle>(active_f);
+
+        uint16_t nv = num_vertices, ne = num_edges, nf = num_faces;
+
+        PatchInfo patch_info;
+        patch_info.patch_id = patch_id;
+        patch_info.ev       = reinterpret_cast<LocalVertexT*>(
+            const_cast<uint16_t*>(ev.data()));
+        patch_info.fe =
+            reinterpret_cast<LocalEdgeT*>(const_cast<uint16_t*>(fe.data()));
+        patch_info.active_mask_v = active_v.data();
+        patch_info.active_mask_e = active_e.data();
+        patch_info.active_mask_f = active_f.data();
+        patch_info.num_vertices  = &nv;
+        patch_info.num_edges     = &ne;
+        patch_info.num_faces     = &nf;
+
+        offset.clear();
+        detail::query_host<op>(patch_info, offset, value, oriented);
+    }
+
+    /**
+     * @brief the memory used by this record (counted against the cache
+     * budget)
+     */
+    size_t num_bytes() const
+    {
+        return sizeof(PatchRecord) +
+               sizeof(uint32_t) * (stash.size() + ltog_v.size() +
+                                   ltog_e.size() + ltog_f.size() +
+                                   owner_v.size() + owner_e.size() +
+                                   owner_f.size()) +
+               sizeof(uint16_t) * (ev.size() + fe.size() +
+                                   owner_local_v.size() +
+                                   owner_local_e.size() + owner_local_f.size());
+    }
+
+    /**
+     * @brief resize all arrays to match the number of elements
+     */
+    void resize(const uint16_t nv, const uint16_t ne, const uint16_t nf)
+    {
+        num_vertices = nv;
+        num_edges    = ne;
+        num_faces    = nf;
+        ltog_v.resize(nv);
+        ltog_e.resize(ne);
+        ltog_f.resize(nf);
+        ev.resize(2 * size_t(ne));
+        fe.resize(3 * size_t(nf));
+        owner_v.resize(nv);
+        owner_e.resize(ne);
+        owner_f.resize(nf);
+        owner_local_v.resize(nv);
+        owner_local_e.resize(ne);
+        owner_local_f.resize(nf);
+    }
+
+    /**
+     * @brief append the record to buf
+     */
+    void serialize(std::vector<char>& buf) const
+    {
+        const uint32_t num_stash = static_cast<uint32_t>(stash.size());
+        put(buf, &patch_id, 1);
+        put(buf, &num_vertices, 1);
+        put(buf, &num_edges, 1);
+        put(buf, &num_faces, 1);
+        put(buf, &num_stash, 1);
+        put(buf, stash);
+        put(buf, ltog_v);
+        put(buf, ltog_e);
+        put(buf, ltog_f);
+        put(buf, owner_v);
+        put(buf, owner_e);
+        put(buf, owner_f);
+        put(buf, ev);
+        put(buf, fe);
+        put(buf, owner_local_v);
+        put(buf, owner_local_e);
+        put(buf, owner_local_f);
+    }
+
+    /**
+     * @brief read a record written by serialize(). Return false if buf is
+     * too small
+     */
+    bool deserialize(const char* buf, const size_t num_bytes)
+    {
+        size_t   pos       = 0;
+        uint16_t nv        = 0;
+        uint16_t ne        = 0;
+        uint16_t nf        = 0;
+        uint32_t num_stash = 0;
+        if (!get(buf, num_bytes, pos, &patch_id, 1) ||
+            !get(buf, num_bytes, pos, &nv, 1) ||
+            !get(buf, num_bytes, pos, &ne, 1) ||
+            !get(buf, num_bytes, pos, &nf, 1) ||
+            !get(buf, num_bytes, pos, &num_stash, 1)) {
+            return false;
+        }
+        resize(nv, ne, nf);
+        stash.resize(num_stash);
+        return get(buf, num_bytes, pos, stash) &&
+               get(buf, num_bytes, pos, ltog_v) &&
+               get(buf, num_bytes, pos, ltog_e) &&
+               get(buf, num_bytes, pos, ltog_f) &&
+               get(buf, num_bytes, pos, owner_v) &&
+               get(buf, num_bytes, pos, owner_e) &&
+               get(buf, num_bytes, pos, owner_f) &&
+               get(buf, num_bytes, pos, ev) && get(buf, num_bytes, pos, fe) &&
+               get(buf, num_bytes, pos, owner_local_v) &&
+               get(buf, num_bytes, pos, owner_local_e) &&
+               get(buf, num_bytes, pos, owner_local_f) && pos == num_bytes;
+    }
+
+   private:
+    template <typename HandleT>
+    void make_active_mask(std::vector<uint32_t>& mask) const
+    {
+        const uint16_t n = get_num_elements<HandleT>();
+        mask.assign(detail::mask_num_bytes(n) / sizeof(uint32_t) + 1, 0);
+        for (uint16_t l = 0; l < n; ++l) {
+            if (!is_deleted<HandleT>(l)) {
+                mask[l / 32] |= (1u << (l % 32));
+            }
+        }
+    }
+
+    template <typename HandleT>
+    const std::vector<uint32_t>& owner() const
+    {
+        if constexpr (std::is_same_v<HandleT, VertexHandle>) {
+            return owner_v;
+        }
+        if constexpr (std::is_same_v<HandleT, EdgeHandle>) {
+            return owner_e;
+        }
+        if constexpr (std::is_same_v<HandleT, FaceHandle>) {
+            return owner_f;
+        }
+    }
+
+    template <typename HandleT>
+    const std::vector<uint16_t>& owner_local() const
+    {
+        if constexpr (std::is_same_v<HandleT, VertexHandle>) {
+            return owner_local_v;
+        }
+        if constexpr (std::is_same_v<HandleT, EdgeHandle>) {
+            return owner_local_e;
+        }
+        if constexpr (std::is_same_v<HandleT, FaceHandle>) {
+            return owner_local_f;
+        }
+    }
+
+    template <typename T>
+    static void put(std::vector<char>& buf, const T* data, const size_t count)
+    {
+        const size_t pos = buf.size();
+        buf.resize(pos + count * sizeof(T));
+        if (count > 0) {
+            memcpy(buf.data() + pos, data, count * sizeof(T));
+        }
+    }
+
+    template <typename T>
+    static void put(std::vector<char>& buf, const std::vector<T>& vec)
+    {
+        put(buf, vec.data(), vec.size());
+    }
+
+    template <typename T>
+    static bool get(const char*  buf,
+                    const size_t num_bytes,
+                    size_t&      pos,
+                    T*           data,
+                    const size_t count)
+    {
+        if (pos + count * sizeof(T) > num_bytes) {
+            return false;
+        }
+        if (count > 0) {
+            memcpy(data, buf + pos, count * sizeof(T));
+        }
+        pos += count * sizeof(T);
+        return true;
+    }
+
+    template <typename T>
+    static bool get(const char*     buf,
+                    const size_t    num_bytes,
+                    size_t&         pos,
+                    std::vector<T>& vec)
+    {
+        return get(buf, num_bytes, pos, vec.data(), vec.size());
+    }
+};
+
+/**
+ * @brief iterator over the output of a query on a PatchRecord (see
+ * PatchStore::run_query). Similar to Iterator, operator[] returns the handle
+ * of the output element in its owner patch so that it could be used directly
+ * with PatchStore::get_attribute() or PatchStore::get_patch(). The local index
+ * of the output element in the queried patch is returned by local()
+ */
+template <typename HandleT>
+struct PatchRecordIterator
+{
+    using LocalT = typename HandleT::LocalT;
+
+    PatchRecordIterator(const PatchRecord& record,
+                        const uint16_t*    value,
+                        const uint16_t     size,
+                        const int          shift)
+        : m_record(record), m_value(value), m_size(size), m_shift(shift)
+    {
+    }
+
+    uint16_t size() const
+    {
+        return m_size;
+    }
+
+    /**
+     * @brief the local index (in the queried patch) of the i-th output.
+     * INVALID16 for missing output (e.g., boundary edges in EE)
+     */
+    uint16_t local(const uint16_t i) const
+    {
+        assert(i < m_size);
+        const uint16_t l = m_value[i];
+        return (l == INVALID16) ? INVALID16 : uint16_t(l >> m_shift);
+    }
+
+    HandleT operator[](const uint16_t i) const
+    {
+        const uint16_t l = local(i);
+        if (l == INVALID16) {
+            return HandleT();
+        }
+        return m_record.template get_owner_handle<HandleT>(l);
+    }
+
+   private:
+    const PatchRecord& m_record;
+    const uint16_t*    m_value;
+    uint16_t           m_size;
+    int                m_shift;
+};
+
+namespace detail {
+/**
+ * @brief a patch store is a file that starts with PatchStoreHeader followed
+ * by the serialized PatchRecords (in any order) and ends with the index i.e.,
+ * one PatchStoreIndex per patch. Attributes are stored in separate files
+ * (next to the store file) where every patch has a fixed-size slot.
+ * patch_store_version should be bumped whenever the format changes
+ */
+static constexpr char     patch_store_magic[8]      = "RXMPSTO";
+static constexpr char     patch_store_attr_magic[8] = "RXMPATR";
+static constexpr uint32_t patch_store_version       = 1;
+static constexpr uint32_t patch_store_endian        = 0x01020304;
+
+struct PatchStoreHeader
+{
+    char     magic[8];
+    uint32_t version;
+    uint32_t endian;
+    uint32_t num_patches;
+    uint32_t num_vertices;
+    uint32_t num_edges;
+    uint32_t num_faces;
+    uint64_t index_offset;
+};
+
+struct PatchStoreIndex
+{
+    uint64_t offset;
+    uint64_t num_bytes;
+    uint16_t num_vertices;
+    uint16_t num_edges;
+    uint16_t num_faces;
+    uint16_t reserved;
+};
+
+struct PatchStoreAttributeHeader
+{
+    char     magic[8];
+    uint32_t version;
+    uint32_t element_size;
+    uint32_t num_attributes;
+    uint32_t element_type;
+};
+
+template <typename HandleT>
+constexpr uint32_t patch_store_element_type()
+{
+    if constexpr (std::is_same_v<HandleT, VertexHandle>) {
+        return 0;
+    }
+    if constexpr (std::is_same_v<HandleT, EdgeHandle>) {
+        return 1;
+    }
+    if constexpr (std::is_same_v<HandleT, FaceHandle>) {
+        return 2;
+    }
+}
+}  // namespace detail
+
+/**
+ * @brief write a patch store one patch at a time so that the whole mesh does
+ * not need to be in memory. add_patch() could be called from multiple threads
+ * and in any patch order. The store is only valid after finalize()
+ */
+class PatchStoreWriter
+{
+   public:
+    PatchStoreWriter(const std::string& file_name, const uint32_t num_patches)
+        : m_file(file_name, std::ios::binary),
+          m_index(num_patches),
+          m_pos(0),
+          m_finalized(false)
+    {
+        if (!m_file.is_open()) {
+            RXMESH_ERROR("PatchStoreWriter can not open {}", file_name);
+            return;
+        }
+        std::memset(m_index.data(), 0, m_index.size() * sizeof(m_index[0]));
+        std::memset(&m_header, 0, sizeof(m_header));
+        memcpy(m_header.magic, detail::patch_store_magic, 8);
+        m_header.version     = detail::patch_store_version;
+        m_header.endian      = detail::patch_store_endian;
+        m_header.num_patches = num_patches;
+        write_bytes(&m_header, sizeof(m_header));
+    }
+
+    PatchStoreWriter(const PatchStoreWriter&)            = delete;
+    PatchStoreWriter& operator=(const PatchStoreWriter&) = delete;
+
+    bool is_ok() const
+    {
+        return m_file.good();
+    }
+
+    /**
+     * @brief serialize and append one patch
+     */
+    void add_patch(const PatchRecord& record)
+    {
+        if (record.patch_id >= m_index.size()) {
+            RXMESH_ERROR(
+                "PatchStoreWriter::add_patch() patch id {} is out of range "
+                "({})",
+                record.patch_id,
+                m_index.size());
+            return;
+        }
+        std::vector<char> buf;
+        record.serialize(buf);
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        detail::PatchStoreIndex& id = m_index[record.patch_id];
+        id.offset                   = m_pos;
+        id.num_bytes                = buf.size();
+        id.num_vertices             = record.num_vertices;
+        id.num_edges                = record.num_edges;
+        id.num_faces                = record.num_faces;
+        write_bytes(buf.data(), buf.size());
+    }
+
+    /**
+     * @brief write the index and the header. Should be called after all
+     * patches are added
+     */
+    void finalize(const uint32_t num_vertices,
+                  const uint32_t num_edges,
+                  const uint32_t num_faces)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_finalized) {
+            return;
+        }
+        m_header.num_vertices = num_vertices;
+        m_header.num_edges    = num_edges;
+        m_header.num_faces    = num_faces;
+        m_header.index_offset = m_pos;
+        write_bytes(m_index.data(), m_index.size() * sizeof(m_index[0]));
+        m_file.seekp(0);
+        m_file.write(reinterpret_cast<const char*>(&m_header),
+                     sizeof(m_header));
+        m_file.flush();
+        m_finalized = true;
+    }
+
+   private:
+    void write_bytes(const void* data, const size_t num_bytes)
+    {
+        if (num_bytes > 0) {
+            m_file.write(reinterpret_cast<const char*>(data), num_bytes);
+            m_pos += num_bytes;
+        }
+    }
+
+    std::mutex                           m_mutex;
+    std::ofstream                        m_file;
+    detail::PatchStoreHeader             m_header;
+    std::vector<detail::PatchStoreIndex> m_index;
+    uint64_t                             m_pos;
+    bool                                 m_finalized;
+};
+
+/**
+ * @brief out-of-core access to a mesh written by RXMesh::save_patch_store()
+ * (or by PatchStoreWriter). Only the per-patch index lives in memory. Patches
+ * and per-patch attribute slices are read from disk on demand and kept in LRU
+ * caches with a budget in bytes so that meshes that do not fit in host memory
+ * could be processed patch by patch. Patch data returned by the store stays
+ * valid (even after it is evicted from the cache) as long as the returned
+ * shared_ptr is alive. Reading is thread-safe. Writing an attribute slice
+ * while another thread reads the same slice is not
+ */
+class PatchStore
+{
+   public:
+    /**
+     * @param file_name the store file
+     * @param cache_mega_bytes the budget of the patch cache and (separately)
+     * of the attribute cache
+     */
+    explicit PatchStore(const std::string& file_name,
+                        const double       cache_mega_bytes = 1024)
+        : m_file_name(file_name),
+          m_file(file_name, std::ios::binary),
+          m_ok(false),
+          m_patch_cache(size_t(cache_mega_bytes * 1024.0 * 1024.0)),
+          m_attr_cache(size_t(cache_mega_bytes * 1024.0 * 1024.0))
+    {
+        std::memset(&m_header, 0, sizeof(m_header));
+        if (!m_file.is_open()) {
+            RXMESH_ERROR("PatchStore can not open {}", file_name);
+            return;
+        }
+        m_file.read(reinterpret_cast<char*>(&m_header), sizeof(m_header));
+        if (!m_file.good() ||
+            memcmp(m_header.magic, detail::patch_store_magic, 8) != 0) {
+            RXMESH_ERROR("PatchStore {} is not a patch store file", file_name);
+            return;
+        }
+        if (m_header.endian != detail::patch_store_endian ||
+            m_header.version != detail::patch_store_version) {
+            RXMESH_ERROR(
+                "PatchStore {} was written with a different version or "
+                "endianness. Please re-create the store",
+                file_name);
+            return;
+        }
+        m_index.resize(m_header.num_patches);
+        m_file.seekg(m_header.index_offset);
+        m_file.read(reinterpret_cast<char*>(m_index.data()),
+                    m_index.size() * sizeof(m_index[0]));
+        if (!m_file.good()) {
+            RXMESH_ERROR("PatchStore {} has a truncated index", file_name);
+            return;
+        }
+        m_ok = true;
+    }
+
+    PatchStore(const PatchStore&)            = delete;
+    PatchStore& operator=(const PatchStore&) = delete;
+
+    bool is_ok() const
+    {
+        return m_ok;
+    }
+
+    uint32_t get_num_patches() const
+    {
+        return m_header.num_patches;
+    }
+
+    uint32_t get_num_vertices() const
+    {
+        return m_header.num_vertices;
+    }
+
+    uint32_t get_num_edges() const
+    {
+        return m_header.num_edges;
+    }
+
+    uint32_t get_num_faces() const
+    {
+        return m_header.num_faces;
+    }
+
+    /**
+     * @brief number of vertices/edges/faces (depending on HandleT) in a patch
+     * without loading the patch
+     */
+    template <typename HandleT>
+    uint16_t get_num_elements(const uint32_t p) const
+    {
+        if constexpr (std::is_same_v<HandleT, VertexHandle>) {
+            return m_index[p].num_vertices;
+        }
+        if constexpr (std::is_same_v<HandleT, EdgeHandle>) {
+            return m_index[p].num_edges;
+        }
+        if constexpr (std::is_same_v<HandleT, FaceHandle>) {
+            return m_index[p].num_faces;
+        }
+    }
+
+    /**
+     * @brief return patch p from the cache or load it from disk
+     */
+    std::shared_ptr<const PatchRecord> get_patch(const uint32_t p)
+    {
+        if (p >= get_num_patches()) {
+            RXMESH_ERROR("PatchStore::get_patch() patch {} is out of range",
+                         p);
+            return nullptr;
+        }
+
+        std::shared_ptr<PatchRecord> record = m_patch_cache.get(p);
+        if (record != nullptr) {
+            return record;
+        }
+
+        std::vector<char> buf(m_index[p].num_bytes);
+        {
+            std::lock_guard<std::mutex> lock(m_file_mutex);
+            m_file.seekg(m_index[p].offset);
+            m_file.read(buf.data(), buf.size());
+            if (!m_file.good()) {
+                m_file.clear();
+                RXMESH_ERROR("PatchStore::get_patch() can not read patch {}",
+                             p);
+                return nullptr;
+            }
+        }
+
+        record = std::make_shared<PatchRecord>();
+        if (!record->deserialize(buf.data(), buf.size()) ||
+            record->patch_id != p) {
+            RXMESH_ERROR("PatchStore::get_patch() patch {} is corrupted", p);
+            return nullptr;
+        }
+        m_patch_cache.put(p, record, record->num_bytes());
+        return record;
+    }
+
+    /**
+     * @brief load all the neighbor patches of p (its patch stash) into the
+     * cache
+     */
+    void prefetch_neighbors(const uint32_t p)
+    {
+        std::shared_ptr<const PatchRecord> record = get_patch(p);
+        if (record == nullptr) {
+            return;
+        }
+        for (const uint32_t q : record->stash) {
+            get_patch(q);
+        }
+    }
+
+    /**
+     * @brief call func(const PatchRecord&) on every patch. Patches are
+     * visited in order and loaded one at a time
+     * @param prefetch if true, the neighbor patches of every patch are loaded
+     * before calling func on it
+     */
+    template <typename FuncT>
+    void for_each_patch(FuncT func, const bool prefetch = false)
+    {
+        for (uint32_t p = 0; p < get_num_patches(); ++p) {
+            std::shared_ptr<const PatchRecord> record = get_patch(p);
+            if (record == nullptr) {
+                continue;
+            }
+            if (prefetch) {
+                prefetch_neighbors(p);
+            }
+            func(*record);
+        }
+    }
+
+    /**
+     * @brief call func(const PatchRecord&, const VertexHandle) on every owned
+     * vertex. Similarly for_each_edge and for_each_face
+     */
+    template <typename FuncT>
+    void for_each_vertex(FuncT func)
+    {
+        for_each<VertexHandle>(func);
+    }
+
+    template <typename FuncT>
+    void for_each_edge(FuncT func)
+    {
+        for_each<EdgeHandle>(func);
+    }
+
+    template <typename FuncT>
+    void for_each_face(FuncT func)
+    {
+        for_each<FaceHandle>(func);
+    }
+
+    /**
+     * @brief run the query operation op on the host over every patch and call
+     * func(const PatchRecord&, InputHandleT, const PatchRecordIterator<
+     * OutputHandleT>&) on every owned (and not deleted) source element, where
+     * InputHandleT/OutputHandleT are the input/output handle types of op (e.g.,
+     * VertexHandle for VV). Patches are loaded one at a time through the patch
+     * cache and the query uses the same host query as
+     * RXMeshStatic::run_query_kernel(HOST). The iterator returns the owner
+     * handle of every output element so that not-owned output could be
+     * followed into its owner patch via get_patch() or get_attribute() which
+     * load it on demand through the caches
+     * @param oriented if the output of VV/VE should be oriented
+     * @param prefetch if true, the neighbor patches of every patch are loaded
+     * before querying it
+     */
+    template <Op op, typename FuncT>
+    void run_query(FuncT      func,
+                   const bool oriented = false,
+                   const bool prefetch = false)
+    {
+        using InputHandleT  = typename InputHandle<op>::type;
+        using OutputHandleT = typename OutputHandle<op>::type;
+
+        constexpr uint16_t fixed_offset =
+            ((op == Op::EV) ? 2 :
+                              ((op == Op::FV || op == Op::FE) ?
+                                   3 :
+                                   ((op == Op::EVDiamond || op == Op::EE) ?
+                                        4 :
+                                        0)));
+
+        std::vector<uint16_t> offset, value;
+
+        for_each_patch(
+            [&](const PatchRecord& record) {
+                record.template query<op>(offset, value, oriented);
+
+                const uint16_t n =
+                    record.template get_num_elements<InputHandleT>();
+                for (uint16_t l = 0; l < n; ++l) {
+                    if (!record.template is_owned<InputHandleT>(l)) {
+                        continue;
+                    }
+                    const uint16_t begin =
+                        (fixed_offset == 0) ? offset[l] : l * fixed_offset;
+                    const uint16_t end = (fixed_offset == 0) ?
+                                             offset[l + 1] :
+                                             begin + fixed_offset;
+
+                    PatchRecordIterator<OutputHandleT> iter(
+                        record,
+                        value.data() + begin,
+                        end - begin,
+                        int(op == Op::FE));
+
+                    func(record,
+                         InputHandleT(record.patch_id,
+                                      typename InputHandleT::LocalT(l)),
+                         iter);
+                }
+            },
+            prefetch);
+    }
+
+    /**
+     * @brief create an attribute file for the store where every mesh element
+     * (of type HandleT) has num_attributes values of type T. All values are
+     * zero. If the attribute exists, it is overwritten
+     */
+    template <typename T, typename HandleT>
+    bool add_attribute(const std::string& name, const uint32_t num_attributes)
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+
+        detail::PatchStoreAttributeHeader header;
+        std::memset(&header, 0, sizeof(header));
+        memcpy(header.magic, detail::patch_store_attr_magic, 8);
+        header.version        = detail::patch_store_version;
+        header.element_size   = sizeof(T);
+        header.num_attributes = num_attributes;
+        header.element_type   = detail::patch_store_element_type<HandleT>();
+
+        std::lock_guard<std::mutex> lock(m_file_mutex);
+
+        const std::string file_name = attribute_file_name(name);
+        {
+            std::ofstream file(file_name, std::ios::binary);
+            if (!file.is_open()) {
+                RXMESH_ERROR(
+                    "PatchStore::add_attribute() can not create {}",
+                    file_name);
+                return false;
+            }
+            file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        }
+        return open_attribute(name, header);
+    }
+
+    /**
+     * @brief open an attribute created earlier (e.g., by another process)
+     */
+    bool load_attribute(const std::string& name)
+    {
+        std::lock_guard<std::mutex> lock(m_file_mutex);
+
+        const std::string file_name = attribute_file_name(name);
+        std::ifstream     file(file_name, std::ios::binary);
+        detail::PatchStoreAttributeHeader header;
+        file.read(reinterpret_cast<char*>(&header), sizeof(header));
+        if (!file.good() ||
+            memcmp(header.magic, detail::patch_store_attr_magic, 8) != 0 ||
+            header.version != detail::patch_store_version) {
+            RXMESH_ERROR(
+                "PatchStore::load_attribute() {} is not a valid attribute "
+                "file",
+                file_name);
+            return false;
+        }
+        return open_attribute(name, header);
+    }
+
+    bool has_attribute(const std::string& name) const
+    {
+        std::lock_guard<std::mutex> lock(m_file_mutex);
+        return m_attributes.find(name) != m_attributes.end();
+    }
+
+    /**
+     * @brief return the values of attribute name in patch p where attribute
+     * j of local element l is at [l * num_attributes + j]. The slice is read
+     * from the cache or loaded from disk
+     */
+    template <typename T>
+    std::shared_ptr<const T> read_attribute(const std::string& name,
+                                            const uint32_t     p)
+    {
+        AttributeFile* attr = find_attribute<T>(name, "read_attribute");
+        if (attr == nullptr || p >= get_num_patches()) {
+            return nullptr;
+        }
+
+        const uint64_t key = (uint64_t(attr->id) << 32) | p;
+
+        std::shared_ptr<std::vector<char>> page = m_attr_cache.get(key);
+        if (page == nullptr) {
+            page = std::make_shared<std::vector<char>>(
+                attr->offset[p + 1] - attr->offset[p]);
+            {
+                std::lock_guard<std::mutex> lock(m_file_mutex);
+                attr->file.seekg(attr->offset[p]);
+                attr->file.read(page->data(), page->size());
+                if (!attr->file.good()) {
+                    attr->file.clear();
+                    RXMESH_ERROR(
+                        "PatchStore::read_attribute() can not read {} of "
+                        "patch {}",
+                        name,
+                        p);
+                    return nullptr;
+                }
+            }
+            m_attr_cache.put(key, page, page->size());
+        }
+        return std::shared_ptr<const T>(
+            page, reinterpret_cast<const T*>(page->data()));
+    }
+
+    /**
+     * @brief write the values of attribute name in patch p (with the same
+     * layout as read_attribute()) to disk and to the cache
+     */
+    template <typename T>
+    bool write_attribute(const std::string& name,
+                         const uint32_t     p,
+                         const T*           values)
+    {
+        AttributeFile* attr = find_attribute<T>(name, "write_attribute");
+        if (attr == nullptr || p >= get_num_patches()) {
+            return false;
+        }
+
+        auto page = std::make_shared<std::vector<char>>(
+            attr->offset[p + 1] - attr->offset[p]);
+        if (!page->empty()) {
+            memcpy(page->data(), values, page->size());
+        }
+        {
+            std::lock_guard<std::mutex> lock(m_file_mutex);
+            attr->file.seekp(attr->offset[p]);
+            attr->file.write(page->data(), page->size());
+            attr->file.flush();
+            if (!attr->file.good()) {
+                attr->file.clear();
+                RXMESH_ERROR(
+                    "PatchStore::write_attribute() can not write {} of patch "
+                    "{}",
+                    name,
+                    p);
+                return false;
+            }
+        }
+        m_attr_cache.put((uint64_t(attr->id) << 32) | p, page, page->size());
+        return true;
+    }
+
+    /**
+     * @brief read attribute j of the mesh element h. If h is not owned by its
+     * patch, the value is read from the owner patch which is loaded on demand
+     */
+    template <typename T, typename HandleT>
+    T get_attribute(const std::string& name, const HandleT h, const uint32_t j)
+    {
+        AttributeFile* attr = find_attribute<T>(name, "get_attribute");
+        if (attr == nullptr) {
+            return T();
+        }
+        std::shared_ptr<const PatchRecord> record = get_patch(h.patch_id());
+        if (record == nullptr) {
+            return T();
+        }
+        const HandleT owner =
+            record->template get_owner_handle<HandleT>(h.local_id());
+        if (!owner.is_valid()) {
+            return T();
+        }
+        std::shared_ptr<const T> values =
+            read_attribute<T>(name, owner.patch_id());
+        if (values == nullptr) {
+            return T();
+        }
+        return values.get()[size_t(owner.local_id()) * attr->num_attributes +
+                            j];
+    }
+
+    const LRUCache<uint32_t, PatchRecord>& get_patch_cache() const
+    {
+        return m_patch_cache;
+    }
+
+    const LRUCache<uint64_t, std::vector<char>>& get_attribute_cache() const
+    {
+        return m_attr_cache;
+    }
+
+   private:
+    struct AttributeFile
+    {
+        uint32_t              id;
+        uint32_t              element_size;
+        uint32_t              num_attributes;
+        uint32_t              element_type;
+        std::vector<uint64_t> offset;
+        std::fstream          file;
+    };
+
+    std::string attribute_file_name(const std::string& name) const
+    {
+        return m_file_name + "." + name + ".attr";
+    }
+
+    /**
+     * @brief compute the per-patch slots of an attribute, extend the file to
+     * its full size, and keep it open. m_file_mutex should be held
+     */
+    bool open_attribute(const std::string&                       name,
+                        const detail::PatchStoreAttributeHeader& header)
+    {
+        auto it = m_attributes.find(name);
+        if (it != m_attributes.end()) {
+            // the old slices of an overwritten attribute should not be
+            // returned from the cache
+            for (uint32_t p = 0; p < get_num_patches(); ++p) {
+                m_attr_cache.erase((uint64_t(it->second.id) << 32) | p);
+            }
+            m_attributes.erase(it);
+        }
+
+        AttributeFile& attr = m_attributes[name];
+        attr.id             = m_next_attribute_id++;
+        attr.element_size   = header.element_size;
+        attr.num_attributes = header.num_attributes;
+        attr.element_type   = header.element_type;
+        attr.offset.resize(get_num_patches() + 1);
+        attr.offset[0] = sizeof(header);
+        for (uint32_t p = 0; p < get_num_patches(); ++p) {
+            const uint64_t n = (header.element_type == 0) ?
+                                   m_index[p].num_vertices :
+                               (header.element_type == 1) ?
+                                   m_index[p].num_edges :
+                                   m_index[p].num_faces;
+            attr.offset[p + 1] =
+                attr.offset[p] +
+                n * header.num_attributes * header.element_size;
+        }
+
+        attr.file.open(attribute_file_name(name),
+                       std::ios::binary | std::ios::in | std::ios::out);
+        if (!attr.file.is_open()) {
+            RXMESH_ERROR("PatchStore can not open {}",
+                         attribute_file_name(name));
+            m_attributes.erase(name);
+            return false;
+        }
+
+        // make sure the file covers all slots (the new bytes are zeros)
+        attr.file.seekg(0, std::ios::end);
+        const uint64_t size = attr.file.tellg();
+        if (size < attr.offset.back()) {
+            attr.file.seekp(attr.offset.back() - 1);
+            attr.file.put(0);
+            attr.file.flush();
+        }
+        return attr.file.good();
+    }
+
+    template <typename T>
+    AttributeFile* find_attribute(const std::string& name, const char* caller)
+    {
+        std::lock_guard<std::mutex> lock(m_file_mutex);
+        auto                        it = m_attributes.find(name);
+        if (it == m_attributes.end()) {
+            RXMESH_ERROR("PatchStore::{}() attribute {} does not exist",
+                         caller,
+                         name);
+            return nullptr;
+        }
+        if (it->second.element_size != sizeof(T)) {
+            RXMESH_ERROR(
+                "PatchStore::{}() attribute {} has element size {} while the "
+                "requested type has size {}",
+                caller,
+                name,
+                it->second.element_size,
+                sizeof(T));
+            return nullptr;
+        }
+        return &it->second;
+    }
+
+    template <typename HandleT, typename FuncT>
+    void for_each(FuncT func)
+    {
+        using LocalT = typename HandleT::LocalT;
+        for_each_patch([&](const PatchRecord& record) {
+            const uint16_t n = record.template get_num_elements<HandleT>();
+            for (uint16_t l = 0; l < n; ++l) {
+                if (record.template is_owned<HandleT>(l)) {
+                    func(record, HandleT(record.patch_id, LocalT(l)));
+                }
+            }
+        });
+    }
+
+    std::string                                    m_file_name;
+    std::ifstream                                  m_file;
+    bool                                           m_ok;
+    detail::PatchStoreHeader                       m_header;
+    std::vector<detail::PatchStoreIndex>           m_index;
+    mutable std::mutex                             m_file_mutex;
+    std::unordered_map<std::string, AttributeFile> m_attributes;
+    uint32_t                                       m_next_attribute_id = 0;
+    LRUCache<uint32_t, PatchRecord>                m_patch_cache;
+    LRUCache<uint64_t, std::vector<char>>          m_attr_cache;
+};
+}  // namespace rxmesh
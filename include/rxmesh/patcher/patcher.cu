@@ -4,15 +4,18 @@
 #include <iomanip>
 #include <queue>
 #include <unordered_map>
+#ifndef RX_CPU_ONLY
 #include "cub/device/device_radix_sort.cuh"
 #include "cub/device/device_scan.cuh"
 #include "cuda_profiler_api.h"
+#include "rxmesh/patcher/patcher_kernel.cuh"
+#endif
 #include "rxmesh/kernels/util.cuh"
 #include "rxmesh/patcher/patcher.h"
-#include "rxmesh/patcher/patcher_kernel.cuh"
 #include "rxmesh/util/log.h"
 #include "rxmesh/util/macros.h"
 #include "rxmesh/util/timer.h"
+#include "rxmesh/util/trace.h"
 #include "rxmesh/util/util.h"
 
 #include "metis.h"
@@ -31,21 +34,27 @@ Patcher::Patcher(std::string filename)
     print_statistics();
 }
 
-Patcher::Patcher(uint32_t                                        patch_size,
-                 const std::vector<uint32_t>&                    ff_offset,
-                 const std::vector<uint32_t>&                    ff_values,
-                 const std::vector<std::vector<uint32_t>>&       fv,
-                 const std::unordered_map<std::pair<uint32_t, uint32_t>,
-                                          uint32_t,
-                                          detail::edge_key_hash> edges_map,
-                 const uint32_t                                  num_vertices,
-                 const uint32_t                                  num_edges,
-                 bool                                            use_metis)
+Patcher::Patcher(std::istream& is)
+{
+    cereal::PortableBinaryInputArchive archive(is);
+    archive(*this);
+}
+
+Patcher::Patcher(uint32_t                     patch_size,
+                 const std::vector<uint32_t>& ff_offset,
+                 const std::vector<uint32_t>& ff_values,
+                 const uint32_t*              fv,
+                 const uint32_t               num_faces,
+                 const detail::SortedEdgeMap& edges_map,
+                 const uint32_t               num_vertices,
+                 const uint32_t               num_edges,
+                 const PatchingMethod         patching_method,
+                 const float*                 vertices)
     : m_patch_size(patch_size),
       m_num_patches(0),
       m_num_vertices(num_vertices),
       m_num_edges(num_edges),
-      m_num_faces(fv.size()),
+      m_num_faces(num_faces),
       m_num_seeds(0),
       m_max_num_patches(0),
       m_num_components(0),
@@ -53,6 +62,7 @@ Patcher::Patcher(uint32_t                                        patch_size,
       m_patching_time_ms(0.0)
 
 {
+    RXMESH_TRACE_SCOPE("Patcher");
 
     m_num_patches =
         m_num_faces / m_patch_size + ((m_num_faces % m_patch_size) ? 1 : 0);
@@ -62,6 +72,25 @@ Patcher::Patcher(uint32_t                                        patch_size,
     m_num_seeds = m_num_patches;
     std::vector<uint32_t> seeds;
 
+    PatchingMethod method = patching_method;
+    if ((method == PatchingMethod::Morton ||
+         method == PatchingMethod::Hilbert) &&
+        vertices == nullptr) {
+        RXMESH_WARN(
+            "Patcher::Patcher() space-filling curve patching needs the vertex "
+            "coordinates. Using PatchingMethod::HostLloyd instead");
+        method = PatchingMethod::HostLloyd;
+    }
+
+#ifdef RX_CPU_ONLY
+    if (method == PatchingMethod::Lloyd) {
+        RXMESH_TRACE(
+            "Patcher::Patcher() using PatchingMethod::HostLloyd in a CPU-only "
+            "build");
+        method = PatchingMethod::HostLloyd;
+    }
+#endif
+
     uint32_t* d_face_patch            = nullptr;
     uint32_t* d_queue                 = nullptr;
     uint32_t* d_queue_ptr             = nullptr;
@@ -69,8 +98,10 @@ Patcher::Patcher(uint32_t                                        patch_size,
     uint32_t* d_ff_offset             = nullptr;
     void*     d_cub_temp_storage_scan = nullptr;
     void*     d_cub_temp_storage_max  = nullptr;
+#ifndef RX_CPU_ONLY
     size_t    cub_scan_bytes          = 0;
     size_t    cub_max_bytes           = 0;
+#endif
     uint32_t* d_seeds                 = nullptr;
     uint32_t* d_new_num_patches       = nullptr;
     uint32_t* d_max_patch_size        = nullptr;
@@ -90,33 +121,48 @@ Patcher::Patcher(uint32_t                                        patch_size,
             m_face_patch[i]  = 0;
             m_patches_val[i] = i;
         }
-        allocate_device_memory(seeds,
-                               ff_offset,
-                               ff_values,
-                               d_face_patch,
-                               d_queue,
-                               d_queue_ptr,
-                               d_ff_values,
-                               d_ff_offset,
-                               d_cub_temp_storage_scan,
-                               d_cub_temp_storage_max,
-                               cub_scan_bytes,
-                               cub_max_bytes,
-                               d_seeds,
-                               d_new_num_patches,
-                               d_max_patch_size,
-                               d_patches_offset,
-                               d_patches_size,
-                               d_patches_val);
+#ifndef RX_CPU_ONLY
+        if (method == PatchingMethod::Lloyd) {
+            allocate_device_memory(seeds,
+                                   ff_offset,
+                                   ff_values,
+                                   d_face_patch,
+                                   d_queue,
+                                   d_queue_ptr,
+                                   d_ff_values,
+                                   d_ff_offset,
+                                   d_cub_temp_storage_scan,
+                                   d_cub_temp_storage_max,
+                                   cub_scan_bytes,
+                                   cub_max_bytes,
+                                   d_seeds,
+                                   d_new_num_patches,
+                                   d_max_patch_size,
+                                   d_patches_offset,
+                                   d_patches_size,
+                                   d_patches_val);
+        }
+#endif
         assign_patch(fv, edges_map);
     } else {
 
         if (false) {
             grid(fv);
         } else {
-            if (use_metis) {
+            if (method == PatchingMethod::Metis) {
                 metis_kway(ff_offset, ff_values);
+            } else if (method == PatchingMethod::HostLloyd) {
+                initialize_random_seeds(seeds, ff_offset, ff_values);
+                run_lloyd_host(seeds, ff_offset, ff_values);
+            } else if (method == PatchingMethod::Morton ||
+                       method == PatchingMethod::Hilbert) {
+                space_filling_curve(fv,
+                                    vertices,
+                                    ff_offset,
+                                    ff_values,
+                                    method == PatchingMethod::Hilbert);
             } else {
+#ifndef RX_CPU_ONLY
                 initialize_random_seeds(seeds, ff_offset, ff_values);
                 allocate_device_memory(seeds,
                                        ff_offset,
@@ -151,6 +197,7 @@ Patcher::Patcher(uint32_t                                        patch_size,
                           d_patches_offset,
                           d_patches_size,
                           d_patches_val);
+#endif
             }
         }
         extract_ribbons(fv, ff_offset, ff_values);
@@ -178,7 +225,7 @@ Patcher::Patcher(uint32_t                                        patch_size,
     GPU_FREE(d_patches_val);
 }
 
-void Patcher::grid(const std::vector<std::vector<uint32_t>>& fv)
+void Patcher::grid(const uint32_t* fv)
 {
     // this only work if the input is a mesh coming from create_plane()
     // where are laid out sequentially and so we can just group them using
@@ -212,9 +259,9 @@ void Patcher::grid(const std::vector<std::vector<uint32_t>>& fv)
         // for (uint32_t v = 0; v < fv[f].size(); ++v) {
         //     minn = std::min(fv[f][v], minn);
         // }
-        uint32_t id0 = calc_id(fv[f][0]);
-        uint32_t id1 = calc_id(fv[f][1]);
-        uint32_t id2 = calc_id(fv[f][2]);
+        uint32_t id0 = calc_id(fv[3 * f + 0]);
+        uint32_t id1 = calc_id(fv[3 * f + 1]);
+        uint32_t id2 = calc_id(fv[3 * f + 2]);
 
         m_face_patch[f] = std::max(id0, std::max(id1, id2));
     }
@@ -254,6 +301,7 @@ void Patcher::allocate_memory(std::vector<uint32_t>& seeds)
     m_ribbon_ext_val.resize(m_num_faces);
 }
 
+#ifndef RX_CPU_ONLY
 void Patcher::allocate_device_memory(const std::vector<uint32_t>& seeds,
                                      const std::vector<uint32_t>& ff_offset,
                                      const std::vector<uint32_t>& ff_values,
@@ -347,10 +395,11 @@ void Patcher::allocate_device_memory(const std::vector<uint32_t>& seeds,
     CUDA_ERROR(cudaMalloc((void**)&d_cub_temp_storage_scan, cub_scan_bytes));
     CUDA_ERROR(cudaMalloc((void**)&d_cub_temp_storage_max, cub_max_bytes));
 }
+#endif
 
-void Patcher::calc_edge_cut(const std::vector<std::vector<uint32_t>>& fv,
-                            const std::vector<uint32_t>&              ff_offset,
-                            const std::vector<uint32_t>&              ff_values)
+void Patcher::calc_edge_cut(const uint32_t*              fv,
+                            const std::vector<uint32_t>& ff_offset,
+                            const std::vector<uint32_t>& ff_values)
 {
     // given a graph where nodes represents faces in the mesh and two nodes
     // are connected in this graph if two faces share an edge, we calculate
@@ -375,10 +424,10 @@ void Patcher::calc_edge_cut(const std::vector<std::vector<uint32_t>>& fv,
     uint32_t num_edges = 0;
 
     for (uint32_t f = 0; f < m_num_faces; ++f) {
-        for (uint32_t i = 0; i < fv[f].size(); ++i) {
+        for (uint32_t i = 0; i < 3; ++i) {
 
-            uint32_t v0 = fv[f][i];
-            uint32_t v1 = fv[f][(i + 1) % fv[f].size()];
+            uint32_t v0 = fv[3 * f + i];
+            uint32_t v1 = fv[3 * f + (i + 1) % 3];
 
             std::pair<uint32_t, uint32_t> edge = detail::edge_key(v0, v1);
 
@@ -636,7 +685,7 @@ void Patcher::bfs(const std::vector<uint32_t>& ff_offset,
     }
 }
 
-void Patcher::extract_ribbons(const std::vector<std::vector<uint32_t>>& fv,
+void Patcher::extract_ribbons(const uint32_t*              fv,
                               const std::vector<uint32_t>& ff_offset,
                               const std::vector<uint32_t>& ff_values)
 {
@@ -661,8 +710,8 @@ void Patcher::extract_ribbons(const std::vector<std::vector<uint32_t>>& fv,
         vertex_incident_faces[i].clear();
     }
     for (uint32_t face = 0; face < m_num_faces; ++face) {
-        for (uint32_t v = 0; v < fv[face].size(); ++v) {
-            vertex_incident_faces[fv[face][v]].push_back(face);
+        for (uint32_t v = 0; v < 3; ++v) {
+            vertex_incident_faces[fv[3 * face + v]].push_back(face);
         }
     }
 
@@ -701,11 +750,12 @@ void Patcher::extract_ribbons(const std::vector<std::vector<uint32_t>>& fv,
                     // that are shared between face and n
 
                     // add the common vertices in fv[face] and fv[n]
-                    for (uint32_t i = 0; i < fv[face].size(); ++i) {
-                        auto it_vf =
-                            std::find(fv[n].begin(), fv[n].end(), fv[face][i]);
-                        if (it_vf != fv[n].end()) {
-                            bd_vertices.push_back(fv[face][i]);
+                    const uint32_t* fv_n = fv + 3 * n;
+                    for (uint32_t i = 0; i < 3; ++i) {
+                        const uint32_t vf    = fv[3 * face + i];
+                        auto           it_vf = std::find(fv_n, fv_n + 3, vf);
+                        if (it_vf != fv_n + 3) {
+                            bd_vertices.push_back(vf);
                         }
                     }
 
@@ -770,11 +820,8 @@ void Patcher::extract_ribbons(const std::vector<std::vector<uint32_t>>& fv,
     m_ribbon_ext_val.resize(m_ribbon_ext_offset[m_num_patches - 1]);
 }
 
-void Patcher::assign_patch(
-    const std::vector<std::vector<uint32_t>>&                 fv,
-    const std::unordered_map<std::pair<uint32_t, uint32_t>,
-                             uint32_t,
-                             ::rxmesh::detail::edge_key_hash> edges_map)
+void Patcher::assign_patch(const uint32_t*                        fv,
+                           const ::rxmesh::detail::SortedEdgeMap& edges_map)
 {
     // For every patch p, for every face in the patch, find the three edges
     // that bound that face, and assign them to the patch. For boundary vertices
@@ -790,9 +837,9 @@ void Patcher::assign_patch(
 
             uint32_t face = m_patches_val[f];
 
-            uint32_t v1 = fv[face].back();
-            for (uint32_t v = 0; v < fv[face].size(); ++v) {
-                uint32_t v0 = fv[face][v];
+            uint32_t v1 = fv[3 * face + 2];
+            for (uint32_t v = 0; v < 3; ++v) {
+                uint32_t v0 = fv[3 * face + v];
 
                 std::pair<uint32_t, uint32_t> key =
                     ::rxmesh::detail::edge_key(v0, v1);
@@ -880,6 +927,7 @@ void Patcher::assign_patch(
     }*/
 }
 
+#ifndef RX_CPU_ONLY
 void Patcher::run_lloyd(uint32_t* d_face_patch,
                         uint32_t* d_queue,
                         uint32_t* d_queue_ptr,
@@ -1087,6 +1135,7 @@ uint32_t Patcher::construct_patches_compressed_format(
 
     return max_patch_size;
 }
+#endif
 
 
 void Patcher::metis_kway(const std::vector<uint32_t>& ff_offset,
@@ -6,6 +6,7 @@
 #include <string>
 #include <unordered_map>
 
+#include "rxmesh/util/sorted_edge_map.h"
 #include "rxmesh/util/util.h"
 
 #define CEREAL_RAPIDJSON_NAMESPACE CerealRapidjson
@@ -18,11 +19,23 @@ namespace rxmesh {
 
 class RXMeshDynamic;
 
+/**
+ * @brief the algorithm used to partition the input mesh into patches
+ */
+enum class PatchingMethod
+{
+    Lloyd     = 0,  // Lloyd on the gpu
+    HostLloyd = 1,  // Lloyd on the host (multithreaded with OpenMP)
+    Metis     = 2,  // METIS k-way partitioning of the face graph
+    Morton    = 3,  // sort faces along a Morton curve (needs coordinates)
+    Hilbert   = 4,  // sort faces along a Hilbert curve (needs coordinates)
+};
+
 namespace patcher {
 
 /**
  * @brief Takes an input mesh and partition it to patches using Lloyd algorithm
- * on the gpu
+ * on the gpu (or on the host, or using METIS depending on PatchingMethod)
  */
 class Patcher
 {
@@ -32,19 +45,24 @@ class Patcher
    public:
     Patcher() = default;
 
-    Patcher(uint32_t                                  patch_size,
-            const std::vector<uint32_t>&              ff_offset,
-            const std::vector<uint32_t>&              ff_values,
-            const std::vector<std::vector<uint32_t>>& fv,
-            const std::unordered_map<std::pair<uint32_t, uint32_t>,
-                                     uint32_t,
-                                     ::rxmesh::detail::edge_key_hash> edges_map,
-            const uint32_t num_vertices,
-            const uint32_t num_edges,
-            bool           use_metis);
+    Patcher(uint32_t                               patch_size,
+            const std::vector<uint32_t>&           ff_offset,
+            const std::vector<uint32_t>&           ff_values,
+            const uint32_t*                        fv,
+            const uint32_t                         num_faces,
+            const ::rxmesh::detail::SortedEdgeMap& edges_map,
+            const uint32_t                         num_vertices,
+            const uint32_t                         num_edges,
+            const PatchingMethod                   method,
+            const float*                           vertices = nullptr);
 
     Patcher(std::string filename);
 
+    /**
+     * @brief read the patcher from a stream written by save(std::ostream&)
+     */
+    explicit Patcher(std::istream& is);
+
     ~Patcher();
 
     void print_statistics();
@@ -153,8 +171,13 @@ class Patcher
 
     void save(std::string filename)
     {
-        std::ofstream                       ss(filename, std::ios::binary);
-        cereal::PortableBinaryOutputArchive archive(ss);
+        std::ofstream ss(filename, std::ios::binary);
+        save(ss);
+    }
+
+    void save(std::ostream& os)
+    {
+        cereal::PortableBinaryOutputArchive archive(os);
         archive(*this);
     }
 
@@ -214,7 +237,7 @@ class Patcher
                                 uint32_t*& d_patches_size,
                                 uint32_t*& d_patches_val);
 
-    void grid(const std::vector<std::vector<uint32_t>>& fv);
+    void grid(const uint32_t* fv);
 
 
     /**
@@ -223,11 +246,8 @@ class Patcher
      */
     void compute_inital_compressed_patches();
 
-    void assign_patch(
-        const std::vector<std::vector<uint32_t>>&                 fv,
-        const std::unordered_map<std::pair<uint32_t, uint32_t>,
-                                 uint32_t,
-                                 ::rxmesh::detail::edge_key_hash> edges_map);
+    void assign_patch(const uint32_t*                        fv,
+                      const ::rxmesh::detail::SortedEdgeMap& edges_map);
 
     void initialize_random_seeds(std::vector<uint32_t>&       seeds,
                                  const std::vector<uint32_t>& ff_offset,
@@ -242,9 +262,9 @@ class Patcher
                                              std::vector<uint32_t>& component,
                                              uint32_t               num_seeds);
 
-    void extract_ribbons(const std::vector<std::vector<uint32_t>>& fv,
-                         const std::vector<uint32_t>&              ff_offset,
-                         const std::vector<uint32_t>&              ff_values);
+    void extract_ribbons(const uint32_t*              fv,
+                         const std::vector<uint32_t>& ff_offset,
+                         const std::vector<uint32_t>& ff_values);
 
     uint32_t construct_patches_compressed_format(uint32_t* d_face_patch,
                                                  void*  d_cub_temp_storage_scan,
@@ -272,15 +292,82 @@ class Patcher
                    uint32_t* d_patches_size,
                    uint32_t* d_patches_val);
 
+    /**
+     * @brief run Lloyd algorithm on the host using OpenMP. Produces the same
+     * outputs as run_lloyd() i.e., m_face_patch, m_patches_val, and
+     * m_patches_offset along with the number of patches and Lloyd iterations
+     * @param seeds the initial seeds (one per patch)
+     */
+    void run_lloyd_host(std::vector<uint32_t>&       seeds,
+                        const std::vector<uint32_t>& ff_offset,
+                        const std::vector<uint32_t>& ff_values);
+
+    /**
+     * @brief host version of cluster_seed_propagation i.e., multi-source BFS
+     * from the seeds. The output face_patch stores the patch id shifted by one
+     * and the first bit indicates if the face is a boundary face
+     */
+    void host_cluster_seed_propagation(const std::vector<uint32_t>& seeds,
+                                       std::vector<uint32_t>&       face_patch,
+                                       const std::vector<uint32_t>& ff_offset,
+                                       const std::vector<uint32_t>& ff_values);
+
+    /**
+     * @brief host version of construct_patches_compressed_format. Returns the
+     * max patch size
+     */
+    uint32_t host_construct_patches_compressed_format(
+        const std::vector<uint32_t>& face_patch);
+
+    /**
+     * @brief host version of the interior kernel i.e., move every seed to the
+     * face that is the farthest from its patch boundary
+     */
+    void host_interior(std::vector<uint32_t>&       seeds,
+                       const std::vector<uint32_t>& face_patch,
+                       const std::vector<uint32_t>& ff_offset,
+                       const std::vector<uint32_t>& ff_values,
+                       std::vector<uint32_t>&       visited);
+
+    /**
+     * @brief host version of add_more_seeds i.e., add a seed on the boundary
+     * of every patch larger than the patch size
+     */
+    void host_add_more_seeds(std::vector<uint32_t>& seeds);
+
+    /**
+     * @brief partition the mesh by sorting the faces along a space-filling
+     * curve of their centroids and cutting the sorted faces into runs of
+     * m_patch_size faces. Runs that are not connected are then fixed by
+     * repair_disconnected_patches(). Much faster than Lloyd at the cost of
+     * (slightly) more ribbon faces
+     * @param vertices vertex coordinates (three per vertex)
+     * @param hilbert use Hilbert curve if true and Morton curve otherwise
+     */
+    void space_filling_curve(const uint32_t*              fv,
+                             const float*                 vertices,
+                             const std::vector<uint32_t>& ff_offset,
+                             const std::vector<uint32_t>& ff_values,
+                             const bool                   hilbert);
+
+    /**
+     * @brief make every patch a single connected component. In every patch,
+     * the largest connected component is kept and the other (smaller)
+     * components are moved to the neighbour patch they share the most edges
+     * with. Components that have no such neighbour become new patches
+     */
+    void repair_disconnected_patches(const std::vector<uint32_t>& ff_offset,
+                                     const std::vector<uint32_t>& ff_values);
+
     void bfs(const std::vector<uint32_t>& ff_offset,
              const std::vector<uint32_t>& ff_values);
 
     void metis_kway(const std::vector<uint32_t>& ff_offset,
                     const std::vector<uint32_t>& ff_values);
 
-    void calc_edge_cut(const std::vector<std::vector<uint32_t>>& fv,
-                       const std::vector<uint32_t>&              ff_offset,
-                       const std::vector<uint32_t>&              ff_values);
+    void calc_edge_cut(const uint32_t*              fv,
+                       const std::vector<uint32_t>& ff_offset,
+                       const std::vector<uint32_t>& ff_values);
 
     uint32_t m_patch_size, m_num_patches, m_num_vertices, m_num_edges,
         m_num_faces, m_num_seeds, m_max_num_patches, m_num_components,
@@ -0,0 +1,6 @@
+// With RX_USE_CUDA=OFF, .cu files are not compiled. The patcher is needed to
+// build the mesh on the host and so it is compiled here as C++ where the
+// device code paths are guarded by RX_CPU_ONLY
+#ifdef RX_CPU_ONLY
+#include "rxmesh/patcher/patcher.cu"
+#endif
@@ -0,0 +1,635 @@
+#include <omp.h>
+#include <stdint.h>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "rxmesh/patcher/patcher.h"
+#include "rxmesh/util/host_parallel.h"
+#include "rxmesh/util/log.h"
+#include "rxmesh/util/space_filling_curve.h"
+#include "rxmesh/util/timer.h"
+
+namespace rxmesh {
+
+namespace patcher {
+
+void Patcher::run_lloyd_host(std::vector<uint32_t>&       seeds,
+                             const std::vector<uint32_t>& ff_offset,
+                             const std::vector<uint32_t>& ff_values)
+{
+    // Same steps as run_lloyd() but every step runs on the host. The only
+    // difference is that, when two patches reach a face at the same BFS level,
+    // the face goes to the patch with the smaller id (on the gpu, it goes to
+    // whoever gets there first). So the result only depends on the seeds and
+    // not on the number of threads
+    seeds.resize(m_max_num_patches);
+
+    std::vector<uint32_t> face_patch(m_num_faces);
+    std::vector<uint32_t> visited(m_num_faces);
+
+    CPUTimer timer;
+    timer.start();
+
+    m_num_lloyd_run = 0;
+    while (true) {
+        ++m_num_lloyd_run;
+
+        // add more seeds if needed
+        if (m_num_lloyd_run % 5 == 0 && m_num_lloyd_run > 0) {
+            host_add_more_seeds(seeds);
+        }
+
+        // Cluster seed propagation
+        host_cluster_seed_propagation(seeds, face_patch, ff_offset, ff_values);
+
+        uint32_t max_patch_size =
+            host_construct_patches_compressed_format(face_patch);
+
+        // Interior
+        host_interior(seeds, face_patch, ff_offset, ff_values, visited);
+
+        if (max_patch_size < m_patch_size) {
+            break;
+        }
+    }
+
+    // remove the boundary bit
+    const int num_faces = static_cast<int>(m_num_faces);
+#pragma omp parallel for
+    for (int f = 0; f < num_faces; ++f) {
+        m_face_patch[f]  = face_patch[f] >> 1;
+        m_patches_val[f] = m_patches_val[f] >> 1;
+    }
+
+    timer.stop();
+    m_patching_time_ms = timer.elapsed_millis();
+
+    m_num_seeds = m_num_patches;
+    m_patches_offset.resize(m_num_patches);
+}
+
+void Patcher::host_cluster_seed_propagation(
+    const std::vector<uint32_t>& seeds,
+    std::vector<uint32_t>&       face_patch,
+    const std::vector<uint32_t>& ff_offset,
+    const std::vector<uint32_t>& ff_values)
+{
+    const int num_faces = static_cast<int>(m_num_faces);
+
+    // the patch that claims a face in the current level. Every face is
+    // claimed only once and so there is no need to reset it between levels
+    std::vector<std::atomic<uint32_t>> claim(m_num_faces);
+
+#pragma omp parallel for
+    for (int f = 0; f < num_faces; ++f) {
+        face_patch[f] = INVALID32;
+        claim[f].store(INVALID32, std::memory_order_relaxed);
+    }
+
+    std::vector<uint32_t> queue;
+    queue.reserve(m_num_faces);
+    for (uint32_t p = 0; p < m_num_patches; ++p) {
+        const uint32_t seed = seeds[p];
+        if (face_patch[seed] == INVALID32) {
+            face_patch[seed] = p << 1;
+            claim[seed].store(p, std::memory_order_relaxed);
+            queue.push_back(seed);
+        }
+    }
+
+    const int num_threads = omp_get_max_threads();
+
+    std::vector<std::vector<uint32_t>> thread_next(num_threads);
+    std::vector<size_t>                thread_offset(num_threads + 1);
+
+    // level-synchronous BFS where queue[level_start, level_end) is the
+    // current level
+    size_t level_start = 0;
+    while (level_start < queue.size()) {
+        const size_t level_end  = queue.size();
+        const int    level_size = static_cast<int>(level_end - level_start);
+
+        // 1) every face in the current level tries to claim its unassigned
+        // neighbours. The smaller patch id wins. The thread that first claims
+        // a face adds it to the next level
+#pragma omp parallel num_threads(num_threads)
+        {
+            std::vector<uint32_t>& next = thread_next[omp_get_thread_num()];
+            next.clear();
+
+#pragma omp for schedule(static)
+            for (int i = 0; i < level_size; ++i) {
+                const uint32_t face  = queue[level_start + i];
+                const uint32_t patch = face_patch[face] >> 1;
+
+                for (uint32_t n = ff_offset[face]; n < ff_offset[face + 1];
+                     ++n) {
+                    const uint32_t n_face = ff_values[n];
+                    if (face_patch[n_face] != INVALID32) {
+                        continue;
+                    }
+                    uint32_t old =
+                        claim[n_face].load(std::memory_order_relaxed);
+                    while (patch < old &&
+                           !claim[n_face].compare_exchange_weak(
+                               old, patch, std::memory_order_relaxed)) {
+                    }
+                    if (old == INVALID32) {
+                        next.push_back(n_face);
+                    }
+                }
+            }
+        }
+
+        // 2) append the next level to the queue and assign its faces
+        thread_offset[0] = 0;
+        for (int t = 0; t < num_threads; ++t) {
+            thread_offset[t + 1] = thread_offset[t] + thread_next[t].size();
+        }
+        queue.resize(level_end + thread_offset[num_threads]);
+
+#pragma omp parallel for num_threads(num_threads)
+        for (int t = 0; t < num_threads; ++t) {
+            std::copy(thread_next[t].begin(),
+                      thread_next[t].end(),
+                      queue.begin() + level_end + thread_offset[t]);
+        }
+
+        const int next_size = static_cast<int>(thread_offset[num_threads]);
+#pragma omp parallel for
+        for (int i = 0; i < next_size; ++i) {
+            const uint32_t face = queue[level_end + i];
+            face_patch[face] =
+                claim[face].load(std::memory_order_relaxed) << 1;
+        }
+
+        level_start = level_end;
+    }
+
+    if (queue.size() != m_num_faces) {
+        RXMESH_ERROR(
+            "Patcher::host_cluster_seed_propagation() {} faces are not "
+            "reachable from any seed",
+            m_num_faces - queue.size());
+        exit(EXIT_FAILURE);
+    }
+
+    // mark the boundary faces i.e., faces with a neighbour face in a different
+    // patch
+#pragma omp parallel for
+    for (int f = 0; f < num_faces; ++f) {
+        const uint32_t patch       = face_patch[f] >> 1;
+        uint32_t       is_boundary = 0;
+        for (uint32_t n = ff_offset[f]; n < ff_offset[f + 1]; ++n) {
+            if ((face_patch[ff_values[n]] >> 1) != patch) {
+                is_boundary = 1;
+                break;
+            }
+        }
+        face_patch[f] = (patch << 1) | is_boundary;
+    }
+}
+
+uint32_t Patcher::host_construct_patches_compressed_format(
+    const std::vector<uint32_t>& face_patch)
+{
+    const int num_faces   = static_cast<int>(m_num_faces);
+    const int num_patches = static_cast<int>(m_num_patches);
+
+    // sort the faces by their patch. The sort is stable and so the faces of
+    // every patch are sorted by their id
+    std::vector<uint32_t> patch_key(m_num_faces);
+    std::vector<uint32_t> patch_val(m_num_faces);
+#pragma omp parallel for
+    for (int f = 0; f < num_faces; ++f) {
+        patch_key[f] = face_patch[f] >> 1;
+        patch_val[f] = (uint32_t(f) << 1) | (face_patch[f] & 1);
+    }
+
+    int num_bits = 1;
+    while ((uint64_t(1) << num_bits) < uint64_t(m_num_patches)) {
+        ++num_bits;
+    }
+    detail::host_radix_sort_pairs(patch_key, patch_val, num_bits);
+
+    std::copy(patch_val.begin(), patch_val.end(), m_patches_val.begin());
+
+    // the (inclusive) offset of patch p is the end of its segment in the
+    // sorted keys. Empty patches get the offset of the patch before them
+#pragma omp parallel for
+    for (int p = 0; p < num_patches; ++p) {
+        m_patches_offset[p] = static_cast<uint32_t>(
+            std::upper_bound(patch_key.begin(), patch_key.end(), uint32_t(p)) -
+            patch_key.begin());
+    }
+
+    uint32_t max_patch_size = 0;
+#pragma omp parallel for reduction(max : max_patch_size)
+    for (int p = 0; p < num_patches; ++p) {
+        const uint32_t p_start = (p == 0) ? 0 : m_patches_offset[p - 1];
+        max_patch_size =
+            std::max(max_patch_size, m_patches_offset[p] - p_start);
+    }
+
+    return max_patch_size;
+}
+
+void Patcher::host_interior(std::vector<uint32_t>&       seeds,
+                            const std::vector<uint32_t>& face_patch,
+                            const std::vector<uint32_t>& ff_offset,
+                            const std::vector<uint32_t>& ff_values,
+                            std::vector<uint32_t>&       visited)
+{
+    const int num_faces   = static_cast<int>(m_num_faces);
+    const int num_patches = static_cast<int>(m_num_patches);
+
+#pragma omp parallel for
+    for (int f = 0; f < num_faces; ++f) {
+        visited[f] = INVALID32;
+    }
+
+    // one patch per iteration. Every face belongs to one patch and so threads
+    // never touch the same entry in visited
+#pragma omp parallel
+    {
+        std::vector<uint32_t> queue;
+
+#pragma omp for schedule(dynamic)
+        for (int p = 0; p < num_patches; ++p) {
+            const uint32_t patch_id = static_cast<uint32_t>(p);
+            const uint32_t p_start  = (p == 0) ? 0 : m_patches_offset[p - 1];
+            const uint32_t p_end    = m_patches_offset[p];
+            const uint32_t p_size   = p_end - p_start;
+
+            // construct boundary queue
+            queue.clear();
+            for (uint32_t i = p_start; i < p_end; ++i) {
+                const uint32_t face = m_patches_val[i];
+                if (face & 1) {
+                    queue.push_back(face >> 1);
+                    visited[face >> 1] = patch_id;
+                }
+            }
+
+            // if there is no boundary, it means that the patch is a single
+            // component. Keep the seed as it is
+            if (queue.empty()) {
+                continue;
+            }
+
+            size_t queue_start = 0;
+            size_t queue_end   = 0;
+            while (true) {
+                queue_start = queue_end;
+                queue_end   = queue.size();
+
+                if (queue_end == p_size) {
+                    break;
+                }
+
+                for (size_t i = queue_start; i < queue_end; ++i) {
+                    const uint32_t face = queue[i];
+                    for (uint32_t n = ff_offset[face]; n < ff_offset[face + 1];
+                         ++n) {
+                        const uint32_t n_face = ff_values[n];
+                        if ((face_patch[n_face] >> 1) == patch_id &&
+                            visited[n_face] != patch_id) {
+                            visited[n_face] = patch_id;
+                            queue.push_back(n_face);
+                        }
+                    }
+                }
+
+                // the rest of the patch is not reachable from its boundary
+                if (queue.size() == queue_end) {
+                    break;
+                }
+            }
+
+            // the new seed is the first face in the last BFS level i.e., one
+            // of the faces that are the farthest from the boundary
+            if (queue_start != 0) {
+                seeds[p] = queue[queue_start];
+            }
+        }
+    }
+}
+
+void Patcher::host_add_more_seeds(std::vector<uint32_t>& seeds)
+{
+    // sequential so that the new seeds are numbered in the patch order
+    const uint32_t num_patches = m_num_patches;
+    for (uint32_t p = 0; p < num_patches; ++p) {
+        const uint32_t p_start = (p == 0) ? 0 : m_patches_offset[p - 1];
+        const uint32_t p_end   = m_patches_offset[p];
+
+        if (p_end - p_start <= m_patch_size) {
+            continue;
+        }
+
+        // look for a boundary face
+        for (uint32_t f = p_start; f < p_end; ++f) {
+            const uint32_t face = m_patches_val[f];
+            if (face & 1) {
+                if (m_num_patches >= m_max_num_patches) {
+                    RXMESH_ERROR(
+                        "Patcher::host_add_more_seeds() m_num_patches exceeds "
+                        "m_max_num_patches");
+                    exit(EXIT_FAILURE);
+                }
+                seeds[m_num_patches++] = face >> 1;
+                break;
+            }
+        }
+    }
+}
+
+void Patcher::space_filling_curve(const uint32_t*              fv,
+                                  const float*                 vertices,
+                                  const std::vector<uint32_t>& ff_offset,
+                                  const std::vector<uint32_t>& ff_values,
+                                  const bool                   hilbert)
+{
+    const int num_faces = static_cast<int>(m_num_faces);
+
+    CPUTimer timer;
+    timer.start();
+
+    // 1) bounding box of the face centroids
+    std::vector<float> centroid(3 * size_t(m_num_faces));
+
+    float lo_x = std::numeric_limits<float>::max();
+    float lo_y = std::numeric_limits<float>::max();
+    float lo_z = std::numeric_limits<float>::max();
+    float hi_x = std::numeric_limits<float>::lowest();
+    float hi_y = std::numeric_limits<float>::lowest();
+    float hi_z = std::numeric_limits<float>::lowest();
+
+#pragma omp parallel for reduction(min : lo_x, lo_y, lo_z) \
+    reduction(max : hi_x, hi_y, hi_z)
+    for (int f = 0; f < num_faces; ++f) {
+        for (uint32_t i = 0; i < 3; ++i) {
+            float c = 0;
+            for (uint32_t v = 0; v < 3; ++v) {
+                c += vertices[3 * size_t(fv[3 * f + v]) + i];
+            }
+            centroid[3 * size_t(f) + i] = c / 3.f;
+        }
+        lo_x = std::min(lo_x, centroid[3 * size_t(f) + 0]);
+        lo_y = std::min(lo_y, centroid[3 * size_t(f) + 1]);
+        lo_z = std::min(lo_z, centroid[3 * size_t(f) + 2]);
+        hi_x = std::max(hi_x, centroid[3 * size_t(f) + 0]);
+        hi_y = std::max(hi_y, centroid[3 * size_t(f) + 1]);
+        hi_z = std::max(hi_z, centroid[3 * size_t(f) + 2]);
+    }
+    const float lo[3] = {lo_x, lo_y, lo_z};
+
+    // 2) quantize the centroids (with the same scale along all axes) and
+    // compute their codes. We only use as many bits as needed to (roughly)
+    // separate the faces to reduce the number of sorting passes
+    int num_bits = 2;
+    while (num_bits < 21 && (uint64_t(1) << (3 * (num_bits - 2))) <
+                                uint64_t(m_num_faces)) {
+        ++num_bits;
+    }
+    const float extent =
+        std::max(hi_x - lo_x, std::max(hi_y - lo_y, hi_z - lo_z));
+    const float max_cell = static_cast<float>((uint32_t(1) << num_bits) - 1);
+    const float scale    = (extent > 0) ? max_cell / extent : 0.f;
+
+    std::vector<uint64_t> code(m_num_faces);
+    std::vector<uint32_t> order(m_num_faces);
+#pragma omp parallel for
+    for (int f = 0; f < num_faces; ++f) {
+        uint32_t q[3];
+        for (uint32_t i = 0; i < 3; ++i) {
+            const float c = (centroid[3 * size_t(f) + i] - lo[i]) * scale;
+            q[i] = static_cast<uint32_t>(std::min(std::max(c, 0.f), max_cell));
+        }
+        if (hilbert) {
+            code[f] = detail::hilbert_code_3d(q[0], q[1], q[2], num_bits);
+        } else {
+            code[f] = detail::morton_code_3d(q[0], q[1], q[2]);
+        }
+        order[f] = f;
+    }
+    centroid.clear();
+    centroid.shrink_to_fit();
+
+    // 3) sort the faces along the curve. The sort is stable so faces with
+    // the same code are sorted by their id
+    detail::host_radix_sort_pairs(code, order, 3 * num_bits);
+
+    // 4) cut the sorted faces into patches
+#pragma omp parallel for
+    for (int i = 0; i < num_faces; ++i) {
+        m_face_patch[order[i]] = static_cast<uint32_t>(i) / m_patch_size;
+    }
+
+    // 5) fix patches that are not connected
+    repair_disconnected_patches(ff_offset, ff_values);
+
+    timer.stop();
+    m_patching_time_ms = timer.elapsed_millis();
+    m_num_seeds        = m_num_patches;
+    m_num_lloyd_run    = 0;
+}
+
+void Patcher::repair_disconnected_patches(
+    const std::vector<uint32_t>& ff_offset,
+    const std::vector<uint32_t>& ff_values)
+{
+    const int num_faces = static_cast<int>(m_num_faces);
+
+    // the component of a face is identified by the first face (in the patch
+    // order) from which the component is reached
+    std::vector<uint32_t> face_comp(m_num_faces);
+    std::vector<uint32_t> new_patch(m_num_faces);
+    std::vector<uint32_t> face_patch(m_num_faces);
+
+    while (true) {
+#pragma omp parallel for
+        for (int f = 0; f < num_faces; ++f) {
+            face_patch[f] = m_face_patch[f] << 1;
+            face_comp[f]  = INVALID32;
+            new_patch[f]  = m_face_patch[f];
+        }
+        host_construct_patches_compressed_format(face_patch);
+
+        const int num_patches = static_cast<int>(m_num_patches);
+
+        std::vector<uint32_t> main_comp(m_num_patches);
+
+        // 1) find the connected components of every patch and keep the
+        // largest one as the main component
+#pragma omp parallel
+        {
+            std::vector<uint32_t> queue;
+#pragma omp for schedule(dynamic)
+            for (int p = 0; p < num_patches; ++p) {
+                const uint32_t patch_id = static_cast<uint32_t>(p);
+                const uint32_t p_start = (p == 0) ? 0 : m_patches_offset[p - 1];
+                const uint32_t p_end   = m_patches_offset[p];
+
+                uint32_t max_size = 0;
+                for (uint32_t i = p_start; i < p_end; ++i) {
+                    const uint32_t seed = m_patches_val[i] >> 1;
+                    if (face_comp[seed] != INVALID32) {
+                        continue;
+                    }
+                    queue.clear();
+                    queue.push_back(seed);
+                    face_comp[seed] = seed;
+                    for (size_t q = 0; q < queue.size(); ++q) {
+                        const uint32_t face = queue[q];
+                        for (uint32_t n = ff_offset[face];
+                             n < ff_offset[face + 1];
+                             ++n) {
+                            const uint32_t n_face = ff_values[n];
+                            if (m_face_patch[n_face] == patch_id &&
+                                face_comp[n_face] == INVALID32) {
+                                face_comp[n_face] = seed;
+                                queue.push_back(n_face);
+                            }
+                        }
+                    }
+                    if (queue.size() > max_size) {
+                        max_size     = static_cast<uint32_t>(queue.size());
+                        main_comp[p] = seed;
+                    }
+                }
+            }
+        }
+
+        // 2) move every other (small) component to the neighbour patch with
+        // which it shares the most edges. Only components adjacent to the main
+        // component of the other patch are considered so that the patch stays
+        // connected after the move. Large components are marked (with
+        // INVALID32) to become new patches so we do not double the size of
+        // the neighbour patch
+        bool has_fragments = false;
+        bool has_changed   = false;
+#pragma omp parallel reduction(|| : has_fragments, has_changed)
+        {
+            std::vector<std::pair<uint32_t, uint32_t>> frag;
+            std::vector<uint32_t>                      neighbour;
+#pragma omp for schedule(dynamic)
+            for (int p = 0; p < num_patches; ++p) {
+                const uint32_t p_start = (p == 0) ? 0 : m_patches_offset[p - 1];
+                const uint32_t p_end   = m_patches_offset[p];
+
+                frag.clear();
+                for (uint32_t i = p_start; i < p_end; ++i) {
+                    const uint32_t face = m_patches_val[i] >> 1;
+                    if (face_comp[face] != main_comp[p]) {
+                        frag.push_back({face_comp[face], face});
+                    }
+                }
+                if (frag.empty()) {
+                    continue;
+                }
+                has_fragments = true;
+                std::sort(frag.begin(), frag.end());
+
+                size_t c_start = 0;
+                while (c_start < frag.size()) {
+                    size_t c_end = c_start;
+                    while (c_end < frag.size() &&
+                           frag[c_end].first == frag[c_start].first) {
+                        ++c_end;
+                    }
+
+                    uint32_t best = INVALID32;
+                    if (4 * (c_end - c_start) < m_patch_size) {
+                        neighbour.clear();
+                        for (size_t i = c_start; i < c_end; ++i) {
+                            const uint32_t face = frag[i].second;
+                            for (uint32_t n = ff_offset[face];
+                                 n < ff_offset[face + 1];
+                                 ++n) {
+                                const uint32_t n_face  = ff_values[n];
+                                const uint32_t n_patch = m_face_patch[n_face];
+                                if (n_patch != uint32_t(p) &&
+                                    face_comp[n_face] == main_comp[n_patch]) {
+                                    neighbour.push_back(n_patch);
+                                }
+                            }
+                        }
+                        if (neighbour.empty()) {
+                            c_start = c_end;
+                            continue;
+                        }
+                        std::sort(neighbour.begin(), neighbour.end());
+                        size_t best_count = 0;
+                        size_t n          = 0;
+                        while (n < neighbour.size()) {
+                            size_t m = n;
+                            while (m < neighbour.size() &&
+                                   neighbour[m] == neighbour[n]) {
+                                ++m;
+                            }
+                            if (m - n > best_count) {
+                                best_count = m - n;
+                                best       = neighbour[n];
+                            }
+                            n = m;
+                        }
+                    }
+                    for (size_t i = c_start; i < c_end; ++i) {
+                        new_patch[frag[i].second] = best;
+                    }
+                    has_changed = true;
+                    c_start     = c_end;
+                }
+            }
+        }
+
+        if (!has_fragments) {
+            break;
+        }
+
+        // 3) if nothing could be moved, the remaining components are only
+        // adjacent to other (non-main) components so we turn each of them
+        // into a new patch
+        if (!has_changed) {
+#pragma omp parallel for
+            for (int f = 0; f < num_faces; ++f) {
+                if (face_comp[f] != main_comp[m_face_patch[f]]) {
+                    new_patch[f] = INVALID32;
+                }
+            }
+        }
+
+        // new patches are numbered in the order of the face ids
+        for (uint32_t f = 0; f < m_num_faces; ++f) {
+            if (new_patch[f] == INVALID32 && face_comp[f] == f) {
+                if (m_num_patches >= m_max_num_patches) {
+                    RXMESH_ERROR(
+                        "Patcher::repair_disconnected_patches() m_num_patches "
+                        "exceeds m_max_num_patches");
+                    exit(EXIT_FAILURE);
+                }
+                new_patch[f] = m_num_patches++;
+            }
+        }
+#pragma omp parallel for
+        for (int f = 0; f < num_faces; ++f) {
+            if (new_patch[f] == INVALID32) {
+                new_patch[f] = new_patch[face_comp[f]];
+            }
+        }
+        std::swap(m_face_patch, new_patch);
+    }
+
+#pragma omp parallel for
+    for (int i = 0; i < num_faces; ++i) {
+        m_patches_val[i] = m_patches_val[i] >> 1;
+    }
+    m_patches_offset.resize(m_num_patches);
+}
+
+}  // namespace patcher
+}  // namespace rxmesh
@@ -265,7 +265,8 @@ struct Query
             m_s_output_owned_bitmask,
             m_output_lp_hashtable,
             m_s_table,
-            allow_not_owned);
+            allow_not_owned,
+            m_context.template adjacency_cache<op>(oriented));
     }
 
 
@@ -314,7 +315,10 @@ struct Query
             ((m_op == Op::EV) ? 2 :
                                 ((m_op == Op::FV || m_op == Op::FE) ?
                                      3 :
-                                     ((m_op == Op::EVDiamond) ? 4 : 0)));
+                                     ((m_op == Op::EVDiamond ||
+                                       m_op == Op::EE) ?
+                                          4 :
+                                          0)));
 
         using LocalT = typename IteratorT::LocalT;
 
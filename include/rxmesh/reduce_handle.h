@@ -1,21 +1,30 @@
 #pragma once
 
+#include <functional>
+#include <vector>
+
 #include "rxmesh/attribute.h"
+#include "rxmesh/attribute_expr.h"
+#ifndef RX_CPU_ONLY
 #include "rxmesh/kernels/attribute.cuh"
+#endif
 
 #include "rxmesh/arg_ops.h"
 
 #include "rxmesh/rxmesh.h"
+#include "rxmesh/util/host_reduce.h"
 
 namespace rxmesh {
-namespace detail {
-
-}  // namespace detail
 
 /**
  * @brief This class is used to compute different reduction operations on
  * Attribute. To create a new ReduceHandle, use create_reduce_handle()
- * from Attribute
+ * from Attribute. Every operation runs on the DEVICE by default or on the
+ * HOST (over the host copy of the attribute) if location is HOST. On the host,
+ * every patch is reduced to one partial (with a fixed number of vectorized
+ * accumulators) and the partials are combined with a fixed-order tree so that
+ * results are bitwise reproducible run-to-run and independent of the number of
+ * threads. In a CPU-only build, all operations run on the host
  * @tparam T The type of the attribute
  */
 template <typename T, typename HandleT>
@@ -55,8 +64,14 @@ class ReduceHandle
      * operations
      * @param num_patches is the number of patches in the mesh
      */
-    ReduceHandle(const uint32_t num_patches) : m_max_num_patches(num_patches)
+    ReduceHandle(const uint32_t num_patches)
+        : m_reduce_temp_storage_bytes(0),
+          m_d_reduce_1st_stage(nullptr),
+          m_d_reduce_2nd_stage(nullptr),
+          m_d_reduce_temp_storage(nullptr),
+          m_max_num_patches(num_patches)
     {
+#ifndef RX_CPU_ONLY
         size_t type_size = std::max(sizeof(T), sizeof(KeyValue));
 
         CUDA_ERROR(
@@ -89,6 +104,7 @@ class ReduceHandle
 
         CUDA_ERROR(cudaMalloc((void**)&m_d_reduce_temp_storage,
                               m_reduce_temp_storage_bytes));
+#endif
     }
 
     ~ReduceHandle()
@@ -107,13 +123,23 @@ class ReduceHandle
      * @param attribute_id specific attribute ID to compute its dot product.
      * Default is INVALID32 which compute dot product for all attributes
      * @param stream stream to run the computation on
+     * @param location where the computation runs (DEVICE or HOST)
      * @return the output of dot product on the host
      */
     T dot(const Attribute<T, HandleT>& attr1,
           const Attribute<T, HandleT>& attr2,
           uint32_t                     attribute_id = INVALID32,
-          cudaStream_t                 stream       = NULL)
+          cudaStream_t                 stream       = NULL,
+          locationT                    location     = DEVICE)
     {
+#ifdef RX_CPU_ONLY
+        location = detail::cpu_location(location);
+#endif
+        if (location == HOST) {
+            return host_dot(attr1, attr2, attribute_id);
+        }
+
+#ifndef RX_CPU_ONLY
         if ((attr1.get_allocated() & DEVICE) != DEVICE ||
             (attr2.get_allocated() & DEVICE) != DEVICE) {
             RXMESH_ERROR(
@@ -131,6 +157,9 @@ class ReduceHandle
                 attribute_id);
 
         return reduce_2nd_stage<T>(stream, cub::Sum(), 0);
+#else
+        return T(0);
+#endif
     }
 
     /**
@@ -140,12 +169,22 @@ class ReduceHandle
      * @param attribute_id specific attribute ID to compute its norm2. Default
      * is INVALID32 which compute norm2 for all attributes
      * @param stream stream to run the computation on
+     * @param location where the computation runs (DEVICE or HOST)
      * @return the output of L2 norm on the host
      */
     T norm2(const Attribute<T, HandleT>& attr,
             uint32_t                     attribute_id = INVALID32,
-            cudaStream_t                 stream       = NULL)
+            cudaStream_t                 stream       = NULL,
+            locationT                    location     = DEVICE)
     {
+#ifdef RX_CPU_ONLY
+        location = detail::cpu_location(location);
+#endif
+        if (location == HOST) {
+            return std::sqrt(host_dot(attr, attr, attribute_id));
+        }
+
+#ifndef RX_CPU_ONLY
         if ((attr.get_allocated() & DEVICE) != DEVICE) {
             RXMESH_ERROR(
                 "ReduceHandle::norm2() input attribute to should be "
@@ -162,6 +201,9 @@ class ReduceHandle
                 attribute_id);
 
         return std::sqrt(reduce_2nd_stage<T>(stream, cub::Sum(), 0));
+#else
+        return T(0);
+#endif
     }
 
     /**
@@ -169,33 +211,21 @@ class ReduceHandle
      * @param attr
      * @param attribute_id
      * @param stream
+     * @param location where the computation runs (DEVICE or HOST). On the
+     * host, ties are broken in favor of the first element in patch order
      * @return
      */
     KeyValue arg_max(const Attribute<T, HandleT>& attr,
                      uint32_t                     attribute_id = INVALID32,
-                     cudaStream_t                 stream       = NULL)
+                     cudaStream_t                 stream       = NULL,
+                     locationT                    location     = DEVICE)
     {
-        if ((attr.get_allocated() & DEVICE) != DEVICE) {
-            RXMESH_ERROR(
-                "ReduceHandle::arg_max() input attribute to should be "
-                "allocated on the device");
-        }
-
-        detail::ArgMaxOp<HandleT, T> max_pair;
-
-        detail::arg_minmax_kernel<T, attr.m_block_size, HandleT>
-            <<<m_max_num_patches, attr.m_block_size, 0, stream>>>(
-                attr,
-                attribute_id,
-                max_pair,
-                m_max_num_patches,
-                attr.get_num_attributes(),
-                reinterpret_cast<KeyValue*>(m_d_reduce_1st_stage));
-
-        KeyValue init(HandleT(), max_pair.default_val());
-
-        return reduce_2nd_stage<KeyValue>(
-            stream, detail::ArgMaxOp<HandleT, T>(), init);
+        return arg_minmax(attr,
+                          attribute_id,
+                          stream,
+                          location,
+                          detail::ArgMaxOp<HandleT, T>(),
+                          "arg_max");
     }
 
 
@@ -204,33 +234,21 @@ class ReduceHandle
      * @param attr
      * @param attribute_id
      * @param stream
+     * @param location where the computation runs (DEVICE or HOST). On the
+     * host, ties are broken in favor of the first element in patch order
      * @return
      */
     KeyValue arg_min(const Attribute<T, HandleT>& attr,
                      uint32_t                     attribute_id = INVALID32,
-                     cudaStream_t                 stream       = NULL)
+                     cudaStream_t                 stream       = NULL,
+                     locationT                    location     = DEVICE)
     {
-        if ((attr.get_allocated() & DEVICE) != DEVICE) {
-            RXMESH_ERROR(
-                "ReduceHandle::arg_min() input attribute to should be "
-                "allocated on the device");
-        }
-
-        detail::ArgMinOp<HandleT, T> min_pair;
-
-        detail::arg_minmax_kernel<T, attr.m_block_size, HandleT>
-            <<<m_max_num_patches, attr.m_block_size, 0, stream>>>(
-                attr,
-                attribute_id,
-                min_pair,
-                m_max_num_patches,
-                attr.get_num_attributes(),
-                reinterpret_cast<KeyValue*>(m_d_reduce_1st_stage));
-
-        KeyValue init(HandleT(), min_pair.default_val());
-
-        return reduce_2nd_stage<KeyValue>(
-            stream, detail::ArgMinOp<HandleT, T>(), init);
+        return arg_minmax(attr,
+                          attribute_id,
+                          stream,
+                          location,
+                          detail::ArgMinOp<HandleT, T>(),
+                          "arg_min");
     }
 
 
@@ -253,12 +271,14 @@ class ReduceHandle
      * };
      * Read more about reduction from CUB doc
      * https://nvlabs.github.io/cub/structcub_1_1_device_reduce.html
+     * For the HOST, the functor should be __host__ callable
      * @param init initial value for reduction. This should be the "neutral"
      * value for the reduction operations e.g., 0 for sum, 1 for multiplication,
      * 0 for max on uint32_t
      * @param attribute_id specific attribute ID to compute its reduction.
      * Default is INVALID32 which compute reduction for all attributes
      * @param stream stream to run the computation on
+     * @param location where the computation runs (DEVICE or HOST)
      * @return the reduced output on the host
      */
     template <typename ReductionOp>
@@ -266,8 +286,17 @@ class ReduceHandle
              ReductionOp                  reduction_op,
              T                            init,
              uint32_t                     attribute_id = INVALID32,
-             cudaStream_t                 stream       = NULL)
+             cudaStream_t                 stream       = NULL,
+             locationT                    location     = DEVICE)
     {
+#ifdef RX_CPU_ONLY
+        location = detail::cpu_location(location);
+#endif
+        if (location == HOST) {
+            return host_reduce(attr, reduction_op, init, attribute_id);
+        }
+
+#ifndef RX_CPU_ONLY
         if ((attr.get_allocated() & DEVICE) != DEVICE) {
             RXMESH_ERROR(
                 "ReduceHandle::reduce() input attribute to should be "
@@ -286,9 +315,254 @@ class ReduceHandle
                 attribute_id);
 
         return reduce_2nd_stage<T>(stream, reduction_op, init);
+#else
+        return init;
+#endif
+    }
+
+    /**
+     * @brief evaluate attribute expressions (see attribute_expr.h) and sum
+     * reductions in a single pass over the patches and return the sum of all
+     * reduce_sum() terms on the host. For example, one CG update is
+     *
+     * delta = reduce_handle.evaluate(rx, DEVICE, stream,
+     *                                assign(X, X + alpha * P),
+     *                                assign(R, R - alpha * S),
+     *                                reduce_sum(R * R));
+     *
+     * The per-patch sums are combined with the same fixed-order tree on the
+     * host and the device so that the result is reproducible run-to-run
+     * @param rx the mesh the attributes are defined on
+     * @param location HOST or DEVICE
+     * @param stream the stream on which the kernel is launched
+     * @param terms assign() and reduce_sum() terms applied in order on every
+     * element
+     */
+    template <typename... TermsT>
+    T evaluate(const RXMesh& rx,
+               locationT     location,
+               cudaStream_t  stream,
+               const TermsT&... terms)
+    {
+        static_assert((TermsT::is_reduction || ...),
+                      "ReduceHandle::evaluate() expects at least one "
+                      "reduce_sum() term. Use evaluate() otherwise");
+
+        if (rx.get_num_patches() > m_max_num_patches) {
+            RXMESH_ERROR(
+                "ReduceHandle::evaluate() the mesh has more patches than the "
+                "ReduceHandle was created for");
+            return T(0);
+        }
+
+        return detail::evaluate_expr<T, HandleT>(rx,
+                                                 location,
+                                                 stream,
+                                                 m_d_reduce_1st_stage,
+                                                 &m_h_partial,
+                                                 terms...);
     }
 
    private:
+    template <typename Operation>
+    KeyValue arg_minmax(const Attribute<T, HandleT>& attr,
+                        uint32_t                     attribute_id,
+                        cudaStream_t                 stream,
+                        locationT                    location,
+                        Operation                    reduction_op,
+                        const char*                  name)
+    {
+#ifdef RX_CPU_ONLY
+        location = detail::cpu_location(location);
+#endif
+        KeyValue init(HandleT(), reduction_op.default_val());
+
+        if (location == HOST) {
+            return host_arg_minmax(attr, attribute_id, reduction_op, init);
+        }
+
+#ifndef RX_CPU_ONLY
+        if ((attr.get_allocated() & DEVICE) != DEVICE) {
+            RXMESH_ERROR(
+                "ReduceHandle::{}() input attribute to should be "
+                "allocated on the device",
+                name);
+        }
+
+        detail::arg_minmax_kernel<T, attr.m_block_size, HandleT>
+            <<<m_max_num_patches, attr.m_block_size, 0, stream>>>(
+                attr,
+                attribute_id,
+                reduction_op,
+                m_max_num_patches,
+                attr.get_num_attributes(),
+                reinterpret_cast<KeyValue*>(m_d_reduce_1st_stage));
+
+        return reduce_2nd_stage<KeyValue>(stream, reduction_op, init);
+#else
+        return init;
+#endif
+    }
+
+    /**
+     * @brief call f(p) for every patch of attr in parallel (on the home
+     * thread of p if the mesh has host affinity) and return the number of
+     * patches
+     */
+    template <typename FuncT>
+    static uint32_t host_for_each_patch(const Attribute<T, HandleT>& attr,
+                                        FuncT                        f)
+    {
+        const uint32_t num_patches = attr.m_rxmesh->get_num_patches();
+
+        if (const detail::HostAffinity* affinity =
+                attr.m_rxmesh->get_host_affinity()) {
+            affinity->run(num_patches, f);
+        } else {
+#pragma omp parallel for schedule(dynamic)
+            for (int p = 0; p < static_cast<int>(num_patches); ++p) {
+                f(p);
+            }
+        }
+        return num_patches;
+    }
+
+    static void check_host(const Attribute<T, HandleT>& attr,
+                           const char*                  name)
+    {
+        if (!attr.is_host_allocated()) {
+            RXMESH_ERROR(
+                "ReduceHandle::{}() input attribute to should be allocated on "
+                "the host",
+                name);
+        }
+    }
+
+    T host_dot(const Attribute<T, HandleT>& attr1,
+               const Attribute<T, HandleT>& attr2,
+               uint32_t                     attribute_id)
+    {
+        check_host(attr1, "dot");
+        check_host(attr2, "dot");
+        assert(attr1.get_num_attributes() == attr2.get_num_attributes());
+
+        m_h_partial.resize(attr1.m_rxmesh->get_num_patches());
+
+        const uint32_t num_attributes = attr1.get_num_attributes();
+
+        auto dot_patch = [&](uint32_t p) {
+            const PatchInfo& pi = attr1.get_patch_info(p);
+            const T*         x  = attr1.m_h_attr[p];
+            const T*         y  = attr2.m_h_attr[p];
+            // both attributes live on the same mesh and so have the same
+            // capacity and pitch
+            const uint32_t px = attr1.pitch_x();
+            const uint32_t py = attr1.pitch_y(p);
+
+            if (attribute_id != INVALID32) {
+                const uint32_t a = attribute_id * py;
+                m_h_partial[p]   = detail::host_masked_sum<T>(
+                    pi.get_owned_mask<HandleT>(),
+                    pi.get_active_mask<HandleT>(),
+                    attr1.size(p),
+                    [&](uint32_t i) { return x[i * px + a] * y[i * px + a]; });
+            } else {
+                m_h_partial[p] = detail::host_masked_sum<T>(
+                    pi.get_owned_mask<HandleT>(),
+                    pi.get_active_mask<HandleT>(),
+                    attr1.size(p),
+                    [&](uint32_t i) {
+                        T sum = 0;
+                        for (uint32_t j = 0; j < num_attributes; ++j) {
+                            sum += x[i * px + j * py] * y[i * px + j * py];
+                        }
+                        return sum;
+                    });
+            }
+        };
+
+        const uint32_t num_patches = host_for_each_patch(attr1, dot_patch);
+
+        return detail::host_tree_reduce(
+            m_h_partial, num_patches, std::plus<T>(), T(0));
+    }
+
+    template <typename ReductionOp>
+    T host_reduce(const Attribute<T, HandleT>& attr,
+                  ReductionOp                  reduction_op,
+                  T                            init,
+                  uint32_t                     attribute_id)
+    {
+        check_host(attr, "reduce");
+
+        m_h_partial.resize(attr.m_rxmesh->get_num_patches());
+
+        const uint32_t num_attributes = attr.get_num_attributes();
+
+        auto reduce_patch = [&](uint32_t p) {
+            const PatchInfo& pi = attr.get_patch_info(p);
+            m_h_partial[p]      = detail::host_masked_fold(
+                pi.get_owned_mask<HandleT>(),
+                pi.get_active_mask<HandleT>(),
+                attr.size(p),
+                [&](T acc, uint32_t i) -> T {
+                    if (attribute_id != INVALID32) {
+                        return reduction_op(acc, attr(p, i, attribute_id));
+                    }
+                    for (uint32_t j = 0; j < num_attributes; ++j) {
+                        acc = reduction_op(acc, attr(p, i, j));
+                    }
+                    return acc;
+                },
+                init);
+        };
+
+        const uint32_t num_patches = host_for_each_patch(attr, reduce_patch);
+
+        return detail::host_tree_reduce(
+            m_h_partial, num_patches, reduction_op, init);
+    }
+
+    template <typename Operation>
+    KeyValue host_arg_minmax(const Attribute<T, HandleT>& attr,
+                             uint32_t                     attribute_id,
+                             Operation                    reduction_op,
+                             KeyValue                     init)
+    {
+        check_host(attr, "arg_minmax");
+
+        m_h_partial_kv.resize(attr.m_rxmesh->get_num_patches());
+
+        const uint32_t num_attributes = attr.get_num_attributes();
+
+        auto arg_patch = [&](uint32_t p) {
+            const PatchInfo& pi = attr.get_patch_info(p);
+            m_h_partial_kv[p]   = detail::host_masked_fold(
+                pi.get_owned_mask<HandleT>(),
+                pi.get_active_mask<HandleT>(),
+                attr.size(p),
+                [&](KeyValue acc, uint32_t i) -> KeyValue {
+                    const HandleT handle(p, i);
+                    if (attribute_id != INVALID32) {
+                        return reduction_op(
+                            acc, KeyValue(handle, attr(p, i, attribute_id)));
+                    }
+                    for (uint32_t j = 0; j < num_attributes; ++j) {
+                        acc = reduction_op(acc,
+                                           KeyValue(handle, attr(p, i, j)));
+                    }
+                    return acc;
+                },
+                init);
+        };
+
+        const uint32_t num_patches = host_for_each_patch(attr, arg_patch);
+
+        return detail::host_tree_reduce(
+            m_h_partial_kv, num_patches, reduction_op, init);
+    }
+
+#ifndef RX_CPU_ONLY
     template <typename U, typename ReductionOp>
     U reduce_2nd_stage(cudaStream_t stream, ReductionOp reduction_op, U init)
     {
@@ -313,12 +587,17 @@ class ReduceHandle
 
         return h_output;
     }
+#endif
 
     size_t   m_reduce_temp_storage_bytes;
     T*       m_d_reduce_1st_stage;
     T*       m_d_reduce_2nd_stage;
     void*    m_d_reduce_temp_storage;
     uint32_t m_max_num_patches;
+
+    // one partial per patch for host reductions
+    std::vector<T>        m_h_partial;
+    std::vector<KeyValue> m_h_partial_kv;
 };
 
 template <class T>
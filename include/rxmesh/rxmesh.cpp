@@ -1,21 +1,26 @@
 #include <assert.h>
 #include <omp.h>
+#include <algorithm>
+#include <cstring>
 #include <filesystem>
 #include <iostream>
 #include <memory>
 #include <numeric>
 #include <queue>
 #include <set>
+#include <sstream>
 
 #include "patcher/patcher.h"
 #include "rxmesh/context.h"
+#include "rxmesh/patch_store.h"
 #include "rxmesh/patch_scheduler.cuh"
 #include "rxmesh/rxmesh.h"
 #include "rxmesh/util/bitmask_util.h"
+#include "rxmesh/util/host_parallel.h"
 #include "rxmesh/util/util.h"
 
 namespace rxmesh {
-RXMesh::RXMesh(uint32_t patch_size)
+RXMesh::RXMesh(uint32_t patch_size, bool host_affinity)
     : m_num_edges(0),
       m_num_faces(0),
       m_num_vertices(0),
@@ -30,6 +35,7 @@ RXMesh::RXMesh(uint32_t patch_size)
       m_num_patches(0),
       m_max_num_patches(0),
       m_patch_size(patch_size),
+      m_host_affinity(host_affinity),
       m_max_capacity_lp_v(0),
       m_max_capacity_lp_e(0),
       m_max_capacity_lp_f(0),
@@ -56,15 +62,70 @@ void RXMesh::init(const std::vector<std::vector<uint32_t>>& fv,
                   const std::string                         patcher_file,
                   const float                               capacity_factor,
                   const float                               patch_alloc_factor,
-                  const float lp_hashtable_load_factor)
+                  const float          lp_hashtable_load_factor,
+                  const PatchingMethod patching_method,
+                  const bool           reorder_patch_elements)
 {
+    if (fv.empty()) {
+        RXMESH_ERROR(
+            "RXMesh::init input fv is empty. Can not build RXMesh properly");
+    }
+
+    // copy the faces into a single contiguous buffer
+    const int num_faces = static_cast<int>(fv.size());
+
+    std::vector<uint32_t> flat_fv(3 * fv.size());
+
+    int non_tri_face = num_faces;
+#pragma omp parallel for reduction(min : non_tri_face)
+    for (int f = 0; f < num_faces; ++f) {
+        if (fv[f].size() != 3) {
+            non_tri_face = std::min(non_tri_face, f);
+            continue;
+        }
+        for (uint32_t v = 0; v < 3; ++v) {
+            flat_fv[3 * f + v] = fv[f][v];
+        }
+    }
+
+    if (non_tri_face != num_faces) {
+        RXMESH_ERROR(
+            "RXMesh::init() Face {} is not triangle. Non-triangular faces are "
+            "not supported",
+            non_tri_face);
+        exit(EXIT_FAILURE);
+    }
+
+    init(flat_fv.data(),
+         static_cast<uint32_t>(num_faces),
+         patcher_file,
+         capacity_factor,
+         patch_alloc_factor,
+         lp_hashtable_load_factor,
+         patching_method,
+         nullptr,
+         reorder_patch_elements);
+}
+
+void RXMesh::init(const uint32_t*      fv,
+                  const uint32_t       num_faces,
+                  const std::string    patcher_file,
+                  const float          capacity_factor,
+                  const float          patch_alloc_factor,
+                  const float          lp_hashtable_load_factor,
+                  const PatchingMethod patching_method,
+                  const float*         vertices,
+                  const bool           reorder_patch_elements)
+{
+    RXMESH_TRACE_SCOPE("RXMesh::init");
+
     m_topo_memory_mega_bytes   = 0;
     m_capacity_factor          = capacity_factor;
     m_lp_hashtable_load_factor = lp_hashtable_load_factor;
     m_patch_alloc_factor       = patch_alloc_factor;
 
     // Build everything from scratch including patches
-    if (fv.empty()) {
+    if (fv == nullptr || num_faces == 0) {
         RXMESH_ERROR(
             "RXMesh::init input fv is empty. Can not build RXMesh properly");
     }
@@ -80,21 +141,17 @@ void RXMesh::init(const std::vector<std::vector<uint32_t>>& fv,
             "RXMesh::init hashtable load factor should be less than 1");
     }
 
-    m_timers.add("LPHashTable");
-    m_timers.add("ht.insert");
-    m_timers.add("lower_bound");
-    m_timers.add("bitmask");
-    m_timers.add("buildHT");
-    m_timers.add("cudaMalloc");
-    m_timers.add("malloc");
-    m_timers.add("hashtable.move");
-    m_timers.add("cudaMemcpy");
-    m_timers.add("bitmask.cudaMemcpy");
+    add_build_timers();
 
     // 1)
     m_timers.add("build");
     m_timers.start("build");
-    build(fv, patcher_file);
+    build(fv,
+          num_faces,
+          patcher_file,
+          patching_method,
+          vertices,
+          reorder_patch_elements);
     m_timers.stop("build");
 
     // 2)
@@ -117,46 +174,8 @@ void RXMesh::init(const std::vector<std::vector<uint32_t>>& fv,
     m_timers.stop("build_device");
 
 
-    // 5)
-    m_timers.add("PatchScheduler");
-    m_timers.start("PatchScheduler");
-    PatchScheduler sch;
-    sch.init(get_max_num_patches());
-    m_topo_memory_mega_bytes +=
-        BYTES_TO_MEGABYTES(sizeof(uint32_t) * get_max_num_patches());
-    sch.refill(get_num_patches());
-    m_timers.stop("PatchScheduler");
-
-
-    // 6)
-    m_timers.add("allocate_extra_patches");
-    m_timers.start("allocate_extra_patches");
-    // Allocate  extra patches
-    allocate_extra_patches();
-    m_timers.stop("allocate_extra_patches");
-
-    // 7)
-    m_timers.add("context.init");
-    m_timers.start("context.init");
-    // Allocate and copy the context to the gpu
-    m_rxmesh_context.init(m_num_vertices,
-                          m_num_edges,
-                          m_num_faces,
-                          m_max_vertices_per_patch,
-                          m_max_edges_per_patch,
-                          m_max_faces_per_patch,
-                          get_num_patches(),
-                          get_max_num_patches(),
-                          m_capacity_factor,
-                          m_d_vertex_prefix,
-                          m_d_edge_prefix,
-                          m_d_face_prefix,
-                          m_h_vertex_prefix,
-                          m_h_edge_prefix,
-                          m_h_face_prefix,
-                          m_d_patches_info,
-                          sch);
-    m_timers.stop("context.init");
+    // 5), 6), and 7)
+    finalize_init();
 
 
     RXMESH_INFO("#Vertices = {}, #Faces= {}, #Edges= {}, #Patches = {}",
@@ -179,15 +198,39 @@ void RXMesh::init(const std::vector<std::vector<uint32_t>>& fv,
 
     ////
     RXMESH_INFO("1) build time = {} (ms)", m_timers.elapsed_millis("build"));
+    RXMESH_INFO(" -build_supporting_structures time = {} (ms)",
+                m_timers.elapsed_millis("build_supporting_structures"));
+    RXMESH_INFO("   --edge_keys time = {} (ms)",
+                m_timers.elapsed_millis("edge_keys"));
+    RXMESH_INFO("   --edge_sort time = {} (ms)",
+                m_timers.elapsed_millis("edge_sort"));
+    RXMESH_INFO("   --edge_unique time = {} (ms)",
+                m_timers.elapsed_millis("edge_unique"));
+    RXMESH_INFO("   --ev_ef time = {} (ms)", m_timers.elapsed_millis("ev_ef"));
+    RXMESH_INFO("   --ff time = {} (ms)", m_timers.elapsed_millis("ff"));
+    RXMESH_INFO("   --edge_map time = {} (ms)",
+                m_timers.elapsed_millis("edge_map"));
+    RXMESH_INFO(" -patching time = {} (ms)",
+                m_timers.elapsed_millis("patching"));
+    RXMESH_INFO(" -build_ltog time = {} (ms)",
+                m_timers.elapsed_millis("build_ltog"));
+    RXMESH_INFO(" -build_topology time = {} (ms)",
+                m_timers.elapsed_millis("build_topology"));
+    RXMESH_INFO(" -reorder_patch time = {} (ms)",
+                m_timers.elapsed_millis("reorder_patch"));
+    RXMESH_INFO(" -statistics time = {} (ms)",
+                m_timers.elapsed_millis("statistics"));
     RXMESH_INFO("2) populate_patch_stash time = {} (ms)",
                 m_timers.elapsed_millis("populate_patch_stash"));
     RXMESH_INFO("3) patch graph coloring time = {} (ms)",
                 m_timers.elapsed_millis("coloring"));
     RXMESH_INFO("4) build_device time = {} (ms)",
                 m_timers.elapsed_millis("build_device"));
+    // the time of the stages below is summed over all threads since the
+    // patches are built in parallel
     RXMESH_INFO(" -buildHT time = {} (ms)", m_timers.elapsed_millis("buildHT"));
-    RXMESH_INFO("   --lower_bound time = {} (ms)",
-                m_timers.elapsed_millis("lower_bound"));
+    RXMESH_INFO("   --owner_local time = {} (ms)",
+                m_timers.elapsed_millis("owner_local"));
     RXMESH_INFO("   --ht.insert time = {} (ms)",
                 m_timers.elapsed_millis("ht.insert"));
     RXMESH_INFO("   --hashtable.move time = {} (ms)",
@@ -197,6 +240,8 @@ void RXMesh::init(const std::vector<std::vector<uint32_t>>& fv,
     RXMESH_INFO(" -bitmask time = {} (ms)", m_timers.elapsed_millis("bitmask"));
     RXMESH_INFO("   --bitmask.cudaMemcpy time = {} (ms)",
                 m_timers.elapsed_millis("bitmask.cudaMemcpy"));
+    RXMESH_INFO(" -stash_symmetry time = {} (ms)",
+                m_timers.elapsed_millis("stash_symmetry"));
 
     RXMESH_INFO("5) PatchScheduler time = {} (ms)",
                 m_timers.elapsed_millis("PatchScheduler"));
@@ -204,6 +249,8 @@ void RXMesh::init(const std::vector<std::vector<uint32_t>>& fv,
                 m_timers.elapsed_millis("allocate_extra_patches"));
     RXMESH_INFO("7) context.init time = {} (ms)",
                 m_timers.elapsed_millis("context.init"));
+    RXMESH_INFO("8) global_to_local time = {} (ms)",
+                m_timers.elapsed_millis("global_to_local"));
 
     RXMESH_INFO("cudaMemcpy time = {} (ms)",
                 m_timers.elapsed_millis("cudaMemcpy"));
@@ -212,6 +259,487 @@ void RXMesh::init(const std::vector<std::vector<uint32_t>>& fv,
     RXMESH_INFO("malloc time = {} (ms)", m_timers.elapsed_millis("malloc"));
 }
 
+void RXMesh::save_snapshot(const std::string&        file_name,
+                           const std::vector<float>& vertices)
+{
+    detail::SnapshotWriter writer(file_name, m_patch_size);
+
+    // 1) scalars
+    snapshot_scalars(writer);
+
+    // 2) edge map as (v0, v1, edge id) triplets sorted by (v0, v1)
+    const int             num_edges = static_cast<int>(m_edges_map.size());
+    std::vector<uint32_t> edges(3 * m_edges_map.size());
+#pragma omp parallel for
+    for (int e = 0; e < num_edges; ++e) {
+        const EdgeMapT::value_type& entry = m_edges_map.begin()[e];
+
+        edges[3 * e + 0] = entry.first.first;
+        edges[3 * e + 1] = entry.first.second;
+        edges[3 * e + 2] = entry.second;
+    }
+    writer.write_vector(edges);
+
+    // 3) patcher
+    std::ostringstream patcher_stream(std::ios::binary);
+    m_patcher->save(patcher_stream);
+    const std::string patcher_str = patcher_stream.str();
+    writer.write_array(patcher_str.data(), patcher_str.size());
+
+    // 4) number of owned elements, local-to-global maps (as CSR), and prefix
+    // sums
+    writer.write_vector(m_h_num_owned_v);
+    writer.write_vector(m_h_num_owned_e);
+    writer.write_vector(m_h_num_owned_f);
+
+    auto write_ltog = [&](const std::vector<std::vector<uint32_t>>& ltog) {
+        std::vector<uint32_t> offset(ltog.size() + 1, 0);
+        for (size_t p = 0; p < ltog.size(); ++p) {
+            offset[p + 1] = offset[p] + static_cast<uint32_t>(ltog[p].size());
+        }
+        std::vector<uint32_t> values(offset.back());
+#pragma omp parallel for
+        for (int p = 0; p < static_cast<int>(ltog.size()); ++p) {
+            std::copy(
+                ltog[p].begin(), ltog[p].end(), values.begin() + offset[p]);
+        }
+        writer.write_vector(offset);
+        writer.write_vector(values);
+    };
+    write_ltog(m_h_patches_ltog_v);
+    write_ltog(m_h_patches_ltog_e);
+    write_ltog(m_h_patches_ltog_f);
+
+    writer.write_array(m_h_vertex_prefix, get_max_num_patches() + 1);
+    writer.write_array(m_h_edge_prefix, get_max_num_patches() + 1);
+    writer.write_array(m_h_face_prefix, get_max_num_patches() + 1);
+
+    // 5) per-patch data. All patches have the same capacity so every member
+    // is concatenated across all patches into a single array
+    const int num_patches = static_cast<int>(get_num_patches());
+
+    auto write_per_patch = [&](auto get_ptr, const size_t count) {
+        using T = std::remove_cv_t<
+            std::remove_pointer_t<decltype(get_ptr(m_h_patches_info[0]))>>;
+        std::vector<T> buffer(count * num_patches);
+#pragma omp parallel for
+        for (int p = 0; p < num_patches; ++p) {
+            const T* src = get_ptr(m_h_patches_info[p]);
+            std::copy(src, src + count, buffer.begin() + count * p);
+        }
+        writer.write_vector(buffer);
+    };
+
+    snapshot_per_patch(write_per_patch);
+
+    // 6) vertex coordinates
+    writer.write_vector(vertices);
+
+    if (!writer.is_ok()) {
+        RXMESH_ERROR("RXMesh::save_snapshot() failed to write {}", file_name);
+    }
+}
+
+void RXMesh::save_patch_store(const std::string& file_name) const
+{
+    PatchStoreWriter writer(file_name, get_num_patches());
+    if (!writer.is_ok()) {
+        return;
+    }
+
+    const int num_patches = static_cast<int>(get_num_patches());
+
+    // the owner of every element is resolved through the patch hashtable
+    auto fill = [&](const uint32_t               p,
+                    auto                         handle,
+                    const uint16_t               num_elements,
+                    const std::vector<uint32_t>& ltog,
+                    std::vector<uint32_t>&       rec_ltog,
+                    std::vector<uint32_t>&       owner,
+                    std::vector<uint16_t>&       owner_local) {
+        using HandleT = decltype(handle);
+        using LocalT  = typename HandleT::LocalT;
+        for (uint16_t l = 0; l < num_elements; ++l) {
+            rec_ltog[l] = (l < ltog.size()) ? ltog[l] : INVALID32;
+            if (m_h_patches_info[p].is_deleted(LocalT(l))) {
+                owner[l]       = INVALID32;
+                owner_local[l] = INVALID16;
+                continue;
+            }
+            const HandleT oh = m_rxmesh_context.get_owner_handle(
+                HandleT(p, LocalT(l)), m_h_patches_info);
+            owner[l]       = oh.patch_id();
+            owner_local[l] = oh.local_id();
+        }
+    };
+
+#pragma omp parallel for schedule(dynamic)
+    for (int p = 0; p < num_patches; ++p) {
+        const PatchInfo& pi = m_h_patches_info[p];
+
+        PatchRecord rec;
+        rec.patch_id = p;
+        rec.resize(pi.num_vertices[0], pi.num_edges[0], pi.num_faces[0]);
+
+        for (uint8_t i = 0; i < PatchStash::stash_size; ++i) {
+            const uint32_t q = pi.patch_stash.get_patch(i);
+            if (q != INVALID32) {
+                rec.stash.push_back(q);
+            }
+        }
+
+        for (size_t i = 0; i < rec.ev.size(); ++i) {
+            rec.ev[i] = pi.ev[i].id;
+        }
+        for (size_t i = 0; i < rec.fe.size(); ++i) {
+            rec.fe[i] = pi.fe[i].id;
+        }
+
+        fill(p,
+             VertexHandle(),
+             rec.num_vertices,
+             m_h_patches_ltog_v[p],
+             rec.ltog_v,
+             rec.owner_v,
+             rec.owner_local_v);
+        fill(p,
+             EdgeHandle(),
+             rec.num_edges,
+             m_h_patches_ltog_e[p],
+             rec.ltog_e,
+             rec.owner_e,
+             rec.owner_local_e);
+        fill(p,
+             FaceHandle(),
+             rec.num_faces,
+             m_h_patches_ltog_f[p],
+             rec.ltog_f,
+             rec.owner_f,
+             rec.owner_local_f);
+
+        writer.add_patch(rec);
+    }
+
+    writer.finalize(m_num_vertices, m_num_edges, m_num_faces);
+
+    if (!writer.is_ok()) {
+        RXMESH_ERROR("RXMesh::save_patch_store() failed to write {}",
+                     file_name);
+    }
+}
+
+void RXMesh::init(const SnapshotFile&     snapshot,
+                  detail::SnapshotReader& reader,
+                  std::vector<float>&     vertices)
+{
+    RXMESH_TRACE_SCOPE("RXMesh::init");
+
+    m_topo_memory_mega_bytes = 0;
+
+    add_build_timers();
+    m_timers.add("load_snapshot");
+    m_timers.add("build_device");
+
+    m_timers.start("load_snapshot");
+
+    auto check = [&]() {
+        if (!reader.is_ok()) {
+            RXMESH_ERROR("RXMesh::init() could not load the snapshot {}",
+                         snapshot.file_name);
+            exit(EXIT_FAILURE);
+        }
+    };
+    check();
+
+    // 1) scalars
+    snapshot_scalars(reader);
+    check();
+
+    // 2) edge map
+    size_t          num_edges_3 = 0;
+    const uint32_t* edges       = reader.read_array<uint32_t>(num_edges_3);
+    check();
+    const int num_edges = static_cast<int>(num_edges_3 / 3);
+
+    std::vector<EdgeMapT::value_type> edge_map_entries(num_edges);
+#pragma omp parallel for
+    for (int e = 0; e < num_edges; ++e) {
+        edge_map_entries[e] = std::make_pair(
+            std::make_pair(edges[3 * e + 0], edges[3 * e + 1]),
+            edges[3 * e + 2]);
+    }
+    m_edges_map.assign(std::move(edge_map_entries));
+
+    // 3) patcher
+    size_t      patcher_size = 0;
+    const char* patcher_data = reader.read_array<char>(patcher_size);
+    check();
+    {
+        detail::MemoryStreamBuf patcher_buf(patcher_data, patcher_size);
+        std::istream            patcher_stream(&patcher_buf);
+        m_patcher = std::make_unique<patcher::Patcher>(patcher_stream);
+    }
+
+    if (m_host_affinity) {
+        build_host_affinity();
+    }
+
+    // 4) number of owned elements, local-to-global maps, and prefix sums
+    reader.read_vector(m_h_num_owned_v);
+    reader.read_vector(m_h_num_owned_e);
+    reader.read_vector(m_h_num_owned_f);
+    check();
+
+    auto read_ltog = [&](std::vector<std::vector<uint32_t>>& ltog) {
+        std::vector<uint32_t> offset;
+        reader.read_vector(offset);
+        size_t          num_values = 0;
+        const uint32_t* values     = reader.read_array<uint32_t>(num_values);
+        check();
+        if (offset.size() != get_num_patches() + 1 ||
+            offset.back() != num_values) {
+            RXMESH_ERROR("RXMesh::init() invalid snapshot {}",
+                         snapshot.file_name);
+            exit(EXIT_FAILURE);
+        }
+        ltog.resize(get_num_patches());
+        for_each_patch_host([&](uint32_t p) {
+            ltog[p].assign(values + offset[p], values + offset[p + 1]);
+        });
+    };
+    read_ltog(m_h_patches_ltog_v);
+    read_ltog(m_h_patches_ltog_e);
+    read_ltog(m_h_patches_ltog_f);
+
+    const uint32_t patches_1_bytes =
+        (get_max_num_patches() + 1) * sizeof(uint32_t);
+
+    m_h_vertex_prefix = (uint32_t*)malloc(patches_1_bytes);
+    m_h_edge_prefix   = (uint32_t*)malloc(patches_1_bytes);
+    m_h_face_prefix   = (uint32_t*)malloc(patches_1_bytes);
+    reader.read_into(m_h_vertex_prefix, get_max_num_patches() + 1);
+    reader.read_into(m_h_edge_prefix, get_max_num_patches() + 1);
+    reader.read_into(m_h_face_prefix, get_max_num_patches() + 1);
+    check();
+
+    if (m_h_num_owned_v.size() != get_max_num_patches() ||
+        m_h_num_owned_e.size() != get_max_num_patches() ||
+        m_h_num_owned_f.size() != get_max_num_patches() ||
+        m_patcher->get_num_patches() != get_num_patches()) {
+        RXMESH_ERROR("RXMesh::init() invalid snapshot {}", snapshot.file_name);
+        exit(EXIT_FAILURE);
+    }
+
+    // 5) per-patch data. We first allocate the host patches the same way
+    // build() and build_device() do and then fill them from the snapshot
+    const int num_patches = static_cast<int>(get_num_patches());
+
+    m_h_patches_info =
+        (PatchInfo*)malloc(get_max_num_patches() * sizeof(PatchInfo));
+
+    const uint16_t lp_cap_v = max_lp_hashtable_capacity<LocalVertexT>();
+    const uint16_t lp_cap_e = max_lp_hashtable_capacity<LocalEdgeT>();
+    const uint16_t lp_cap_f = max_lp_hashtable_capacity<LocalFaceT>();
+
+    // allocated (and first touched) by the thread that owns the patch
+    for_each_patch_host([&](uint32_t p) {
+        PatchInfo& h_patch_info = m_h_patches_info[p];
+
+        const uint16_t v_cap = get_per_patch_max_vertex_capacity();
+        const uint16_t e_cap = get_per_patch_max_edge_capacity();
+        const uint16_t f_cap = get_per_patch_max_face_capacity();
+
+        uint16_t* h_counts = (uint16_t*)malloc(3 * sizeof(uint16_t));
+
+        h_counts[0] = static_cast<uint16_t>(m_h_patches_ltog_f[p].size());
+        h_counts[1] = static_cast<uint16_t>(m_h_patches_ltog_e[p].size());
+        h_counts[2] = static_cast<uint16_t>(m_h_patches_ltog_v[p].size());
+
+        h_patch_info.num_faces    = h_counts;
+        h_patch_info.num_edges    = h_counts + 1;
+        h_patch_info.num_vertices = h_counts + 2;
+
+        h_patch_info.vertices_capacity = v_cap;
+        h_patch_info.edges_capacity    = e_cap;
+        h_patch_info.faces_capacity    = f_cap;
+        h_patch_info.patch_id          = p;
+        h_patch_info.dirty             = (int*)malloc(sizeof(int));
+        h_patch_info.dirty[0]          = 0;
+        h_patch_info.child_id          = INVALID32;
+        h_patch_info.should_slice      = false;
+
+        h_patch_info.ev =
+            (LocalVertexT*)malloc(e_cap * 2 * sizeof(LocalVertexT));
+        h_patch_info.fe = (LocalEdgeT*)malloc(f_cap * 3 * sizeof(LocalEdgeT));
+
+        h_patch_info.active_mask_v =
+            (uint32_t*)malloc(detail::mask_num_bytes(v_cap));
+        h_patch_info.active_mask_e =
+            (uint32_t*)malloc(detail::mask_num_bytes(e_cap));
+        h_patch_info.active_mask_f =
+            (uint32_t*)malloc(detail::mask_num_bytes(f_cap));
+        h_patch_info.owned_mask_v =
+            (uint32_t*)malloc(detail::mask_num_bytes(v_cap));
+        h_patch_info.owned_mask_e =
+            (uint32_t*)malloc(detail::mask_num_bytes(e_cap));
+        h_patch_info.owned_mask_f =
+            (uint32_t*)malloc(detail::mask_num_bytes(f_cap));
+
+        h_patch_info.patch_stash = PatchStash(false);
+
+        h_patch_info.lp_v = LPHashTable(lp_cap_v, false);
+        h_patch_info.lp_e = LPHashTable(lp_cap_e, false);
+        h_patch_info.lp_f = LPHashTable(lp_cap_f, false);
+    });
+
+    for (int p = num_patches; p < static_cast<int>(get_max_num_patches());
+         ++p) {
+        m_h_patches_info[p].patch_stash = PatchStash(false);
+    }
+
+    auto read_per_patch = [&](auto get_ptr, const size_t count) {
+        using T = std::remove_cv_t<
+            std::remove_pointer_t<decltype(get_ptr(m_h_patches_info[0]))>>;
+        size_t   num = 0;
+        const T* src = reader.read_array<T>(num);
+        check();
+        if (num != count * num_patches) {
+            RXMESH_ERROR(
+                "RXMesh::init() invalid snapshot {}. The per-patch data does "
+                "not match the patches capacity",
+                snapshot.file_name);
+            exit(EXIT_FAILURE);
+        }
+        for_each_patch_host([&](uint32_t p) {
+            std::copy(src + count * p,
+                      src + count * (p + 1),
+                      get_ptr(m_h_patches_info[p]));
+        });
+    };
+
+    snapshot_per_patch(read_per_patch);
+
+    // 6) vertex coordinates
+    reader.read_vector(vertices);
+    check();
+    if (!vertices.empty() && vertices.size() != 3 * size_t(m_num_vertices)) {
+        RXMESH_ERROR(
+            "RXMesh::init() invalid snapshot {}. The number of vertex "
+            "coordinates does not match the number of vertices",
+            snapshot.file_name);
+        exit(EXIT_FAILURE);
+    }
+    m_timers.stop("load_snapshot");
+
+    // copy the patches to the device
+    m_timers.start("build_device");
+    build_device_prefix();
+
+    m_timers.start("cudaMalloc");
+    CUDA_ERROR(cudaMalloc((void**)&m_d_patches_info,
+                          get_max_num_patches() * sizeof(PatchInfo)));
+    m_timers.stop("cudaMalloc");
+
+    m_topo_memory_mega_bytes +=
+        BYTES_TO_MEGABYTES(get_max_num_patches() * sizeof(PatchInfo));
+
+    for (int p = 0; p < num_patches; ++p) {
+        upload_device_single_patch(m_h_patches_info[p], m_d_patches_info[p]);
+    }
+    m_timers.stop("build_device");
+
+    finalize_init();
+
+    RXMESH_INFO("#Vertices = {}, #Faces= {}, #Edges= {}, #Patches = {}",
+                m_num_vertices,
+                m_num_faces,
+                m_num_edges,
+                m_num_patches);
+    RXMESH_INFO("load_snapshot time = {} (ms)",
+                m_timers.elapsed_millis("load_snapshot"));
+    RXMESH_INFO("build_device time = {} (ms)",
+                m_timers.elapsed_millis("build_device"));
+    RXMESH_INFO("allocate_extra_patches time = {} (ms)",
+                m_timers.elapsed_millis("allocate_extra_patches"));
+}
+
+void RXMesh::add_build_timers()
+{
+    m_timers.add("LPHashTable");
+    m_timers.add("ht.insert");
+    m_timers.add("owner_local");
+    m_timers.add("bitmask");
+    m_timers.add("buildHT");
+    m_timers.add("cudaMalloc");
+    m_timers.add("malloc");
+    m_timers.add("hashtable.move");
+    m_timers.add("cudaMemcpy");
+    m_timers.add("bitmask.cudaMemcpy");
+    m_timers.add("build_supporting_structures");
+    m_timers.add("edge_keys");
+    m_timers.add("edge_sort");
+    m_timers.add("edge_unique");
+    m_timers.add("ev_ef");
+    m_timers.add("ff");
+    m_timers.add("edge_map");
+    m_timers.add("reorder_patch");
+    m_timers.add("patching");
+    m_timers.add("build_ltog");
+    m_timers.add("build_topology");
+    m_timers.add("statistics");
+    m_timers.add("stash_symmetry");
+}
+
+void RXMesh::finalize_init()
+{
+    // 5)
+    m_timers.add("PatchScheduler");
+    m_timers.start("PatchScheduler");
+    PatchScheduler sch;
+    sch.init(get_max_num_patches());
+    m_topo_memory_mega_bytes +=
+        BYTES_TO_MEGABYTES(sizeof(uint32_t) * get_max_num_patches());
+    sch.refill(get_num_patches());
+    m_timers.stop("PatchScheduler");
+
+
+    // 6)
+    m_timers.add("allocate_extra_patches");
+    m_timers.start("allocate_extra_patches");
+    // Allocate  extra patches
+    allocate_extra_patches();
+    m_timers.stop("allocate_extra_patches");
+
+    // 7)
+    m_timers.add("context.init");
+    m_timers.start("context.init");
+    // Allocate and copy the context to the gpu
+    m_rxmesh_context.init(m_num_vertices,
+                          m_num_edges,
+                          m_num_faces,
+                          m_max_vertices_per_patch,
+                          m_max_edges_per_patch,
+                          m_max_faces_per_patch,
+                          get_num_patches(),
+                          get_max_num_patches(),
+                          m_capacity_factor,
+                          m_d_vertex_prefix,
+                          m_d_edge_prefix,
+                          m_d_face_prefix,
+                          m_h_vertex_prefix,
+                          m_h_edge_prefix,
+                          m_h_face_prefix,
+                          m_d_patches_info,
+                          sch);
+    m_timers.stop("context.init");
+
+    // 8)
+    m_timers.add("global_to_local");
+    m_timers.start("global_to_local");
+    build_global_to_local();
+    m_timers.stop("global_to_local");
+}
+
 RXMesh::~RXMesh()
 {
     m_rxmesh_context.m_patch_scheduler.free();
@@ -271,20 +799,29 @@ RXMesh::~RXMesh()
     free(m_h_face_prefix);
 }
 
-void RXMesh::build(const std::vector<std::vector<uint32_t>>& fv,
-                   const std::string                         patcher_file)
+void RXMesh::build(const uint32_t*      fv,
+                   const uint32_t       num_faces,
+                   const std::string    patcher_file,
+                   const PatchingMethod patching_method,
+                   const float*         vertices,
+                   const bool           reorder_patch_elements)
 {
-    std::vector<uint32_t>              ff_values;
-    std::vector<uint32_t>              ff_offset;
-    std::vector<std::vector<uint32_t>> ef;
-    std::vector<std::vector<uint32_t>> ev;
+    std::vector<uint32_t> ff_values;
+    std::vector<uint32_t> ff_offset;
+    std::vector<uint32_t> ef_values;
+    std::vector<uint32_t> ef_offset;
+    std::vector<uint32_t> ev;
 
     m_max_capacity_lp_v = 0;
     m_max_capacity_lp_e = 0;
     m_max_capacity_lp_f = 0;
 
-    build_supporting_structures(fv, ev, ef, ff_offset, ff_values);
+    m_timers.start("build_supporting_structures");
+    build_supporting_structures(
+        fv, num_faces, ev, ef_offset, ef_values, ff_offset, ff_values);
+    m_timers.stop("build_supporting_structures");
 
+    m_timers.start("patching");
     if (!patcher_file.empty()) {
         if (!std::filesystem::exists(patcher_file)) {
             RXMESH_ERROR(
@@ -295,10 +832,12 @@ void RXMesh::build(const std::vector<std::vector<uint32_t>>& fv,
                                                            ff_offset,
                                                            ff_values,
                                                            fv,
+                                                           m_num_faces,
                                                            m_edges_map,
                                                            m_num_vertices,
                                                            m_num_edges,
-                                                           false);
+                                                           patching_method,
+                                                           vertices);
         } else {
             m_patcher = std::make_unique<patcher::Patcher>(patcher_file);
         }
@@ -307,11 +846,14 @@ void RXMesh::build(const std::vector<std::vector<uint32_t>>& fv,
                                                        ff_offset,
                                                        ff_values,
                                                        fv,
+                                                       m_num_faces,
                                                        m_edges_map,
                                                        m_num_vertices,
                                                        m_num_edges,
-                                                       false);
+                                                       patching_method,
+                                                       vertices);
     }
+    m_timers.stop("patching");
 
 
     m_num_patches     = m_patcher->get_num_patches();
@@ -327,11 +869,15 @@ void RXMesh::build(const std::vector<std::vector<uint32_t>>& fv,
     m_h_num_owned_v.resize(get_max_num_patches(), 0);
     m_h_num_owned_e.resize(get_max_num_patches(), 0);
 
-#pragma omp parallel for
-    for (int p = 0; p < static_cast<int>(get_num_patches()); ++p) {
-        build_single_patch_ltog(fv, ev, p);
+    if (m_host_affinity) {
+        build_host_affinity();
     }
 
+    m_timers.start("build_ltog");
+    for_each_patch_host(
+        [&](uint32_t p) { build_single_patch_ltog(fv, ev, p); });
+    m_timers.stop("build_ltog");
+
     // calc max elements for use in build_device (which populates
     // m_h_patches_info and thus we can not use calc_max_elements now)
     m_max_vertices_per_patch = 0;
@@ -358,9 +904,15 @@ void RXMesh::build(const std::vector<std::vector<uint32_t>>& fv,
     m_max_face_capacity = static_cast<uint16_t>(std::ceil(
         m_capacity_factor * static_cast<float>(m_max_faces_per_patch)));
 
-#pragma omp parallel for
-    for (int p = 0; p < static_cast<int>(get_num_patches()); ++p) {
-        build_single_patch_topology(fv, p);
+    m_timers.start("build_topology");
+    for_each_patch_host(
+        [&](uint32_t p) { build_single_patch_topology(fv, p); });
+    m_timers.stop("build_topology");
+
+    if (reorder_patch_elements) {
+        m_timers.start("reorder_patch");
+        for_each_patch_host([&](uint32_t p) { reorder_single_patch(p); });
+        m_timers.stop("reorder_patch");
     }
 
     const uint32_t patches_1_bytes =
@@ -370,9 +922,9 @@ void RXMesh::build(const std::vector<std::vector<uint32_t>>& fv,
     m_h_edge_prefix   = (uint32_t*)malloc(patches_1_bytes);
     m_h_face_prefix   = (uint32_t*)malloc(patches_1_bytes);
 
-    memset(m_h_vertex_prefix, 0, patches_1_bytes);
-    memset(m_h_edge_prefix, 0, patches_1_bytes);
-    memset(m_h_face_prefix, 0, patches_1_bytes);
+    std::memset(m_h_vertex_prefix, 0, patches_1_bytes);
+    std::memset(m_h_edge_prefix, 0, patches_1_bytes);
+    std::memset(m_h_face_prefix, 0, patches_1_bytes);
 
     for (uint32_t p = 0; p < get_num_patches(); ++p) {
         m_h_vertex_prefix[p + 1] = m_h_vertex_prefix[p] + m_h_num_owned_v[p];
@@ -410,6 +962,18 @@ void RXMesh::build(const std::vector<std::vector<uint32_t>>& fv,
                           m_lp_hashtable_load_factor)));
     }
 
+    build_device_prefix();
+
+    m_timers.start("statistics");
+    calc_input_statistics(ev, ef_offset, ff_offset);
+    m_timers.stop("statistics");
+}
+
+void RXMesh::build_device_prefix()
+{
+    const uint32_t patches_1_bytes =
+        (get_max_num_patches() + 1) * sizeof(uint32_t);
+
     m_timers.start("cudaMalloc");
     CUDA_ERROR(cudaMalloc((void**)&m_d_vertex_prefix, patches_1_bytes));
     // m_topo_memory_mega_bytes += BYTES_TO_MEGABYTES(patches_1_bytes);
@@ -432,72 +996,215 @@ void RXMesh::build(const std::vector<std::vector<uint32_t>>& fv,
                           m_h_face_prefix,
                           patches_1_bytes,
                           cudaMemcpyHostToDevice));
-
-    calc_input_statistics(fv, ef);
 }
 
-void RXMesh::build_supporting_structures(
-    const std::vector<std::vector<uint32_t>>& fv,
-    std::vector<std::vector<uint32_t>>&       ev,
-    std::vector<std::vector<uint32_t>>&       ef,
-    std::vector<uint32_t>&                    ff_offset,
-    std::vector<uint32_t>&                    ff_values)
+void RXMesh::build_supporting_structures(const uint32_t*        fv,
+                                         const uint32_t         num_faces_in,
+                                         std::vector<uint32_t>& ev,
+                                         std::vector<uint32_t>& ef_offset,
+                                         std::vector<uint32_t>& ef_values,
+                                         std::vector<uint32_t>& ff_offset,
+                                         std::vector<uint32_t>& ff_values)
 {
-    m_num_faces    = static_cast<uint32_t>(fv.size());
+    m_num_faces    = num_faces_in;
     m_num_vertices = 0;
     m_num_edges    = 0;
     m_edges_map.clear();
 
-    // assuming manifold mesh i.e., #E = 1.5#F
-    ef.clear();
-    uint32_t reserve_size =
-        static_cast<size_t>(1.5f * static_cast<float>(m_num_faces));
-    ef.reserve(reserve_size);
-    m_edges_map.reserve(reserve_size);
-    ev.reserve(2 * reserve_size);
+    const int    num_faces      = static_cast<int>(m_num_faces);
+    const size_t num_half_edges = 3 * static_cast<size_t>(m_num_faces);
+
+    // 1) find the number of vertices and generate a key for every half-edge
+    // such that the two half-edges of the same edge get the same key. The key
+    // packs the edge_key (max, min) in as few bits as possible to reduce the
+    // number of sorting passes
+    m_timers.start("edge_keys");
+    uint32_t max_vertex = 0;
+#pragma omp parallel for reduction(max : max_vertex)
+    for (int64_t i = 0; i < int64_t(num_half_edges); ++i) {
+        max_vertex = std::max(max_vertex, fv[i]);
+    }
 
-    std::vector<uint32_t> ff_size(m_num_faces, 0);
+    m_num_vertices = max_vertex + 1;
 
-    for (uint32_t f = 0; f < fv.size(); ++f) {
-        if (fv[f].size() != 3) {
-            RXMESH_ERROR(
-                "rxmesh::build_supporting_structures() Face {} is not "
-                "triangle. Non-triangular faces are not supported",
-                f);
-            exit(EXIT_FAILURE);
+    int vertex_bits = 1;
+    while ((uint64_t(1) << vertex_bits) < uint64_t(m_num_vertices)) {
+        ++vertex_bits;
+    }
+
+    // half-edge h = 3*f + v goes from fv[3*f + v] to fv[3*f + (v+1)%3]
+    std::vector<uint64_t> he_key(num_half_edges);
+    std::vector<uint32_t> he_id(num_half_edges);
+
+#pragma omp parallel for
+    for (int f = 0; f < num_faces; ++f) {
+        for (uint32_t v = 0; v < 3; ++v) {
+            const uint32_t h = 3 * f + v;
+
+            std::pair<uint32_t, uint32_t> edge =
+                detail::edge_key(fv[h], fv[3 * f + (v + 1) % 3]);
+
+            he_key[h] = (uint64_t(edge.first) << vertex_bits) | edge.second;
+            he_id[h]  = h;
         }
+    }
+    m_timers.stop("edge_keys");
+
+    // 2) sort the half-edges by their key. The sort is stable so half-edges
+    // of the same edge are sorted by their id i.e., by their face id
+    m_timers.start("edge_sort");
+    detail::host_radix_sort_pairs(he_key, he_id, 2 * vertex_bits);
+    m_timers.stop("edge_sort");
+
+    // 3) unique: every segment of equal keys is an edge. We assign edge ids in
+    // the order in which the edges are first encountered in fv (i.e., by the
+    // smallest half-edge in the segment) which gives the same edge ids as
+    // the sequential construction (and so previously saved patch files)
+    m_timers.start("edge_unique");
+    const int num_he = static_cast<int>(num_half_edges);
+
+    auto is_seg_head = [&](const int i) {
+        return i == 0 || he_key[i] != he_key[i - 1];
+    };
 
-        for (uint32_t v = 0; v < fv[f].size(); ++v) {
-            uint32_t v0 = fv[f][v];
-            uint32_t v1 = fv[f][(v + 1) % 3];
+    std::vector<uint32_t> seg_id(num_half_edges);
+#pragma omp parallel for
+    for (int i = 0; i < num_he; ++i) {
+        seg_id[i] = is_seg_head(i) ? 1 : 0;
+    }
+    m_num_edges =
+        detail::host_exclusive_scan(seg_id.data(), seg_id.data(), num_he);
 
-            m_num_vertices = std::max(m_num_vertices, v0);
+    std::vector<uint32_t> seg_start(m_num_edges + 1);
+#pragma omp parallel for
+    for (int i = 0; i < num_he; ++i) {
+        if (is_seg_head(i)) {
+            seg_start[seg_id[i]] = i;
+        }
+    }
+    seg_start[m_num_edges] = num_he;
+    seg_id.clear();
+    seg_id.shrink_to_fit();
 
-            std::pair<uint32_t, uint32_t> edge   = detail::edge_key(v0, v1);
-            auto                          e_iter = m_edges_map.find(edge);
-            if (e_iter == m_edges_map.end()) {
-                uint32_t edge_id = m_num_edges++;
-                m_edges_map.insert(std::make_pair(edge, edge_id));
+    const int num_edges = static_cast<int>(m_num_edges);
 
-                std::vector<uint32_t> evv = {v0, v1};
-                ev.push_back(evv);
+    // mark the first half-edge of every edge and scan the marks in the
+    // half-edge order to get the edge id
+    std::vector<uint32_t> he_edge(num_half_edges, 0);
+#pragma omp parallel for
+    for (int s = 0; s < num_edges; ++s) {
+        he_edge[he_id[seg_start[s]]] = 1;
+    }
+    detail::host_exclusive_scan(he_edge.data(), he_edge.data(), num_he);
 
-                std::vector<uint32_t> tmp(1, f);
-                ef.push_back(tmp);
-            } else {
-                uint32_t edge_id = (*e_iter).second;
+    std::vector<uint32_t> seg_edge(m_num_edges);
+#pragma omp parallel for
+    for (int s = 0; s < num_edges; ++s) {
+        seg_edge[s] = he_edge[he_id[seg_start[s]]];
+    }
+
+    // for every half-edge, store its edge id and its position among the
+    // half-edges of this edge
+    std::vector<uint32_t> he_pos(num_half_edges);
+#pragma omp parallel for
+    for (int s = 0; s < num_edges; ++s) {
+        for (uint32_t i = seg_start[s]; i < seg_start[s + 1]; ++i) {
+            he_edge[he_id[i]] = seg_edge[s];
+            he_pos[he_id[i]]  = i - seg_start[s];
+        }
+    }
+    m_timers.stop("edge_unique");
+
+    // 4) EV and EF. EV is taken from the first half-edge of the edge and faces
+    // incident to an edge are sorted
+    m_timers.start("ev_ef");
+    ev.resize(2 * m_num_edges);
+    ef_offset.resize(m_num_edges + 1);
+    ef_values.resize(num_half_edges);
+
+#pragma omp parallel for
+    for (int s = 0; s < num_edges; ++s) {
+        const uint32_t e = seg_edge[s];
+        const uint32_t h = he_id[seg_start[s]];
+        const uint32_t f = h / 3;
+        const uint32_t v = h % 3;
+
+        ev[2 * e + 0] = fv[h];
+        ev[2 * e + 1] = fv[3 * f + (v + 1) % 3];
+        ef_offset[e]  = seg_start[s + 1] - seg_start[s];
+    }
+    ef_offset[m_num_edges] = 0;
+    detail::host_exclusive_scan(
+        ef_offset.data(), ef_offset.data(), ef_offset.size());
+
+#pragma omp parallel for
+    for (int s = 0; s < num_edges; ++s) {
+        const uint32_t offset = ef_offset[seg_edge[s]];
+        for (uint32_t i = seg_start[s]; i < seg_start[s + 1]; ++i) {
+            ef_values[offset + i - seg_start[s]] = he_id[i] / 3;
+        }
+    }
+    m_timers.stop("ev_ef");
+
+    // 5) FF. A face is adjacent to all other faces incident to its three
+    // edges. The faces are ordered by the edge id and then by the order in EF
+    m_timers.start("ff");
+    ff_offset.resize(m_num_faces + 1);
+
+#pragma omp parallel for
+    for (int f = 0; f < num_faces; ++f) {
+        uint32_t ff_size = 0;
+        for (uint32_t v = 0; v < 3; ++v) {
+            const uint32_t e = he_edge[3 * f + v];
+            ff_size += ef_offset[e + 1] - ef_offset[e] - 1;
+        }
+        ff_offset[f] = ff_size;
+    }
+    ff_offset[m_num_faces] = 0;
+    detail::host_exclusive_scan(
+        ff_offset.data(), ff_offset.data(), ff_offset.size());
+
+    ff_values.clear();
+    ff_values.resize(ff_offset.back());
 
-                for (uint32_t f0 = 0; f0 < ef[edge_id].size(); ++f0) {
-                    uint32_t other_face = ef[edge_id][f0];
-                    ++ff_size[other_face];
+#pragma omp parallel for
+    for (int f = 0; f < num_faces; ++f) {
+        const uint32_t h0    = 3 * static_cast<uint32_t>(f);
+        uint32_t       he[3] = {h0, h0 + 1, h0 + 2};
+        std::sort(he, he + 3, [&](uint32_t a, uint32_t b) {
+            return std::make_pair(he_edge[a], he_pos[a]) <
+                   std::make_pair(he_edge[b], he_pos[b]);
+        });
+
+        uint32_t offset = ff_offset[f];
+        for (uint32_t v = 0; v < 3; ++v) {
+            const uint32_t e = he_edge[he[v]];
+            for (uint32_t i = ef_offset[e]; i < ef_offset[e + 1]; ++i) {
+                if (i - ef_offset[e] != he_pos[he[v]]) {
+                    ff_values[offset++] = ef_values[i];
                 }
-                ff_size[f] += ef[edge_id].size();
-
-                ef[edge_id].push_back(f);
             }
         }
+        assert(offset == ff_offset[f + 1]);
+    }
+    m_timers.stop("ff");
+
+    // 6) the edge map. The segments are already sorted by the key
+    m_timers.start("edge_map");
+    const uint64_t vertex_mask = (uint64_t(1) << vertex_bits) - 1;
+
+    std::vector<EdgeMapT::value_type> edge_map_entries(m_num_edges);
+#pragma omp parallel for
+    for (int s = 0; s < num_edges; ++s) {
+        const uint64_t key = he_key[seg_start[s]];
+
+        edge_map_entries[s] = std::make_pair(
+            std::make_pair(uint32_t(key >> vertex_bits),
+                           uint32_t(key & vertex_mask)),
+            seg_edge[s]);
     }
-    ++m_num_vertices;
+    m_edges_map.assign(std::move(edge_map_entries));
+    m_timers.stop("edge_map");
 
     if (m_num_edges != static_cast<uint32_t>(m_edges_map.size())) {
         RXMESH_ERROR(
@@ -507,84 +1214,62 @@ void RXMesh::build_supporting_structures(
             m_edges_map.size());
         exit(EXIT_FAILURE);
     }
-
-    ff_offset.resize(m_num_faces + 1);
-    std::exclusive_scan(ff_size.begin(), ff_size.end(), ff_offset.begin(), 0);
-    ff_offset[m_num_faces] =
-        ff_offset[m_num_faces - 1] + ff_size[m_num_faces - 1];
-    ff_values.clear();
-    ff_values.resize(ff_offset.back());
-    std::fill(ff_size.begin(), ff_size.end(), 0);
-
-    for (uint32_t e = 0; e < m_num_edges; ++e) {
-        for (uint32_t i = 0; i < ef[e].size(); ++i) {
-            uint32_t f0 = ef[e][i];
-            for (uint32_t j = i + 1; j < ef[e].size(); ++j) {
-                uint32_t f1 = ef[e][j];
-
-                uint32_t f0_offset = ff_size[f0]++;
-                uint32_t f1_offset = ff_size[f1]++;
-                f0_offset += ff_offset[f0];
-                f1_offset += ff_offset[f1];
-
-                ff_values[f0_offset] = f1;
-                ff_values[f1_offset] = f0;
-            }
-        }
-    }
 }
 
-void RXMesh::calc_input_statistics(const std::vector<std::vector<uint32_t>>& fv,
-                                   const std::vector<std::vector<uint32_t>>& ef)
+void RXMesh::calc_input_statistics(const std::vector<uint32_t>& ev,
+                                   const std::vector<uint32_t>& ef_offset,
+                                   const std::vector<uint32_t>& ff_offset)
 {
     if (m_num_vertices == 0 || m_num_faces == 0 || m_num_edges == 0 ||
-        fv.size() == 0 || ef.size() == 0) {
+        ev.size() == 0 || ef_offset.size() == 0 || ff_offset.size() == 0) {
         RXMESH_ERROR(
             "RXMesh::calc_statistics() input mesh has not been initialized");
         exit(EXIT_FAILURE);
     }
 
     // calc max valence, max ef, is input closed, and is input manifold
-    m_input_max_edge_incident_faces = 0;
-    m_input_max_valence             = 0;
-    std::vector<uint32_t> vv_count(m_num_vertices, 0);
-    m_is_input_closed        = true;
-    m_is_input_edge_manifold = true;
-    for (const auto& e_iter : m_edges_map) {
-        uint32_t v0 = e_iter.first.first;
-        uint32_t v1 = e_iter.first.second;
+    const int num_edges    = static_cast<int>(m_num_edges);
+    const int num_faces    = static_cast<int>(m_num_faces);
+    const int num_vertices = static_cast<int>(m_num_vertices);
 
-        vv_count[v0]++;
-        vv_count[v1]++;
-
-        m_input_max_valence = std::max(m_input_max_valence, vv_count[v0]);
-        m_input_max_valence = std::max(m_input_max_valence, vv_count[v1]);
+    std::vector<uint32_t> vv_count(m_num_vertices, 0);
 
-        uint32_t edge_id                = e_iter.second;
-        m_input_max_edge_incident_faces = std::max(
-            m_input_max_edge_incident_faces, uint32_t(ef[edge_id].size()));
+    uint32_t max_ef   = 0;
+    bool     closed   = true;
+    bool     manifold = true;
+#pragma omp parallel for reduction(max : max_ef) \
+    reduction(&& : closed, manifold)
+    for (int e = 0; e < num_edges; ++e) {
+#pragma omp atomic
+        vv_count[ev[2 * e + 0]]++;
+#pragma omp atomic
+        vv_count[ev[2 * e + 1]]++;
+
+        const uint32_t ef_size = ef_offset[e + 1] - ef_offset[e];
+
+        max_ef   = std::max(max_ef, ef_size);
+        closed   = closed && (ef_size >= 2);
+        manifold = manifold && (ef_size <= 2);
+    }
 
-        if (ef[edge_id].size() < 2) {
-            m_is_input_closed = false;
-        }
-        if (ef[edge_id].size() > 2) {
-            m_is_input_edge_manifold = false;
-        }
+    uint32_t max_valence = 0;
+#pragma omp parallel for reduction(max : max_valence)
+    for (int v = 0; v < num_vertices; ++v) {
+        max_valence = std::max(max_valence, vv_count[v]);
     }
 
     // calc max ff
-    m_input_max_face_adjacent_faces = 0;
-    for (uint32_t f = 0; f < fv.size(); ++f) {
-        uint32_t ff_count = 0;
-        for (uint32_t v = 0; v < fv[f].size(); ++v) {
-            uint32_t v0       = fv[f][v];
-            uint32_t v1       = fv[f][(v + 1) % 3];
-            uint32_t edge_num = get_edge_id(v0, v1);
-            ff_count += ef[edge_num].size() - 1;
-        }
-        m_input_max_face_adjacent_faces =
-            std::max(ff_count, m_input_max_face_adjacent_faces);
+    uint32_t max_ff = 0;
+#pragma omp parallel for reduction(max : max_ff)
+    for (int f = 0; f < num_faces; ++f) {
+        max_ff = std::max(max_ff, ff_offset[f + 1] - ff_offset[f]);
     }
+
+    m_input_max_valence             = max_valence;
+    m_input_max_edge_incident_faces = max_ef;
+    m_input_max_face_adjacent_faces = max_ff;
+    m_is_input_closed               = closed;
+    m_is_input_edge_manifold        = manifold;
 }
 
 void RXMesh::calc_max_elements()
@@ -605,10 +1290,21 @@ void RXMesh::calc_max_elements()
     }
 }
 
-void RXMesh::build_single_patch_ltog(
-    const std::vector<std::vector<uint32_t>>& fv,
-    const std::vector<std::vector<uint32_t>>& ev,
-    const uint32_t                            patch_id)
+void RXMesh::build_host_affinity()
+{
+    const uint32_t*              offset = m_patcher->get_patches_offset();
+    const std::vector<uint32_t>& ribbon = m_patcher->get_external_ribbon_offset();
+
+    m_h_affinity = detail::HostAffinity(get_num_patches(), [&](uint32_t p) {
+        const uint32_t p_start = (p == 0) ? 0 : offset[p - 1];
+        const uint32_t r_start = (p == 0) ? 0 : ribbon[p - 1];
+        return (offset[p] - p_start) + (ribbon[p] - r_start);
+    });
+}
+
+void RXMesh::build_single_patch_ltog(const uint32_t*              fv,
+                                     const std::vector<uint32_t>& ev,
+                                     const uint32_t               patch_id)
 {
     // patch start and end
     const uint32_t p_start =
@@ -636,8 +1332,8 @@ void RXMesh::build_single_patch_ltog(
         m_h_patches_ltog_f[patch_id][local_face_id] = global_face_id;
 
         for (uint32_t v = 0; v < 3; ++v) {
-            uint32_t v0 = fv[global_face_id][v];
-            uint32_t v1 = fv[global_face_id][(v + 1) % 3];
+            uint32_t v0 = fv[3 * global_face_id + v];
+            uint32_t v1 = fv[3 * global_face_id + (v + 1) % 3];
 
             uint32_t edge_id = get_edge_id(v0, v1);
 
@@ -673,7 +1369,7 @@ void RXMesh::build_single_patch_ltog(
         if (m_patcher->get_edge_patch_id(e) == patch_id && !is_edge_added[e]) {
             m_h_patches_ltog_e[patch_id].push_back(e);
             for (uint32_t i = 0; i < 2; ++i) {
-                uint32_t v = ev[e][i];
+                uint32_t v = ev[2 * e + i];
                 if (!is_vertex_added[v]) {
                     m_h_patches_ltog_v[patch_id].push_back(v);
                 }
@@ -717,9 +1413,8 @@ void RXMesh::build_single_patch_ltog(
         m_h_patches_ltog_v[patch_id], m_patcher->get_vertex_patch());
 }
 
-void RXMesh::build_single_patch_topology(
-    const std::vector<std::vector<uint32_t>>& fv,
-    const uint32_t                            patch_id)
+void RXMesh::build_single_patch_topology(const uint32_t* fv,
+                                         const uint32_t  patch_id)
 {
     // patch start and end
     const uint32_t p_start =
@@ -776,8 +1471,8 @@ void RXMesh::build_single_patch_topology(
         for (uint32_t v = 0; v < 3; ++v) {
 
 
-            const uint32_t global_v0 = fv[global_face_id][v];
-            const uint32_t global_v1 = fv[global_face_id][(v + 1) % 3];
+            const uint32_t global_v0 = fv[3 * global_face_id + v];
+            const uint32_t global_v1 = fv[3 * global_face_id + (v + 1) % 3];
 
             std::pair<uint32_t, uint32_t> edge_key =
                 detail::edge_key(global_v0, global_v1);
@@ -844,57 +1539,247 @@ void RXMesh::build_single_patch_topology(
     }
 }
 
+void RXMesh::reorder_single_patch(const uint32_t patch_id)
+{
+    std::vector<uint32_t>& ltog_v = m_h_patches_ltog_v[patch_id];
+    std::vector<uint32_t>& ltog_e = m_h_patches_ltog_e[patch_id];
+    std::vector<uint32_t>& ltog_f = m_h_patches_ltog_f[patch_id];
+
+    const uint16_t num_v = static_cast<uint16_t>(ltog_v.size());
+    const uint16_t num_e = static_cast<uint16_t>(ltog_e.size());
+    const uint16_t num_f = static_cast<uint16_t>(ltog_f.size());
+
+    const uint16_t num_owned_v = m_h_num_owned_v[patch_id];
+    const uint16_t num_owned_e = m_h_num_owned_e[patch_id];
+    const uint16_t num_owned_f = m_h_num_owned_f[patch_id];
+
+    LocalVertexT* ev = m_h_patches_info[patch_id].ev;
+    LocalEdgeT*   fe = m_h_patches_info[patch_id].fe;
+
+    // edge-to-face adjacency inside the patch (in CSR) so we can move from a
+    // face to its neighbor faces
+    std::vector<uint32_t> ef_offset(num_e + 1, 0);
+    std::vector<uint16_t> ef_value(3 * size_t(num_f));
+    for (uint16_t f = 0; f < num_f; ++f) {
+        for (uint16_t i = 0; i < 3; ++i) {
+            ef_offset[(fe[3 * f + i].id >> 1) + 1]++;
+        }
+    }
+    for (uint16_t e = 0; e < num_e; ++e) {
+        ef_offset[e + 1] += ef_offset[e];
+    }
+    {
+        std::vector<uint32_t> pos(ef_offset.begin(), ef_offset.end() - 1);
+        for (uint16_t f = 0; f < num_f; ++f) {
+            for (uint16_t i = 0; i < 3; ++i) {
+                ef_value[pos[fe[3 * f + i].id >> 1]++] = f;
+            }
+        }
+    }
+
+    // the new order is given as a list of old local indices. Owned elements
+    // are stable-partitioned to the front since the ownership is encoded as
+    // the prefix [0, num_owned) of the local index space
+    auto owned_first = [](std::vector<uint16_t>& order,
+                          const uint16_t         num_owned) {
+        std::stable_partition(
+            order.begin(), order.end(), [num_owned](uint16_t i) {
+                return i < num_owned;
+            });
+    };
+
+    // 1) faces in BFS order. The traversal restarts from the first unvisited
+    // face in case the patch (with its ribbon) is not connected
+    std::vector<uint16_t> f_order;
+    f_order.reserve(num_f);
+    std::vector<bool> f_visited(num_f, false);
+    for (uint16_t s = 0; s < num_f; ++s) {
+        if (f_visited[s]) {
+            continue;
+        }
+        f_visited[s] = true;
+        size_t front = f_order.size();
+        f_order.push_back(s);
+        while (front < f_order.size()) {
+            const uint16_t f = f_order[front++];
+            for (uint16_t i = 0; i < 3; ++i) {
+                const uint16_t e = fe[3 * f + i].id >> 1;
+                for (uint32_t j = ef_offset[e]; j < ef_offset[e + 1]; ++j) {
+                    const uint16_t n = ef_value[j];
+                    if (!f_visited[n]) {
+                        f_visited[n] = true;
+                        f_order.push_back(n);
+                    }
+                }
+            }
+        }
+    }
+    owned_first(f_order, num_owned_f);
+
+    // 2) edges in order of their first appearance in the new face order
+    std::vector<uint16_t> e_order;
+    e_order.reserve(num_e);
+    std::vector<bool> e_visited(num_e, false);
+    for (const uint16_t f : f_order) {
+        for (uint16_t i = 0; i < 3; ++i) {
+            const uint16_t e = fe[3 * f + i].id >> 1;
+            if (!e_visited[e]) {
+                e_visited[e] = true;
+                e_order.push_back(e);
+            }
+        }
+    }
+    for (uint16_t e = 0; e < num_e; ++e) {
+        if (!e_visited[e]) {
+            e_order.push_back(e);
+        }
+    }
+    owned_first(e_order, num_owned_e);
+
+    // 3) vertices in order of their first appearance in the new edge order.
+    // EV is only populated for edges incident to the patch faces
+    std::vector<uint16_t> v_order;
+    v_order.reserve(num_v);
+    std::vector<bool> v_visited(num_v, false);
+    for (const uint16_t e : e_order) {
+        if (!e_visited[e]) {
+            continue;
+        }
+        for (uint16_t i = 0; i < 2; ++i) {
+            const uint16_t v = ev[2 * e + i].id;
+            if (!v_visited[v]) {
+                v_visited[v] = true;
+                v_order.push_back(v);
+            }
+        }
+    }
+    for (uint16_t v = 0; v < num_v; ++v) {
+        if (!v_visited[v]) {
+            v_order.push_back(v);
+        }
+    }
+    owned_first(v_order, num_owned_v);
+
+    // old to new maps
+    auto inverse = [](const std::vector<uint16_t>& order) {
+        std::vector<uint16_t> map(order.size());
+        for (uint16_t i = 0; i < order.size(); ++i) {
+            map[order[i]] = i;
+        }
+        return map;
+    };
+    const std::vector<uint16_t> e_map = inverse(e_order);
+    const std::vector<uint16_t> v_map = inverse(v_order);
+
+    // apply the new order on ltog, FE (both the rows and the edge ids while
+    // keeping the direction bit), and EV
+    auto permute_ltog = [](std::vector<uint32_t>&       ltog,
+                           const std::vector<uint16_t>& order) {
+        std::vector<uint32_t> new_ltog(ltog.size());
+        for (uint16_t i = 0; i < order.size(); ++i) {
+            new_ltog[i] = ltog[order[i]];
+        }
+        ltog.swap(new_ltog);
+    };
+    permute_ltog(ltog_f, f_order);
+    permute_ltog(ltog_e, e_order);
+    permute_ltog(ltog_v, v_order);
+
+    std::vector<uint16_t> new_fe(3 * size_t(num_f));
+    for (uint16_t f = 0; f < num_f; ++f) {
+        for (uint16_t i = 0; i < 3; ++i) {
+            const uint16_t id = fe[3 * f_order[f] + i].id;
+            new_fe[3 * f + i] = (e_map[id >> 1] << 1) | (id & 1);
+        }
+    }
+    for (size_t i = 0; i < new_fe.size(); ++i) {
+        fe[i].id = new_fe[i];
+    }
+
+    std::vector<uint16_t> new_ev(2 * size_t(num_e), INVALID16);
+    for (uint16_t e = 0; e < num_e; ++e) {
+        if (!e_visited[e_order[e]]) {
+            continue;
+        }
+        for (uint16_t i = 0; i < 2; ++i) {
+            new_ev[2 * e + i] = v_map[ev[2 * e_order[e] + i].id];
+        }
+    }
+    for (size_t i = 0; i < new_ev.size(); ++i) {
+        ev[i].id = new_ev[i];
+    }
+}
+
 const VertexHandle RXMesh::map_to_local_vertex(uint32_t i) const
 {
-    auto pl = map_to_local<VertexHandle>(i, m_h_vertex_prefix);
-    return {pl.first, pl.second};
+    if (i >= m_h_vertex_g2l.size()) {
+        RXMESH_ERROR(
+            "RXMesh::map_to_local_vertex() input {} is out of range ({})!",
+            i,
+            m_h_vertex_g2l.size());
+        return VertexHandle();
+    }
+    return m_h_vertex_g2l[i];
 }
 
 const EdgeHandle RXMesh::map_to_local_edge(uint32_t i) const
 {
-    auto pl = map_to_local<EdgeHandle>(i, m_h_edge_prefix);
-    return {pl.first, pl.second};
+    if (i >= m_h_edge_g2l.size()) {
+        RXMESH_ERROR(
+            "RXMesh::map_to_local_edge() input {} is out of range ({})!",
+            i,
+            m_h_edge_g2l.size());
+        return EdgeHandle();
+    }
+    return m_h_edge_g2l[i];
 }
 
 const FaceHandle RXMesh::map_to_local_face(uint32_t i) const
 {
-    auto pl = map_to_local<FaceHandle>(i, m_h_face_prefix);
-    return {pl.first, pl.second};
+    if (i >= m_h_face_g2l.size()) {
+        RXMESH_ERROR(
+            "RXMesh::map_to_local_face() input {} is out of range ({})!",
+            i,
+            m_h_face_g2l.size());
+        return FaceHandle();
+    }
+    return m_h_face_g2l[i];
 }
 
+void RXMesh::build_global_to_local()
+{
+    build_global_to_local(m_h_vertex_g2l, m_h_vertex_prefix);
+    build_global_to_local(m_h_edge_g2l, m_h_edge_prefix);
+    build_global_to_local(m_h_face_g2l, m_h_face_prefix);
+}
 
 template <typename HandleT>
-const std::pair<uint32_t, uint16_t> RXMesh::map_to_local(
-    const uint32_t  i,
-    const uint32_t* element_prefix) const
+void RXMesh::build_global_to_local(std::vector<HandleT>& g2l,
+                                   const uint32_t*       element_prefix)
 {
-    const auto end = element_prefix + get_num_patches() + 1;
+    using LocalT = typename HandleT::LocalT;
 
-    auto p = std::lower_bound(
-        element_prefix, end, i, [](int a, int b) { return a <= b; });
-    if (p == end) {
-        RXMESH_ERROR(
-            "RXMeshStatic::map_to_local can not its patch. Input is out of "
-            "range!");
-    }
-    p -= 1;
-    uint32_t patch_id = std::distance(element_prefix, p);
-    uint32_t prefix   = i - *p;
-    uint16_t local_id = 0;
-    uint16_t num_elements =
-        *(m_h_patches_info[patch_id].template get_num_elements<HandleT>());
-    for (uint16_t l = 0; l < num_elements; ++l) {
-        if (m_h_patches_info[patch_id].is_owned(typename HandleT::LocalT(l)) &&
-            !m_h_patches_info[patch_id].is_deleted(
-                typename HandleT::LocalT(l))) {
-            if (local_id == prefix) {
-                local_id = l;
-                break;
+    const int num_patches = static_cast<int>(get_num_patches());
+
+    g2l.resize(element_prefix[num_patches]);
+
+    // every patch writes to its own range of the table
+#pragma omp parallel for schedule(dynamic)
+    for (int p = 0; p < num_patches; ++p) {
+        const PatchInfo& pi = m_h_patches_info[p];
+
+        const uint16_t num_elements =
+            *(pi.template get_num_elements<HandleT>());
+
+        uint32_t g = element_prefix[p];
+
+        for (uint16_t l = 0; l < num_elements; ++l) {
+            if (pi.is_owned(LocalT(l)) && !pi.is_deleted(LocalT(l))) {
+                assert(g < element_prefix[p + 1]);
+                g2l[g++] = HandleT(static_cast<uint32_t>(p), LocalT(l));
             }
-            local_id++;
         }
     }
-    return {patch_id, local_id};
 }
 
 
@@ -960,7 +1845,8 @@ void RXMesh::populate_patch_stash()
         }
     };
 
-    // #pragma omp parallel for
+    // every patch only writes to its own stash
+#pragma omp parallel for
     for (int p = 0; p < static_cast<int>(get_num_patches()); ++p) {
         m_h_patches_info[p].patch_stash = PatchStash(false);
 
@@ -978,7 +1864,7 @@ void RXMesh::populate_patch_stash()
                              m_h_num_owned_f[p]);
     }
 
-    // #pragma omp parallel for
+#pragma omp parallel for
     for (int p = get_num_patches(); p < static_cast<int>(get_max_num_patches());
          ++p) {
         m_h_patches_info[p].patch_stash = PatchStash(false);
@@ -987,6 +1873,8 @@ void RXMesh::populate_patch_stash()
 
 void RXMesh::build_device()
 {
+    RXMESH_TRACE_SCOPE("RXMesh::build_device");
+
     m_timers.start("cudaMalloc");
     CUDA_ERROR(cudaMalloc((void**)&m_d_patches_info,
                           get_max_num_patches() * sizeof(PatchInfo)));
@@ -995,10 +1883,31 @@ void RXMesh::build_device()
     m_topo_memory_mega_bytes +=
         BYTES_TO_MEGABYTES(get_max_num_patches() * sizeof(PatchInfo));
 
-
-    // #pragma omp parallel for
-    for (int p = 0; p < static_cast<int>(get_num_patches()); ++p) {
-
+    // the local index of every element in its owner patch. The ltog maps are
+    // not necessarily sorted (e.g., after reorder_single_patch) so we can not
+    // use binary search on them to find the owner local index
+    m_timers.start("owner_local");
+    auto owner_local = [&](std::vector<uint16_t>&       table,
+                           const uint32_t               size,
+                           const auto&                  ltog,
+                           const std::vector<uint16_t>& num_owned) {
+        table.assign(size, INVALID16);
+#pragma omp parallel for
+        for (int p = 0; p < static_cast<int>(get_num_patches()); ++p) {
+            for (uint16_t i = 0; i < num_owned[p]; ++i) {
+                table[ltog[p][i]] = i;
+            }
+        }
+    };
+    owner_local(
+        m_h_owner_local_v, m_num_vertices, m_h_patches_ltog_v, m_h_num_owned_v);
+    owner_local(
+        m_h_owner_local_e, m_num_edges, m_h_patches_ltog_e, m_h_num_owned_e);
+    owner_local(
+        m_h_owner_local_f, m_num_faces, m_h_patches_ltog_f, m_h_num_owned_f);
+    m_timers.stop("owner_local");
+
+    for_each_patch_host([&](uint32_t p) {
         const uint16_t p_num_vertices =
             static_cast<uint16_t>(m_h_patches_ltog_v[p].size());
         const uint16_t p_num_edges =
@@ -1021,28 +1930,62 @@ void RXMesh::build_device()
                                   m_h_patches_ltog_f[p],
                                   m_h_patches_info[p],
                                   m_d_patches_info[p]);
-    }
+    });
 
+    m_h_owner_local_v.clear();
+    m_h_owner_local_v.shrink_to_fit();
+    m_h_owner_local_e.clear();
+    m_h_owner_local_e.shrink_to_fit();
+    m_h_owner_local_f.clear();
+    m_h_owner_local_f.shrink_to_fit();
 
     // make sure that if a patch stash of patch p has patch q, then q's patch
-    // stash should have p in it
-    for (uint32_t p = 0; p < get_num_patches(); ++p) {
+    // stash should have p in it. First, every patch p collects the (q, p)
+    // pairs where q is missing p. Then, every q inserts its missing patches
+    // in increasing order of p (i.e., the same order as a serial pass over p)
+    m_timers.start("stash_symmetry");
+    const int num_patches = static_cast<int>(get_num_patches());
+
+    std::vector<std::vector<uint32_t>> missing(num_patches);
+#pragma omp parallel for
+    for (int p = 0; p < num_patches; ++p) {
         for (uint8_t p_sh = 0; p_sh < PatchStash::stash_size; ++p_sh) {
-            uint32_t q = m_h_patches_info[p].patch_stash.get_patch(p_sh);
-            if (q != INVALID32) {
-                bool found = false;
-                for (uint8_t q_sh = 0; q_sh < PatchStash::stash_size; ++q_sh) {
-                    if (m_h_patches_info[q].patch_stash.get_patch(q_sh) == p) {
-                        found = true;
-                        break;
-                    }
-                }
-                if (!found) {
-                    m_h_patches_info[q].patch_stash.insert_patch(p);
-                }
+            const uint32_t q = m_h_patches_info[p].patch_stash.get_patch(p_sh);
+            if (q != INVALID32 &&
+                m_h_patches_info[q].patch_stash.find_patch_index(p) ==
+                    INVALID8) {
+                missing[p].push_back(q);
+            }
+        }
+    }
+
+    std::vector<uint32_t> missing_offset(num_patches + 1, 0);
+    for (int p = 0; p < num_patches; ++p) {
+        for (const uint32_t q : missing[p]) {
+            missing_offset[q + 1]++;
+        }
+    }
+    for (int q = 0; q < num_patches; ++q) {
+        missing_offset[q + 1] += missing_offset[q];
+    }
+    std::vector<uint32_t> missing_value(missing_offset.back());
+    {
+        std::vector<uint32_t> pos(missing_offset.begin(),
+                                  missing_offset.end() - 1);
+        for (int p = 0; p < num_patches; ++p) {
+            for (const uint32_t q : missing[p]) {
+                missing_value[pos[q]++] = p;
             }
         }
     }
+
+#pragma omp parallel for
+    for (int q = 0; q < num_patches; ++q) {
+        for (uint32_t i = missing_offset[q]; i < missing_offset[q + 1]; ++i) {
+            m_h_patches_info[q].patch_stash.insert_patch(missing_value[i]);
+        }
+    }
+    m_timers.stop("stash_symmetry");
 }
 
 void RXMesh::build_device_single_patch(const uint32_t patch_id,
@@ -1061,7 +2004,9 @@ void RXMesh::build_device_single_patch(const uint32_t patch_id,
                                        PatchInfo& h_patch_info,
                                        PatchInfo& d_patch_info)
 {
-
+    // accumulated locally and added to m_topo_memory_mega_bytes at the end
+    // since patches are built in parallel
+    double topo_memory_mega_bytes = 0;
 
     m_timers.start("malloc");
     uint16_t* h_counts = (uint16_t*)malloc(3 * sizeof(uint16_t));
@@ -1090,7 +2035,7 @@ void RXMesh::build_device_single_patch(const uint32_t patch_id,
     m_timers.stop("cudaMalloc");
 
 
-    m_topo_memory_mega_bytes += BYTES_TO_MEGABYTES(3 * sizeof(uint16_t));
+    topo_memory_mega_bytes += BYTES_TO_MEGABYTES(3 * sizeof(uint16_t));
 
     PatchInfo d_patch;
     d_patch.num_faces         = d_counts;
@@ -1106,7 +2051,7 @@ void RXMesh::build_device_single_patch(const uint32_t patch_id,
     d_patch.child_id     = INVALID32;
     d_patch.should_slice = false;
 
-    m_topo_memory_mega_bytes +=
+    topo_memory_mega_bytes +=
         BYTES_TO_MEGABYTES(PatchStash::stash_size * sizeof(uint32_t));
 
     // copy count and capacities
@@ -1134,7 +2079,7 @@ void RXMesh::build_device_single_patch(const uint32_t patch_id,
     m_timers.stop("cudaMalloc");
 
 
-    m_topo_memory_mega_bytes +=
+    topo_memory_mega_bytes +=
         BYTES_TO_MEGABYTES(p_edges_capacity * 2 * sizeof(LocalVertexT));
     h_patch_info.ev = (LocalVertexT*)realloc(
         h_patch_info.ev, p_edges_capacity * 2 * sizeof(LocalVertexT));
@@ -1154,7 +2099,7 @@ void RXMesh::build_device_single_patch(const uint32_t patch_id,
     m_timers.stop("cudaMalloc");
 
 
-    m_topo_memory_mega_bytes +=
+    topo_memory_mega_bytes +=
         BYTES_TO_MEGABYTES(p_faces_capacity * 3 * sizeof(LocalEdgeT));
     h_patch_info.fe = (LocalEdgeT*)realloc(
         h_patch_info.fe, p_faces_capacity * 3 * sizeof(LocalEdgeT));
@@ -1173,7 +2118,7 @@ void RXMesh::build_device_single_patch(const uint32_t patch_id,
     m_timers.stop("cudaMalloc");
 
 
-    m_topo_memory_mega_bytes += BYTES_TO_MEGABYTES(sizeof(int));
+    topo_memory_mega_bytes += BYTES_TO_MEGABYTES(sizeof(int));
     CUDA_ERROR(cudaMemset(d_patch.dirty, 0, sizeof(int)));
 
 
@@ -1195,7 +2140,7 @@ void RXMesh::build_device_single_patch(const uint32_t patch_id,
         m_timers.stop("cudaMalloc");
 
 
-        m_topo_memory_mega_bytes += BYTES_TO_MEGABYTES(num_bytes);
+        topo_memory_mega_bytes += BYTES_TO_MEGABYTES(num_bytes);
 
         for (uint16_t i = 0; i < capacity; ++i) {
             if (predicate(i)) {
@@ -1263,16 +2208,15 @@ void RXMesh::build_device_single_patch(const uint32_t patch_id,
 
 
     // build LPHashtable
-    auto build_ht = [&](const std::vector<std::vector<uint32_t>>& ltog,
-                        const std::vector<uint32_t>&              p_ltog,
-                        const std::vector<uint32_t>&              element_patch,
-                        const std::vector<uint16_t>&              num_owned,
-                        const uint16_t                            num_elements,
-                        const uint16_t num_owned_elements,
-                        const uint16_t cap,
-                        PatchStash&    stash,
-                        LPHashTable&   h_hashtable,
-                        LPHashTable&   d_hashtable) {
+    auto build_ht = [&](const std::vector<uint16_t>& owner_local,
+                        const std::vector<uint32_t>& p_ltog,
+                        const std::vector<uint32_t>& element_patch,
+                        const uint16_t               num_elements,
+                        const uint16_t               num_owned_elements,
+                        const uint16_t               cap,
+                        PatchStash&                  stash,
+                        LPHashTable&                 h_hashtable,
+                        LPHashTable&                 d_hashtable) {
         m_timers.start("buildHT");
 
         const uint16_t num_not_owned = num_elements - num_owned_elements;
@@ -1282,23 +2226,22 @@ void RXMesh::build_device_single_patch(const uint32_t patch_id,
         d_hashtable = LPHashTable(cap, true);
         m_timers.stop("LPHashTable");
 
-        m_topo_memory_mega_bytes += BYTES_TO_MEGABYTES(d_hashtable.num_bytes());
-        m_topo_memory_mega_bytes +=
+        topo_memory_mega_bytes += BYTES_TO_MEGABYTES(d_hashtable.num_bytes());
+        topo_memory_mega_bytes +=
             BYTES_TO_MEGABYTES(LPHashTable::stash_size * sizeof(LPPair));
 
+        // timed once for all the not-owned elements of the patch since
+        // patches are built in parallel and every start()/stop() takes the
+        // Timers lock
+        m_timers.start("ht.insert");
         for (uint16_t i = 0; i < num_not_owned; ++i) {
             uint16_t local_id    = i + num_owned_elements;
             uint32_t global_id   = p_ltog[local_id];
             uint32_t owner_patch = element_patch[global_id];
 
-            m_timers.start("lower_bound");
-            auto it = std::lower_bound(
-                ltog[owner_patch].begin(),
-                ltog[owner_patch].begin() + num_owned[owner_patch],
-                global_id);
-            m_timers.stop("lower_bound");
+            const uint16_t local_id_in_owner_patch = owner_local[global_id];
 
-            if (it == ltog[owner_patch].begin() + num_owned[owner_patch]) {
+            if (local_id_in_owner_patch == INVALID16) {
                 RXMESH_ERROR(
                     "rxmesh::build_device can not find the local id of "
                     "{} in patch {}. Maybe this patch does not own "
@@ -1306,12 +2249,8 @@ void RXMesh::build_device_single_patch(const uint32_t patch_id,
                     global_id,
                     owner_patch);
             } else {
-                uint16_t local_id_in_owner_patch =
-                    static_cast<uint16_t>(it - ltog[owner_patch].begin());
-
                 uint8_t owner_st = stash.find_patch_index(owner_patch);
 
-                m_timers.start("ht.insert");
                 LPPair pair(local_id, local_id_in_owner_patch, owner_st);
                 if (!h_hashtable.insert(pair, nullptr, nullptr)) {
                     RXMESH_ERROR(
@@ -1320,9 +2259,9 @@ void RXMesh::build_device_single_patch(const uint32_t patch_id,
                         "factor used = {}",
                         m_lp_hashtable_load_factor);
                 }
-                m_timers.stop("ht.insert");
             }
         }
+        m_timers.stop("ht.insert");
 
         m_timers.start("hashtable.move");
         d_hashtable.move(h_hashtable);
@@ -1332,10 +2271,9 @@ void RXMesh::build_device_single_patch(const uint32_t patch_id,
     };
 
     const uint16_t lp_cap_v = max_lp_hashtable_capacity<LocalVertexT>();
-    build_ht(m_h_patches_ltog_v,
+    build_ht(m_h_owner_local_v,
              ltog_v,
              m_patcher->get_vertex_patch(),
-             m_h_num_owned_v,
              p_num_vertices,
              p_num_owned_vertices,
              lp_cap_v,
@@ -1344,10 +2282,9 @@ void RXMesh::build_device_single_patch(const uint32_t patch_id,
              d_patch.lp_v);
 
     const uint16_t lp_cap_e = max_lp_hashtable_capacity<LocalEdgeT>();
-    build_ht(m_h_patches_ltog_e,
+    build_ht(m_h_owner_local_e,
              ltog_e,
              m_patcher->get_edge_patch(),
-             m_h_num_owned_e,
              p_num_edges,
              p_num_owned_edges,
              lp_cap_e,
@@ -1356,10 +2293,9 @@ void RXMesh::build_device_single_patch(const uint32_t patch_id,
              d_patch.lp_e);
 
     const uint16_t lp_cap_f = max_lp_hashtable_capacity<LocalFaceT>();
-    build_ht(m_h_patches_ltog_f,
+    build_ht(m_h_owner_local_f,
              ltog_f,
              m_patcher->get_face_patch(),
-             m_h_num_owned_f,
              p_num_faces,
              p_num_owned_faces,
              lp_cap_f,
@@ -1371,6 +2307,166 @@ void RXMesh::build_device_single_patch(const uint32_t patch_id,
     CUDA_ERROR(cudaMemcpy(
         &d_patch_info, &d_patch, sizeof(PatchInfo), cudaMemcpyHostToDevice));
     m_timers.stop("cudaMemcpy");
+
+#pragma omp atomic
+    m_topo_memory_mega_bytes += topo_memory_mega_bytes;
+}
+
+void RXMesh::upload_device_single_patch(PatchInfo& h_patch_info,
+                                        PatchInfo& d_patch_info)
+{
+    const uint16_t p_num_vertices      = h_patch_info.num_vertices[0];
+    const uint16_t p_num_edges         = h_patch_info.num_edges[0];
+    const uint16_t p_num_faces         = h_patch_info.num_faces[0];
+    const uint16_t p_vertices_capacity = h_patch_info.vertices_capacity;
+    const uint16_t p_edges_capacity    = h_patch_info.edges_capacity;
+    const uint16_t p_faces_capacity    = h_patch_info.faces_capacity;
+
+    uint16_t* d_counts;
+
+    m_timers.start("cudaMalloc");
+    CUDA_ERROR(cudaMalloc((void**)&d_counts, 6 * sizeof(uint16_t)));
+    m_timers.stop("cudaMalloc");
+
+    m_topo_memory_mega_bytes += BYTES_TO_MEGABYTES(3 * sizeof(uint16_t));
+
+    PatchInfo d_patch;
+    d_patch.num_faces         = d_counts;
+    d_patch.num_edges         = d_counts + 1;
+    d_patch.num_vertices      = d_counts + 2;
+    d_patch.vertices_capacity = p_vertices_capacity;
+    d_patch.edges_capacity    = p_edges_capacity;
+    d_patch.faces_capacity    = p_faces_capacity;
+    d_patch.patch_id          = h_patch_info.patch_id;
+    d_patch.color             = h_patch_info.color;
+    d_patch.patch_stash       = PatchStash(true);
+    d_patch.lock.init();
+    d_patch.child_id     = INVALID32;
+    d_patch.should_slice = false;
+
+    m_topo_memory_mega_bytes +=
+        BYTES_TO_MEGABYTES(PatchStash::stash_size * sizeof(uint32_t));
+
+    // the three counts are contiguous on the host and device
+    m_timers.start("cudaMemcpy");
+    CUDA_ERROR(cudaMemcpy(d_patch.num_faces,
+                          h_patch_info.num_faces,
+                          3 * sizeof(uint16_t),
+                          cudaMemcpyHostToDevice));
+    m_timers.stop("cudaMemcpy");
+
+    // topology
+    m_timers.start("cudaMalloc");
+    CUDA_ERROR(cudaMalloc((void**)&d_patch.ev,
+                          p_edges_capacity * 2 * sizeof(LocalVertexT)));
+    CUDA_ERROR(cudaMalloc((void**)&d_patch.fe,
+                          p_faces_capacity * 3 * sizeof(LocalEdgeT)));
+    CUDA_ERROR(cudaMalloc((void**)&d_patch.dirty, sizeof(int)));
+    m_timers.stop("cudaMalloc");
+
+    m_topo_memory_mega_bytes +=
+        BYTES_TO_MEGABYTES(p_edges_capacity * 2 * sizeof(LocalVertexT));
+    m_topo_memory_mega_bytes +=
+        BYTES_TO_MEGABYTES(p_faces_capacity * 3 * sizeof(LocalEdgeT));
+    m_topo_memory_mega_bytes += BYTES_TO_MEGABYTES(sizeof(int));
+
+    m_timers.start("cudaMemcpy");
+    if (p_num_edges > 0) {
+        CUDA_ERROR(cudaMemcpy(d_patch.ev,
+                              h_patch_info.ev,
+                              p_num_edges * 2 * sizeof(LocalVertexT),
+                              cudaMemcpyHostToDevice));
+    }
+    if (p_num_faces > 0) {
+        CUDA_ERROR(cudaMemcpy(d_patch.fe,
+                              h_patch_info.fe,
+                              p_num_faces * 3 * sizeof(LocalEdgeT),
+                              cudaMemcpyHostToDevice));
+    }
+    CUDA_ERROR(cudaMemset(d_patch.dirty, 0, sizeof(int)));
+    m_timers.stop("cudaMemcpy");
+
+    // bitmasks
+    auto bitmask = [&](uint32_t*&       d_mask,
+                       const uint32_t* h_mask,
+                       const uint32_t  capacity) {
+        m_timers.start("bitmask");
+
+        size_t num_bytes = detail::mask_num_bytes(capacity);
+
+        m_timers.start("cudaMalloc");
+        CUDA_ERROR(cudaMalloc((void**)&d_mask, num_bytes));
+        m_timers.stop("cudaMalloc");
+
+        m_topo_memory_mega_bytes += BYTES_TO_MEGABYTES(num_bytes);
+
+        m_timers.start("bitmask.cudaMemcpy");
+        CUDA_ERROR(
+            cudaMemcpy(d_mask, h_mask, num_bytes, cudaMemcpyHostToDevice));
+        m_timers.stop("bitmask.cudaMemcpy");
+
+        m_timers.stop("bitmask");
+    };
+
+    bitmask(d_patch.active_mask_v,
+            h_patch_info.active_mask_v,
+            p_vertices_capacity);
+    bitmask(
+        d_patch.active_mask_e, h_patch_info.active_mask_e, p_edges_capacity);
+    bitmask(
+        d_patch.active_mask_f, h_patch_info.active_mask_f, p_faces_capacity);
+    bitmask(
+        d_patch.owned_mask_v, h_patch_info.owned_mask_v, p_vertices_capacity);
+    bitmask(
+        d_patch.owned_mask_e, h_patch_info.owned_mask_e, p_edges_capacity);
+    bitmask(
+        d_patch.owned_mask_f, h_patch_info.owned_mask_f, p_faces_capacity);
+
+    // PatchStash
+    m_timers.start("cudaMemcpy");
+    CUDA_ERROR(cudaMemcpy(d_patch.patch_stash.m_stash,
+                          h_patch_info.patch_stash.m_stash,
+                          PatchStash::stash_size * sizeof(uint32_t),
+                          cudaMemcpyHostToDevice));
+    m_timers.stop("cudaMemcpy");
+
+    // LPHashtable: allocate with the same capacity used when the hashtable was
+    // built and copy the hash functions and the content as they are
+    auto upload_ht = [&](const uint16_t     cap,
+                         const LPHashTable& h_hashtable,
+                         LPHashTable&       d_hashtable) {
+        m_timers.start("LPHashTable");
+        d_hashtable = LPHashTable(cap, true);
+        m_timers.stop("LPHashTable");
+
+        m_topo_memory_mega_bytes += BYTES_TO_MEGABYTES(d_hashtable.num_bytes());
+        m_topo_memory_mega_bytes +=
+            BYTES_TO_MEGABYTES(LPHashTable::stash_size * sizeof(LPPair));
+
+        d_hashtable.m_hasher0 = h_hashtable.m_hasher0;
+        d_hashtable.m_hasher1 = h_hashtable.m_hasher1;
+        d_hashtable.m_hasher2 = h_hashtable.m_hasher2;
+        d_hashtable.m_hasher3 = h_hashtable.m_hasher3;
+
+        m_timers.start("hashtable.move");
+        d_hashtable.move(h_hashtable);
+        m_timers.stop("hashtable.move");
+    };
+
+    upload_ht(max_lp_hashtable_capacity<LocalVertexT>(),
+              h_patch_info.lp_v,
+              d_patch.lp_v);
+    upload_ht(max_lp_hashtable_capacity<LocalEdgeT>(),
+              h_patch_info.lp_e,
+              d_patch.lp_e);
+    upload_ht(max_lp_hashtable_capacity<LocalFaceT>(),
+              h_patch_info.lp_f,
+              d_patch.lp_f);
+
+    m_timers.start("cudaMemcpy");
+    CUDA_ERROR(cudaMemcpy(
+        &d_patch_info, &d_patch, sizeof(PatchInfo), cudaMemcpyHostToDevice));
+    m_timers.stop("cudaMemcpy");
 }
 
 void RXMesh::allocate_extra_patches()
@@ -1415,65 +2511,115 @@ void RXMesh::allocate_extra_patches()
 
 void RXMesh::patch_graph_coloring()
 {
+    // Jones-Plassmann coloring of the distance-2 patch graph i.e., two patches
+    // get different colors if they are neighbors or share a neighbor. Every
+    // patch gets a random priority. In every round, an uncolored patch whose
+    // priority is the highest among its uncolored distance-2 neighbors takes
+    // the smallest color not used by its distance-2 neighbors. Patches
+    // colored in the same round are not distance-2 neighbors of each other
+    // and so every round runs in parallel
+    const int num_patches = static_cast<int>(m_num_patches);
+
     std::vector<uint32_t> ids(m_num_patches);
     fill_with_random_numbers(ids.data(), ids.size());
 
-    m_num_colors = 0;
+    std::vector<uint32_t> priority(m_num_patches);
+#pragma omp parallel for
+    for (int i = 0; i < num_patches; ++i) {
+        priority[ids[i]] = i;
+    }
+
+    // the patch stash is not necessarily symmetric at this point (q could be
+    // in p's stash while p is not in q's stash) so we first build the
+    // symmetric one-ring patch graph
+    std::vector<std::vector<uint32_t>> ring1(m_num_patches);
+    for (int p = 0; p < num_patches; ++p) {
+        const PatchStash& stash = m_h_patches_info[p].patch_stash;
+        for (uint32_t i = 0; i < PatchStash::stash_size; ++i) {
+            const uint32_t q = stash.get_patch(i);
+            if (q != INVALID32 && q != uint32_t(p)) {
+                ring1[p].push_back(q);
+                ring1[q].push_back(p);
+            }
+        }
+    }
+#pragma omp parallel for
+    for (int p = 0; p < num_patches; ++p) {
+        std::sort(ring1[p].begin(), ring1[p].end());
+        ring1[p].erase(std::unique(ring1[p].begin(), ring1[p].end()),
+                       ring1[p].end());
+    }
 
-    // init all colors
-    for (uint32_t p_id : ids) {
-        m_h_patches_info[p_id].color = INVALID32;
-    }
-
-    // assign colors
-    for (uint32_t p_id : ids) {
-        PatchInfo&         patch = m_h_patches_info[p_id];
-        std::set<uint32_t> neighbours_color;
-
-        // One Ring
-        // put neighbour colors in a set
-        // for (uint32_t i = 0; i < patch.patch_stash.stash_size; ++i) {
-        //    uint32_t n = patch.patch_stash.get_patch(i);
-        //    if (n != INVALID32) {
-        //        uint32_t c = m_h_patches_info[n].color;
-        //        if (c != INVALID32) {
-        //            neighbours_color.insert(c);
-        //        }
-        //    }
-        //}
-
-        // Two Ring
-        for (uint32_t i = 0; i < patch.patch_stash.stash_size; ++i) {
-            uint32_t n = patch.patch_stash.get_patch(i);
-            if (n != INVALID32) {
-                uint32_t c = m_h_patches_info[n].color;
-                if (c != INVALID32) {
-                    neighbours_color.insert(c);
+    std::vector<std::vector<uint32_t>> ring2(m_num_patches);
+#pragma omp parallel for
+    for (int p = 0; p < num_patches; ++p) {
+        for (const uint32_t n : ring1[p]) {
+            ring2[p].push_back(n);
+            for (const uint32_t nn : ring1[n]) {
+                if (nn != uint32_t(p)) {
+                    ring2[p].push_back(nn);
                 }
+            }
+        }
+        std::sort(ring2[p].begin(), ring2[p].end());
+        ring2[p].erase(std::unique(ring2[p].begin(), ring2[p].end()),
+                       ring2[p].end());
+    }
+    ring1.clear();
 
+    std::vector<uint32_t> color(m_num_patches, INVALID32);
+    std::vector<char>     selected(m_num_patches, 0);
+    std::vector<uint32_t> uncolored(m_num_patches);
+    fill_with_sequential_numbers(uncolored.data(), uncolored.size());
 
-                for (uint32_t j = 0; j < patch.patch_stash.stash_size; ++j) {
-                    uint32_t nn = m_h_patches_info[n].patch_stash.get_patch(j);
-                    if (nn != INVALID32 && nn != patch.patch_id) {
-                        uint32_t cc = m_h_patches_info[nn].color;
-                        if (cc != INVALID32) {
-                            neighbours_color.insert(cc);
-                        }
-                    }
+    while (!uncolored.empty()) {
+        const int num_uncolored = static_cast<int>(uncolored.size());
+
+        // select the local maxima among the uncolored patches
+#pragma omp parallel for
+        for (int i = 0; i < num_uncolored; ++i) {
+            const uint32_t p      = uncolored[i];
+            bool           is_max = true;
+            for (const uint32_t n : ring2[p]) {
+                if (color[n] == INVALID32 && priority[n] > priority[p]) {
+                    is_max = false;
+                    break;
                 }
             }
+            selected[p] = is_max;
         }
 
-        // find the min color id that is not in the list/set
-        for (uint32_t i = 0; i < m_num_patches; ++i) {
-            if (neighbours_color.find(i) == neighbours_color.end()) {
-                patch.color  = i;
-                m_num_colors = std::max(m_num_colors, patch.color);
-                break;
+        // color the selected patches with the smallest available color
+#pragma omp parallel for
+        for (int i = 0; i < num_uncolored; ++i) {
+            const uint32_t p = uncolored[i];
+            if (!selected[p]) {
+                continue;
+            }
+            std::vector<bool> used(ring2[p].size() + 1, false);
+            for (const uint32_t n : ring2[p]) {
+                if (color[n] != INVALID32 && color[n] < used.size()) {
+                    used[color[n]] = true;
+                }
             }
+            uint32_t c = 0;
+            while (used[c]) {
+                ++c;
+            }
+            color[p] = c;
         }
+
+        uncolored.erase(
+            std::remove_if(uncolored.begin(),
+                           uncolored.end(),
+                           [&](uint32_t p) { return color[p] != INVALID32; }),
+            uncolored.end());
     }
 
-    m_num_colors++;
+    m_num_colors = 0;
+    for (int p = 0; p < num_patches; ++p) {
+        m_h_patches_info[p].color = color[p];
+        m_num_colors              = std::max(m_num_colors, color[p] + 1);
+    }
 }
 }  // namespace rxmesh
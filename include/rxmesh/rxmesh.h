@@ -8,11 +8,15 @@
 #include "rxmesh/patcher/patcher.h"
 #include "rxmesh/types.h"
 #include "rxmesh/util/cuda_query.h"
+#include "rxmesh/util/host_affinity.h"
 #include "rxmesh/util/log.h"
 #include "rxmesh/util/macros.h"
+#include "rxmesh/util/snapshot.h"
+#include "rxmesh/util/sorted_edge_map.h"
 #include "rxmesh/util/util.h"
 
 #include "rxmesh/util/timer.h"
+#include "rxmesh/util/trace.h"
 
 class RXMeshTest;
 
@@ -23,9 +27,11 @@ inline void rx_init(int                       device_id,
                     spdlog::level::level_enum level = spdlog::level::info)
 {
     Log::init(level);
+#ifndef RX_CPU_ONLY
     if (device_id >= 0) {
         cuda_query(device_id);
     }
+#endif
 }
 
 /**
@@ -210,6 +216,15 @@ class RXMesh
         return m_max_num_patches;
     }
 
+    /**
+     * @brief the patch-to-thread affinity used on the host or nullptr if the
+     * mesh was not built with host affinity
+     */
+    const detail::HostAffinity* get_host_affinity() const
+    {
+        return m_h_affinity.is_valid() ? &m_h_affinity : nullptr;
+    }
+
     /**
      * @brief Returns the number of disconnected component the input mesh is
      * composed of
@@ -428,17 +443,36 @@ class RXMesh
         return m_topo_memory_mega_bytes;
     }
 
+    /**
+     * @brief write every patch (topology, local-to-global maps, neighbor
+     * patches, and element owners) to a PatchStore file that could be
+     * processed out-of-core. The host data structures should be in sync with
+     * the device
+     * @param file_name the output store file
+     */
+    void save_patch_store(const std::string& file_name) const;
+
    protected:
-    // Edge hash map that takes two vertices and return their edge id
-    using EdgeMapT = std::unordered_map<std::pair<uint32_t, uint32_t>,
-                                        uint32_t,
-                                        detail::edge_key_hash>;
+    // Edge map that takes two vertices and return their edge id
+    using EdgeMapT = detail::SortedEdgeMap;
+
+    // Edge hash map that takes two vertices and return their edge id. Used
+    // when the map has to be updated incrementally (e.g., polyscope)
+    using EdgeHashMapT = std::unordered_map<std::pair<uint32_t, uint32_t>,
+                                            uint32_t,
+                                            detail::edge_key_hash>;
 
     virtual ~RXMesh();
 
     RXMesh(const RXMesh&) = delete;
 
-    RXMesh(uint32_t patch_size);
+    /**
+     * @param patch_size the target number of faces in a patch
+     * @param host_affinity pin patch ranges to host threads (see HostAffinity)
+     * so that every patch's host topology is allocated and first touched by
+     * the thread that later processes it on the host
+     */
+    RXMesh(uint32_t patch_size, bool host_affinity = false);
 
     /**
      * @brief init all the data structures
@@ -452,12 +486,163 @@ class RXMesh
      * patch_alloc_factor*x patches
      * @param lp_hashtable_load_factor loading factor for the hashtable use for
      * the not-owned vertices/edges/faces
+     * @param patching_method the algorithm used to partition the mesh into
+     * patches (ignored if the patches are loaded from patcher_file)
+     * @param reorder_patch_elements if true, the vertices, edges, and faces
+     * inside every patch are renumbered in breadth-first order so that
+     * neighbor elements get close local indices (see reorder_single_patch)
      */
     void init(const std::vector<std::vector<uint32_t>>& fv,
               const std::string                         patcher_file    = "",
               const float                               capacity_factor = 1.8,
               const float patch_alloc_factor                            = 5.0,
-              const float lp_hashtable_load_factor                      = 0.5);
+              const float lp_hashtable_load_factor                      = 0.5,
+              const PatchingMethod patching_method = PatchingMethod::Lloyd,
+              const bool           reorder_patch_elements = false);
+
+    /**
+     * @brief init all the data structures from a contiguous index buffer.
+     * Similar to the above but without the need to copy the faces into nested
+     * vectors
+     * @param fv the mesh connectivity as a contiguous index triangle buffer
+     * i.e., the three vertices of face f are fv[3*f], fv[3*f+1], and fv[3*f+2]
+     * @param num_faces number of faces in fv
+     * @param vertices optional vertex coordinates (three per vertex). Only
+     * used by the space-filling-curve patching methods
+     * @param reorder_patch_elements renumber the elements inside every patch
+     * in breadth-first order
+     */
+    void init(const uint32_t*      fv,
+              const uint32_t       num_faces,
+              const std::string    patcher_file             = "",
+              const float          capacity_factor          = 1.8,
+              const float          patch_alloc_factor       = 5.0,
+              const float          lp_hashtable_load_factor = 0.5,
+              const PatchingMethod patching_method = PatchingMethod::Lloyd,
+              const float*         vertices        = nullptr,
+              const bool           reorder_patch_elements = false);
+
+    /**
+     * @brief init all the data structures from a snapshot written by
+     * save_snapshot(). The host data structures (patches, topology, bitmasks,
+     * hashtables, etc) are read as they are and only copied to the device i.e.,
+     * there is no edge extraction, patching, or hashtable construction
+     * @param snapshot the snapshot file
+     * @param reader reader over the (already mapped) snapshot file that is
+     * positioned right after the header
+     * @param vertices output vertex coordinates stored in the snapshot (three
+     * per vertex in the input vertex order). Empty if the snapshot was saved
+     * without coordinates
+     */
+    void init(const SnapshotFile&     snapshot,
+              detail::SnapshotReader& reader,
+              std::vector<float>&     vertices);
+
+    /**
+     * @brief write the host data structures along with the vertex coordinates
+     * to a snapshot file that can be loaded using init(SnapshotFile). The
+     * host data structures should be in sync with the device
+     * @param file_name the output snapshot file
+     * @param vertices vertex coordinates (three per vertex in the input vertex
+     * order). Could be empty
+     */
+    void save_snapshot(const std::string&        file_name,
+                       const std::vector<float>& vertices);
+
+    /**
+     * @brief read or write (depending on ArchiveT) the scalar members stored
+     * in a snapshot
+     */
+    template <typename ArchiveT>
+    void snapshot_scalars(ArchiveT& ar)
+    {
+        ar(m_num_edges,
+           m_num_faces,
+           m_num_vertices,
+           m_max_edge_capacity,
+           m_max_face_capacity,
+           m_max_vertex_capacity,
+           m_input_max_valence,
+           m_input_max_edge_incident_faces,
+           m_input_max_face_adjacent_faces,
+           m_is_input_edge_manifold,
+           m_is_input_closed,
+           m_num_patches,
+           m_max_num_patches,
+           m_max_capacity_lp_v,
+           m_max_capacity_lp_e,
+           m_max_capacity_lp_f,
+           m_max_vertices_per_patch,
+           m_max_edges_per_patch,
+           m_max_faces_per_patch,
+           m_capacity_factor,
+           m_lp_hashtable_load_factor,
+           m_patch_alloc_factor,
+           m_num_colors);
+    }
+
+    /**
+     * @brief call func(get_ptr, count) for every per-patch array stored in a
+     * snapshot where get_ptr(PatchInfo&) returns a pointer to the array in the
+     * given patch and count is the number of elements in the array (the same
+     * for all patches)
+     */
+    template <typename FuncT>
+    void snapshot_per_patch(FuncT func)
+    {
+        const size_t v_cap = get_per_patch_max_vertex_capacity();
+        const size_t e_cap = get_per_patch_max_edge_capacity();
+        const size_t f_cap = get_per_patch_max_face_capacity();
+
+        const size_t v_mask = detail::mask_num_bytes(v_cap) / sizeof(uint32_t);
+        const size_t e_mask = detail::mask_num_bytes(e_cap) / sizeof(uint32_t);
+        const size_t f_mask = detail::mask_num_bytes(f_cap) / sizeof(uint32_t);
+
+        func([](PatchInfo& pi) { return &pi.color; }, 1);
+        func([](PatchInfo& pi) { return pi.patch_stash.m_stash; },
+             PatchStash::stash_size);
+
+        func([](PatchInfo& pi) { return pi.ev; }, 2 * e_cap);
+        func([](PatchInfo& pi) { return pi.fe; }, 3 * f_cap);
+
+        func([](PatchInfo& pi) { return pi.active_mask_v; }, v_mask);
+        func([](PatchInfo& pi) { return pi.active_mask_e; }, e_mask);
+        func([](PatchInfo& pi) { return pi.active_mask_f; }, f_mask);
+        func([](PatchInfo& pi) { return pi.owned_mask_v; }, v_mask);
+        func([](PatchInfo& pi) { return pi.owned_mask_e; }, e_mask);
+        func([](PatchInfo& pi) { return pi.owned_mask_f; }, f_mask);
+
+        auto hashtable = [&](auto get_ht) {
+            const size_t cap = get_ht(m_h_patches_info[0]).get_capacity();
+            func([&](PatchInfo& pi) { return get_ht(pi).m_table; }, cap);
+            func([&](PatchInfo& pi) { return get_ht(pi).m_stash; },
+                 LPHashTable::stash_size);
+            func([&](PatchInfo& pi) { return &get_ht(pi).m_hasher0; }, 1);
+            func([&](PatchInfo& pi) { return &get_ht(pi).m_hasher1; }, 1);
+            func([&](PatchInfo& pi) { return &get_ht(pi).m_hasher2; }, 1);
+            func([&](PatchInfo& pi) { return &get_ht(pi).m_hasher3; }, 1);
+        };
+        hashtable([](PatchInfo& pi) -> LPHashTable& { return pi.lp_v; });
+        hashtable([](PatchInfo& pi) -> LPHashTable& { return pi.lp_e; });
+        hashtable([](PatchInfo& pi) -> LPHashTable& { return pi.lp_f; });
+    }
+
+    /**
+     * @brief add the timers used while building the data structures
+     */
+    void add_build_timers();
+
+    /**
+     * @brief allocate and copy the vertex/edge/face prefix sum to the device
+     */
+    void build_device_prefix();
+
+    /**
+     * @brief the last steps of init(), shared by all init() variants, that run
+     * after the patches are on the device: the patch scheduler, allocating
+     * extra patches, and the context
+     */
+    void finalize_init();
 
     /**
      * @brief build different supporting data structure used to build RXMesh
@@ -465,18 +650,26 @@ class RXMesh
      * Set the number of vertices, edges, and faces, populate edge_map (which
      * takes two connected vertices and returns their edge id), build
      * face-incident-faces data structure (used to in creating patches). This is
-     * done using a single pass over FV
+     * done in parallel by sorting the half-edges by their edge key so that
+     * half-edges of the same edge become consecutive. Edge ids are assigned in
+     * the order in which edges are first encountered when scanning FV
      *
-     * @param fv input face incident vertices
-     * @param ef output edge incident faces
-     * @param ef output face adjacent faces
-     */
-    void build_supporting_structures(
-        const std::vector<std::vector<uint32_t>>& fv,
-        std::vector<std::vector<uint32_t>>&       ev,
-        std::vector<std::vector<uint32_t>>&       ef,
-        std::vector<uint32_t>&                    ff_offset,
-        std::vector<uint32_t>&                    ff_values);
+     * @param fv input face incident vertices (three per face)
+     * @param num_faces number of faces in fv
+     * @param ev output edge incident vertices (two per edge)
+     * @param ef_offset output edge incident faces offset (CSR)
+     * @param ef_values output edge incident faces values (CSR) where faces of
+     * every edge are sorted
+     * @param ff_offset output face adjacent faces offset (CSR)
+     * @param ff_values output face adjacent faces values (CSR)
+     */
+    void build_supporting_structures(const uint32_t*        fv,
+                                     const uint32_t         num_faces,
+                                     std::vector<uint32_t>& ev,
+                                     std::vector<uint32_t>& ef_offset,
+                                     std::vector<uint32_t>& ef_values,
+                                     std::vector<uint32_t>& ff_offset,
+                                     std::vector<uint32_t>& ff_values);
 
     /**
      * @brief Calculate various statistics for the input mesh
@@ -485,11 +678,13 @@ class RXMesh
      * if the input is closed, if the input is edge manifold, and max number of
      * vertices/edges/faces per patch
      *
-     * @param fv input face incident vertices
-     * @param ef input edge incident faces
+     * @param ev input edge incident vertices (two per edge)
+     * @param ef_offset input edge incident faces offset (CSR)
+     * @param ff_offset input face adjacent faces offset (CSR)
      */
-    void calc_input_statistics(const std::vector<std::vector<uint32_t>>& fv,
-                               const std::vector<std::vector<uint32_t>>& ef);
+    void calc_input_statistics(const std::vector<uint32_t>& ev,
+                               const std::vector<uint32_t>& ef_offset,
+                               const std::vector<uint32_t>& ff_offset);
 
     /**
      * @brief count the max number of vertices/edges/faces per patch and
@@ -505,10 +700,22 @@ class RXMesh
      */
     void allocate_extra_patches();
 
+    /**
+     * @brief build the global-to-local table of one element type i.e., the
+     * i-th entry is the handle of the i-th owned (and not deleted) element
+     * where owned elements are enumerated patch by patch using the prefix sum
+     * @param g2l the table to (re)build
+     * @param element_prefix the prefix sum of the owned elements in patches
+     */
     template <typename HandleT>
-    const std::pair<uint32_t, uint16_t> map_to_local(
-        const uint32_t  i,
-        const uint32_t* element_prefix) const;
+    void build_global_to_local(std::vector<HandleT>& g2l,
+                               const uint32_t*       element_prefix);
+
+    /**
+     * @brief (re)build the vertex/edge/face global-to-local tables used by
+     * map_to_local_vertex/edge/face
+     */
+    void build_global_to_local();
 
     template <typename LocalT>
     uint16_t max_lp_hashtable_capacity() const
@@ -536,16 +743,56 @@ class RXMesh
         }
     }
 
-    void build(const std::vector<std::vector<uint32_t>>& fv,
-               const std::string                         patcher_file);
+    void build(const uint32_t*      fv,
+               const uint32_t       num_faces,
+               const std::string    patcher_file,
+               const PatchingMethod patching_method,
+               const float*         vertices,
+               const bool           reorder_patch_elements);
 
-    void build_single_patch_ltog(const std::vector<std::vector<uint32_t>>& fv,
-                                 const std::vector<std::vector<uint32_t>>& ev,
-                                 const uint32_t patch_id);
+    /**
+     * @brief assign every patch a home host thread such that the threads get
+     * a similar number of faces (including the ribbon). Requires the patcher
+     */
+    void build_host_affinity();
 
-    void build_single_patch_topology(
-        const std::vector<std::vector<uint32_t>>& fv,
-        const uint32_t                            patch_id);
+    /**
+     * @brief call f(p) for every patch in parallel on the host. With host
+     * affinity, f(p) runs on the home thread of p so that the memory that f
+     * allocates and first touches is placed on the NUMA node that later
+     * processes the patch
+     */
+    template <typename FuncT>
+    void for_each_patch_host(FuncT f) const
+    {
+        if (m_h_affinity.is_valid()) {
+            m_h_affinity.run(get_num_patches(), f);
+        } else {
+            const int num_patches = static_cast<int>(get_num_patches());
+#pragma omp parallel for schedule(dynamic)
+            for (int p = 0; p < num_patches; ++p) {
+                f(static_cast<uint32_t>(p));
+            }
+        }
+    }
+
+    void build_single_patch_ltog(const uint32_t*              fv,
+                                 const std::vector<uint32_t>& ev,
+                                 const uint32_t               patch_id);
+
+    void build_single_patch_topology(const uint32_t* fv,
+                                     const uint32_t  patch_id);
+
+    /**
+     * @brief renumber the faces, edges, and vertices of a patch (after its
+     * topology is built) such that elements that are close in the mesh are
+     * also close in the patch local index space. Faces are ordered by a
+     * breadth-first traversal over the patch faces, then edges and vertices
+     * are ordered by their first appearance in the new face/edge order. Owned
+     * elements are still placed before not-owned ones. The patch ltog maps
+     * and its EV and FE are updated accordingly
+     */
+    void reorder_single_patch(const uint32_t patch_id);
 
     // get the max vertex/edge/face capacity i.e., the max number of
     // vertices/edges/faces allowed in a patch (for allocation purposes)
@@ -570,6 +817,13 @@ class RXMesh
                                    PatchInfo&                   h_patch_info,
                                    PatchInfo&                   d_patch_info);
 
+    /**
+     * @brief allocate a patch on the device and copy an already-built host
+     * patch (topology, bitmasks, patch stash, and hashtables) to it
+     */
+    void upload_device_single_patch(PatchInfo& h_patch_info,
+                                    PatchInfo& d_patch_info);
+
     void patch_graph_coloring();
 
     void populate_patch_stash();
@@ -599,6 +853,10 @@ class RXMesh
     uint32_t       m_num_patches, m_max_num_patches;
     const uint32_t m_patch_size;
 
+    // if the host data of the patches is placed by HostAffinity
+    const bool           m_host_affinity;
+    detail::HostAffinity m_h_affinity;
+
     // pointer to the patcher class responsible for everything related to
     // patching the mesh into small pieces
     std::unique_ptr<patcher::Patcher> m_patcher;
@@ -606,6 +864,12 @@ class RXMesh
     // the number of owned mesh elements per patch
     std::vector<uint16_t> m_h_num_owned_f, m_h_num_owned_e, m_h_num_owned_v;
 
+    // the local index of every mesh element (global id) in the patch that owns
+    // it. Only valid during build_device() where it is used to find the owner
+    // local index of the not-owned elements
+    std::vector<uint16_t> m_h_owner_local_f, m_h_owner_local_e,
+        m_h_owner_local_v;
+
     // uint16_t m_max_not_owned_vertices, m_max_not_owned_edges,
     //    m_max_not_owned_faces;
 
@@ -621,6 +885,13 @@ class RXMesh
     std::vector<std::vector<uint32_t>> m_h_patches_ltog_e;
     std::vector<std::vector<uint32_t>> m_h_patches_ltog_f;
 
+    // global-to-local maps i.e., the handle of the i-th owned vertex/edge/face
+    // where i is the index used by map_to_local_vertex/edge/face.
+    // Should be rebuilt with update_host
+    std::vector<VertexHandle> m_h_vertex_g2l;
+    std::vector<EdgeHandle>   m_h_edge_g2l;
+    std::vector<FaceHandle>   m_h_face_g2l;
+
     // the prefix sum of the owned vertices/edges/faces in patches
     uint32_t* m_h_vertex_prefix;
     uint32_t* m_h_edge_prefix;
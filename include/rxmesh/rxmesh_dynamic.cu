@@ -2655,6 +2655,12 @@ bool RXMeshDynamic::validate()
 
 void RXMeshDynamic::cleanup()
 {
+    RXMESH_TRACE_SCOPE("RXMeshDynamic::cleanup");
+
+    // the topology has changed and so any cached query is stale
+    release_adjacency_cache();
+    release_k_ring();
+
     // CUDA_ERROR(cudaMemcpy(&m_num_patches,
     //                       m_rxmesh_context.m_num_patches,
     //                       sizeof(uint32_t),
@@ -2750,8 +2756,12 @@ void RXMeshDynamic::cleanup()
 
 void RXMeshDynamic::update_host()
 {
+    RXMESH_TRACE_SCOPE("RXMeshDynamic::update_host");
     RXMESH_TRACE("RXMeshDynamic updating host started");
 
+    release_adjacency_cache();
+    release_k_ring();
+
     auto resize_masks = [&](uint16_t   size,
                             uint16_t&  capacity,
                             uint32_t*& active_mask,
@@ -2983,6 +2993,8 @@ void RXMeshDynamic::update_host()
                           patches_1_bytes,
                           cudaMemcpyHostToDevice));
 
+    this->build_global_to_local();
+
     this->calc_max_elements();
 
     RXMESH_TRACE("RXMeshDynamic updating host finished");
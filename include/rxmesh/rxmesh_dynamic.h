@@ -617,18 +617,23 @@ class RXMeshDynamic : public RXMeshStatic
      * @brief Constructor using path to obj file
      * @param file_path path to an obj file
      */
-    explicit RXMeshDynamic(const std::string file_path,
-                           const std::string patcher_file             = "",
-                           const uint32_t    patch_size               = 256,
-                           const float       capacity_factor          = 3.5,
-                           const float       patch_alloc_factor       = 5.0,
-                           const float       lp_hashtable_load_factor = 0.5)
+    explicit RXMeshDynamic(
+        const std::string    file_path,
+        const std::string    patcher_file             = "",
+        const uint32_t       patch_size               = 256,
+        const float          capacity_factor          = 3.5,
+        const float          patch_alloc_factor       = 5.0,
+        const float          lp_hashtable_load_factor = 0.5,
+        const PatchingMethod patching_method          = PatchingMethod::Lloyd,
+        const bool           reorder_patch_elements   = false)
         : RXMeshStatic(file_path,
                        patcher_file,
                        patch_size,
                        capacity_factor,
                        patch_alloc_factor,
-                       lp_hashtable_load_factor)
+                       lp_hashtable_load_factor,
+                       patching_method,
+                       reorder_patch_elements)
     {
     }
 
@@ -636,18 +641,57 @@ class RXMeshDynamic : public RXMeshStatic
      * @brief Constructor using triangles and vertices
      * @param fv Face incident vertices as read from an obj file
      */
-    explicit RXMeshDynamic(std::vector<std::vector<uint32_t>>& fv,
-                           const std::string patcher_file             = "",
-                           const uint32_t    patch_size               = 256,
-                           const float       capacity_factor          = 3.5,
-                           const float       patch_alloc_factor       = 5.0,
-                           const float       lp_hashtable_load_factor = 0.5)
+    explicit RXMeshDynamic(
+        std::vector<std::vector<uint32_t>>& fv,
+        const std::string                   patcher_file             = "",
+        const uint32_t                      patch_size               = 256,
+        const float                         capacity_factor          = 3.5,
+        const float                         patch_alloc_factor       = 5.0,
+        const float                         lp_hashtable_load_factor = 0.5,
+        const PatchingMethod patching_method = PatchingMethod::Lloyd,
+        const bool           reorder_patch_elements = false)
         : RXMeshStatic(fv,
                        patcher_file,
                        patch_size,
                        capacity_factor,
                        patch_alloc_factor,
-                       lp_hashtable_load_factor)
+                       lp_hashtable_load_factor,
+                       patching_method,
+                       reorder_patch_elements)
+    {
+    }
+
+    /**
+     * @brief Constructor using contiguous buffers of triangles and vertex
+     * coordinates (see RXMeshStatic for the buffers layout)
+     * @param fv face incident vertices (three per face)
+     * @param num_faces number of faces in fv
+     * @param vertices vertex coordinates (three per vertex). Could be nullptr
+     * @param num_vertices number of vertices in vertices
+     */
+    explicit RXMeshDynamic(
+        const uint32_t*      fv,
+        const uint32_t       num_faces,
+        const float*         vertices                 = nullptr,
+        const uint32_t       num_vertices             = 0,
+        const std::string    patcher_file             = "",
+        const uint32_t       patch_size               = 256,
+        const float          capacity_factor          = 3.5,
+        const float          patch_alloc_factor       = 5.0,
+        const float          lp_hashtable_load_factor = 0.5,
+        const PatchingMethod patching_method          = PatchingMethod::Lloyd,
+        const bool           reorder_patch_elements   = false)
+        : RXMeshStatic(fv,
+                       num_faces,
+                       vertices,
+                       num_vertices,
+                       patcher_file,
+                       patch_size,
+                       capacity_factor,
+                       patch_alloc_factor,
+                       lp_hashtable_load_factor,
+                       patching_method,
+                       reorder_patch_elements)
     {
     }
 
@@ -924,7 +968,8 @@ class RXMeshDynamic : public RXMeshStatic
     /**
      * @brief cleanup after topology changes by removing surplus elements
      * and make sure that hashtable store owner patches. Also, reset the number
-     * of vertices/edges/faces
+     * of vertices/edges/faces and release the adjacency cache and the k-ring
+     * (if any)
      */
     void cleanup();
 
@@ -935,6 +980,10 @@ class RXMeshDynamic : public RXMeshStatic
     template <typename... AttributesT>
     void slice_patches(AttributesT... attributes)
     {
+        RXMESH_TRACE_SCOPE("RXMeshDynamic::slice_patches");
+
+        release_adjacency_cache();
+        release_k_ring();
 
         constexpr uint32_t block_size = 256;
 
@@ -1012,7 +1061,8 @@ class RXMeshDynamic : public RXMeshStatic
      * @brief update the host side. Use this function to update the host side
      * after performing (dynamic) updates on the GPU. This function may
      * re-allocates the host side memory buffers in case it is not enough (e.g.,
-     * after performing mesh refinement on the GPU)
+     * after performing mesh refinement on the GPU). The adjacency cache and
+     * the k-ring are released and could be rebuilt afterwards
      */
     void update_host();
 
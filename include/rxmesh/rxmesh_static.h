@@ -4,23 +4,35 @@
 #include <functional>
 #include <memory>
 
+#ifndef RX_CPU_ONLY
 #include <cuda_profiler_api.h>
+#endif
 
 #include "rxmesh/attribute.h"
+#ifndef RX_CPU_ONLY
 #include "rxmesh/diff/diff_attribute.h"
+#endif
 #include "rxmesh/handle.h"
+#include "rxmesh/k_ring.h"
+#ifndef RX_CPU_ONLY
 #include "rxmesh/kernels/for_each.cuh"
+#endif
 #include "rxmesh/kernels/shmem_allocator.cuh"
 #include "rxmesh/launch_box.h"
 #include "rxmesh/rxmesh.h"
 #include "rxmesh/types.h"
 #include "rxmesh/util/bitmask_util.h"
+#include "rxmesh/util/host_scheduler.h"
+#include "rxmesh/util/import_mesh.h"
 #include "rxmesh/util/import_obj.h"
 #include "rxmesh/util/log.h"
 #include "rxmesh/util/timer.h"
 
+#include "rxmesh/kernels/query_host_dispatcher.h"
+#ifndef RX_CPU_ONLY
 #include "rxmesh/kernels/boundary.cuh"
 #include "rxmesh/kernels/query_kernel.cuh"
+#endif
 
 #if USE_POLYSCOPE
 #include "polyscope/surface_mesh.h"
@@ -41,31 +53,50 @@ class RXMeshStatic : public RXMesh
     RXMeshStatic(const RXMeshStatic&) = delete;
 
     /**
-     * @brief Constructor using path to obj file
-     * @param file_path path to an obj file
+     * @brief Constructor using path to a mesh file
+     * @param file_path path to an obj, ply, or stl file
+     * @param patching_method the algorithm used to partition the mesh into
+     * patches e.g., PatchingMethod::HostLloyd to build the patches on the host
+     * or PatchingMethod::Hilbert for fast patching along a space-filling curve
+     * @param reorder_patch_elements renumber the vertices, edges, and faces
+     * inside every patch in breadth-first order for better memory locality of
+     * the queries
+     * @param host_affinity give every patch a stable home host thread that
+     * allocates (i.e., first touches) the patch's host topology and
+     * attributes and processes the patch in host for_each and queries. This
+     * keeps the patch data on the NUMA node that uses it. Threads should be
+     * bound to cores, e.g., OMP_PROC_BIND=close and OMP_PLACES=cores
      */
-    explicit RXMeshStatic(const std::string file_path,
-                          const std::string patcher_file             = "",
-                          const uint32_t    patch_size               = 512,
-                          const float       capacity_factor          = 1.0,
-                          const float       patch_alloc_factor       = 1.0,
-                          const float       lp_hashtable_load_factor = 0.8)
-        : RXMesh(patch_size)
+    explicit RXMeshStatic(
+        const std::string    file_path,
+        const std::string    patcher_file             = "",
+        const uint32_t       patch_size               = 512,
+        const float          capacity_factor          = 1.0,
+        const float          patch_alloc_factor       = 1.0,
+        const float          lp_hashtable_load_factor = 0.8,
+        const PatchingMethod patching_method          = PatchingMethod::Lloyd,
+        const bool           reorder_patch_elements   = false,
+        const bool           host_affinity            = false)
+        : RXMesh(patch_size, host_affinity)
     {
-        std::vector<std::vector<uint32_t>> fv;
-        std::vector<std::vector<float>>    vertices;
-        if (!import_obj(file_path, vertices, fv)) {
+        std::vector<uint32_t> fv;
+        std::vector<float>    vertices;
+        if (!import_mesh(file_path, vertices, fv)) {
             RXMESH_ERROR(
                 "RXMeshStatic::RXMeshStatic could not read the input file {}",
                 file_path);
             exit(EXIT_FAILURE);
         }
 
-        this->init(fv,
+        this->init(fv.data(),
+                   static_cast<uint32_t>(fv.size() / 3),
                    patcher_file,
                    capacity_factor,
                    patch_alloc_factor,
-                   lp_hashtable_load_factor);
+                   lp_hashtable_load_factor,
+                   patching_method,
+                   vertices.data(),
+                   reorder_patch_elements);
 
         m_attr_container = std::make_shared<AttributeContainer>();
 
@@ -73,29 +104,97 @@ class RXMeshStatic : public RXMesh
 #if USE_POLYSCOPE
         name = polyscope::guessNiceNameFromPath(file_path);
 #endif
-        add_vertex_coordinates(vertices, name);
+        add_vertex_coordinates(
+            vertices.data(), static_cast<uint32_t>(vertices.size() / 3), name);
     };
 
     /**
      * @brief Constructor using triangles and vertices
      * @param fv Face incident vertices as read from an obj file
+     * @param host_affinity see the constructor that takes a file path
      */
-    explicit RXMeshStatic(std::vector<std::vector<uint32_t>>& fv,
-                          const std::string                   patcher_file = "",
-                          const uint32_t                      patch_size = 512,
-                          const float capacity_factor                    = 1.0,
-                          const float patch_alloc_factor                 = 1.0,
-                          const float lp_hashtable_load_factor           = 0.8)
-        : RXMesh(patch_size), m_input_vertex_coordinates(nullptr)
+    explicit RXMeshStatic(
+        std::vector<std::vector<uint32_t>>& fv,
+        const std::string                   patcher_file             = "",
+        const uint32_t                      patch_size               = 512,
+        const float                         capacity_factor          = 1.0,
+        const float                         patch_alloc_factor       = 1.0,
+        const float                         lp_hashtable_load_factor = 0.8,
+        const PatchingMethod patching_method = PatchingMethod::Lloyd,
+        const bool           reorder_patch_elements = false,
+        const bool           host_affinity          = false)
+        : RXMesh(patch_size, host_affinity), m_input_vertex_coordinates(nullptr)
     {
         this->init(fv,
                    patcher_file,
                    capacity_factor,
                    patch_alloc_factor,
-                   lp_hashtable_load_factor);
+                   lp_hashtable_load_factor,
+                   patching_method,
+                   reorder_patch_elements);
         m_attr_container = std::make_shared<AttributeContainer>();
     };
 
+    /**
+     * @brief Constructor using contiguous buffers of triangles and vertex
+     * coordinates. The buffers are only read during the construction and so
+     * they can be owned/freed by the caller afterwards
+     * @param fv face incident vertices where the three vertices of face f are
+     * fv[3*f], fv[3*f+1], and fv[3*f+2]
+     * @param num_faces number of faces in fv
+     * @param vertices vertex coordinates where the coordinates of vertex v are
+     * vertices[3*v], vertices[3*v+1], and vertices[3*v+2]. Could be nullptr and
+     * then add_vertex_coordinates() can be called later
+     * @param num_vertices number of vertices in vertices
+     * @param host_affinity see the constructor that takes a file path
+     */
+    explicit RXMeshStatic(
+        const uint32_t*      fv,
+        const uint32_t       num_faces,
+        const float*         vertices                 = nullptr,
+        const uint32_t       num_vertices             = 0,
+        const std::string    patcher_file             = "",
+        const uint32_t       patch_size               = 512,
+        const float          capacity_factor          = 1.0,
+        const float          patch_alloc_factor       = 1.0,
+        const float          lp_hashtable_load_factor = 0.8,
+        const PatchingMethod patching_method          = PatchingMethod::Lloyd,
+        const bool           reorder_patch_elements   = false,
+        const bool           host_affinity            = false)
+        : RXMesh(patch_size, host_affinity), m_input_vertex_coordinates(nullptr)
+    {
+        this->init(fv,
+                   num_faces,
+                   patcher_file,
+                   capacity_factor,
+                   patch_alloc_factor,
+                   lp_hashtable_load_factor,
+                   patching_method,
+                   vertices,
+                   reorder_patch_elements);
+        m_attr_container = std::make_shared<AttributeContainer>();
+
+        if (vertices != nullptr) {
+            add_vertex_coordinates(vertices, num_vertices);
+        }
+    };
+
+    /**
+     * @brief Constructor using a snapshot written by save_snapshot(). The
+     * patches and all other data structures are read from the snapshot as
+     * they are (i.e., nothing is rebuilt) and copied to the device. The vertex
+     * coordinates are added if they are stored in the snapshot
+     * @param snapshot the snapshot file
+     * @param host_affinity see the constructor that takes a file path
+     */
+    explicit RXMeshStatic(const SnapshotFile& snapshot,
+                          const bool          host_affinity = false)
+        : RXMeshStatic(snapshot,
+                       detail::SnapshotReader(snapshot.file_name),
+                       host_affinity)
+    {
+    }
+
     /**
      * @brief Add vertex coordinates to the input mesh. When calling
      * RXMeshStatic constructor that takes the face's vertices, this function
@@ -112,23 +211,64 @@ class RXMeshStatic : public RXMesh
             m_input_vertex_coordinates =
                 this->add_vertex_attribute<float>(vertices, "rx:vertices");
 
-#if USE_POLYSCOPE
-            // polyscope::options::autocenterStructures = true;
-            // polyscope::options::autoscaleStructures  = true;
-            // polyscope::options::automaticallyComputeSceneExtents = true;
-            polyscope::init();
-            m_polyscope_mesh_name = mesh_name.empty() ? "RXMesh" : mesh_name;
-            m_polyscope_mesh_name += std::to_string(rand());
-            this->register_polyscope();
-            render_vertex_patch();
-            render_edge_patch();
-            render_face_patch();
-#endif
+            add_input_mesh_to_polyscope(mesh_name);
+        }
+    }
+
+    /**
+     * @brief Similar to add_vertex_coordinates() above but reading the
+     * coordinates from a contiguous buffer where the coordinates of vertex v
+     * are vertices[3*v], vertices[3*v+1], and vertices[3*v+2]
+     */
+    void add_vertex_coordinates(const float*   vertices,
+                                const uint32_t num_vertices,
+                                std::string    mesh_name = "")
+    {
+        if (m_input_vertex_coordinates == nullptr) {
+
+            m_input_vertex_coordinates = this->add_vertex_attribute<float>(
+                vertices, num_vertices, 3, "rx:vertices");
+
+            if (m_input_vertex_coordinates == nullptr) {
+                return;
+            }
+
+            add_input_mesh_to_polyscope(mesh_name);
         }
     }
 
+    /**
+     * @brief Save the mesh (patches, all data structures, and the input vertex
+     * coordinates) to a snapshot file that can be loaded later using
+     * RXMeshStatic(SnapshotFile) without rebuilding anything. The vertex
+     * coordinates are taken from the host so they should be moved to the host
+     * first if they were updated on the device
+     * @param file_name the output snapshot file
+     */
+    void save_snapshot(const std::string& file_name)
+    {
+        std::vector<float> vertices;
+        if (m_input_vertex_coordinates != nullptr) {
+            const VertexAttribute<float>& coords = *m_input_vertex_coordinates;
+
+            vertices.resize(3 * size_t(get_num_vertices()));
+            for_each_vertex(HOST, [&](const VertexHandle vh) {
+                const uint32_t v = map_to_global(vh);
+                for (uint32_t i = 0; i < 3; ++i) {
+                    vertices[3 * v + i] = coords(vh, i);
+                }
+            });
+        }
+        RXMesh::save_snapshot(file_name, vertices);
+    }
+
     virtual ~RXMeshStatic()
     {
+        release_adjacency_cache();
+        release_k_ring();
+#ifndef RX_CPU_ONLY
+        GPU_FREE(m_d_adjacency_cache);
+#endif
     }
 
 #if USE_POLYSCOPE
@@ -437,8 +577,8 @@ class RXMeshStatic : public RXMesh
      * function signature takes a VertexHandle
      * @param stream the stream used to run the kernel in case of DEVICE
      * execution location
-     * @param with_omp for HOST execution, use OpenMP where each patch is
-     * assigned to a thread
+     * @param with_omp for HOST execution, use the work-stealing host scheduler
+     * (see HostScheduler) where large patches may be split between threads
      */
     template <typename LambdaT>
     void for_each_vertex(locationT    location,
@@ -446,13 +586,12 @@ class RXMeshStatic : public RXMesh
                          cudaStream_t stream   = NULL,
                          bool         with_omp = true) const
     {
+#ifdef RX_CPU_ONLY
+        location = detail::cpu_location(location);
+#endif
         if ((location & HOST) == HOST) {
-            const int num_patches = this->get_num_patches();
-
-            auto run = [&](int p) {
-                for (uint16_t v = 0;
-                     v < this->m_h_patches_info[p].num_vertices[0];
-                     ++v) {
+            auto run = [&](int p, uint16_t begin, uint16_t end) {
+                for (uint16_t v = begin; v < end; ++v) {
 
                     if (detail::is_owned(v, m_h_patches_info[p].owned_mask_v) &&
                         !detail::is_deleted(
@@ -465,18 +604,16 @@ class RXMeshStatic : public RXMesh
                 }
             };
 
-            if (!with_omp) {
-                for (int p = 0; p < num_patches; ++p) {
-                    run(p);
-                }
-            } else {
-#pragma omp parallel for
-                for (int p = 0; p < num_patches; ++p) {
-                    run(p);
-                }
-            }
+            for_each_host_task(
+                [&](uint32_t p) {
+                    return uint32_t(m_h_patches_info[p].num_vertices[0]);
+                },
+                get_num_vertices(),
+                with_omp,
+                run);
         }
 
+#ifndef RX_CPU_ONLY
         if ((location & DEVICE) == DEVICE) {
             if constexpr (IS_HD_LAMBDA(LambdaT) || IS_D_LAMBDA(LambdaT)) {
 
@@ -491,6 +628,7 @@ class RXMeshStatic : public RXMesh
                     "device");
             }
         }
+#endif
     }
 
     /**
@@ -501,8 +639,8 @@ class RXMeshStatic : public RXMesh
      * function signature takes a EdgeHandle
      * @param stream the stream used to run the kernel in case of DEVICE
      * execution location
-     * @param with_omp for HOST execution, use OpenMP where each patch is
-     * assigned to a thread
+     * @param with_omp for HOST execution, use the work-stealing host scheduler
+     * (see HostScheduler) where large patches may be split between threads
      */
     template <typename LambdaT>
     void for_each_edge(locationT    location,
@@ -510,12 +648,12 @@ class RXMeshStatic : public RXMesh
                        cudaStream_t stream   = NULL,
                        bool         with_omp = true) const
     {
+#ifdef RX_CPU_ONLY
+        location = detail::cpu_location(location);
+#endif
         if ((location & HOST) == HOST) {
-            const int num_patches = this->get_num_patches();
-
-            auto run = [&](int p) {
-                for (uint16_t e = 0; e < this->m_h_patches_info[p].num_edges[0];
-                     ++e) {
+            auto run = [&](int p, uint16_t begin, uint16_t end) {
+                for (uint16_t e = begin; e < end; ++e) {
 
                     if (detail::is_owned(e, m_h_patches_info[p].owned_mask_e) &&
                         !detail::is_deleted(
@@ -527,18 +665,16 @@ class RXMeshStatic : public RXMesh
                 }
             };
 
-            if (!with_omp) {
-                for (int p = 0; p < num_patches; ++p) {
-                    run(p);
-                }
-            } else {
-#pragma omp parallel for
-                for (int p = 0; p < num_patches; ++p) {
-                    run(p);
-                }
-            }
+            for_each_host_task(
+                [&](uint32_t p) {
+                    return uint32_t(m_h_patches_info[p].num_edges[0]);
+                },
+                get_num_edges(),
+                with_omp,
+                run);
         }
 
+#ifndef RX_CPU_ONLY
         if ((location & DEVICE) == DEVICE) {
             if constexpr (IS_HD_LAMBDA(LambdaT) || IS_D_LAMBDA(LambdaT)) {
 
@@ -553,6 +689,7 @@ class RXMeshStatic : public RXMesh
                     "device");
             }
         }
+#endif
     }
 
     /**
@@ -563,8 +700,8 @@ class RXMeshStatic : public RXMesh
      * function signature takes a FaceHandle
      * @param stream the stream used to run the kernel in case of DEVICE
      * execution location
-     * @param with_omp for HOST execution, use OpenMP where each patch is
-     * assigned to a thread
+     * @param with_omp for HOST execution, use the work-stealing host scheduler
+     * (see HostScheduler) where large patches may be split between threads
      */
     template <typename LambdaT>
     void for_each_face(locationT    location,
@@ -572,12 +709,12 @@ class RXMeshStatic : public RXMesh
                        cudaStream_t stream   = NULL,
                        bool         with_omp = true) const
     {
+#ifdef RX_CPU_ONLY
+        location = detail::cpu_location(location);
+#endif
         if ((location & HOST) == HOST) {
-            const int num_patches = this->get_num_patches();
-
-            auto run = [&](int p) {
-                for (int f = 0; f < this->m_h_patches_info[p].num_faces[0];
-                     ++f) {
+            auto run = [&](int p, uint16_t begin, uint16_t end) {
+                for (uint16_t f = begin; f < end; ++f) {
 
                     if (detail::is_owned(f, m_h_patches_info[p].owned_mask_f) &&
                         !detail::is_deleted(
@@ -589,17 +726,15 @@ class RXMeshStatic : public RXMesh
             };
 
 
-            if (!with_omp) {
-                for (int p = 0; p < num_patches; ++p) {
-                    run(p);
-                }
-            } else {
-#pragma omp parallel for
-                for (int p = 0; p < num_patches; ++p) {
-                    run(p);
-                }
-            }
+            for_each_host_task(
+                [&](uint32_t p) {
+                    return uint32_t(m_h_patches_info[p].num_faces[0]);
+                },
+                get_num_faces(),
+                with_omp,
+                run);
         }
+#ifndef RX_CPU_ONLY
         if ((location & DEVICE) == DEVICE) {
             if constexpr (IS_HD_LAMBDA(LambdaT) || IS_D_LAMBDA(LambdaT)) {
 
@@ -614,6 +749,7 @@ class RXMeshStatic : public RXMesh
                     "device");
             }
         }
+#endif
     }
 
 
@@ -641,6 +777,7 @@ class RXMeshStatic : public RXMesh
     }
 
 
+#ifndef RX_CPU_ONLY
     /**
      * @brief Launching a kernel knowing its launch box
      * @tparam ...ArgsT inferred
@@ -802,8 +939,321 @@ class RXMeshStatic : public RXMesh
             <<<lb.blocks, lb.num_threads, lb.smem_bytes_dyn, stream>>>(
                 get_context(), oriented, user_lambda);
     }
+#endif
+
+    /**
+     * @brief run a query operation on the host and/or the device. This is
+     * limited to one query only.
+     * @tparam LambdaT inferred
+     * @tparam blockThreads the size of cuda block (used for DEVICE execution)
+     * @tparam op the type of query operation
+     * @param location the execution location
+     * @param user_lambda the user lambda function which has the signature
+     *      [=](InputHandle h, OutputIterator iter) {
+     *      }
+     * For HOST execution, the lambda function should be either a host lambda
+     * or annotated with __host__ __device__. For DEVICE execution, the lambda
+     * function should be annotated with __device__ or __host__ __device__
+     * @param oriented if the query operation op is oriented
+     * @param stream the stream to launch the kernel on in case of DEVICE
+     * execution location
+     * @param with_omp for HOST execution, use OpenMP where each patch is
+     * assigned to a thread
+     */
+    template <Op op, uint32_t blockThreads, typename LambdaT>
+    void run_query_kernel(locationT     location,
+                          const LambdaT user_lambda,
+                          const bool    oriented = false,
+                          cudaStream_t  stream   = NULL,
+                          bool          with_omp = true) const
+    {
+#ifdef RX_CPU_ONLY
+        location = detail::cpu_location(location);
+#endif
+        if ((location & HOST) == HOST) {
+            if constexpr (IS_D_LAMBDA(LambdaT)) {
+                RXMESH_ERROR(
+                    "RXMeshStatic::run_query_kernel() Input lambda function "
+                    "should be annotated with __host__ __device__ or not "
+                    "annotated for execution on host");
+            } else {
+                run_query_host<op>(user_lambda, oriented, with_omp);
+            }
+        }
+
+#ifndef RX_CPU_ONLY
+        if ((location & DEVICE) == DEVICE) {
+            if constexpr (IS_HD_LAMBDA(LambdaT) || IS_D_LAMBDA(LambdaT)) {
+                run_query_kernel<op, blockThreads>(
+                    user_lambda, oriented, stream);
+            } else {
+                RXMESH_ERROR(
+                    "RXMeshStatic::run_query_kernel() Input lambda function "
+                    "should be annotated with __device__ for execution on "
+                    "device");
+            }
+        }
+#endif
+    }
+
+    /**
+     * @brief run a query operation on the host. This mirrors the device query
+     * (Query::dispatch) using the host copy of the patches where each patch is
+     * processed by a single thread. The output of the query (i.e., the
+     * iterator) has the same order and layout as the device query except for
+     * the queries that are computed via transpose (VV, VE, VF, EF, FF) where
+     * the order (for unoriented queries) is deterministic on the host.
+     * @tparam LambdaT inferred
+     * @tparam op the type of query operation
+     * @param user_lambda the user lambda function which has the signature
+     *      [=](InputHandle h, OutputIterator iter) {
+     *      }
+     * @param oriented if the query operation op is oriented
+     * @param with_omp use the work-stealing host scheduler where each patch is
+     * processed by one thread
+     */
+    template <Op op, typename LambdaT>
+    void run_query_host(const LambdaT user_lambda,
+                        const bool    oriented = false,
+                        bool          with_omp = true) const
+    {
+        using ComputeTraits  = detail::FunctionTraits<LambdaT>;
+        using ComputeHandleT = typename ComputeTraits::template arg<0>::type;
+
+        const int num_patches = this->get_num_patches();
+
+        auto run = [&](int                    p,
+                       std::vector<uint16_t>& offset,
+                       std::vector<uint16_t>& value) {
+            detail::query_host_dispatcher<op>(
+                get_context(),
+                this->m_h_patches_info[p],
+                user_lambda,
+                [](ComputeHandleT) { return true; },
+                oriented,
+                false,
+                offset,
+                value);
+        };
+
+        if (!with_omp) {
+            std::vector<uint16_t> offset, value;
+            for (int p = 0; p < num_patches; ++p) {
+                run(p, offset, value);
+            }
+        } else {
+            // a query runs on a whole patch and so patches are not split. The
+            // cost of a patch is the number of its input elements
+            const detail::HostAffinity* affinity = this->get_host_affinity();
+
+            detail::HostScheduler scheduler(
+                num_patches,
+                [&](uint32_t p) {
+                    const PatchInfo& pi = m_h_patches_info[p];
+                    if constexpr (op == Op::VV || op == Op::VE ||
+                                  op == Op::VF) {
+                        return uint32_t(pi.num_vertices[0]);
+                    } else if constexpr (op == Op::FV || op == Op::FE ||
+                                         op == Op::FF) {
+                        return uint32_t(pi.num_faces[0]);
+                    } else {
+                        return uint32_t(pi.num_edges[0]);
+                    }
+                },
+                0,
+                affinity ? affinity->get_num_threads() : omp_get_max_threads(),
+                affinity);
+
+            // scratch space is reused across the patches of one thread
+            std::vector<std::vector<uint16_t>> offset(
+                scheduler.get_num_threads()),
+                value(scheduler.get_num_threads());
+
+            scheduler.run([&](const detail::HostTask& task, int tid) {
+                run(task.patch_id, offset[tid], value[tid]);
+            });
+        }
+    }
+
+    /**
+     * @brief materialize the output of the query operation op of all patches
+     * (on the host and the device) in a per-patch CSR (see AdjacencyCache).
+     * Subsequent queries of op (run_query_kernel, run_query_host,
+     * Query::dispatch, and higher_query_block_dispatcher) read their output
+     * from the cache instead of computing it which pays off when the same
+     * query runs many times on a static mesh. The cache costs two bytes per
+     * output element. It is built from the host copy of the patches. It is
+     * released by RXMeshDynamic after topology changes (i.e., cleanup(),
+     * slice_patches(), and update_host()) and so it should be rebuilt after
+     * update_host() if needed. Building the cache of an op that is already
+     * cached replaces it
+     * @param op the query operation
+     * @param oriented if the cached query is oriented (only for VV and VE).
+     * An oriented cache only serves oriented queries and vice versa
+     */
+    void build_adjacency_cache(const Op op, const bool oriented = false)
+    {
+        switch (op) {
+            case Op::VV:
+                build_adjacency_cache<Op::VV>(oriented);
+                break;
+            case Op::VE:
+                build_adjacency_cache<Op::VE>(oriented);
+                break;
+            case Op::VF:
+                build_adjacency_cache<Op::VF>(oriented);
+                break;
+            case Op::FV:
+                build_adjacency_cache<Op::FV>(oriented);
+                break;
+            case Op::FE:
+                build_adjacency_cache<Op::FE>(oriented);
+                break;
+            case Op::FF:
+                build_adjacency_cache<Op::FF>(oriented);
+                break;
+            case Op::EV:
+                build_adjacency_cache<Op::EV>(oriented);
+                break;
+            case Op::EE:
+                build_adjacency_cache<Op::EE>(oriented);
+                break;
+            case Op::EF:
+                build_adjacency_cache<Op::EF>(oriented);
+                break;
+            case Op::EVDiamond:
+                build_adjacency_cache<Op::EVDiamond>(oriented);
+                break;
+            default:
+                RXMESH_ERROR(
+                    "RXMeshStatic::build_adjacency_cache() {} is not a query "
+                    "operation",
+                    op_to_string(op));
+        }
+    }
+
+    /**
+     * @brief check if the query operation op is cached
+     * @param op the query operation
+     * @param oriented if the query is oriented (only for VV and VE)
+     */
+    bool has_adjacency_cache(const Op op, const bool oriented = false) const
+    {
+        if (m_h_adjacency_cache.empty() || op == Op::INVALID) {
+            return false;
+        }
+        const AdjacencyCache& cache = m_h_adjacency_cache[int(op)];
+        return cache.is_valid() &&
+               ((op != Op::VV && op != Op::VE) || cache.oriented == oriented);
+    }
+
+    /**
+     * @brief release the adjacency cache of the query operation op so that its
+     * queries are computed from scratch again
+     */
+    void release_adjacency_cache(const Op op)
+    {
+        if (m_h_adjacency_cache.empty() || op == Op::INVALID) {
+            return;
+        }
+        const int i = int(op);
+
+#ifndef RX_CPU_ONLY
+        AdjacencyCache& d_cache = m_h_adjacency_cache_on_device[i];
+        if (d_cache.is_valid()) {
+            CUDA_ERROR(cudaFree(const_cast<uint32_t*>(d_cache.offset_start)));
+            CUDA_ERROR(cudaFree(const_cast<uint16_t*>(d_cache.data)));
+            d_cache = AdjacencyCache();
+            CUDA_ERROR(cudaMemcpy(m_d_adjacency_cache + i,
+                                  &d_cache,
+                                  sizeof(AdjacencyCache),
+                                  cudaMemcpyHostToDevice));
+        }
+#endif
+        m_h_adjacency_cache[i] = AdjacencyCache();
+        m_h_adjacency_start[i].clear();
+        m_h_adjacency_start[i].shrink_to_fit();
+        m_h_adjacency_data[i].clear();
+        m_h_adjacency_data[i].shrink_to_fit();
+    }
+
+    /**
+     * @brief release the adjacency cache of all query operations
+     */
+    void release_adjacency_cache()
+    {
+        for (int i = 0; i < ADJACENCY_CACHE_NUM_OPS; ++i) {
+            release_adjacency_cache(static_cast<Op>(i));
+        }
+    }
+
+    /**
+     * @brief build the k-ring neighborhood of every (owned) vertex in the mesh
+     * and store it (on the host and the device) in a compact CSR (see KRing).
+     * The 1-ring of every patch is computed once (reading the adjacency cache
+     * if VV is cached) where neighbors that live in the ribbon are resolved to
+     * their owner patch through the patch's LPHashTable and PatchStash. The
+     * higher rings are then expanded on the host from the 1-rings such that
+     * rings may cross any number of patches. The returned view can be used on
+     * the host and passed by value to kernels. The k-ring is built once and
+     * rebuilt only if a larger k is requested i.e., a k-ring also serves any
+     * smaller k. It is released by release_k_ring() and by RXMeshDynamic after
+     * topology changes (i.e., cleanup(), slice_patches(), and update_host()).
+     * The returned view does not own the memory. All views returned earlier
+     * become dangling (on the host and the device) when the k-ring is
+     * released or rebuilt i.e., after release_k_ring(), any of the
+     * RXMeshDynamic calls above, or build_k_ring() with a larger k than the
+     * one already built. Call build_k_ring() again to get a valid view
+     * @param k the number of rings (should be > 0)
+     */
+    KRing build_k_ring(const uint32_t k)
+    {
+        if (k == 0) {
+            RXMESH_ERROR("RXMeshStatic::build_k_ring() k should be > 0");
+            return KRing();
+        }
+
+        if (m_k_ring.m_num_rings < k) {
+            build_k_ring_impl(k);
+        }
+
+        KRing ret = m_k_ring;
+        ret.m_k   = k;
+        return ret;
+    }
 
+    /**
+     * @brief check if the k-ring (or a larger one) has been built
+     */
+    bool has_k_ring(const uint32_t k) const
+    {
+        return k > 0 && m_k_ring.m_num_rings >= k;
+    }
 
+    /**
+     * @brief release the memory of the k-ring (on the host and the device).
+     * Any KRing returned by build_k_ring() should not be used afterwards
+     */
+    void release_k_ring()
+    {
+#ifndef RX_CPU_ONLY
+        if (m_k_ring.is_valid()) {
+            CUDA_ERROR(cudaFree(const_cast<uint32_t*>(m_k_ring.m_d_start)));
+            CUDA_ERROR(cudaFree(const_cast<uint32_t*>(m_k_ring.m_d_offset)));
+            CUDA_ERROR(cudaFree(const_cast<VertexHandle*>(m_k_ring.m_d_value)));
+        }
+#endif
+        m_k_ring = KRing();
+        m_h_k_ring_start.clear();
+        m_h_k_ring_start.shrink_to_fit();
+        m_h_k_ring_offset.clear();
+        m_h_k_ring_offset.shrink_to_fit();
+        m_h_k_ring_value.clear();
+        m_h_k_ring_value.shrink_to_fit();
+    }
+
+
+#ifndef RX_CPU_ONLY
     /**
      * @brief populate the launch_box with grid size and dynamic shared memory
      * needed for kernel launch
@@ -877,6 +1327,7 @@ class RXMeshStatic : public RXMesh
                             blockThreads,
                             kernel);
     }
+#endif
 
 
     /**
@@ -1033,6 +1484,7 @@ class RXMeshStatic : public RXMesh
         return ret;
     }
 
+#ifndef RX_CPU_ONLY
     /**
      * @brief Adding a new differentiable face attribute
      * @tparam T the underlying type of the attribute
@@ -1053,6 +1505,7 @@ class RXMeshStatic : public RXMesh
             ->template add<DiffFaceAttribute<T, Size, WithHessian>>(
                 name.c_str(), num_attributes, location, layout, this);
     }
+#endif
 
     /**
      * @brief Adding a new edge attribute
@@ -1096,6 +1549,7 @@ class RXMeshStatic : public RXMesh
                                      other.get_layout());
     }
 
+#ifndef RX_CPU_ONLY
     /**
      * @brief Adding a new differentiable edge attribute
      * @tparam T the underlying type of the attribute
@@ -1116,6 +1570,7 @@ class RXMeshStatic : public RXMesh
             ->template add<DiffEdgeAttribute<T, Size, WithHessian>>(
                 name.c_str(), num_attributes, location, layout, this);
     }
+#endif
 
     /**
      * @brief Adding a new vertex attribute
@@ -1159,6 +1614,7 @@ class RXMeshStatic : public RXMesh
                                        other.get_layout());
     }
 
+#ifndef RX_CPU_ONLY
     /**
      * @brief Adding a new differentiable vertex attribute
      * @tparam T the underlying type of the attribute
@@ -1180,6 +1636,7 @@ class RXMeshStatic : public RXMesh
             ->template add<DiffVertexAttribute<T, Size, WithHessian>>(
                 name.c_str(), num_attributes, location, layout, this);
     }
+#endif
 
     /**
      * @brief Adding a new vertex attribute by reading values from a host buffer
@@ -1241,6 +1698,86 @@ class RXMeshStatic : public RXMesh
         return ret;
     }
 
+    /**
+     * @brief Adding a new vertex attribute by reading values from a contiguous
+     * host buffer v_attributes where the order of vertices is the same as the
+     * order of vertices given to the constructor and the attributes of vertex v
+     * are v_attributes[v * num_attributes + a]. The attributes are populated on
+     * device and host
+     * @tparam T type of the attribute
+     * @param v_attributes attributes to read
+     * @param num_vertices number of vertices in v_attributes
+     * @param num_attributes number of attributes per vertex
+     * @param name of the attribute. Should not collide with other attributes
+     * names
+     * @param layout as SoA or AoS
+     * @return shared pointer to the created attribute or nullptr if
+     * v_attributes is empty or num_vertices is less than the number of
+     * vertices in the input mesh. If num_vertices is larger, the values of
+     * the extra (unreferenced) vertices are ignored
+     */
+    template <class T>
+    std::shared_ptr<VertexAttribute<T>> add_vertex_attribute(
+        const T*           v_attributes,
+        const uint32_t     num_vertices,
+        const uint32_t     num_attributes,
+        const std::string& name,
+        layoutT            layout = SoA)
+    {
+        if (v_attributes == nullptr || num_attributes == 0) {
+            RXMESH_ERROR(
+                "RXMeshStatic::add_vertex_attribute() input attribute is "
+                "empty");
+            return nullptr;
+        }
+
+        if (num_vertices < get_num_vertices()) {
+            RXMESH_ERROR(
+                "RXMeshStatic::add_vertex_attribute() input attribute size "
+                "({}) is less than the number of vertices in the input mesh "
+                "({})",
+                num_vertices,
+                get_num_vertices());
+            return nullptr;
+        }
+
+        if (num_vertices > get_num_vertices()) {
+            // e.g., OBJ/PLY files with vertices that are not referenced by
+            // any face
+            RXMESH_WARN(
+                "RXMeshStatic::add_vertex_attribute() input attribute size "
+                "({}) is more than the number of vertices in the input mesh "
+                "({}). The extra values are ignored",
+                num_vertices,
+                get_num_vertices());
+        }
+
+        auto ret = m_attr_container->template add<VertexAttribute<T>>(
+            name.c_str(), num_attributes, LOCATION_ALL, layout, this);
+
+        // populate the attribute before returning it
+        const int num_patches = this->get_num_patches();
+#pragma omp parallel for
+        for (int p = 0; p < num_patches; ++p) {
+            for (uint16_t v = 0; v < this->m_h_num_owned_v[p]; ++v) {
+
+                const VertexHandle v_handle(static_cast<uint32_t>(p), v);
+
+                const T* global_v =
+                    v_attributes + size_t(m_h_patches_ltog_v[p][v]) *
+                                       size_t(num_attributes);
+
+                for (uint32_t a = 0; a < num_attributes; ++a) {
+                    (*ret)(v_handle, a) = global_v[a];
+                }
+            }
+        }
+
+        // move to device
+        ret->move(rxmesh::HOST, rxmesh::DEVICE);
+        return ret;
+    }
+
     /**
      * @brief Adding a new vertex attribute by reading values from a host buffer
      * v_attributes where the order of vertices is the same as the order of
@@ -1327,6 +1864,31 @@ class RXMeshStatic : public RXMesh
         }
     }
 
+    /**
+     * @brief Adding a pair of attributes for double buffering (see
+     * PingPongAttribute). The front buffer is named name and the back buffer
+     * is named name + ":back"
+     * @tparam T type of the attribute
+     * @tparam HandleT handle type of the attribute (vertex, edge, or face)
+     * @param name of the attribute. Should not collide with other attributes
+     * names
+     * @param num_attributes number of the attributes
+     * @param location where to allocate the attributes
+     * @param layout as SoA or AoS
+     */
+    template <class T, class HandleT>
+    PingPongAttribute<T, HandleT> add_ping_pong_attribute(
+        const std::string& name,
+        uint32_t           num_attributes,
+        locationT          location = LOCATION_ALL,
+        layoutT            layout   = SoA)
+    {
+        return PingPongAttribute<T, HandleT>(
+            add_attribute<T, HandleT>(name, num_attributes, location, layout),
+            add_attribute<T, HandleT>(
+                name + ":back", num_attributes, location, layout));
+    }
+
     /**
      * @brief Adding a new attribute similar to another attribute in allocation,
      * number of attributes, and layout. The type of the attribute (vertex,edge,
@@ -1393,6 +1955,7 @@ class RXMeshStatic : public RXMesh
         m_attr_container->remove(name.c_str());
     }
 
+#ifndef RX_CPU_ONLY
     /**
      * @brief populate boundary_v with 1 if the vertex is a boundary vertex and
      * 0 otherwise. Only the first attribute (i.e., boundary_v(vh, 0)) will be
@@ -1447,6 +2010,7 @@ class RXMeshStatic : public RXMesh
             boundary_v.move(DEVICE, HOST, stream);
         }
     }
+#endif
 
     /**
      * @brief return a shared pointer the input vertex position
@@ -1785,6 +2349,315 @@ class RXMeshStatic : public RXMesh
     }
 
    protected:
+    /**
+     * @brief the constructor behind RXMeshStatic(SnapshotFile). The snapshot
+     * is mapped and its header is validated once by the reader, which is then
+     * used for both the patch size and loading the data structures
+     */
+    RXMeshStatic(const SnapshotFile&      snapshot,
+                 detail::SnapshotReader&& reader,
+                 const bool               host_affinity)
+        : RXMesh(reader.get_patch_size(), host_affinity),
+          m_input_vertex_coordinates(nullptr)
+    {
+        std::vector<float> vertices;
+        this->init(snapshot, reader, vertices);
+        m_attr_container = std::make_shared<AttributeContainer>();
+
+        if (!vertices.empty()) {
+            std::string name = extract_file_name(snapshot.file_name);
+#if USE_POLYSCOPE
+            name = polyscope::guessNiceNameFromPath(snapshot.file_name);
+#endif
+            add_vertex_coordinates(vertices.data(), get_num_vertices(), name);
+        }
+    };
+
+    /**
+     * @brief compute the output of the query operation op for every patch on
+     * the host and store it (on the host and the device) in the adjacency
+     * cache. The output of all patches is packed in one buffer such that the
+     * offset (if any) of a patch is followed by its value
+     */
+    template <Op op>
+    void build_adjacency_cache(const bool oriented)
+    {
+        RXMESH_TRACE_SCOPE("RXMeshStatic::build_adjacency_cache");
+
+        if (m_h_adjacency_cache.empty()) {
+            m_h_adjacency_cache.resize(ADJACENCY_CACHE_NUM_OPS);
+            m_h_adjacency_start.resize(ADJACENCY_CACHE_NUM_OPS);
+            m_h_adjacency_data.resize(ADJACENCY_CACHE_NUM_OPS);
+#ifdef RX_CPU_ONLY
+            m_d_adjacency_cache = m_h_adjacency_cache.data();
+#else
+            m_h_adjacency_cache_on_device.resize(ADJACENCY_CACHE_NUM_OPS);
+            CUDA_ERROR(
+                cudaMalloc((void**)&m_d_adjacency_cache,
+                           ADJACENCY_CACHE_NUM_OPS * sizeof(AdjacencyCache)));
+            CUDA_ERROR(cudaMemcpy(
+                m_d_adjacency_cache,
+                m_h_adjacency_cache_on_device.data(),
+                ADJACENCY_CACHE_NUM_OPS * sizeof(AdjacencyCache),
+                cudaMemcpyHostToDevice));
+#endif
+            this->m_rxmesh_context.m_h_adjacency_cache =
+                m_h_adjacency_cache.data();
+            this->m_rxmesh_context.m_d_adjacency_cache = m_d_adjacency_cache;
+        }
+
+        release_adjacency_cache(op);
+
+        // ops with fixed number of output per element have no offset
+        constexpr bool has_offset = (op == Op::VV || op == Op::VE ||
+                                     op == Op::VF || op == Op::EF ||
+                                     op == Op::FF);
+
+        const uint32_t num_patches = this->get_num_patches();
+
+        std::vector<std::vector<uint16_t>> offset(num_patches),
+            value(num_patches);
+
+        this->for_each_patch_host([&](uint32_t p) {
+            detail::query_host<op>(
+                this->m_h_patches_info[p], offset[p], value[p], oriented);
+            if constexpr (!has_offset) {
+                offset[p].clear();
+            }
+        });
+
+        const int i = int(op);
+
+        // the start of the offset of patch p followed by the start of its
+        // value
+        std::vector<uint32_t>& start = m_h_adjacency_start[i];
+        start.resize(2 * size_t(num_patches));
+        size_t size = 0;
+        for (uint32_t p = 0; p < num_patches; ++p) {
+            start[p] = static_cast<uint32_t>(size);
+            size += offset[p].size();
+            start[num_patches + p] = static_cast<uint32_t>(size);
+            size += value[p].size();
+        }
+
+        std::vector<uint16_t>& data = m_h_adjacency_data[i];
+        data.resize(std::max<size_t>(size, 1));
+        this->for_each_patch_host([&](uint32_t p) {
+            std::copy(offset[p].begin(), offset[p].end(), &data[start[p]]);
+            std::copy(value[p].begin(),
+                      value[p].end(),
+                      &data[start[num_patches + p]]);
+        });
+
+        AdjacencyCache& cache = m_h_adjacency_cache[i];
+        cache.oriented        = oriented;
+        cache.offset_start    = start.data();
+        cache.value_start     = start.data() + num_patches;
+        cache.data            = data.data();
+
+#ifndef RX_CPU_ONLY
+        uint32_t* d_start(nullptr);
+        uint16_t* d_data(nullptr);
+        CUDA_ERROR(
+            cudaMalloc((void**)&d_start, start.size() * sizeof(uint32_t)));
+        CUDA_ERROR(cudaMalloc((void**)&d_data, data.size() * sizeof(uint16_t)));
+        CUDA_ERROR(cudaMemcpy(d_start,
+                              start.data(),
+                              start.size() * sizeof(uint32_t),
+                              cudaMemcpyHostToDevice));
+        CUDA_ERROR(cudaMemcpy(d_data,
+                              data.data(),
+                              data.size() * sizeof(uint16_t),
+                              cudaMemcpyHostToDevice));
+
+        AdjacencyCache& d_cache = m_h_adjacency_cache_on_device[i];
+        d_cache.oriented        = oriented;
+        d_cache.offset_start    = d_start;
+        d_cache.value_start     = d_start + num_patches;
+        d_cache.data            = d_data;
+        CUDA_ERROR(cudaMemcpy(m_d_adjacency_cache + i,
+                              &d_cache,
+                              sizeof(AdjacencyCache),
+                              cudaMemcpyHostToDevice));
+#endif
+    }
+
+    /**
+     * @brief build the k-ring (with k rings) of every owned vertex on the host
+     * and copy it to the device. The k-ring of a vertex is expanded ring by
+     * ring (breadth-first) from the 1-rings of all vertices. Since k-rings are
+     * small, duplicates are removed with a linear search (similar to
+     * higher_query_block_dispatcher)
+     */
+    void build_k_ring_impl(const uint32_t k)
+    {
+        RXMESH_TRACE_SCOPE("RXMeshStatic::build_k_ring");
+
+        release_k_ring();
+
+        const uint32_t num_patches = this->get_num_patches();
+
+        // the slot of the local vertex v in patch p is start[p] + v
+        std::vector<uint32_t>& start = m_h_k_ring_start;
+        start.resize(num_patches + 1);
+        start[0] = 0;
+        for (uint32_t p = 0; p < num_patches; ++p) {
+            start[p + 1] = start[p] + this->m_h_patches_info[p].num_vertices[0];
+        }
+        const uint32_t num_slots = start[num_patches];
+
+        auto slot = [&](const VertexHandle& vh) {
+            return start[vh.patch_id()] + vh.local_id();
+        };
+
+        // the 1-ring of every owned vertex with the neighbors resolved to
+        // their owner handles (through the iterator)
+        std::vector<std::vector<VertexHandle>> one_ring(num_slots);
+        run_query_host<Op::VV>(
+            [&](const VertexHandle& vh, const VertexIterator& iter) {
+                std::vector<VertexHandle>& ring = one_ring[slot(vh)];
+                ring.reserve(iter.size());
+                for (uint16_t i = 0; i < iter.size(); ++i) {
+                    const VertexHandle n = iter[i];
+                    if (n.is_valid()) {
+                        ring.push_back(n);
+                    }
+                }
+            });
+
+        // expand the rings where the size of every ring is stored in offset
+        // which is then turned into row offsets
+        std::vector<uint32_t>& offset = m_h_k_ring_offset;
+        offset.resize(size_t(num_slots) * k + 1, 0);
+
+        std::vector<std::vector<VertexHandle>> k_ring(num_slots);
+
+        this->for_each_patch_host([&](uint32_t p) {
+            const uint16_t num_v = this->m_h_patches_info[p].num_vertices[0];
+            for (uint16_t v = 0; v < num_v; ++v) {
+                const uint32_t s = start[p] + v;
+                if (one_ring[s].empty()) {
+                    continue;
+                }
+                const VertexHandle         vh(p, v);
+                std::vector<VertexHandle>& ring = k_ring[s];
+
+                ring = one_ring[s];
+                offset[size_t(s) * k] = static_cast<uint32_t>(ring.size());
+
+                size_t begin = 0;
+                for (uint32_t r = 1; r < k; ++r) {
+                    const size_t end = ring.size();
+                    for (size_t i = begin; i < end; ++i) {
+                        for (const VertexHandle& n : one_ring[slot(ring[i])]) {
+                            if (n != vh && std::find(ring.begin(),
+                                                     ring.end(),
+                                                     n) == ring.end()) {
+                                ring.push_back(n);
+                            }
+                        }
+                    }
+                    offset[size_t(s) * k + r] =
+                        static_cast<uint32_t>(ring.size() - end);
+                    begin = end;
+                }
+            }
+        });
+
+        uint32_t sum = 0;
+        for (size_t i = 0; i < offset.size(); ++i) {
+            const uint32_t size = offset[i];
+            offset[i]           = sum;
+            sum += size;
+        }
+
+        std::vector<VertexHandle>& value = m_h_k_ring_value;
+        value.resize(std::max<uint32_t>(sum, 1));
+        this->for_each_patch_host([&](uint32_t p) {
+            for (uint32_t s = start[p]; s < start[p + 1]; ++s) {
+                std::copy(k_ring[s].begin(),
+                          k_ring[s].end(),
+                          value.begin() + offset[size_t(s) * k]);
+            }
+        });
+
+        m_k_ring.m_k         = k;
+        m_k_ring.m_num_rings = k;
+        m_k_ring.m_h_start   = start.data();
+        m_k_ring.m_h_offset  = offset.data();
+        m_k_ring.m_h_value   = value.data();
+
+#ifdef RX_CPU_ONLY
+        m_k_ring.m_d_start  = m_k_ring.m_h_start;
+        m_k_ring.m_d_offset = m_k_ring.m_h_offset;
+        m_k_ring.m_d_value  = m_k_ring.m_h_value;
+#else
+        uint32_t *    d_start(nullptr), *d_offset(nullptr);
+        VertexHandle* d_value(nullptr);
+        CUDA_ERROR(
+            cudaMalloc((void**)&d_start, start.size() * sizeof(uint32_t)));
+        CUDA_ERROR(
+            cudaMalloc((void**)&d_offset, offset.size() * sizeof(uint32_t)));
+        CUDA_ERROR(
+            cudaMalloc((void**)&d_value, value.size() * sizeof(VertexHandle)));
+        CUDA_ERROR(cudaMemcpy(d_start,
+                              start.data(),
+                              start.size() * sizeof(uint32_t),
+                              cudaMemcpyHostToDevice));
+        CUDA_ERROR(cudaMemcpy(d_offset,
+                              offset.data(),
+                              offset.size() * sizeof(uint32_t),
+                              cudaMemcpyHostToDevice));
+        CUDA_ERROR(cudaMemcpy(d_value,
+                              value.data(),
+                              value.size() * sizeof(VertexHandle),
+                              cudaMemcpyHostToDevice));
+        m_k_ring.m_d_start  = d_start;
+        m_k_ring.m_d_offset = d_offset;
+        m_k_ring.m_d_value  = d_value;
+#endif
+    }
+
+    /**
+     * @brief run run(p, begin, end) on the local elements [begin, end) of
+     * every patch p on the host where cost(p) is the number of local elements
+     * in patch p and num_elements is the total number of elements in the
+     * mesh. With with_omp, large patches are split into element ranges and
+     * the tasks are load-balanced with the work-stealing HostScheduler
+     */
+    template <typename CostT, typename RunT>
+    void for_each_host_task(CostT          cost,
+                            const uint32_t num_elements,
+                            const bool     with_omp,
+                            RunT           run) const
+    {
+        const uint32_t num_patches = this->get_num_patches();
+
+        if (!with_omp) {
+            for (uint32_t p = 0; p < num_patches; ++p) {
+                run(p, 0, cost(p));
+            }
+            return;
+        }
+
+        // with host affinity, every patch is queued to its home thread
+        const detail::HostAffinity* affinity = this->get_host_affinity();
+        const int                   num_threads =
+            affinity ? affinity->get_num_threads() : omp_get_max_threads();
+
+        detail::HostScheduler scheduler(
+            num_patches,
+            cost,
+            detail::HostScheduler::default_split_size(num_elements,
+                                                      num_threads),
+            num_threads,
+            affinity);
+
+        scheduler.run([&](const detail::HostTask& task, int) {
+            run(task.patch_id, task.begin, task.end);
+        });
+    }
+
     template <typename AttributeT>
     void export_vtk(std::fstream&     file,
                     bool&             first_v_attr,
@@ -2210,6 +3083,7 @@ class RXMeshStatic : public RXMesh
         return dynamic_smem;
     }
 
+#ifndef RX_CPU_ONLY
     void check_shared_memory(const uint32_t smem_bytes_dyn,
                              size_t&        smem_bytes_static,
                              uint32_t&      num_reg_per_thread,
@@ -2307,6 +3181,28 @@ class RXMeshStatic : public RXMesh
             // exit(EXIT_FAILURE);
         }
     }
+#endif
+
+    /**
+     * @brief initialize polyscope and register the input mesh (and its patches)
+     * once the vertex coordinates are added. Does nothing if polyscope is not
+     * used
+     */
+    void add_input_mesh_to_polyscope(const std::string& mesh_name)
+    {
+#if USE_POLYSCOPE
+        // polyscope::options::autocenterStructures = true;
+        // polyscope::options::autoscaleStructures  = true;
+        // polyscope::options::automaticallyComputeSceneExtents = true;
+        polyscope::init();
+        m_polyscope_mesh_name = mesh_name.empty() ? "RXMesh" : mesh_name;
+        m_polyscope_mesh_name += std::to_string(rand());
+        this->register_polyscope();
+        render_vertex_patch();
+        render_edge_patch();
+        render_face_patch();
+#endif
+    }
 
 #if USE_POLYSCOPE
     void add_patch_to_polyscope(const uint32_t                        p,
@@ -2395,10 +3291,28 @@ class RXMeshStatic : public RXMesh
 
     std::string             m_polyscope_mesh_name;
     polyscope::SurfaceMesh* m_polyscope_mesh;
-    EdgeMapT                m_polyscope_edges_map;
+    EdgeHashMapT            m_polyscope_edges_map;
 #endif
 
     std::shared_ptr<AttributeContainer>     m_attr_container;
     std::shared_ptr<VertexAttribute<float>> m_input_vertex_coordinates;
+
+    // the adjacency cache indexed by Op (see build_adjacency_cache()). The
+    // host entries point to m_h_adjacency_start/data and the device entries
+    // (with their host copy in m_h_adjacency_cache_on_device) point to device
+    // memory. In a CPU-only build, the device entries are the host entries
+    std::vector<AdjacencyCache>        m_h_adjacency_cache;
+    std::vector<AdjacencyCache>        m_h_adjacency_cache_on_device;
+    AdjacencyCache*                    m_d_adjacency_cache = nullptr;
+    std::vector<std::vector<uint32_t>> m_h_adjacency_start;
+    std::vector<std::vector<uint16_t>> m_h_adjacency_data;
+
+    // the k-ring (see build_k_ring()) where the host pointers of m_k_ring
+    // point to m_h_k_ring_start/offset/value. In a CPU-only build, the device
+    // pointers are the host pointers
+    KRing                     m_k_ring;
+    std::vector<uint32_t>     m_h_k_ring_start;
+    std::vector<uint32_t>     m_h_k_ring_offset;
+    std::vector<VertexHandle> m_h_k_ring_value;
 };
 }  // namespace rxmesh
\ No newline at end of file
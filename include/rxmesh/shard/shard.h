@@ -0,0 +1,467 @@
+#pragma once
+#include <stdint.h>
+#include <string.h>
+#include <algorithm>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "rxmesh/handle.h"
+#include "rxmesh/patch_store.h"
+#include "rxmesh/shard/transport.h"
+#include "rxmesh/util/log.h"
+#include "rxmesh/util/macros.h"
+
+namespace rxmesh {
+
+/**
+ * @brief assign the patches of a store to num_shards shards as contiguous
+ * ranges of patch ids where every range has (roughly) the same number of
+ * faces. Patches with nearby ids are spatially close (for all patchers) and
+ * so contiguous ranges keep the ribbons between shards small. Return the
+ * shard of every patch
+ */
+inline std::vector<int> assign_patches_to_shards(const PatchStore& store,
+                                                 const int         num_shards)
+{
+    const uint32_t   num_patches = store.get_num_patches();
+    std::vector<int> shard(num_patches, 0);
+
+    uint64_t total = 0;
+    for (uint32_t p = 0; p < num_patches; ++p) {
+        total += store.get_num_elements<FaceHandle>(p);
+    }
+
+    uint64_t prefix = 0;
+    for (uint32_t p = 0; p < num_patches; ++p) {
+        // the shard of the patch is decided by its middle face
+        const uint64_t nf  = store.get_num_elements<FaceHandle>(p);
+        const uint64_t mid = prefix + nf / 2;
+        shard[p]           = std::min<int>(
+            num_shards - 1,
+            static_cast<int>(mid * num_shards / std::max<uint64_t>(total, 1)));
+        prefix += nf;
+    }
+    return shard;
+}
+
+/**
+ * @brief the values of an attribute on the local patches of a shard. Every
+ * local patch stores the values of all its elements (owned and ribbon) where
+ * attribute j of local element l is at [l * num_attributes + j]. Values of
+ * ribbon (not-owned) elements are only valid after Shard::halo_exchange()
+ */
+template <typename T, typename HandleT>
+class ShardAttribute
+{
+   public:
+    ShardAttribute() = default;
+
+    T& operator()(const HandleT h, const uint32_t j = 0)
+    {
+        return m_values[(*m_local_index)[h.patch_id()]]
+                       [size_t(h.local_id()) * m_num_attributes + j];
+    }
+
+    const T& operator()(const HandleT h, const uint32_t j = 0) const
+    {
+        return m_values[(*m_local_index)[h.patch_id()]]
+                       [size_t(h.local_id()) * m_num_attributes + j];
+    }
+
+    uint32_t get_num_attributes() const
+    {
+        return m_num_attributes;
+    }
+
+    /**
+     * @brief the values of the i-th local patch of the shard
+     */
+    std::vector<T>& get_patch_values(const uint32_t i)
+    {
+        return m_values[i];
+    }
+
+   private:
+    friend class Shard;
+
+    uint32_t                                     m_num_attributes = 0;
+    std::vector<std::vector<T>>                  m_values;
+    std::shared_ptr<const std::vector<uint32_t>> m_local_index;
+};
+
+/**
+ * @brief one shard of a sharded (distributed-memory) run. A shard loads only
+ * its local patches from a PatchStore. Every patch already contains its
+ * ribbon i.e., the not-owned elements that are needed to run queries on the
+ * owned elements, so no other patches are loaded. Attributes are stored per
+ * local patch (ShardAttribute) and halo_exchange() copies the values of the
+ * ribbon elements from their owners, which could be in a local patch or in a
+ * patch of another shard. The communication pattern (who sends which values
+ * to whom) is computed once in the constructor, so the exchange only sends
+ * the values, in a known order.
+ * All shards should construct their Shard and call halo_exchange() on the
+ * same attributes in the same order
+ */
+class Shard
+{
+   public:
+    /**
+     * @param store the patch store (every shard opens the same store)
+     * @param transport the transport of this shard
+     * @param shard_of_patch the shard of every patch. If empty,
+     * assign_patches_to_shards() is used
+     */
+    Shard(PatchStore&             store,
+          Transport&              transport,
+          const std::vector<int>& shard_of_patch = {})
+        : m_transport(transport),
+          m_shard_of_patch(shard_of_patch),
+          m_num_sent_bytes(0)
+    {
+        if (m_shard_of_patch.empty()) {
+            m_shard_of_patch =
+                assign_patches_to_shards(store, m_transport.size());
+        }
+        if (m_shard_of_patch.size() != store.get_num_patches()) {
+            RXMESH_ERROR(
+                "Shard::Shard() shard_of_patch size ({}) does not match the "
+                "number of patches ({})",
+                m_shard_of_patch.size(),
+                store.get_num_patches());
+            return;
+        }
+
+        auto local_index = std::make_shared<std::vector<uint32_t>>(
+            store.get_num_patches(), INVALID32);
+        for (uint32_t p = 0; p < store.get_num_patches(); ++p) {
+            if (m_shard_of_patch[p] == rank()) {
+                (*local_index)[p] = static_cast<uint32_t>(m_patches.size());
+                m_patches.push_back(store.get_patch(p));
+                if (m_patches.back() == nullptr) {
+                    RXMESH_ERROR("Shard::Shard() can not load patch {}", p);
+                    return;
+                }
+            }
+        }
+        m_local_index = local_index;
+
+        build_plan<VertexHandle>(m_plan[0]);
+        build_plan<EdgeHandle>(m_plan[1]);
+        build_plan<FaceHandle>(m_plan[2]);
+    }
+
+    Shard(const Shard&)            = delete;
+    Shard& operator=(const Shard&) = delete;
+
+    int rank() const
+    {
+        return m_transport.rank();
+    }
+
+    int size() const
+    {
+        return m_transport.size();
+    }
+
+    Transport& get_transport()
+    {
+        return m_transport;
+    }
+
+    /**
+     * @brief the shard that a patch belongs to
+     */
+    int get_shard(const uint32_t p) const
+    {
+        return m_shard_of_patch[p];
+    }
+
+    uint32_t get_num_local_patches() const
+    {
+        return static_cast<uint32_t>(m_patches.size());
+    }
+
+    /**
+     * @brief the i-th local patch
+     */
+    const PatchRecord& get_local_patch(const uint32_t i) const
+    {
+        return *m_patches[i];
+    }
+
+    /**
+     * @brief number of ribbon elements (of type HandleT) in the local patches
+     * whose owner is in another shard i.e., the number of values received by
+     * one halo_exchange() per attribute
+     */
+    template <typename HandleT>
+    size_t get_num_halo_elements() const
+    {
+        const HaloPlan& plan = m_plan[plan_id<HandleT>()];
+        size_t          n    = 0;
+        for (const auto& slots : plan.recv_slots) {
+            n += slots.size();
+        }
+        return n;
+    }
+
+    /**
+     * @brief total number of bytes this shard sent by halo_exchange()
+     */
+    size_t get_num_sent_bytes() const
+    {
+        return m_num_sent_bytes;
+    }
+
+    /**
+     * @brief call func(const PatchRecord&, const HandleT) on every element
+     * owned by the local patches. for_each_vertex/edge/face are shortcuts
+     */
+    template <typename HandleT, typename FuncT>
+    void for_each(FuncT func) const
+    {
+        using LocalT = typename HandleT::LocalT;
+        for (const auto& rec : m_patches) {
+            const uint16_t n = rec->template get_num_elements<HandleT>();
+            for (uint16_t l = 0; l < n; ++l) {
+                if (rec->template is_owned<HandleT>(l)) {
+                    func(*rec, HandleT(rec->patch_id, LocalT(l)));
+                }
+            }
+        }
+    }
+
+    template <typename FuncT>
+    void for_each_vertex(FuncT func) const
+    {
+        for_each<VertexHandle>(func);
+    }
+
+    template <typename FuncT>
+    void for_each_edge(FuncT func) const
+    {
+        for_each<EdgeHandle>(func);
+    }
+
+    template <typename FuncT>
+    void for_each_face(FuncT func) const
+    {
+        for_each<FaceHandle>(func);
+    }
+
+    /**
+     * @brief allocate an attribute on the local patches with all values set
+     * to init
+     */
+    template <typename T, typename HandleT>
+    ShardAttribute<T, HandleT> add_attribute(const uint32_t num_attributes,
+                                             const T        init = T())
+    {
+        ShardAttribute<T, HandleT> attr;
+        attr.m_num_attributes = num_attributes;
+        attr.m_local_index    = m_local_index;
+        attr.m_values.resize(m_patches.size());
+        for (size_t i = 0; i < m_patches.size(); ++i) {
+            attr.m_values[i].resize(
+                size_t(m_patches[i]->template get_num_elements<HandleT>()) *
+                    num_attributes,
+                init);
+        }
+        return attr;
+    }
+
+    /**
+     * @brief copy the values of the owned elements to their ribbon copies in
+     * all shards. Every shard should call it (collective)
+     */
+    template <typename T, typename HandleT>
+    void halo_exchange(ShardAttribute<T, HandleT>& attr)
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+
+        const HaloPlan& plan = m_plan[plan_id<HandleT>()];
+        const uint32_t  na   = attr.m_num_attributes;
+
+        // ribbon elements owned by another local patch
+        for (const auto& c : plan.local) {
+            for (uint32_t j = 0; j < na; ++j) {
+                attr.m_values[c.dst_patch][size_t(c.dst_local) * na + j] =
+                    attr.m_values[c.src_patch][size_t(c.src_local) * na + j];
+            }
+        }
+
+        // pack the values requested by every other shard
+        std::vector<std::vector<char>> out(size());
+        for (int r = 0; r < size(); ++r) {
+            const auto& slots = plan.send_slots[r];
+            out[r].resize(slots.size() * na * sizeof(T));
+            T* dst = reinterpret_cast<T*>(out[r].data());
+            for (size_t s = 0; s < slots.size(); ++s) {
+                const T* src = attr.m_values[slots[s].first].data() +
+                               size_t(slots[s].second) * na;
+                memcpy(dst + s * na, src, na * sizeof(T));
+            }
+        }
+
+        std::vector<std::vector<char>> in;
+        exchange(out, in);
+
+        for (int r = 0; r < size(); ++r) {
+            const auto& slots = plan.recv_slots[r];
+            if (in[r].size() != slots.size() * na * sizeof(T)) {
+                RXMESH_ERROR(
+                    "Shard::halo_exchange() rank {} received {} bytes from "
+                    "rank {} while expecting {}",
+                    rank(),
+                    in[r].size(),
+                    r,
+                    slots.size() * na * sizeof(T));
+                continue;
+            }
+            const T* src = reinterpret_cast<const T*>(in[r].data());
+            for (size_t s = 0; s < slots.size(); ++s) {
+                T* dst = attr.m_values[slots[s].first].data() +
+                         size_t(slots[s].second) * na;
+                memcpy(dst, src + s * na, na * sizeof(T));
+            }
+        }
+    }
+
+   private:
+    struct LocalCopy
+    {
+        uint32_t dst_patch;
+        uint16_t dst_local;
+        uint32_t src_patch;
+        uint16_t src_local;
+    };
+
+    // the communication pattern of one element type. Patches are indexed by
+    // their local index in the shard
+    struct HaloPlan
+    {
+        std::vector<LocalCopy> local;
+        // (local patch, local element) of the values received from rank r
+        // in the order they are received
+        std::vector<std::vector<std::pair<uint32_t, uint16_t>>> recv_slots;
+        // (local patch, local element) of the values sent to rank r in the
+        // order they are sent
+        std::vector<std::vector<std::pair<uint32_t, uint16_t>>> send_slots;
+    };
+
+    template <typename HandleT>
+    static constexpr int plan_id()
+    {
+        if constexpr (std::is_same_v<HandleT, VertexHandle>) {
+            return 0;
+        }
+        if constexpr (std::is_same_v<HandleT, EdgeHandle>) {
+            return 1;
+        }
+        if constexpr (std::is_same_v<HandleT, FaceHandle>) {
+            return 2;
+        }
+    }
+
+    /**
+     * @brief send out[r] to every rank r and receive in[r] from every rank r.
+     * Every pair of ranks exchanges in a fixed order (the lower rank sends
+     * first) and pairs are visited in increasing order, so blocking
+     * transports do not deadlock
+     */
+    void exchange(const std::vector<std::vector<char>>& out,
+                  std::vector<std::vector<char>>&       in)
+    {
+        in.assign(size(), {});
+        for (int r = 0; r < size(); ++r) {
+            if (r == rank()) {
+                continue;
+            }
+            if (rank() < r) {
+                m_transport.send(r, out[r].data(), out[r].size());
+                m_transport.recv(r, in[r]);
+            } else {
+                m_transport.recv(r, in[r]);
+                m_transport.send(r, out[r].data(), out[r].size());
+            }
+            m_num_sent_bytes += out[r].size();
+        }
+    }
+
+    template <typename HandleT>
+    void build_plan(HaloPlan& plan)
+    {
+        plan.recv_slots.assign(size(), {});
+        plan.send_slots.assign(size(), {});
+
+        // the requests sent to every rank as (owner patch, owner local) pairs
+        std::vector<std::vector<uint32_t>> requests(size());
+
+        for (uint32_t i = 0; i < m_patches.size(); ++i) {
+            const PatchRecord& rec = *m_patches[i];
+            const uint16_t     n   = rec.template get_num_elements<HandleT>();
+            for (uint16_t l = 0; l < n; ++l) {
+                if (rec.template is_owned<HandleT>(l) ||
+                    rec.template is_deleted<HandleT>(l)) {
+                    continue;
+                }
+                const HandleT owner =
+                    rec.template get_owner_handle<HandleT>(l);
+                const uint32_t op = owner.patch_id();
+                const int      r  = m_shard_of_patch[op];
+                if (r == rank()) {
+                    plan.local.push_back(
+                        {i, l, (*m_local_index)[op], owner.local_id()});
+                } else {
+                    plan.recv_slots[r].push_back({i, l});
+                    requests[r].push_back(op);
+                    requests[r].push_back(owner.local_id());
+                }
+            }
+        }
+
+        std::vector<std::vector<char>> out(size()), in;
+        for (int r = 0; r < size(); ++r) {
+            out[r].resize(requests[r].size() * sizeof(uint32_t));
+            if (!requests[r].empty()) {
+                memcpy(out[r].data(), requests[r].data(), out[r].size());
+            }
+        }
+        exchange(out, in);
+        m_num_sent_bytes = 0;
+
+        for (int r = 0; r < size(); ++r) {
+            const size_t          num = in[r].size() / (2 * sizeof(uint32_t));
+            std::vector<uint32_t> req(2 * num);
+            if (num > 0) {
+                memcpy(req.data(), in[r].data(), 2 * num * sizeof(uint32_t));
+            }
+            for (size_t s = 0; s < num; ++s) {
+                const uint32_t p = req[2 * s];
+                if (p >= m_local_index->size() ||
+                    (*m_local_index)[p] == INVALID32) {
+                    RXMESH_ERROR(
+                        "Shard::build_plan() rank {} requested patch {} from "
+                        "rank {} which does not own it",
+                        r,
+                        p,
+                        rank());
+                    continue;
+                }
+                plan.send_slots[r].push_back(
+                    {(*m_local_index)[p],
+                     static_cast<uint16_t>(req[2 * s + 1])});
+            }
+        }
+    }
+
+    Transport&                                      m_transport;
+    std::vector<int>                                m_shard_of_patch;
+    std::vector<std::shared_ptr<const PatchRecord>> m_patches;
+    std::shared_ptr<const std::vector<uint32_t>>    m_local_index;
+    HaloPlan                                        m_plan[3];
+    size_t                                          m_num_sent_bytes;
+};
+}  // namespace rxmesh
@@ -0,0 +1,415 @@
+#pragma once
+#include <stdint.h>
+#include <string.h>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#ifndef _WIN32
+#include <errno.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <chrono>
+#include <thread>
+#endif
+
+#include "rxmesh/util/log.h"
+
+namespace rxmesh {
+
+/**
+ * @brief point-to-point message passing between the shards (ranks) of a
+ * sharded run. Messages between a pair of ranks are delivered in the order
+ * they are sent. send() may block until the receiver starts receiving, so
+ * callers should order their sends and receives such that they do not
+ * deadlock (see Shard::halo_exchange())
+ */
+class Transport
+{
+   public:
+    virtual ~Transport() = default;
+
+    /**
+     * @brief the rank of this shard in [0, size())
+     */
+    virtual int rank() const = 0;
+
+    /**
+     * @brief the number of shards
+     */
+    virtual int size() const = 0;
+
+    virtual void send(const int    dst,
+                      const void*  data,
+                      const size_t num_bytes) = 0;
+
+    /**
+     * @brief receive the next message from src. Blocks until it arrives
+     */
+    virtual void recv(const int src, std::vector<char>& data) = 0;
+
+    /**
+     * @brief block until all ranks reach the barrier
+     */
+    virtual void barrier()
+    {
+        const char        token = 0;
+        std::vector<char> msg;
+        if (rank() == 0) {
+            for (int r = 1; r < size(); ++r) {
+                recv(r, msg);
+            }
+            for (int r = 1; r < size(); ++r) {
+                send(r, &token, 1);
+            }
+        } else {
+            send(0, &token, 1);
+            recv(0, msg);
+        }
+    }
+};
+
+/**
+ * @brief transport between shards that run as threads of the same process.
+ * Every pair of ranks has a mailbox in shared memory and send() never blocks
+ */
+class LocalTransport : public Transport
+{
+   public:
+    /**
+     * @brief create the transports of num_ranks shards that talk to each
+     * other. Transport i should be used by rank i
+     */
+    static std::vector<std::unique_ptr<Transport>> create(const int num_ranks)
+    {
+        auto hub = std::make_shared<Hub>(num_ranks);
+        std::vector<std::unique_ptr<Transport>> ret;
+        for (int r = 0; r < num_ranks; ++r) {
+            ret.emplace_back(new LocalTransport(hub, r));
+        }
+        return ret;
+    }
+
+    int rank() const override
+    {
+        return m_rank;
+    }
+
+    int size() const override
+    {
+        return m_hub->num_ranks;
+    }
+
+    void send(const int dst, const void* data, const size_t num_bytes) override
+    {
+        Mailbox& box = m_hub->mailbox(m_rank, dst);
+        {
+            std::lock_guard<std::mutex> lock(box.mutex);
+            const char*                 ptr = static_cast<const char*>(data);
+            box.messages.emplace_back(ptr, ptr + num_bytes);
+        }
+        box.cv.notify_one();
+    }
+
+    void recv(const int src, std::vector<char>& data) override
+    {
+        Mailbox&                     box = m_hub->mailbox(src, m_rank);
+        std::unique_lock<std::mutex> lock(box.mutex);
+        box.cv.wait(lock, [&] { return !box.messages.empty(); });
+        data = std::move(box.messages.front());
+        box.messages.pop_front();
+    }
+
+   private:
+    struct Mailbox
+    {
+        std::mutex                    mutex;
+        std::condition_variable       cv;
+        std::deque<std::vector<char>> messages;
+    };
+
+    struct Hub
+    {
+        explicit Hub(const int n) : num_ranks(n), boxes(size_t(n) * n)
+        {
+        }
+
+        Mailbox& mailbox(const int src, const int dst)
+        {
+            return boxes[size_t(src) * num_ranks + dst];
+        }
+
+        int                  num_ranks;
+        std::vector<Mailbox> boxes;
+    };
+
+    LocalTransport(std::shared_ptr<Hub> hub, const int rank)
+        : m_hub(hub), m_rank(rank)
+    {
+    }
+
+    std::shared_ptr<Hub> m_hub;
+    int                  m_rank;
+};
+
+#ifndef _WIN32
+/**
+ * @brief transport between shards that run as separate processes on the same
+ * machine using Unix domain sockets. Rank r listens on the socket file
+ * "<prefix>.<r>" and every pair of ranks is connected by one stream socket
+ * (the higher rank connects to the lower one). All ranks should use the same
+ * prefix
+ */
+class UnixSocketTransport : public Transport
+{
+   public:
+    /**
+     * @param prefix path prefix of the socket files
+     * @param rank the rank of this process
+     * @param num_ranks the number of processes
+     * @param timeout_ms how long to wait for the other ranks to start. This
+     * bounds both connecting to the lower ranks and accepting the higher ranks
+     * so that a rank that never starts (or dies during the handshake) makes
+     * the others fail instead of hang
+     */
+    UnixSocketTransport(const std::string& prefix,
+                        const int          rank,
+                        const int          num_ranks,
+                        const int          timeout_ms = 30000)
+        : m_rank(rank), m_size(num_ranks), m_fd(num_ranks, -1), m_listen_fd(-1)
+    {
+        m_path = prefix + "." + std::to_string(rank);
+
+        const auto deadline = std::chrono::steady_clock::now() +
+                              std::chrono::milliseconds(timeout_ms);
+
+        // listen for the higher ranks
+        if (rank < num_ranks - 1) {
+            m_listen_fd      = socket(AF_UNIX, SOCK_STREAM, 0);
+            sockaddr_un addr = make_address(m_path);
+            unlink(m_path.c_str());
+            if (m_listen_fd < 0 ||
+                bind(m_listen_fd, (sockaddr*)&addr, sizeof(addr)) != 0 ||
+                listen(m_listen_fd, num_ranks) != 0) {
+                RXMESH_ERROR(
+                    "UnixSocketTransport rank {} can not listen on {} ({})",
+                    rank,
+                    m_path,
+                    strerror(errno));
+                return;
+            }
+        }
+
+        // connect to the lower ranks
+        for (int r = 0; r < rank; ++r) {
+            const std::string path = prefix + "." + std::to_string(r);
+            sockaddr_un       addr = make_address(path);
+            int               fd   = -1;
+            while (std::chrono::steady_clock::now() < deadline) {
+                fd = socket(AF_UNIX, SOCK_STREAM, 0);
+                if (connect(fd, (sockaddr*)&addr, sizeof(addr)) == 0) {
+                    break;
+                }
+                close(fd);
+                fd = -1;
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            }
+            if (fd < 0) {
+                RXMESH_ERROR(
+                    "UnixSocketTransport rank {} can not connect to rank {}",
+                    rank,
+                    r);
+                return;
+            }
+            const int32_t me = rank;
+            write_all(fd, &me, sizeof(me));
+            m_fd[r] = fd;
+        }
+
+        // accept the higher ranks (in any order)
+        for (int i = rank + 1; i < num_ranks; ++i) {
+            if (!wait_readable(m_listen_fd, deadline)) {
+                RXMESH_ERROR(
+                    "UnixSocketTransport rank {} timed out waiting for the "
+                    "higher ranks to connect",
+                    rank);
+                return;
+            }
+            const int fd = accept(m_listen_fd, nullptr, nullptr);
+            int32_t   r  = -1;
+            if (fd < 0 || !wait_readable(fd, deadline) ||
+                !read_all(fd, &r, sizeof(r)) || r <= rank || r >= num_ranks ||
+                m_fd[r] >= 0) {
+                RXMESH_ERROR(
+                    "UnixSocketTransport rank {} failed to accept (rank {})",
+                    rank,
+                    r);
+                if (fd >= 0) {
+                    close(fd);
+                }
+                return;
+            }
+            m_fd[r] = fd;
+        }
+    }
+
+    UnixSocketTransport(const UnixSocketTransport&)            = delete;
+    UnixSocketTransport& operator=(const UnixSocketTransport&) = delete;
+
+    ~UnixSocketTransport()
+    {
+        for (const int fd : m_fd) {
+            if (fd >= 0) {
+                close(fd);
+            }
+        }
+        if (m_listen_fd >= 0) {
+            close(m_listen_fd);
+            unlink(m_path.c_str());
+        }
+    }
+
+    /**
+     * @brief true if this rank is connected to all other ranks
+     */
+    bool is_ok() const
+    {
+        for (int r = 0; r < m_size; ++r) {
+            if (r != m_rank && m_fd[r] < 0) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    int rank() const override
+    {
+        return m_rank;
+    }
+
+    int size() const override
+    {
+        return m_size;
+    }
+
+    void send(const int dst, const void* data, const size_t num_bytes) override
+    {
+        const uint64_t n = num_bytes;
+        if (!write_all(m_fd[dst], &n, sizeof(n)) ||
+            !write_all(m_fd[dst], data, num_bytes)) {
+            RXMESH_ERROR("UnixSocketTransport::send() to rank {} failed ({})",
+                         dst,
+                         strerror(errno));
+        }
+    }
+
+    void recv(const int src, std::vector<char>& data) override
+    {
+        uint64_t n = 0;
+        if (!read_all(m_fd[src], &n, sizeof(n))) {
+            RXMESH_ERROR("UnixSocketTransport::recv() from rank {} failed",
+                         src);
+            data.clear();
+            return;
+        }
+        data.resize(n);
+        if (!read_all(m_fd[src], data.data(), n)) {
+            RXMESH_ERROR("UnixSocketTransport::recv() from rank {} failed",
+                         src);
+            data.clear();
+        }
+    }
+
+   private:
+    static sockaddr_un make_address(const std::string& path)
+    {
+        sockaddr_un addr;
+        memset(&addr, 0, sizeof(addr));
+        addr.sun_family = AF_UNIX;
+        if (path.size() >= sizeof(addr.sun_path)) {
+            RXMESH_ERROR("UnixSocketTransport socket path {} is too long",
+                         path);
+        }
+        strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1);
+        return addr;
+    }
+
+    static bool write_all(const int fd, const void* data, size_t num_bytes)
+    {
+        const char* ptr = static_cast<const char*>(data);
+        while (num_bytes > 0) {
+#ifdef MSG_NOSIGNAL
+            const ssize_t n = ::send(fd, ptr, num_bytes, MSG_NOSIGNAL);
+#else
+            const ssize_t n = ::send(fd, ptr, num_bytes, 0);
+#endif
+            if (n < 0 && errno == EINTR) {
+                continue;
+            }
+            if (n <= 0) {
+                return false;
+            }
+            ptr += n;
+            num_bytes -= n;
+        }
+        return true;
+    }
+
+    /**
+     * @brief wait until fd is readable (or has a pending connection) or the
+     * deadline passes. Return false on timeout or error
+     */
+    static bool wait_readable(
+        const int                                    fd,
+        const std::chrono::steady_clock::time_point& deadline)
+    {
+        while (true) {
+            const auto remaining =
+                std::chrono::duration_cast<std::chrono::milliseconds>(
+                    deadline - std::chrono::steady_clock::now())
+                    .count();
+            if (remaining <= 0) {
+                return false;
+            }
+            pollfd pfd;
+            pfd.fd      = fd;
+            pfd.events  = POLLIN;
+            pfd.revents = 0;
+            const int n = poll(&pfd, 1, static_cast<int>(remaining));
+            if (n < 0 && errno == EINTR) {
+                continue;
+            }
+            return n > 0 && (pfd.revents & POLLIN);
+        }
+    }
+
+    static bool read_all(const int fd, void* data, size_t num_bytes)
+    {
+        char* ptr = static_cast<char*>(data);
+        while (num_bytes > 0) {
+            const ssize_t n = ::recv(fd, ptr, num_bytes, 0);
+            if (n < 0 && errno == EINTR) {
+                continue;
+            }
+            if (n <= 0) {
+                return false;
+            }
+            ptr += n;
+            num_bytes -= n;
+        }
+        return true;
+    }
+
+    int              m_rank;
+    int              m_size;
+    std::vector<int> m_fd;
+    int              m_listen_fd;
+    std::string      m_path;
+};
+#endif
+}  // namespace rxmesh
@@ -70,6 +70,21 @@ static std::string location_to_string(const locationT location)
     }
 }
 
+#ifdef RX_CPU_ONLY
+namespace detail {
+/**
+ * @brief where work requested at location runs in a CPU-only build. The host
+ * and the device share one memory space and so work requested on DEVICE (or
+ * on both) runs once on HOST
+ */
+inline locationT cpu_location(const locationT location)
+{
+    return ((location & (HOST | DEVICE)) != LOCATION_NONE) ? HOST :
+                                                              LOCATION_NONE;
+}
+}  // namespace detail
+#endif
+
 /**
  * @brief Memory layout
  */
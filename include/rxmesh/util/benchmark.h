@@ -0,0 +1,402 @@
+#pragma once
+#include <rapidjson/document.h>
+#include <rapidjson/istreamwrapper.h>
+#include <stdint.h>
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <map>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "rxmesh/util/log.h"
+#include "rxmesh/util/timer.h"
+
+namespace rxmesh {
+
+/**
+ * @brief summary statistics of the timing samples (in ms) of one benchmark
+ * stage. The confidence interval is a distribution-free interval of the
+ * median (based on order statistics) since timings are rarely normal
+ */
+struct BenchmarkStats
+{
+    uint32_t num_samples = 0;
+    double   mean        = 0;
+    double   stddev      = 0;
+    double   min         = 0;
+    double   max         = 0;
+    double   median      = 0;
+    double   p05         = 0;
+    double   p95         = 0;
+    double   ci_lower    = 0;
+    double   ci_upper    = 0;
+};
+
+namespace detail {
+
+/**
+ * @brief the p-th quantile (p in [0, 1]) of sorted samples with linear
+ * interpolation between the closest ranks
+ */
+inline double sorted_percentile(const std::vector<double>& sorted,
+                                const double               p)
+{
+    if (sorted.empty()) {
+        return 0;
+    }
+    const double pos = std::clamp(p, 0.0, 1.0) * double(sorted.size() - 1);
+    const size_t lo  = static_cast<size_t>(std::floor(pos));
+    const size_t hi  = std::min(lo + 1, sorted.size() - 1);
+    return sorted[lo] + (pos - double(lo)) * (sorted[hi] - sorted[lo]);
+}
+
+/**
+ * @brief the two-sided critical value z of the standard normal distribution
+ * for the given confidence (e.g., 1.96 for 0.95) found by bisection
+ */
+inline double normal_critical_value(const double confidence)
+{
+    const double target = std::clamp(confidence, 0.0, 0.999999);
+    double       lo     = 0;
+    double       hi     = 10;
+    for (int i = 0; i < 100; ++i) {
+        const double mid = 0.5 * (lo + hi);
+        if (std::erf(mid / std::sqrt(2.0)) < target) {
+            lo = mid;
+        } else {
+            hi = mid;
+        }
+    }
+    return 0.5 * (lo + hi);
+}
+}  // namespace detail
+
+/**
+ * @brief compute the summary statistics of timing samples
+ * @param samples the timing samples (in ms)
+ * @param confidence the confidence level of the median confidence interval.
+ * With few samples, the interval widens up to [min, max]
+ */
+inline BenchmarkStats compute_benchmark_stats(const std::vector<float>& samples,
+                                              const double confidence = 0.95)
+{
+    BenchmarkStats stats;
+    if (samples.empty()) {
+        return stats;
+    }
+
+    std::vector<double> sorted(samples.begin(), samples.end());
+    std::sort(sorted.begin(), sorted.end());
+
+    const size_t n    = sorted.size();
+    stats.num_samples = static_cast<uint32_t>(n);
+    stats.min         = sorted.front();
+    stats.max         = sorted.back();
+    stats.median      = detail::sorted_percentile(sorted, 0.5);
+    stats.p05         = detail::sorted_percentile(sorted, 0.05);
+    stats.p95         = detail::sorted_percentile(sorted, 0.95);
+
+    double sum = 0;
+    for (double s : sorted) {
+        sum += s;
+    }
+    stats.mean = sum / double(n);
+
+    double sq = 0;
+    for (double s : sorted) {
+        sq += (s - stats.mean) * (s - stats.mean);
+    }
+    stats.stddev = (n > 1) ? std::sqrt(sq / double(n - 1)) : 0;
+
+    // the number of samples below the median is Binomial(n, 0.5) and so the
+    // interval between these two (1-based) ranks covers the median with the
+    // requested confidence (normal approximation of the binomial rounded to
+    // the nearest rank)
+    const double z    = detail::normal_critical_value(confidence);
+    const double half = 0.5 * z * std::sqrt(double(n));
+    const double lo   = std::round(0.5 * double(n) - half);
+    const double hi   = std::round(0.5 * double(n) + 1.0 + half);
+
+    stats.ci_lower = sorted[size_t(std::clamp(lo, 1.0, double(n))) - 1];
+    stats.ci_upper = sorted[size_t(std::clamp(hi, 1.0, double(n))) - 1];
+
+    return stats;
+}
+
+/**
+ * @brief the comparison of one benchmark stage against its baseline
+ */
+struct BenchmarkComparison
+{
+    std::string    stage;
+    BenchmarkStats baseline;
+    BenchmarkStats current;
+    // current median over baseline median
+    double ratio     = 1;
+    bool   regressed = false;
+    bool   improved  = false;
+    // the stage is in the baseline but has no current samples
+    bool missing = false;
+};
+
+/**
+ * @brief run benchmark stages with warm-up and repetitions, keep their
+ * timing samples and summary statistics, and compare them against a
+ * baseline. A stage regresses if its median is slower than the baseline
+ * median by more than a relative threshold and this is statistically
+ * significant i.e., the median confidence intervals do not overlap. The
+ * results are written with Report::add_benchmark which is also the format
+ * of the baseline (see load_baseline)
+ */
+class Benchmark
+{
+   public:
+    /**
+     * @param num_warmup the number of untimed runs before the timed ones
+     * @param num_run the number of timed runs (samples) per stage
+     * @param confidence the confidence level of the median confidence
+     * intervals
+     */
+    Benchmark(const uint32_t num_warmup = 1,
+              const uint32_t num_run    = 10,
+              const double   confidence = 0.95)
+        : m_num_warmup(num_warmup),
+          m_num_run(std::max(1u, num_run)),
+          m_confidence(confidence)
+    {
+    }
+
+    /**
+     * @brief run one stage num_warmup + num_run times
+     * @param stage the stage name (should be unique)
+     * @param func the stage. If it returns a float, it is the time (in ms) of
+     * the run e.g., measured with a GPUTimer around a kernel launch so the
+     * setup is not timed. Otherwise, the whole call is timed on the host
+     * @return the statistics of the timed runs
+     */
+    template <typename FuncT>
+    const BenchmarkStats& run(const std::string& stage, FuncT func)
+    {
+        for (uint32_t i = 0; i < m_num_warmup; ++i) {
+            func();
+        }
+
+        std::vector<float> time_ms;
+        time_ms.reserve(m_num_run);
+        for (uint32_t i = 0; i < m_num_run; ++i) {
+            if constexpr (std::is_void_v<std::invoke_result_t<FuncT>>) {
+                CPUTimer timer;
+                timer.start();
+                func();
+                timer.stop();
+                time_ms.push_back(timer.elapsed_millis());
+            } else {
+                time_ms.push_back(static_cast<float>(func()));
+            }
+        }
+        return add(stage, time_ms);
+    }
+
+    /**
+     * @brief add the timing samples of a stage that was measured elsewhere
+     * e.g., the "time (ms)" of a TestData
+     */
+    const BenchmarkStats& add(const std::string&        stage,
+                              const std::vector<float>& time_ms)
+    {
+        if (m_results.find(stage) == m_results.end()) {
+            m_stages.push_back(stage);
+        }
+        Result& res = m_results[stage];
+        res.time_ms = time_ms;
+        res.stats   = compute_benchmark_stats(time_ms, m_confidence);
+
+        RXMESH_INFO(
+            "Benchmark {}: median= {:.4f} (ms), {:.0f}% CI= [{:.4f}, {:.4f}], "
+            "p05= {:.4f}, p95= {:.4f}",
+            stage,
+            res.stats.median,
+            m_confidence * 100,
+            res.stats.ci_lower,
+            res.stats.ci_upper,
+            res.stats.p05,
+            res.stats.p95);
+        return res.stats;
+    }
+
+    /**
+     * @brief the stages in the order they were added
+     */
+    const std::vector<std::string>& stages() const
+    {
+        return m_stages;
+    }
+
+    const std::vector<float>& samples(const std::string& stage) const
+    {
+        return m_results.at(stage).time_ms;
+    }
+
+    const BenchmarkStats& stats(const std::string& stage) const
+    {
+        return m_results.at(stage).stats;
+    }
+
+    uint32_t get_num_warmup() const
+    {
+        return m_num_warmup;
+    }
+
+    uint32_t get_num_run() const
+    {
+        return m_num_run;
+    }
+
+    double get_confidence() const
+    {
+        return m_confidence;
+    }
+
+    /**
+     * @brief read the timing samples of every stage from a JSON file written
+     * by Report (with Report::add_benchmark)
+     * @param file_name the baseline JSON file
+     * @param baseline the output timing samples indexed by the stage name
+     * @param json_member_name the member written by Report::add_benchmark
+     * @return true if the file was read
+     */
+    static bool load_baseline(
+        const std::string&                         file_name,
+        std::map<std::string, std::vector<float>>& baseline,
+        const std::string json_member_name = "Benchmark")
+    {
+        std::ifstream file(file_name);
+        if (!file.is_open()) {
+            RXMESH_ERROR("Benchmark::load_baseline() can not open {}",
+                         file_name);
+            return false;
+        }
+
+        rapidjson::IStreamWrapper isw(file);
+        rapidjson::Document       doc;
+        doc.ParseStream(isw);
+        if (doc.HasParseError() || !doc.IsObject() ||
+            !doc.HasMember(json_member_name.c_str()) ||
+            !doc[json_member_name.c_str()].IsObject()) {
+            RXMESH_ERROR(
+                "Benchmark::load_baseline() {} is not a valid benchmark "
+                "report (missing \"{}\")",
+                file_name,
+                json_member_name);
+            return false;
+        }
+
+        baseline.clear();
+        for (const auto& stage : doc[json_member_name.c_str()].GetObject()) {
+            if (!stage.value.IsObject() ||
+                !stage.value.HasMember("time (ms)") ||
+                !stage.value["time (ms)"].IsArray()) {
+                continue;
+            }
+            std::vector<float>& time_ms = baseline[stage.name.GetString()];
+            for (const auto& t : stage.value["time (ms)"].GetArray()) {
+                if (t.IsNumber()) {
+                    time_ms.push_back(static_cast<float>(t.GetDouble()));
+                }
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief compare every stage against its baseline. Stages that are not
+     * in the baseline are skipped (with a warning). Baseline stages that were
+     * not run are returned as missing (with a warning) so that the caller
+     * could fail on them
+     * @param baseline the timing samples of the baseline (see load_baseline)
+     * @param threshold the relative slowdown of the median that is tolerated
+     * e.g., 0.05 for 5%
+     */
+    std::vector<BenchmarkComparison> compare(
+        const std::map<std::string, std::vector<float>>& baseline,
+        const double                                     threshold) const
+    {
+        std::vector<BenchmarkComparison> ret;
+        for (const std::string& stage : m_stages) {
+            auto it = baseline.find(stage);
+            if (it == baseline.end() || it->second.empty()) {
+                RXMESH_WARN(
+                    "Benchmark::compare() stage {} is not in the baseline",
+                    stage);
+                continue;
+            }
+
+            BenchmarkComparison cmp;
+            cmp.stage    = stage;
+            cmp.current  = m_results.at(stage).stats;
+            cmp.baseline = compute_benchmark_stats(it->second, m_confidence);
+            cmp.ratio    = (cmp.baseline.median > 0) ?
+                               cmp.current.median / cmp.baseline.median :
+                               1.0;
+
+            cmp.regressed = cmp.ratio > 1.0 + threshold &&
+                            cmp.current.ci_lower > cmp.baseline.ci_upper;
+            cmp.improved  = cmp.ratio < 1.0 - threshold &&
+                           cmp.current.ci_upper < cmp.baseline.ci_lower;
+
+            if (cmp.regressed) {
+                RXMESH_ERROR(
+                    "Benchmark::compare() {} regressed: median= {:.4f} (ms) "
+                    "vs. baseline {:.4f} (ms) ({:+.1f}%)",
+                    stage,
+                    cmp.current.median,
+                    cmp.baseline.median,
+                    (cmp.ratio - 1.0) * 100);
+            } else {
+                RXMESH_INFO(
+                    "Benchmark::compare() {} {}: median= {:.4f} (ms) vs. "
+                    "baseline {:.4f} (ms) ({:+.1f}%)",
+                    stage,
+                    (cmp.improved ? "improved" : "unchanged"),
+                    cmp.current.median,
+                    cmp.baseline.median,
+                    (cmp.ratio - 1.0) * 100);
+            }
+            ret.push_back(cmp);
+        }
+
+        for (const auto& b : baseline) {
+            if (b.second.empty() ||
+                m_results.find(b.first) != m_results.end()) {
+                continue;
+            }
+            RXMESH_WARN(
+                "Benchmark::compare() baseline stage {} has no current samples",
+                b.first);
+
+            BenchmarkComparison cmp;
+            cmp.stage    = b.first;
+            cmp.baseline = compute_benchmark_stats(b.second, m_confidence);
+            cmp.missing  = true;
+            ret.push_back(cmp);
+        }
+        return ret;
+    }
+
+   private:
+    struct Result
+    {
+        std::vector<float> time_ms;
+        BenchmarkStats     stats;
+    };
+
+    uint32_t                      m_num_warmup;
+    uint32_t                      m_num_run;
+    double                        m_confidence;
+    std::vector<std::string>      m_stages;
+    std::map<std::string, Result> m_results;
+};
+
+}  // namespace rxmesh
@@ -1,7 +1,9 @@
 #pragma once
 
-#include <cuda_runtime.h>
 #include <stdint.h>
+#ifndef RX_CPU_ONLY
+#include <cuda_runtime.h>
+#endif
 
 #include "rxmesh/util/bitmask_util.h"
 #include "rxmesh/util/macros.h"
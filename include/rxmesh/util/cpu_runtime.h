@@ -0,0 +1,565 @@
+#pragma once
+
+// Host implementation of the subset of the CUDA runtime and device intrinsics
+// used by the core of RXMesh. It is only included when RXMesh is configured
+// with RX_USE_CUDA=OFF (which defines RX_CPU_ONLY) so that the mesh build,
+// attributes, and host queries compile with a plain C++ compiler.
+// In this configuration there is a single memory space: "device" memory is
+// host memory, streams are executed in order (i.e., every call is
+// synchronous), and a "device" function is a host function that is called
+// from a single host thread. Kernels are not launched by this runtime. Code
+// paths that launch kernels are guarded with RX_CPU_ONLY and provide their
+// host fallbacks
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <type_traits>
+
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
+#define __host__
+#define __device__
+#define __global__
+#define __shared__
+#define __constant__
+#define __forceinline__ inline
+#define __inline__ inline
+#define __launch_bounds__(...)
+
+// ----------------------------------------------------------------------------
+// errors
+// ----------------------------------------------------------------------------
+enum cudaError_t
+{
+    cudaSuccess               = 0,
+    cudaErrorInvalidValue     = 1,
+    cudaErrorMemoryAllocation = 2,
+    cudaErrorNoDevice         = 100,
+};
+
+inline const char* cudaGetErrorString(cudaError_t err)
+{
+    switch (err) {
+        case cudaSuccess:
+            return "no error";
+        case cudaErrorInvalidValue:
+            return "invalid argument";
+        case cudaErrorMemoryAllocation:
+            return "out of memory";
+        case cudaErrorNoDevice:
+            return "no CUDA-capable device is detected";
+        default:
+            return "unknown error";
+    }
+}
+
+inline cudaError_t cudaGetLastError()
+{
+    return cudaSuccess;
+}
+
+inline cudaError_t cudaPeekAtLastError()
+{
+    return cudaSuccess;
+}
+
+// ----------------------------------------------------------------------------
+// device
+// ----------------------------------------------------------------------------
+inline cudaError_t cudaGetDeviceCount(int* count)
+{
+    *count = 0;
+    return cudaSuccess;
+}
+
+inline cudaError_t cudaSetDevice(int)
+{
+    return cudaSuccess;
+}
+
+inline cudaError_t cudaGetDevice(int* device)
+{
+    *device = 0;
+    return cudaSuccess;
+}
+
+inline cudaError_t cudaDeviceSynchronize()
+{
+    return cudaSuccess;
+}
+
+inline cudaError_t cudaDeviceReset()
+{
+    return cudaSuccess;
+}
+
+/**
+ * @brief report the physical memory of the machine as the device memory
+ */
+inline cudaError_t cudaMemGetInfo(size_t* free_bytes, size_t* total_bytes)
+{
+#ifndef _WIN32
+    const size_t page = size_t(sysconf(_SC_PAGESIZE));
+    *total_bytes      = page * size_t(sysconf(_SC_PHYS_PAGES));
+#ifdef _SC_AVPHYS_PAGES
+    *free_bytes = page * size_t(sysconf(_SC_AVPHYS_PAGES));
+#else
+    *free_bytes = *total_bytes;
+#endif
+#else
+    *total_bytes = 0;
+    *free_bytes  = 0;
+#endif
+    return cudaSuccess;
+}
+
+// ----------------------------------------------------------------------------
+// memory
+// ----------------------------------------------------------------------------
+enum cudaMemcpyKind
+{
+    cudaMemcpyHostToHost     = 0,
+    cudaMemcpyHostToDevice   = 1,
+    cudaMemcpyDeviceToHost   = 2,
+    cudaMemcpyDeviceToDevice = 3,
+    cudaMemcpyDefault        = 4,
+};
+
+#define cudaHostAllocDefault 0x00
+#define cudaHostAllocPortable 0x01
+#define cudaHostAllocMapped 0x02
+#define cudaMemAttachGlobal 0x01
+
+namespace rxmesh {
+namespace detail {
+/**
+ * @brief allocate memory aligned to 256 bytes (same as cudaMalloc)
+ */
+inline void* cpu_runtime_malloc(size_t num_bytes)
+{
+    constexpr size_t alignment = 256;
+    num_bytes = std::max(alignment, (num_bytes + alignment - 1) & ~(alignment - 1));
+#ifdef _WIN32
+    return _aligned_malloc(num_bytes, alignment);
+#else
+    return aligned_alloc(alignment, num_bytes);
+#endif
+}
+
+inline void cpu_runtime_free(void* ptr)
+{
+#ifdef _WIN32
+    _aligned_free(ptr);
+#else
+    free(ptr);
+#endif
+}
+}  // namespace detail
+}  // namespace rxmesh
+
+inline cudaError_t cudaMalloc(void** ptr, size_t num_bytes)
+{
+    *ptr = rxmesh::detail::cpu_runtime_malloc(num_bytes);
+    return (*ptr == nullptr) ? cudaErrorMemoryAllocation : cudaSuccess;
+}
+
+inline cudaError_t cudaMallocManaged(void**       ptr,
+                                     size_t       num_bytes,
+                                     unsigned int flags = cudaMemAttachGlobal)
+{
+    return cudaMalloc(ptr, num_bytes);
+}
+
+inline cudaError_t cudaMallocHost(void** ptr, size_t num_bytes)
+{
+    return cudaMalloc(ptr, num_bytes);
+}
+
+inline cudaError_t cudaHostAlloc(void** ptr, size_t num_bytes, unsigned int)
+{
+    return cudaMalloc(ptr, num_bytes);
+}
+
+inline cudaError_t cudaFree(void* ptr)
+{
+    rxmesh::detail::cpu_runtime_free(ptr);
+    return cudaSuccess;
+}
+
+inline cudaError_t cudaFreeHost(void* ptr)
+{
+    return cudaFree(ptr);
+}
+
+inline cudaError_t cudaMemcpy(void*          dst,
+                              const void*    src,
+                              size_t         num_bytes,
+                              cudaMemcpyKind kind)
+{
+    if (num_bytes != 0 && dst != src) {
+        memmove(dst, src, num_bytes);
+    }
+    return cudaSuccess;
+}
+
+inline cudaError_t cudaMemset(void* ptr, int value, size_t num_bytes)
+{
+    memset(ptr, value, num_bytes);
+    return cudaSuccess;
+}
+
+// ----------------------------------------------------------------------------
+// streams and events
+// ----------------------------------------------------------------------------
+struct CUstream_st
+{
+};
+typedef CUstream_st* cudaStream_t;
+
+struct CUevent_st
+{
+    std::chrono::high_resolution_clock::time_point time;
+};
+typedef CUevent_st* cudaEvent_t;
+
+#define cudaStreamDefault 0x00
+#define cudaStreamNonBlocking 0x01
+#define cudaEventDefault 0x00
+#define cudaEventBlockingSync 0x01
+#define cudaEventDisableTiming 0x02
+
+inline cudaError_t cudaStreamCreate(cudaStream_t* stream)
+{
+    *stream = new CUstream_st;
+    return cudaSuccess;
+}
+
+inline cudaError_t cudaStreamCreateWithFlags(cudaStream_t* stream,
+                                             unsigned int)
+{
+    return cudaStreamCreate(stream);
+}
+
+inline cudaError_t cudaStreamDestroy(cudaStream_t stream)
+{
+    delete stream;
+    return cudaSuccess;
+}
+
+inline cudaError_t cudaStreamSynchronize(cudaStream_t)
+{
+    return cudaSuccess;
+}
+
+inline cudaError_t cudaMemcpyAsync(void*          dst,
+                                   const void*    src,
+                                   size_t         num_bytes,
+                                   cudaMemcpyKind kind,
+                                   cudaStream_t   stream = nullptr)
+{
+    return cudaMemcpy(dst, src, num_bytes, kind);
+}
+
+inline cudaError_t cudaMemsetAsync(void*        ptr,
+                                   int          value,
+                                   size_t       num_bytes,
+                                   cudaStream_t stream = nullptr)
+{
+    return cudaMemset(ptr, value, num_bytes);
+}
+
+inline cudaError_t cudaEventCreate(cudaEvent_t* event)
+{
+    *event = new CUevent_st;
+    return cudaSuccess;
+}
+
+inline cudaError_t cudaEventCreateWithFlags(cudaEvent_t* event, unsigned int)
+{
+    return cudaEventCreate(event);
+}
+
+inline cudaError_t cudaEventDestroy(cudaEvent_t event)
+{
+    delete event;
+    return cudaSuccess;
+}
+
+inline cudaError_t cudaEventRecord(cudaEvent_t event, cudaStream_t = nullptr)
+{
+    event->time = std::chrono::high_resolution_clock::now();
+    return cudaSuccess;
+}
+
+inline cudaError_t cudaEventSynchronize(cudaEvent_t)
+{
+    return cudaSuccess;
+}
+
+inline cudaError_t cudaEventElapsedTime(float*      ms,
+                                        cudaEvent_t start,
+                                        cudaEvent_t stop)
+{
+    *ms = std::chrono::duration<float, std::milli>(stop->time - start->time)
+              .count();
+    return cudaSuccess;
+}
+
+inline cudaError_t cudaProfilerStart()
+{
+    return cudaSuccess;
+}
+
+inline cudaError_t cudaProfilerStop()
+{
+    return cudaSuccess;
+}
+
+// ----------------------------------------------------------------------------
+// thread hierarchy. A "device" function is called from one host thread that
+// acts as thread 0 of block 0 in a grid of one block of one thread
+// ----------------------------------------------------------------------------
+struct uint3
+{
+    unsigned int x, y, z;
+};
+
+struct dim3
+{
+    unsigned int x, y, z;
+    constexpr dim3(unsigned int vx = 1, unsigned int vy = 1, unsigned int vz = 1)
+        : x(vx), y(vy), z(vz)
+    {
+    }
+};
+
+inline thread_local uint3 threadIdx = {0, 0, 0};
+inline thread_local uint3 blockIdx  = {0, 0, 0};
+inline thread_local dim3  blockDim  = dim3(1, 1, 1);
+inline thread_local dim3  gridDim   = dim3(1, 1, 1);
+
+inline void __syncthreads()
+{
+}
+
+inline void __syncwarp(unsigned int = 0xFFFFFFFF)
+{
+}
+
+inline void __threadfence()
+{
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+}
+
+inline void __threadfence_block()
+{
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+}
+
+inline void __nanosleep(unsigned int)
+{
+    std::this_thread::yield();
+}
+
+inline int __float_as_int(float f)
+{
+    int i;
+    memcpy(&i, &f, sizeof(int));
+    return i;
+}
+
+inline float __int_as_float(int i)
+{
+    float f;
+    memcpy(&f, &i, sizeof(float));
+    return f;
+}
+
+inline int __popc(unsigned int x)
+{
+    return __builtin_popcount(x);
+}
+
+inline int __popcll(unsigned long long x)
+{
+    return __builtin_popcountll(x);
+}
+
+inline int __ffs(int x)
+{
+    return __builtin_ffs(x);
+}
+
+inline int __clz(int x)
+{
+    return (x == 0) ? 32 : __builtin_clz(static_cast<unsigned int>(x));
+}
+
+// ----------------------------------------------------------------------------
+// complex types with the layout of cuComplex.h. There is no host arithmetic
+// on them; they only let code that dispatches on the value type compile
+// ----------------------------------------------------------------------------
+struct cuFloatComplex
+{
+    float x, y;
+};
+
+struct cuDoubleComplex
+{
+    double x, y;
+};
+
+typedef cuFloatComplex cuComplex;
+
+// ----------------------------------------------------------------------------
+// atomics: sequentially consistent host atomics with CUDA's signatures
+// ----------------------------------------------------------------------------
+namespace rxmesh {
+namespace detail {
+template <typename T, typename OpT>
+inline T cpu_atomic_cas_loop(T* address, OpT op)
+{
+    static_assert(sizeof(T) == 4 || sizeof(T) == 8,
+                  "cpu_atomic_cas_loop() only supports 32 and 64-bit types");
+    using IntT = std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t>;
+    IntT* addr = reinterpret_cast<IntT*>(address);
+    IntT  old  = __atomic_load_n(addr, __ATOMIC_SEQ_CST);
+    while (true) {
+        T old_val;
+        memcpy(&old_val, &old, sizeof(T));
+        const T new_val = op(old_val);
+        IntT    desired;
+        memcpy(&desired, &new_val, sizeof(T));
+        if (__atomic_compare_exchange_n(addr,
+                                        &old,
+                                        desired,
+                                        false,
+                                        __ATOMIC_SEQ_CST,
+                                        __ATOMIC_SEQ_CST)) {
+            return old_val;
+        }
+    }
+}
+}  // namespace detail
+}  // namespace rxmesh
+
+template <typename T>
+inline T atomicAdd(T* address, T val)
+{
+    if constexpr (std::is_integral_v<T>) {
+        return __atomic_fetch_add(address, val, __ATOMIC_SEQ_CST);
+    } else {
+        return rxmesh::detail::cpu_atomic_cas_loop(
+            address, [val](T old) { return old + val; });
+    }
+}
+
+template <typename T>
+inline T atomicSub(T* address, T val)
+{
+    return __atomic_fetch_sub(address, val, __ATOMIC_SEQ_CST);
+}
+
+template <typename T>
+inline T atomicExch(T* address, T val)
+{
+    if constexpr (std::is_integral_v<T>) {
+        return __atomic_exchange_n(address, val, __ATOMIC_SEQ_CST);
+    } else {
+        return rxmesh::detail::cpu_atomic_cas_loop(address,
+                                                   [val](T) { return val; });
+    }
+}
+
+template <typename T>
+inline T atomicCAS(T* address, T compare, T val)
+{
+    __atomic_compare_exchange_n(
+        address, &compare, val, false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+    return compare;
+}
+
+template <typename T>
+inline T atomicMin(T* address, T val)
+{
+    return rxmesh::detail::cpu_atomic_cas_loop(
+        address, [val](T old) { return std::min(old, val); });
+}
+
+template <typename T>
+inline T atomicMax(T* address, T val)
+{
+    return rxmesh::detail::cpu_atomic_cas_loop(
+        address, [val](T old) { return std::max(old, val); });
+}
+
+template <typename T>
+inline T atomicAnd(T* address, T val)
+{
+    return __atomic_fetch_and(address, val, __ATOMIC_SEQ_CST);
+}
+
+template <typename T>
+inline T atomicOr(T* address, T val)
+{
+    return __atomic_fetch_or(address, val, __ATOMIC_SEQ_CST);
+}
+
+template <typename T>
+inline T atomicXor(T* address, T val)
+{
+    return __atomic_fetch_xor(address, val, __ATOMIC_SEQ_CST);
+}
+
+// ----------------------------------------------------------------------------
+// cooperative groups: a block of one thread
+// ----------------------------------------------------------------------------
+namespace cooperative_groups {
+class thread_block
+{
+   public:
+    void sync() const
+    {
+    }
+
+    unsigned int thread_rank() const
+    {
+        return 0;
+    }
+
+    unsigned int size() const
+    {
+        return 1;
+    }
+};
+
+inline thread_block this_thread_block()
+{
+    return thread_block();
+}
+
+inline void sync(const thread_block&)
+{
+}
+
+template <typename GroupT>
+inline void memcpy_async(const GroupT&,
+                         void*       dst,
+                         const void* src,
+                         size_t      num_bytes)
+{
+    memcpy(dst, src, num_bytes);
+}
+
+template <typename GroupT>
+inline void wait(const GroupT&)
+{
+}
+}  // namespace cooperative_groups
@@ -1,5 +1,7 @@
 #pragma once
+#ifndef RX_CPU_ONLY
 #include <cuda_runtime_api.h>
+#endif
 #include "rxmesh/kernels/get_arch.cuh"
 #include "rxmesh/util/log.h"
 #include "rxmesh/util/macros.h"
@@ -57,6 +59,21 @@ inline int convert_SMV_to_cores(int major, int minor)
     return nGpuArchCoresPerSM[index - 1].Cores;
 }
 
+/**
+ * @brief check if there is at least one CUDA-capable device on this machine
+ */
+inline bool has_cuda_device()
+{
+    int device_count = 0;
+    if (cudaGetDeviceCount(&device_count) != cudaSuccess) {
+        // clear the error so it is not reported by a later CUDA call
+        cudaGetLastError();
+        return false;
+    }
+    return device_count > 0;
+}
+
+#ifndef RX_CPU_ONLY
 inline cudaDeviceProp cuda_query(const int dev)
 {
 
@@ -149,4 +166,5 @@ inline cudaDeviceProp cuda_query(const int dev)
 
     return dev_prop;
 }
+#endif
 }  // namespace rxmesh
\ No newline at end of file
@@ -0,0 +1,133 @@
+#pragma once
+#include <omp.h>
+#include <stdint.h>
+#include <algorithm>
+#include <vector>
+
+#include "rxmesh/util/log.h"
+
+namespace rxmesh {
+
+namespace detail {
+
+/**
+ * @brief a stable assignment of patches to host threads used for NUMA-aware
+ * first-touch placement. Every thread owns a contiguous range of patches with
+ * a similar cost. Since Linux places a page on the NUMA node of the thread
+ * that first writes to it, allocating and initializing the data of a patch on
+ * its home thread, and later processing the patch on the same thread, keeps
+ * the patch data local to the core that uses it. With OMP_PROC_BIND=close (or
+ * spread) and OMP_PLACES=cores, consecutive threads (and so consecutive patch
+ * ranges) stay on the same NUMA node across all parallel regions.
+ */
+class HostAffinity
+{
+   public:
+    HostAffinity() : m_num_threads(0)
+    {
+    }
+
+    /**
+     * @param num_patches number of patches
+     * @param cost cost(p) returns the (relative) amount of data/work of patch p
+     * @param num_threads number of host threads
+     */
+    template <typename CostT>
+    HostAffinity(const uint32_t num_patches,
+                 CostT          cost,
+                 const int      num_threads = omp_get_max_threads())
+        : m_num_threads(std::max(1, num_threads)),
+          m_offset(m_num_threads + 1, num_patches),
+          m_home(num_patches, 0)
+    {
+        // every patch costs at least one so that empty patches are also spread
+        auto patch_cost = [&](uint32_t p) { return uint64_t(cost(p)) + 1; };
+
+        uint64_t total = 0;
+        for (uint32_t p = 0; p < num_patches; ++p) {
+            total += patch_cost(p);
+        }
+
+        // greedy split of the prefix sum of the cost into equal parts
+        m_offset[0]  = 0;
+        int      t   = 0;
+        uint64_t sum = 0;
+        for (uint32_t p = 0; p < num_patches; ++p) {
+            while (t + 1 < m_num_threads &&
+                   sum * m_num_threads >= total * uint64_t(t + 1)) {
+                m_offset[++t] = p;
+            }
+            m_home[p] = t;
+            sum += patch_cost(p);
+        }
+        for (int i = t + 1; i <= m_num_threads; ++i) {
+            m_offset[i] = num_patches;
+        }
+
+        if (m_num_threads > 1 && omp_get_proc_bind() == omp_proc_bind_false) {
+            RXMESH_WARN(
+                "HostAffinity: OpenMP threads are not bound to cores so the "
+                "patch-to-core affinity is not guaranteed. Set "
+                "OMP_PROC_BIND=close and OMP_PLACES=cores");
+        }
+    }
+
+    /**
+     * @brief if the affinity is defined
+     */
+    bool is_valid() const
+    {
+        return m_num_threads > 0;
+    }
+
+    int get_num_threads() const
+    {
+        return m_num_threads;
+    }
+
+    /**
+     * @brief the home thread of patch p. Patches added after the affinity is
+     * computed (e.g., by patch slicing) are assigned round-robin
+     */
+    int home(const uint32_t p) const
+    {
+        return (p < m_home.size()) ? m_home[p] : int(p % m_num_threads);
+    }
+
+    /**
+     * @brief call f(p) for every patch p in [0, num_patches) where f(p) is
+     * called by the home thread of p
+     */
+    template <typename FuncT>
+    void run(const uint32_t num_patches, FuncT f) const
+    {
+#pragma omp parallel num_threads(m_num_threads)
+        {
+            // the team could be smaller than requested (e.g., nested
+            // parallelism) in which case a thread takes more than one range
+            const int team = omp_get_num_threads();
+            for (int t = omp_get_thread_num(); t < m_num_threads; t += team) {
+                const uint32_t end = std::min(m_offset[t + 1], num_patches);
+                for (uint32_t p = m_offset[t]; p < end; ++p) {
+                    f(p);
+                }
+            }
+            // the patches after the ones that are covered by the affinity
+            for (uint32_t p = static_cast<uint32_t>(m_home.size());
+                 p < num_patches;
+                 ++p) {
+                if (home(p) % team == omp_get_thread_num()) {
+                    f(p);
+                }
+            }
+        }
+    }
+
+   private:
+    int                   m_num_threads;
+    std::vector<uint32_t> m_offset;
+    std::vector<int>      m_home;
+};
+
+}  // namespace detail
+}  // namespace rxmesh
@@ -0,0 +1,193 @@
+#pragma once
+#include <assert.h>
+#include <omp.h>
+#include <stdint.h>
+#include <string.h>
+#include <algorithm>
+#include <vector>
+
+namespace rxmesh {
+
+namespace detail {
+
+/**
+ * @brief split [0, n) evenly between num_threads threads and return the
+ * range of thread tid. The same split is used by all the functions below so
+ * that the different passes see the same partition
+ */
+inline void host_thread_range(const size_t n,
+                              const int    tid,
+                              const int    num_threads,
+                              size_t&      start,
+                              size_t&      end)
+{
+    const size_t chunk = (n + num_threads - 1) / num_threads;
+    start              = std::min(n, chunk * static_cast<size_t>(tid));
+    end                = std::min(n, start + chunk);
+}
+
+/**
+ * @brief exclusive prefix sum on the host using OpenMP. in and out could point
+ * to the same array (i.e., in-place scan)
+ * @param in input array
+ * @param out output array
+ * @param n number of elements in in and out
+ * @return the sum of all elements in the input
+ */
+template <typename T>
+inline T host_exclusive_scan(const T* in, T* out, const size_t n)
+{
+    if (n == 0) {
+        return T(0);
+    }
+
+    const int      num_threads = omp_get_max_threads();
+    std::vector<T> thread_sum(num_threads + 1, T(0));
+
+#pragma omp parallel num_threads(num_threads)
+    {
+        const int tid = omp_get_thread_num();
+        size_t    start, end;
+        host_thread_range(n, tid, omp_get_num_threads(), start, end);
+
+        T sum = T(0);
+        for (size_t i = start; i < end; ++i) {
+            sum += in[i];
+        }
+        thread_sum[tid + 1] = sum;
+
+#pragma omp barrier
+#pragma omp single
+        {
+            for (int t = 0; t < num_threads; ++t) {
+                thread_sum[t + 1] += thread_sum[t];
+            }
+        }
+
+        T running = thread_sum[tid];
+        for (size_t i = start; i < end; ++i) {
+            const T val = in[i];
+            out[i]      = running;
+            running += val;
+        }
+    }
+
+    return thread_sum[num_threads];
+}
+
+/**
+ * @brief stable least-significant-digit radix sort of key-value pairs on the
+ * host using OpenMP. Only the lower num_bits of the keys are used for sorting
+ * so the caller should pack the keys as tight as possible to reduce the number
+ * of passes. Since the sort is stable, values with equal keys keep their input
+ * order
+ * @param keys the keys to sort
+ * @param values the values associated with the keys (permuted with the keys)
+ * @param num_bits number of (lower) bits in the keys to consider
+ */
+template <typename KeyT, typename ValueT>
+inline void host_radix_sort_pairs(std::vector<KeyT>&   keys,
+                                  std::vector<ValueT>& values,
+                                  const int            num_bits)
+{
+    constexpr int radix_bits  = 8;
+    constexpr int num_buckets = 1 << radix_bits;
+
+    assert(keys.size() == values.size());
+
+    const size_t n = keys.size();
+    if (n < 2) {
+        return;
+    }
+
+    const int num_threads = omp_get_max_threads();
+
+    std::vector<KeyT>   keys_alt(n);
+    std::vector<ValueT> values_alt(n);
+    std::vector<size_t> hist(static_cast<size_t>(num_threads) * num_buckets);
+
+    for (int shift = 0; shift < num_bits; shift += radix_bits) {
+        std::fill(hist.begin(), hist.end(), 0);
+
+        bool skip_pass = false;
+
+#pragma omp parallel num_threads(num_threads)
+        {
+            const int tid = omp_get_thread_num();
+            size_t    start, end;
+            host_thread_range(n, tid, omp_get_num_threads(), start, end);
+
+            size_t* t_hist = hist.data() + tid * num_buckets;
+
+            for (size_t i = start; i < end; ++i) {
+                t_hist[(keys[i] >> shift) & (num_buckets - 1)]++;
+            }
+
+#pragma omp barrier
+#pragma omp single
+            {
+                // bucket-major then thread-minor scan so that every thread
+                // scatters after all threads before it (i.e., stable sort)
+                size_t sum = 0;
+                for (int b = 0; b < num_buckets; ++b) {
+                    size_t bucket_count = 0;
+                    for (int t = 0; t < num_threads; ++t) {
+                        const size_t c            = hist[t * num_buckets + b];
+                        hist[t * num_buckets + b] = sum;
+                        sum += c;
+                        bucket_count += c;
+                    }
+                    // all keys have the same digit so this pass is a no-op
+                    if (bucket_count == n) {
+                        skip_pass = true;
+                    }
+                }
+            }
+
+            if (!skip_pass) {
+                for (size_t i = start; i < end; ++i) {
+                    const size_t pos =
+                        t_hist[(keys[i] >> shift) & (num_buckets - 1)]++;
+                    keys_alt[pos]   = keys[i];
+                    values_alt[pos] = values[i];
+                }
+            }
+        }
+
+        if (!skip_pass) {
+            keys.swap(keys_alt);
+            values.swap(values_alt);
+        }
+    }
+}
+
+/**
+ * @brief memcpy on the host where the buffer is split evenly between the
+ * OpenMP threads. Small buffers are copied by the calling thread only
+ */
+inline void host_parallel_memcpy(void* dst, const void* src, const size_t n)
+{
+    constexpr size_t min_parallel_bytes = size_t(1) << 20;
+
+    if (n < min_parallel_bytes) {
+        if (n > 0) {
+            memcpy(dst, src, n);
+        }
+        return;
+    }
+
+#pragma omp parallel
+    {
+        size_t start, end;
+        host_thread_range(
+            n, omp_get_thread_num(), omp_get_num_threads(), start, end);
+        if (end > start) {
+            memcpy(static_cast<char*>(dst) + start,
+                   static_cast<const char*>(src) + start,
+                   end - start);
+        }
+    }
+}
+
+}  // namespace detail
+}  // namespace rxmesh
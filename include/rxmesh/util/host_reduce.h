@@ -0,0 +1,105 @@
+#pragma once
+#include <stdint.h>
+#include <algorithm>
+#include <vector>
+
+namespace rxmesh {
+namespace detail {
+
+// number of independent accumulators in host reductions. Element i of a patch
+// is always added to lane i % host_reduce_lanes so the compiler can vectorize
+// the inner loop while the order of the additions stays fixed
+constexpr uint32_t host_reduce_lanes = 8;
+
+/**
+ * @brief sum f(i) over the elements i in [0, n) of a patch that are set in
+ * both the owned and the active masks. Fully set mask words take a branch-free
+ * loop over contiguous elements. The result only depends on the input (not on
+ * the vector width, the mask path, or the number of threads)
+ */
+template <typename T, typename FuncT>
+inline T host_masked_sum(const uint32_t* owned_mask,
+                         const uint32_t* active_mask,
+                         const uint32_t  n,
+                         FuncT           f)
+{
+    T acc[host_reduce_lanes];
+    for (uint32_t l = 0; l < host_reduce_lanes; ++l) {
+        acc[l] = T(0);
+    }
+
+    for (uint32_t begin = 0; begin < n; begin += 32) {
+        const uint32_t word = owned_mask[begin / 32] & active_mask[begin / 32];
+        const uint32_t end  = std::min(n, begin + 32);
+        if (word == 0xFFFFFFFF && end - begin == 32) {
+            for (uint32_t i = begin; i < end; i += host_reduce_lanes) {
+#pragma omp simd
+                for (uint32_t l = 0; l < host_reduce_lanes; ++l) {
+                    acc[l] += f(i + l);
+                }
+            }
+        } else if (word != 0) {
+            for (uint32_t i = begin; i < end; ++i) {
+                if ((word >> (i - begin)) & 1) {
+                    acc[i % host_reduce_lanes] += f(i);
+                }
+            }
+        }
+    }
+
+    // fixed-order pairwise combine of the lanes
+    for (uint32_t stride = 1; stride < host_reduce_lanes; stride *= 2) {
+        for (uint32_t l = 0; l + stride < host_reduce_lanes; l += 2 * stride) {
+            acc[l] += acc[l + stride];
+        }
+    }
+    return acc[0];
+}
+
+/**
+ * @brief acc = f(acc, i) over the elements i in [0, n) of a patch that are
+ * set in both the owned and the active masks in increasing order of i
+ */
+template <typename U, typename FuncT>
+inline U host_masked_fold(const uint32_t* owned_mask,
+                          const uint32_t* active_mask,
+                          const uint32_t  n,
+                          FuncT           f,
+                          U               init)
+{
+    U acc = init;
+    for (uint32_t begin = 0; begin < n; begin += 32) {
+        const uint32_t word = owned_mask[begin / 32] & active_mask[begin / 32];
+        const uint32_t end  = std::min(n, begin + 32);
+        for (uint32_t i = begin; i < end; ++i) {
+            if ((word >> (i - begin)) & 1) {
+                acc = f(acc, i);
+            }
+        }
+    }
+    return acc;
+}
+
+/**
+ * @brief combine the first n values of partial with a pairwise tree where
+ * every level is combined in parallel. The tree shape only depends on n and
+ * so the result is reproducible run-to-run
+ */
+template <typename U, typename ReductionOp>
+inline U host_tree_reduce(std::vector<U>& partial,
+                          const uint32_t  n,
+                          ReductionOp     reduction_op,
+                          U               init)
+{
+    for (uint32_t stride = 1; stride < n; stride *= 2) {
+        const int num = static_cast<int>(n - stride);
+        const int step = static_cast<int>(2 * stride);
+#pragma omp parallel for if (num / step > 1024)
+        for (int i = 0; i < num; i += step) {
+            partial[i] = reduction_op(partial[i], partial[i + stride]);
+        }
+    }
+    return (n == 0) ? init : reduction_op(init, partial[0]);
+}
+}  // namespace detail
+}  // namespace rxmesh
@@ -0,0 +1,299 @@
+#pragma once
+#include <omp.h>
+#include <stdint.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <numeric>
+#include <vector>
+
+#include "rxmesh/util/host_affinity.h"
+
+namespace rxmesh {
+
+namespace detail {
+
+/**
+ * @brief a unit of host work: the local elements [begin, end) of one patch
+ */
+struct HostTask
+{
+    uint32_t patch_id;
+    uint16_t begin;
+    uint16_t end;
+};
+
+/**
+ * @brief statistics of the last HostScheduler::run()
+ */
+struct HostSchedulerStats
+{
+    int      num_threads = 0;
+    uint32_t num_tasks   = 0;
+    uint32_t num_steals  = 0;
+    double   max_busy_ms = 0;
+    double   avg_busy_ms = 0;
+
+    /**
+     * @brief the ratio between the busiest thread and the average thread.
+     * 1.0 means that the work was perfectly balanced
+     */
+    double imbalance() const
+    {
+        return (avg_busy_ms > 0) ? max_busy_ms / avg_busy_ms : 1.0;
+    }
+};
+
+/**
+ * @brief work-stealing executor for host work over patches. Patches are
+ * turned into tasks (large patches are optionally split into element ranges),
+ * sorted by decreasing cost, and dealt round-robin into one queue per thread
+ * (or queued to their home thread given a HostAffinity).
+ * Every thread processes its own queue from the front (largest tasks first)
+ * and, once it is empty, steals from the back of the other queues. Each queue
+ * is a [head, tail) range packed in one 64-bit atomic so the owner and the
+ * thieves synchronize with a single CAS.
+ */
+class HostScheduler
+{
+   public:
+    /**
+     * @param num_patches number of patches
+     * @param cost cost(p) returns the number of elements to process in patch p
+     * @param split_size patches with more than split_size elements are split
+     * into ranges of at most split_size elements. 0 disables splitting
+     * @param num_threads number of queues (i.e., threads)
+     * @param affinity if not null, the tasks of a patch are queued to the
+     * patch's home thread (in patch order) instead of being dealt by cost so
+     * that every pass processes a patch on the same thread (see HostAffinity).
+     * Stealing still balances the load
+     */
+    template <typename CostT>
+    HostScheduler(const uint32_t      num_patches,
+                  CostT               cost,
+                  const uint32_t      split_size  = 0,
+                  const int           num_threads = omp_get_max_threads(),
+                  const HostAffinity* affinity    = nullptr)
+        : m_num_threads(std::max(1, num_threads))
+    {
+        std::vector<HostTask> tasks;
+        std::vector<uint32_t> task_cost;
+        tasks.reserve(num_patches);
+        task_cost.reserve(num_patches);
+
+        for (uint32_t p = 0; p < num_patches; ++p) {
+            const uint32_t n = cost(p);
+            if (n == 0) {
+                continue;
+            }
+            if (split_size == 0 || n <= split_size) {
+                tasks.push_back({p, 0, static_cast<uint16_t>(n)});
+                task_cost.push_back(n);
+            } else {
+                for (uint32_t b = 0; b < n; b += split_size) {
+                    const uint32_t e = std::min(n, b + split_size);
+                    tasks.push_back({p,
+                                     static_cast<uint16_t>(b),
+                                     static_cast<uint16_t>(e)});
+                    task_cost.push_back(e - b);
+                }
+            }
+        }
+
+        m_queue_offset.resize(m_num_threads + 1, 0);
+        m_queues = std::make_unique<Queue[]>(m_num_threads);
+
+        if (affinity != nullptr && affinity->is_valid()) {
+            auto queue = [&](const HostTask& t) {
+                return affinity->home(t.patch_id) % m_num_threads;
+            };
+            for (const HostTask& t : tasks) {
+                m_queue_offset[queue(t) + 1]++;
+            }
+            for (int q = 0; q < m_num_threads; ++q) {
+                m_queue_offset[q + 1] += m_queue_offset[q];
+            }
+            std::vector<uint32_t> pos(m_queue_offset.begin(),
+                                      m_queue_offset.end() - 1);
+            m_tasks.resize(tasks.size());
+            for (const HostTask& t : tasks) {
+                m_tasks[pos[queue(t)]++] = t;
+            }
+            return;
+        }
+
+        std::vector<uint32_t> order(tasks.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(
+            order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+                return task_cost[a] > task_cost[b];
+            });
+
+        // deal the sorted tasks round-robin so that every queue starts with
+        // a similar cost and is itself sorted by decreasing cost
+        for (int q = 0; q < m_num_threads; ++q) {
+            const size_t num_q =
+                (order.size() + m_num_threads - 1 - q) / m_num_threads;
+            m_queue_offset[q + 1] =
+                m_queue_offset[q] + static_cast<uint32_t>(num_q);
+        }
+
+        m_tasks.resize(tasks.size());
+        for (size_t i = 0; i < order.size(); ++i) {
+            const int q = static_cast<int>(i % m_num_threads);
+            m_tasks[m_queue_offset[q] + i / m_num_threads] = tasks[order[i]];
+        }
+    }
+
+    HostScheduler(const HostScheduler&)            = delete;
+    HostScheduler& operator=(const HostScheduler&) = delete;
+
+    /**
+     * @brief grain size used to split large patches when the total number of
+     * elements to process is num_elements. It aims for a few tasks per thread
+     * without making tasks too small to amortize their overhead
+     */
+    static uint32_t default_split_size(const size_t num_elements,
+                                       const int    num_threads)
+    {
+        constexpr uint32_t min_split = 256;
+        const size_t       grain =
+            num_elements / (8 * static_cast<size_t>(std::max(1, num_threads)));
+        return static_cast<uint32_t>(std::min<size_t>(
+            std::max<size_t>(grain, min_split), UINT16_MAX));
+    }
+
+    /**
+     * @brief run all tasks in parallel
+     * @param task task(const HostTask&, int thread_id) is called once for
+     * every task. thread_id is in [0, get_num_threads()) and could be used to
+     * index per-thread scratch space
+     */
+    template <typename TaskT>
+    void run(TaskT task)
+    {
+        for (int q = 0; q < m_num_threads; ++q) {
+            m_queues[q].range.store(
+                pack(m_queue_offset[q], m_queue_offset[q + 1]),
+                std::memory_order_relaxed);
+        }
+
+        std::vector<double>   busy_ms(m_num_threads, 0);
+        std::atomic<uint32_t> num_steals(0);
+
+#pragma omp parallel num_threads(m_num_threads)
+        {
+            // the team could be smaller than requested (e.g., nested
+            // parallelism) in which case the remaining queues are stolen
+            const int tid = omp_get_thread_num();
+
+            const auto start = std::chrono::high_resolution_clock::now();
+
+            uint32_t id;
+            while (pop_front(tid, id)) {
+                task(m_tasks[id], tid);
+            }
+
+            uint32_t my_steals = 0;
+            bool     found     = true;
+            while (found) {
+                found = false;
+                for (int i = 1; i < m_num_threads; ++i) {
+                    const int victim = (tid + i) % m_num_threads;
+                    if (steal_back(victim, id)) {
+                        task(m_tasks[id], tid);
+                        my_steals++;
+                        found = true;
+                        break;
+                    }
+                }
+            }
+            num_steals.fetch_add(my_steals, std::memory_order_relaxed);
+
+            const auto stop = std::chrono::high_resolution_clock::now();
+            busy_ms[tid] =
+                std::chrono::duration<double, std::milli>(stop - start).count();
+        }
+
+        m_stats.num_threads = m_num_threads;
+        m_stats.num_tasks   = get_num_tasks();
+        m_stats.num_steals  = num_steals.load();
+        m_stats.max_busy_ms = *std::max_element(busy_ms.begin(), busy_ms.end());
+        m_stats.avg_busy_ms =
+            std::accumulate(busy_ms.begin(), busy_ms.end(), 0.0) /
+            double(m_num_threads);
+    }
+
+    /**
+     * @brief statistics of the last run()
+     */
+    const HostSchedulerStats& stats() const
+    {
+        return m_stats;
+    }
+
+    uint32_t get_num_tasks() const
+    {
+        return static_cast<uint32_t>(m_tasks.size());
+    }
+
+    int get_num_threads() const
+    {
+        return m_num_threads;
+    }
+
+   private:
+    struct alignas(64) Queue
+    {
+        std::atomic<uint64_t> range;
+    };
+
+    static uint64_t pack(const uint32_t head, const uint32_t tail)
+    {
+        return (uint64_t(tail) << 32) | uint64_t(head);
+    }
+
+    bool pop_front(const int q, uint32_t& id)
+    {
+        uint64_t r = m_queues[q].range.load(std::memory_order_acquire);
+        while (true) {
+            const uint32_t head = static_cast<uint32_t>(r);
+            const uint32_t tail = static_cast<uint32_t>(r >> 32);
+            if (head >= tail) {
+                return false;
+            }
+            if (m_queues[q].range.compare_exchange_weak(
+                    r, pack(head + 1, tail), std::memory_order_acq_rel)) {
+                id = head;
+                return true;
+            }
+        }
+    }
+
+    bool steal_back(const int q, uint32_t& id)
+    {
+        uint64_t r = m_queues[q].range.load(std::memory_order_acquire);
+        while (true) {
+            const uint32_t head = static_cast<uint32_t>(r);
+            const uint32_t tail = static_cast<uint32_t>(r >> 32);
+            if (head >= tail) {
+                return false;
+            }
+            if (m_queues[q].range.compare_exchange_weak(
+                    r, pack(head, tail - 1), std::memory_order_acq_rel)) {
+                id = tail - 1;
+                return true;
+            }
+        }
+    }
+
+    int                      m_num_threads;
+    std::vector<HostTask>    m_tasks;
+    std::vector<uint32_t>    m_queue_offset;
+    std::unique_ptr<Queue[]> m_queues;
+    HostSchedulerStats       m_stats;
+};
+
+}  // namespace detail
+}  // namespace rxmesh
@@ -0,0 +1,1140 @@
+#pragma once
+#include <omp.h>
+#include <stdint.h>
+#include <string.h>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include "rxmesh/util/host_parallel.h"
+#include "rxmesh/util/log.h"
+#include "rxmesh/util/mapped_file.h"
+
+namespace rxmesh {
+
+namespace detail {
+
+inline bool is_blank(const char c)
+{
+    // white space other than new line
+    return c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+}
+
+inline bool is_digit(const char c)
+{
+    return c >= '0' && c <= '9';
+}
+
+inline const char* skip_blank(const char* p, const char* end)
+{
+    while (p < end && is_blank(*p)) {
+        ++p;
+    }
+    return p;
+}
+
+inline const char* skip_white_space(const char* p, const char* end)
+{
+    while (p < end && (is_blank(*p) || *p == '\n')) {
+        ++p;
+    }
+    return p;
+}
+
+inline const char* next_line(const char* p, const char* end)
+{
+    const char* nl =
+        static_cast<const char*>(memchr(p, '\n', static_cast<size_t>(end - p)));
+    return (nl == nullptr) ? end : nl + 1;
+}
+
+/**
+ * @brief parse a signed integer starting at p. Return the pointer right after
+ * the integer or nullptr if there is no integer at p
+ */
+inline const char* parse_int(const char* p, const char* end, int64_t& val)
+{
+    bool neg = false;
+    if (p < end && (*p == '-' || *p == '+')) {
+        neg = (*p == '-');
+        ++p;
+    }
+    if (p >= end || !is_digit(*p)) {
+        return nullptr;
+    }
+    int64_t v = 0;
+    while (p < end && is_digit(*p)) {
+        v = 10 * v + (*p - '0');
+        ++p;
+    }
+    val = neg ? -v : v;
+    return p;
+}
+
+/**
+ * @brief parse a floating point number (decimal notation with optional
+ * exponent) starting at p. The significant digits are accumulated in an
+ * integer and scaled once by a power of 10 which is exact (i.e., correctly
+ * rounded) for up to 15 significant digits and 22 decimal places which covers
+ * what mesh exporters write. Return the pointer right after the number or
+ * nullptr if there is no number at p
+ */
+template <typename T>
+inline const char* parse_float(const char* p, const char* end, T& val)
+{
+    static constexpr double pow10[] = {
+        1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+    bool neg = false;
+    if (p < end && (*p == '-' || *p == '+')) {
+        neg = (*p == '-');
+        ++p;
+    }
+
+    uint64_t mantissa   = 0;
+    int      exp10      = 0;
+    int      num_digits = 0;
+    bool     any_digit  = false;
+
+    while (p < end && is_digit(*p)) {
+        if (num_digits < 19) {
+            mantissa = 10 * mantissa + (*p - '0');
+            num_digits += (mantissa != 0);
+        } else {
+            ++exp10;
+        }
+        any_digit = true;
+        ++p;
+    }
+
+    if (p < end && *p == '.') {
+        ++p;
+        while (p < end && is_digit(*p)) {
+            if (num_digits < 19) {
+                mantissa = 10 * mantissa + (*p - '0');
+                num_digits += (mantissa != 0);
+                --exp10;
+            }
+            any_digit = true;
+            ++p;
+        }
+    }
+
+    if (!any_digit) {
+        return nullptr;
+    }
+
+    if (p < end && (*p == 'e' || *p == 'E')) {
+        int64_t     e;
+        const char* q = parse_int(p + 1, end, e);
+        if (q != nullptr) {
+            exp10 += static_cast<int>(std::max<int64_t>(
+                std::min<int64_t>(e, 1000), int64_t(-1000)));
+            p = q;
+        }
+    }
+
+    double d = static_cast<double>(mantissa);
+    if (exp10 < 0) {
+        d = (exp10 >= -22) ? d / pow10[-exp10] : d * std::pow(10.0, exp10);
+    } else if (exp10 > 0) {
+        d = (exp10 <= 22) ? d * pow10[exp10] : d * std::pow(10.0, exp10);
+    }
+
+    val = static_cast<T>(neg ? -d : d);
+    return p;
+}
+
+/**
+ * @brief split [data, data + size) into num_chunks chunks where every chunk
+ * (other than the first) starts right after a new line
+ */
+inline std::vector<const char*> split_lines_into_chunks(const char* data,
+                                                        const size_t size,
+                                                        const int num_chunks)
+{
+    const char*              end = data + size;
+    std::vector<const char*> chunks(num_chunks + 1, end);
+    chunks[0] = data;
+    for (int c = 1; c < num_chunks; ++c) {
+        const char* p = data + (size * c) / num_chunks;
+        p             = std::max(p, chunks[c - 1]);
+        chunks[c]     = (p == data) ? data : next_line(p - 1, end);
+    }
+    return chunks;
+}
+
+inline std::string file_extension(const std::string& file_name)
+{
+    const size_t dot = file_name.find_last_of('.');
+    if (dot == std::string::npos) {
+        return "";
+    }
+    std::string ext = file_name.substr(dot + 1);
+    std::transform(ext.begin(), ext.end(), ext.begin(), [](char c) {
+        return static_cast<char>(::tolower(c));
+    });
+    return ext;
+}
+
+/**
+ * @brief PLY property types
+ */
+enum class PlyType
+{
+    Int8,
+    UInt8,
+    Int16,
+    UInt16,
+    Int32,
+    UInt32,
+    Float32,
+    Float64,
+    Invalid,
+};
+
+inline PlyType ply_type(const std::string& s)
+{
+    if (s == "char" || s == "int8") {
+        return PlyType::Int8;
+    }
+    if (s == "uchar" || s == "uint8") {
+        return PlyType::UInt8;
+    }
+    if (s == "short" || s == "int16") {
+        return PlyType::Int16;
+    }
+    if (s == "ushort" || s == "uint16") {
+        return PlyType::UInt16;
+    }
+    if (s == "int" || s == "int32") {
+        return PlyType::Int32;
+    }
+    if (s == "uint" || s == "uint32") {
+        return PlyType::UInt32;
+    }
+    if (s == "float" || s == "float32") {
+        return PlyType::Float32;
+    }
+    if (s == "double" || s == "float64") {
+        return PlyType::Float64;
+    }
+    return PlyType::Invalid;
+}
+
+inline size_t ply_type_size(const PlyType t)
+{
+    switch (t) {
+        case PlyType::Int8:
+        case PlyType::UInt8:
+            return 1;
+        case PlyType::Int16:
+        case PlyType::UInt16:
+            return 2;
+        case PlyType::Int32:
+        case PlyType::UInt32:
+        case PlyType::Float32:
+            return 4;
+        case PlyType::Float64:
+            return 8;
+        default:
+            return 0;
+    }
+}
+
+/**
+ * @brief read a binary PLY value of type t stored at p and cast it to T
+ */
+template <typename T>
+inline T ply_read(const char* p, const PlyType t, const bool swap_bytes)
+{
+    char         buf[8];
+    const size_t s = ply_type_size(t);
+    memcpy(buf, p, s);
+    if (swap_bytes) {
+        std::reverse(buf, buf + s);
+    }
+    switch (t) {
+        case PlyType::Int8: {
+            int8_t v;
+            memcpy(&v, buf, 1);
+            return static_cast<T>(v);
+        }
+        case PlyType::UInt8: {
+            uint8_t v;
+            memcpy(&v, buf, 1);
+            return static_cast<T>(v);
+        }
+        case PlyType::Int16: {
+            int16_t v;
+            memcpy(&v, buf, 2);
+            return static_cast<T>(v);
+        }
+        case PlyType::UInt16: {
+            uint16_t v;
+            memcpy(&v, buf, 2);
+            return static_cast<T>(v);
+        }
+        case PlyType::Int32: {
+            int32_t v;
+            memcpy(&v, buf, 4);
+            return static_cast<T>(v);
+        }
+        case PlyType::UInt32: {
+            uint32_t v;
+            memcpy(&v, buf, 4);
+            return static_cast<T>(v);
+        }
+        case PlyType::Float32: {
+            float v;
+            memcpy(&v, buf, 4);
+            return static_cast<T>(v);
+        }
+        case PlyType::Float64: {
+            double v;
+            memcpy(&v, buf, 8);
+            return static_cast<T>(v);
+        }
+        default:
+            return T(0);
+    }
+}
+
+struct PlyProperty
+{
+    std::string name;
+    PlyType     type       = PlyType::Invalid;
+    bool        is_list    = false;
+    PlyType     count_type = PlyType::Invalid;
+};
+
+struct PlyElement
+{
+    std::string              name;
+    size_t                   count = 0;
+    std::vector<PlyProperty> properties;
+
+    // the size of one record if the element has no list properties
+    size_t fixed_size() const
+    {
+        size_t s = 0;
+        for (const auto& p : properties) {
+            if (p.is_list) {
+                return 0;
+            }
+            s += ply_type_size(p.type);
+        }
+        return s;
+    }
+};
+
+/**
+ * @brief welds the vertices of a triangle soup (e.g., STL) by merging vertices
+ * with bitwise-identical coordinates. The corners are sorted by a hash of
+ * their coordinates in parallel and the vertices are numbered in the order of
+ * their first appearance in the soup
+ * @param soup 3 coordinates per corner (9 per triangle)
+ * @param num_corners number of corners in soup
+ * @param vertices output welded vertex coordinates (3 per vertex)
+ * @param faces output face indices (3 per face)
+ */
+template <typename DataT, typename IndexT>
+inline void weld_vertices(const std::vector<float>& soup,
+                          const size_t              num_corners,
+                          std::vector<DataT>&       vertices,
+                          std::vector<IndexT>&      faces)
+{
+    const int64_t n = static_cast<int64_t>(num_corners);
+
+    auto corner_bits = [&](const int64_t c, const int i) {
+        float x = soup[3 * c + i];
+        // so that -0.0 and 0.0 are welded
+        if (x == 0.f) {
+            x = 0.f;
+        }
+        uint32_t b;
+        memcpy(&b, &x, sizeof(uint32_t));
+        return b;
+    };
+
+    auto mix = [](uint64_t h) {
+        // splitmix64 finalizer
+        h ^= h >> 30;
+        h *= 0xbf58476d1ce4e5b9ULL;
+        h ^= h >> 27;
+        h *= 0x94d049bb133111ebULL;
+        h ^= h >> 31;
+        return h;
+    };
+
+    std::vector<uint64_t> key(num_corners);
+    std::vector<uint32_t> corner(num_corners);
+#pragma omp parallel for
+    for (int64_t c = 0; c < n; ++c) {
+        const uint64_t xy =
+            (uint64_t(corner_bits(c, 0)) << 32) | uint64_t(corner_bits(c, 1));
+        key[c]    = mix(xy ^ mix(uint64_t(corner_bits(c, 2)) + 1));
+        corner[c] = static_cast<uint32_t>(c);
+    }
+
+    host_radix_sort_pairs(key, corner, 64);
+
+    auto same_position = [&](const uint32_t a, const uint32_t b) {
+        return corner_bits(a, 0) == corner_bits(b, 0) &&
+               corner_bits(a, 1) == corner_bits(b, 1) &&
+               corner_bits(a, 2) == corner_bits(b, 2);
+    };
+
+    // segments of equal hash. Within a segment, corners with the same
+    // position are grouped and represented by the smallest corner
+    std::vector<uint32_t> rep(num_corners);
+    std::vector<uint32_t> seg_id(num_corners);
+#pragma omp parallel for
+    for (int64_t i = 0; i < n; ++i) {
+        seg_id[i] = (i == 0 || key[i] != key[i - 1]) ? 1 : 0;
+    }
+    const uint32_t num_seg =
+        host_exclusive_scan(seg_id.data(), seg_id.data(), num_corners);
+
+    std::vector<uint32_t> seg_start(num_seg + 1);
+#pragma omp parallel for
+    for (int64_t i = 0; i < n; ++i) {
+        if (i == 0 || key[i] != key[i - 1]) {
+            seg_start[seg_id[i]] = static_cast<uint32_t>(i);
+        }
+    }
+    seg_start[num_seg] = static_cast<uint32_t>(num_corners);
+
+#pragma omp parallel for schedule(dynamic, 1024)
+    for (int64_t s = 0; s < int64_t(num_seg); ++s) {
+        const uint32_t s_start = seg_start[s];
+        const uint32_t s_end   = seg_start[s + 1];
+
+        // the corners are sorted (since the radix sort is stable) so the first
+        // corner in a group is its smallest one
+        for (uint32_t i = s_start; i < s_end; ++i) {
+            const uint32_t c = corner[i];
+            rep[c]           = c;
+            for (uint32_t j = s_start; j < i; ++j) {
+                if (rep[corner[j]] == corner[j] &&
+                    same_position(corner[j], c)) {
+                    rep[c] = corner[j];
+                    break;
+                }
+            }
+        }
+    }
+
+    // number the representatives in the corner order
+    std::vector<uint32_t> vertex_id(num_corners);
+#pragma omp parallel for
+    for (int64_t c = 0; c < n; ++c) {
+        vertex_id[c] = (rep[c] == uint32_t(c)) ? 1 : 0;
+    }
+    const uint32_t num_vertices =
+        host_exclusive_scan(vertex_id.data(), vertex_id.data(), num_corners);
+
+    vertices.resize(3 * size_t(num_vertices));
+    faces.resize(num_corners);
+#pragma omp parallel for
+    for (int64_t c = 0; c < n; ++c) {
+        const uint32_t v = vertex_id[rep[c]];
+        faces[c]         = static_cast<IndexT>(v);
+        if (rep[c] == uint32_t(c)) {
+            for (int i = 0; i < 3; ++i) {
+                vertices[3 * size_t(v) + i] =
+                    static_cast<DataT>(soup[3 * c + i]);
+            }
+        }
+    }
+}
+
+}  // namespace detail
+
+/**
+ * @brief Read an obj file into flat arrays. The file is memory mapped and
+ * split into chunks (at line boundaries) that are parsed in parallel. Polygons
+ * are triangulated as a fan. Normals, texture coordinates, groups, and
+ * materials are skipped
+ * @tparam DataT coordinates type (float/double)
+ * @tparam IndexT indices type
+ * @param file_name path to the obj file
+ * @param vertices 3d vertices (3*#vertices)
+ * @param faces face index to the vertices array (3*#faces)
+ * @return true if reading the file is successful
+ */
+template <typename DataT, typename IndexT>
+bool fast_import_obj(const std::string    file_name,
+                     std::vector<DataT>&  vertices,
+                     std::vector<IndexT>& faces)
+{
+    using namespace detail;
+
+    MappedFile file;
+    if (!file.open(file_name)) {
+        RXMESH_ERROR("fast_import_obj() can not open {}", file_name);
+        return false;
+    }
+    RXMESH_INFO("Reading {}", file_name);
+
+    vertices.clear();
+    faces.clear();
+
+    const char*  data = file.data();
+    const size_t size = file.size();
+
+    const int num_chunks = std::max(
+        1,
+        static_cast<int>(std::min<size_t>(4 * omp_get_max_threads(),
+                                          size / (1 << 16))));
+    const std::vector<const char*> chunks =
+        split_lines_into_chunks(data, size, num_chunks);
+
+    auto is_vertex_line = [](const char* p, const char* end) {
+        return p + 1 < end && p[0] == 'v' && is_blank(p[1]);
+    };
+    auto is_face_line = [](const char* p, const char* end) {
+        return p + 1 < end && p[0] == 'f' && is_blank(p[1]);
+    };
+
+    // 1) count the vertices and triangles in every chunk
+    std::vector<uint64_t> chunk_num_v(num_chunks + 1, 0);
+    std::vector<uint64_t> chunk_num_t(num_chunks + 1, 0);
+    std::atomic<bool>     is_ok(true);
+
+#pragma omp parallel for schedule(dynamic, 1)
+    for (int c = 0; c < num_chunks; ++c) {
+        const char* p   = chunks[c];
+        const char* end = chunks[c + 1];
+        uint64_t    nv = 0, nt = 0;
+        while (p < end) {
+            p = skip_blank(p, end);
+            if (is_vertex_line(p, end)) {
+                ++nv;
+            } else if (is_face_line(p, end)) {
+                // count the number of corners
+                const char* q         = p + 1;
+                uint32_t    num_words = 0;
+                while (true) {
+                    q = skip_blank(q, end);
+                    if (q >= end || *q == '\n' || *q == '#') {
+                        break;
+                    }
+                    ++num_words;
+                    while (q < end && !is_blank(*q) && *q != '\n') {
+                        ++q;
+                    }
+                }
+                if (num_words < 3) {
+                    is_ok = false;
+                }
+                nt += (num_words >= 3) ? num_words - 2 : 0;
+            }
+            p = next_line(p, end);
+        }
+        chunk_num_v[c] = nv;
+        chunk_num_t[c] = nt;
+    }
+    if (!is_ok) {
+        RXMESH_ERROR("fast_import_obj() face with less than 3 vertices in {}",
+                     file_name);
+        return false;
+    }
+
+    const uint64_t num_vertices = host_exclusive_scan(
+        chunk_num_v.data(), chunk_num_v.data(), chunk_num_v.size());
+    const uint64_t num_faces = host_exclusive_scan(
+        chunk_num_t.data(), chunk_num_t.data(), chunk_num_t.size());
+
+    vertices.resize(3 * num_vertices);
+    faces.resize(3 * num_faces);
+
+    // 2) parse every chunk directly into its place in the output
+#pragma omp parallel for schedule(dynamic, 1)
+    for (int c = 0; c < num_chunks; ++c) {
+        const char* p   = chunks[c];
+        const char* end = chunks[c + 1];
+        uint64_t    v   = chunk_num_v[c];
+        uint64_t    t   = chunk_num_t[c];
+        while (p < end && is_ok) {
+            p = skip_blank(p, end);
+            if (is_vertex_line(p, end)) {
+                const char* q = p + 1;
+                for (int i = 0; i < 3; ++i) {
+                    if (q != nullptr) {
+                        q = skip_blank(q, end);
+                        q = parse_float(q, end, vertices[3 * v + i]);
+                    }
+                }
+                if (q == nullptr) {
+                    is_ok = false;
+                }
+                ++v;
+            } else if (is_face_line(p, end)) {
+                // v is the number of vertices defined before this face which
+                // is what negative (relative) indices refer to
+                const char* q = p + 1;
+                int64_t     first = 0, prev = 0;
+                uint32_t    num_words = 0;
+                while (true) {
+                    q = skip_blank(q, end);
+                    if (q >= end || *q == '\n' || *q == '#') {
+                        break;
+                    }
+                    int64_t id;
+                    q = parse_int(q, end, id);
+                    if (q == nullptr || id == 0) {
+                        is_ok = false;
+                        break;
+                    }
+                    id = (id < 0) ? id + int64_t(v) : id - 1;
+                    if (id < 0 || uint64_t(id) >= num_vertices) {
+                        is_ok = false;
+                        break;
+                    }
+                    // skip texture/normal indices
+                    while (q < end && !is_blank(*q) && *q != '\n') {
+                        ++q;
+                    }
+                    if (num_words == 0) {
+                        first = id;
+                    } else if (num_words >= 2) {
+                        faces[3 * t + 0] = static_cast<IndexT>(first);
+                        faces[3 * t + 1] = static_cast<IndexT>(prev);
+                        faces[3 * t + 2] = static_cast<IndexT>(id);
+                        ++t;
+                    }
+                    prev = id;
+                    ++num_words;
+                }
+            }
+            p = next_line(p, end);
+        }
+    }
+
+    if (!is_ok) {
+        RXMESH_ERROR(
+            "fast_import_obj() invalid vertex or face (e.g., missing "
+            "coordinates or out-of-range index) in {}",
+            file_name);
+        vertices.clear();
+        faces.clear();
+        return false;
+    }
+
+    RXMESH_INFO("fast_import_obj() #vertices= {} ", num_vertices);
+    RXMESH_INFO("fast_import_obj() #faces= {} ", num_faces);
+
+    return true;
+}
+
+/**
+ * @brief Read a PLY file (binary little/big endian or ascii) into flat
+ * arrays. The file is memory mapped and binary vertices (and triangles, if all
+ * faces are triangles) are decoded in parallel. Polygons are triangulated as a
+ * fan and elements other than vertex and face are skipped
+ * @tparam DataT coordinates type (float/double)
+ * @tparam IndexT indices type
+ * @param file_name path to the ply file
+ * @param vertices 3d vertices (3*#vertices)
+ * @param faces face index to the vertices array (3*#faces)
+ * @return true if reading the file is successful
+ */
+template <typename DataT, typename IndexT>
+bool import_ply(const std::string    file_name,
+                std::vector<DataT>&  vertices,
+                std::vector<IndexT>& faces)
+{
+    using namespace detail;
+
+    MappedFile file;
+    if (!file.open(file_name)) {
+        RXMESH_ERROR("import_ply() can not open {}", file_name);
+        return false;
+    }
+    RXMESH_INFO("Reading {}", file_name);
+
+    vertices.clear();
+    faces.clear();
+
+    const char* data = file.data();
+    const char* end  = data + file.size();
+
+    // 1) header
+    if (file.size() < 3 || strncmp(data, "ply", 3) != 0) {
+        RXMESH_ERROR("import_ply() {} is not a ply file", file_name);
+        return false;
+    }
+
+    enum class Format
+    {
+        Ascii,
+        BinaryLittleEndian,
+        BinaryBigEndian
+    };
+    Format                  format = Format::Ascii;
+    std::vector<PlyElement> elements;
+
+    const char* p = next_line(data, end);
+    while (true) {
+        if (p >= end) {
+            RXMESH_ERROR("import_ply() missing end_header in {}", file_name);
+            return false;
+        }
+        const char* line_end = next_line(p, end);
+
+        // split the line into words
+        std::vector<std::string> words;
+        const char*              q = p;
+        while (true) {
+            q = skip_blank(q, line_end);
+            if (q >= line_end || *q == '\n') {
+                break;
+            }
+            const char* w = q;
+            while (q < line_end && !is_blank(*q) && *q != '\n') {
+                ++q;
+            }
+            words.emplace_back(w, q);
+        }
+        p = line_end;
+
+        if (words.empty() || words[0] == "comment" || words[0] == "obj_info") {
+            continue;
+        }
+        if (words[0] == "end_header") {
+            break;
+        }
+        if (words[0] == "format" && words.size() >= 2) {
+            if (words[1] == "ascii") {
+                format = Format::Ascii;
+            } else if (words[1] == "binary_little_endian") {
+                format = Format::BinaryLittleEndian;
+            } else if (words[1] == "binary_big_endian") {
+                format = Format::BinaryBigEndian;
+            } else {
+                RXMESH_ERROR("import_ply() unknown format {} in {}",
+                             words[1],
+                             file_name);
+                return false;
+            }
+        } else if (words[0] == "element" && words.size() >= 3) {
+            PlyElement el;
+            el.name  = words[1];
+            el.count = std::stoull(words[2]);
+            elements.push_back(el);
+        } else if (words[0] == "property" && !elements.empty()) {
+            PlyProperty prop;
+            if (words.size() >= 5 && words[1] == "list") {
+                prop.is_list    = true;
+                prop.count_type = ply_type(words[2]);
+                prop.type       = ply_type(words[3]);
+                prop.name       = words[4];
+            } else if (words.size() >= 3) {
+                prop.type = ply_type(words[1]);
+                prop.name = words[2];
+            }
+            if (prop.type == PlyType::Invalid ||
+                (prop.is_list && prop.count_type == PlyType::Invalid)) {
+                RXMESH_ERROR("import_ply() invalid property in {}", file_name);
+                return false;
+            }
+            elements.back().properties.push_back(prop);
+        }
+    }
+
+    const bool swap_bytes = (format == Format::BinaryBigEndian);
+
+    // 2) body
+    auto find_property = [](const PlyElement& el, const std::string& name) {
+        for (size_t i = 0; i < el.properties.size(); ++i) {
+            if (el.properties[i].name == name) {
+                return static_cast<int>(i);
+            }
+        }
+        return -1;
+    };
+
+    // triangulate a polygon (as a fan) given its corners
+    auto add_polygon = [&](const std::vector<int64_t>& poly) {
+        for (size_t i = 2; i < poly.size(); ++i) {
+            faces.push_back(static_cast<IndexT>(poly[0]));
+            faces.push_back(static_cast<IndexT>(poly[i - 1]));
+            faces.push_back(static_cast<IndexT>(poly[i]));
+        }
+    };
+
+    std::vector<int64_t> poly;
+    std::vector<double>  values;
+
+    for (const PlyElement& el : elements) {
+        const bool is_vertex = (el.name == "vertex");
+        const bool is_face   = (el.name == "face");
+
+        int xyz[3] = {-1, -1, -1};
+        int fid    = -1;
+        if (is_vertex) {
+            xyz[0] = find_property(el, "x");
+            xyz[1] = find_property(el, "y");
+            xyz[2] = find_property(el, "z");
+            if (xyz[0] < 0 || xyz[1] < 0 || xyz[2] < 0) {
+                RXMESH_ERROR("import_ply() vertex without x, y, z in {}",
+                             file_name);
+                return false;
+            }
+            vertices.resize(3 * el.count);
+        }
+        if (is_face) {
+            fid = find_property(el, "vertex_indices");
+            if (fid < 0) {
+                fid = find_property(el, "vertex_index");
+            }
+            if (fid < 0 || !el.properties[fid].is_list) {
+                RXMESH_ERROR("import_ply() face without vertex_indices in {}",
+                             file_name);
+                return false;
+            }
+            faces.reserve(3 * el.count);
+        }
+
+        if (format == Format::Ascii) {
+            for (size_t r = 0; r < el.count; ++r) {
+                for (size_t i = 0; i < el.properties.size(); ++i) {
+                    const PlyProperty& prop = el.properties[i];
+
+                    size_t count = 1;
+                    if (prop.is_list) {
+                        double c;
+                        p = skip_white_space(p, end);
+                        p = parse_float(p, end, c);
+                        if (p == nullptr) {
+                            break;
+                        }
+                        count = static_cast<size_t>(c);
+                    }
+                    values.resize(count);
+                    for (size_t k = 0; k < count && p != nullptr; ++k) {
+                        p = skip_white_space(p, end);
+                        p = parse_float(p, end, values[k]);
+                    }
+                    if (p == nullptr) {
+                        break;
+                    }
+
+                    if (is_vertex) {
+                        for (int k = 0; k < 3; ++k) {
+                            if (int(i) == xyz[k]) {
+                                vertices[3 * r + k] =
+                                    static_cast<DataT>(values[0]);
+                            }
+                        }
+                    }
+                    if (is_face && int(i) == fid) {
+                        poly.assign(values.begin(), values.end());
+                        add_polygon(poly);
+                    }
+                }
+                if (p == nullptr) {
+                    RXMESH_ERROR("import_ply() invalid {} in {}",
+                                 el.name,
+                                 file_name);
+                    return false;
+                }
+            }
+            continue;
+        }
+
+        // binary
+        const size_t fixed_size = el.fixed_size();
+        if (fixed_size > 0) {
+            if (size_t(end - p) < fixed_size * el.count) {
+                RXMESH_ERROR("import_ply() unexpected end of file in {}",
+                             file_name);
+                return false;
+            }
+            if (is_vertex) {
+                size_t  offset[3];
+                PlyType type[3];
+                for (int k = 0; k < 3; ++k) {
+                    offset[k] = 0;
+                    for (int i = 0; i < xyz[k]; ++i) {
+                        offset[k] += ply_type_size(el.properties[i].type);
+                    }
+                    type[k] = el.properties[xyz[k]].type;
+                }
+                const char*   base = p;
+                const int64_t n    = static_cast<int64_t>(el.count);
+#pragma omp parallel for
+                for (int64_t r = 0; r < n; ++r) {
+                    const char* rec = base + r * fixed_size;
+                    for (int k = 0; k < 3; ++k) {
+                        vertices[3 * r + k] = ply_read<DataT>(
+                            rec + offset[k], type[k], swap_bytes);
+                    }
+                }
+            }
+            p += fixed_size * el.count;
+            continue;
+        }
+
+        // elements with list properties. If this is a face element where
+        // the only list is the vertex indices, first assume all faces are
+        // triangles so the records have a fixed size and decode them in
+        // parallel
+        if (is_face) {
+            const PlyProperty& list = el.properties[fid];
+
+            bool   single_list = true;
+            size_t before = 0, after = 0;
+            for (size_t i = 0; i < el.properties.size(); ++i) {
+                if (int(i) == fid) {
+                    continue;
+                }
+                if (el.properties[i].is_list) {
+                    single_list = false;
+                }
+                (int(i) < fid ? before : after) +=
+                    ply_type_size(el.properties[i].type);
+            }
+            const size_t count_size = ply_type_size(list.count_type);
+            const size_t index_size = ply_type_size(list.type);
+            const size_t tri_size =
+                before + count_size + 3 * index_size + after;
+
+            if (single_list && size_t(end - p) >= tri_size * el.count) {
+                const char*       base = p;
+                const int64_t     n    = static_cast<int64_t>(el.count);
+                std::atomic<bool> all_tri(true);
+                faces.resize(3 * el.count);
+#pragma omp parallel for
+                for (int64_t r = 0; r < n; ++r) {
+                    const char* rec = base + r * tri_size + before;
+                    if (ply_read<int64_t>(rec, list.count_type, swap_bytes) !=
+                        3) {
+                        all_tri = false;
+                        continue;
+                    }
+                    for (int k = 0; k < 3; ++k) {
+                        faces[3 * r + k] = ply_read<IndexT>(
+                            rec + count_size + k * index_size,
+                            list.type,
+                            swap_bytes);
+                    }
+                }
+                if (all_tri) {
+                    p += tri_size * el.count;
+                    continue;
+                }
+                faces.clear();
+            }
+        }
+
+        // general case: walk the records sequentially
+        for (size_t r = 0; r < el.count; ++r) {
+            for (size_t i = 0; i < el.properties.size(); ++i) {
+                const PlyProperty& prop = el.properties[i];
+                if (!prop.is_list) {
+                    const size_t size = ply_type_size(prop.type);
+                    if (size_t(end - p) < size) {
+                        p = nullptr;
+                        break;
+                    }
+                    if (is_vertex) {
+                        for (int k = 0; k < 3; ++k) {
+                            if (int(i) == xyz[k]) {
+                                vertices[3 * r + k] =
+                                    ply_read<DataT>(p, prop.type, swap_bytes);
+                            }
+                        }
+                    }
+                    p += size;
+                    continue;
+                }
+                const size_t count_size = ply_type_size(prop.count_type);
+                const size_t value_size = ply_type_size(prop.type);
+                if (size_t(end - p) < count_size) {
+                    p = nullptr;
+                    break;
+                }
+                const int64_t count =
+                    ply_read<int64_t>(p, prop.count_type, swap_bytes);
+                p += count_size;
+                if (count < 0 || size_t(end - p) < count * value_size) {
+                    p = nullptr;
+                    break;
+                }
+                if (is_face && int(i) == fid) {
+                    poly.resize(count);
+                    for (int64_t k = 0; k < count; ++k) {
+                        poly[k] = ply_read<int64_t>(
+                            p + k * value_size, prop.type, swap_bytes);
+                    }
+                    add_polygon(poly);
+                }
+                p += count * value_size;
+            }
+            if (p == nullptr || p > end) {
+                RXMESH_ERROR("import_ply() unexpected end of file in {}",
+                             file_name);
+                return false;
+            }
+        }
+    }
+
+    // check the face indices
+    const uint64_t num_vertices = vertices.size() / 3;
+    const int64_t  num_indices  = static_cast<int64_t>(faces.size());
+    bool           is_ok        = true;
+#pragma omp parallel for reduction(&& : is_ok)
+    for (int64_t i = 0; i < num_indices; ++i) {
+        is_ok = is_ok && (uint64_t(faces[i]) < num_vertices);
+    }
+    if (!is_ok) {
+        RXMESH_ERROR("import_ply() out-of-range face index in {}", file_name);
+        vertices.clear();
+        faces.clear();
+        return false;
+    }
+
+    RXMESH_INFO("import_ply() #vertices= {} ", num_vertices);
+    RXMESH_INFO("import_ply() #faces= {} ", faces.size() / 3);
+
+    return true;
+}
+
+/**
+ * @brief Read an STL file (binary or ascii) into flat arrays. STL stores a
+ * triangle soup so the vertices are welded (i.e., vertices with identical
+ * coordinates are merged) unless weld is false in which case every triangle
+ * gets its own three vertices. Binary triangles are decoded in parallel
+ * @tparam DataT coordinates type (float/double)
+ * @tparam IndexT indices type
+ * @param file_name path to the stl file
+ * @param vertices 3d vertices (3*#vertices)
+ * @param faces face index to the vertices array (3*#faces)
+ * @param weld merge vertices with identical coordinates
+ * @return true if reading the file is successful
+ */
+template <typename DataT, typename IndexT>
+bool import_stl(const std::string    file_name,
+                std::vector<DataT>&  vertices,
+                std::vector<IndexT>& faces,
+                const bool           weld = true)
+{
+    using namespace detail;
+
+    MappedFile file;
+    if (!file.open(file_name)) {
+        RXMESH_ERROR("import_stl() can not open {}", file_name);
+        return false;
+    }
+    RXMESH_INFO("Reading {}", file_name);
+
+    vertices.clear();
+    faces.clear();
+
+    const char*  data = file.data();
+    const size_t size = file.size();
+
+    // 3 coordinates per corner
+    std::vector<float> soup;
+    size_t             num_tri = 0;
+
+    uint32_t bin_num_tri = 0;
+    if (size >= 84) {
+        memcpy(&bin_num_tri, data + 80, sizeof(uint32_t));
+    }
+
+    if (size >= 84 && 84 + 50 * size_t(bin_num_tri) == size) {
+        // binary: 80 bytes header, #triangles, and then 50 bytes per triangle
+        // (normal, 3 vertices, attribute)
+        num_tri = bin_num_tri;
+        soup.resize(9 * num_tri);
+        const int64_t n = static_cast<int64_t>(num_tri);
+#pragma omp parallel for
+        for (int64_t t = 0; t < n; ++t) {
+            memcpy(soup.data() + 9 * t, data + 84 + 50 * t + 12, 36);
+        }
+    } else if (size >= 5 && strncmp(data, "solid", 5) == 0) {
+        // ascii: only the "vertex x y z" lines matter
+        const char* p   = data;
+        const char* end = data + size;
+        while (p < end) {
+            p = skip_white_space(p, end);
+            if (end - p > 6 && strncmp(p, "vertex", 6) == 0 &&
+                is_blank(p[6])) {
+                const char* q = p + 6;
+                for (int i = 0; i < 3 && q != nullptr; ++i) {
+                    float x;
+                    q = skip_blank(q, end);
+                    q = parse_float(q, end, x);
+                    soup.push_back(x);
+                }
+                if (q == nullptr) {
+                    RXMESH_ERROR("import_stl() invalid vertex in {}",
+                                 file_name);
+                    return false;
+                }
+            }
+            p = next_line(p, end);
+        }
+        if (soup.size() % 9 != 0) {
+            RXMESH_ERROR("import_stl() invalid facet in {}", file_name);
+            return false;
+        }
+        num_tri = soup.size() / 9;
+    } else {
+        RXMESH_ERROR("import_stl() {} is not a valid stl file", file_name);
+        return false;
+    }
+
+    if (weld) {
+        weld_vertices(soup, 3 * num_tri, vertices, faces);
+    } else {
+        vertices.assign(soup.begin(), soup.end());
+        faces.resize(3 * num_tri);
+        for (size_t i = 0; i < faces.size(); ++i) {
+            faces[i] = static_cast<IndexT>(i);
+        }
+    }
+
+    RXMESH_INFO("import_stl() #vertices= {} ", vertices.size() / 3);
+    RXMESH_INFO("import_stl() #faces= {} ", faces.size() / 3);
+
+    return true;
+}
+
+/**
+ * @brief Read a mesh into flat arrays using the importer that matches the
+ * file extension (obj, ply, or stl)
+ * @tparam DataT coordinates type (float/double)
+ * @tparam IndexT indices type
+ * @param file_name path to the mesh file
+ * @param vertices 3d vertices (3*#vertices)
+ * @param faces face index to the vertices array (3*#faces)
+ * @return true if reading the file is successful
+ */
+template <typename DataT, typename IndexT>
+bool import_mesh(const std::string    file_name,
+                 std::vector<DataT>&  vertices,
+                 std::vector<IndexT>& faces)
+{
+    const std::string ext = detail::file_extension(file_name);
+    if (ext == "obj") {
+        return fast_import_obj(file_name, vertices, faces);
+    }
+    if (ext == "ply") {
+        return import_ply(file_name, vertices, faces);
+    }
+    if (ext == "stl") {
+        return import_stl(file_name, vertices, faces);
+    }
+    RXMESH_ERROR("import_mesh() unsupported file extension {} for {}",
+                 ext,
+                 file_name);
+    return false;
+}
+}  // namespace rxmesh
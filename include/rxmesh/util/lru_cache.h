@@ -0,0 +1,153 @@
+#pragma once
+#include <stddef.h>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+
+namespace rxmesh {
+
+/**
+ * @brief thread-safe least-recently-used cache with a budget in bytes. Values
+ * are held by shared_ptr so that a value evicted from the cache stays valid
+ * for whoever is still using it. The most recently inserted value is never
+ * evicted even if it alone exceeds the budget
+ */
+template <typename KeyT, typename ValueT>
+class LRUCache
+{
+   public:
+    using ValuePtr = std::shared_ptr<ValueT>;
+
+    explicit LRUCache(const size_t max_bytes)
+        : m_max_bytes(max_bytes),
+          m_bytes(0),
+          m_num_hits(0),
+          m_num_misses(0),
+          m_num_evictions(0)
+    {
+    }
+
+    LRUCache(const LRUCache&)            = delete;
+    LRUCache& operator=(const LRUCache&) = delete;
+
+    /**
+     * @brief return the value of key and mark it as most recently used.
+     * Return nullptr if key is not in the cache
+     */
+    ValuePtr get(const KeyT& key)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto                        it = m_map.find(key);
+        if (it == m_map.end()) {
+            m_num_misses++;
+            return nullptr;
+        }
+        m_num_hits++;
+        m_list.splice(m_list.begin(), m_list, it->second);
+        return it->second->value;
+    }
+
+    /**
+     * @brief insert (or replace) the value of key and evict the least
+     * recently used values until the cache fits in the budget
+     * @param num_bytes the size of value that is counted against the budget
+     */
+    void put(const KeyT& key, ValuePtr value, const size_t num_bytes)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto                        it = m_map.find(key);
+        if (it != m_map.end()) {
+            m_bytes -= it->second->num_bytes;
+            m_list.erase(it->second);
+            m_map.erase(it);
+        }
+        m_list.push_front({key, std::move(value), num_bytes});
+        m_map[key] = m_list.begin();
+        m_bytes += num_bytes;
+
+        while (m_bytes > m_max_bytes && m_list.size() > 1) {
+            const Entry& lru = m_list.back();
+            m_bytes -= lru.num_bytes;
+            m_map.erase(lru.key);
+            m_list.pop_back();
+            m_num_evictions++;
+        }
+    }
+
+    /**
+     * @brief drop key from the cache (if it is there)
+     */
+    void erase(const KeyT& key)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto                        it = m_map.find(key);
+        if (it != m_map.end()) {
+            m_bytes -= it->second->num_bytes;
+            m_list.erase(it->second);
+            m_map.erase(it);
+        }
+    }
+
+    void clear()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_list.clear();
+        m_map.clear();
+        m_bytes = 0;
+    }
+
+    size_t size() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_list.size();
+    }
+
+    size_t get_num_bytes() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_bytes;
+    }
+
+    size_t get_max_bytes() const
+    {
+        return m_max_bytes;
+    }
+
+    size_t get_num_hits() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_num_hits;
+    }
+
+    size_t get_num_misses() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_num_misses;
+    }
+
+    size_t get_num_evictions() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_num_evictions;
+    }
+
+   private:
+    struct Entry
+    {
+        KeyT     key;
+        ValuePtr value;
+        size_t   num_bytes;
+    };
+
+    mutable std::mutex m_mutex;
+    std::list<Entry>   m_list;
+    std::unordered_map<KeyT, typename std::list<Entry>::iterator> m_map;
+    size_t m_max_bytes;
+    size_t m_bytes;
+    size_t m_num_hits;
+    size_t m_num_misses;
+    size_t m_num_evictions;
+};
+}  // namespace rxmesh
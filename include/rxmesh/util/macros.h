@@ -1,10 +1,15 @@
 #pragma once
 
+#include <stdint.h>
+#include "rxmesh/util/log.h"
+
+#ifdef RX_CPU_ONLY
+#include "rxmesh/util/cpu_runtime.h"
+#else
 #include <cuda_runtime_api.h>
 #include <cusolverSp.h>
 #include <cusparse.h>
-#include <stdint.h>
-#include "rxmesh/util/log.h"
+#endif
 
 #ifdef USE_CUDSS
 #include <cudss.h>
@@ -88,6 +93,7 @@ inline void HandleError(cudaError_t err, const char* file, int line)
 #define CUDA_ERROR(err) (HandleError(err, __FILE__, __LINE__))
 #endif
 
+#ifndef RX_CPU_ONLY
 #ifndef CUSPARSE_ERROR
 inline void cusparseHandleError(cusparseStatus_t status,
                                 const char*      file,
@@ -162,6 +168,7 @@ inline void cublasHandleError(cublasStatus_t status,
 }
 #define CUBLAS_ERROR(err) (cublasHandleError(err, __FILE__, __LINE__))
 #endif
+#endif
 
 
 #ifdef USE_CUDSS
@@ -211,7 +218,7 @@ inline void cudssHandleError(cudssStatus_t status,
     }
 
 // Taken from https://stackoverflow.com/a/12779757/1608232
-#if defined(__CUDACC__)  // NVCC
+#if defined(__CUDACC__) && !defined(RX_CPU_ONLY)  // NVCC
 #define ALIGN(n) __align__(n)
 #elif defined(__GNUC__)  // GCC
 #define ALIGN(n) __attribute__((aligned(n)))
@@ -224,7 +231,12 @@ inline void cudssHandleError(cudssStatus_t status,
 
 // Taken from
 // https://docs.nvidia.com/cuda/cuda-c-programming-guide/index.html#extended-lambda-traits
+#ifdef RX_CPU_ONLY
+#define IS_D_LAMBDA(X) false
+#define IS_HD_LAMBDA(X) false
+#else
 #define IS_D_LAMBDA(X) __nv_is_extended_device_lambda_closure_type(X)
 #define IS_HD_LAMBDA(X) __nv_is_extended_host_device_lambda_closure_type(X)
+#endif
 
 }  // namespace rxmesh
\ No newline at end of file
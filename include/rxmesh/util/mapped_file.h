@@ -0,0 +1,179 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "rxmesh/util/log.h"
+
+namespace rxmesh {
+
+/**
+ * @brief read-only memory mapping of a whole file. The mapping is released
+ * when the object is destroyed. Reading through data() lets the OS page the
+ * file in on demand (and in parallel) instead of copying it through a stream
+ */
+class MappedFile
+{
+   public:
+    MappedFile() = default;
+
+    explicit MappedFile(const std::string& file_name)
+    {
+        open(file_name);
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    ~MappedFile()
+    {
+        close();
+    }
+
+    /**
+     * @brief map the file. Return false (and log the error) if the file can
+     * not be opened or mapped
+     */
+    bool open(const std::string& file_name)
+    {
+        close();
+
+#ifdef _WIN32
+        m_file = CreateFileA(file_name.c_str(),
+                             GENERIC_READ,
+                             FILE_SHARE_READ,
+                             NULL,
+                             OPEN_EXISTING,
+                             FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN,
+                             NULL);
+        if (m_file == INVALID_HANDLE_VALUE) {
+            RXMESH_ERROR("MappedFile::open() can not open {}", file_name);
+            return false;
+        }
+
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(m_file, &size)) {
+            RXMESH_ERROR("MappedFile::open() can not get the size of {}",
+                         file_name);
+            close();
+            return false;
+        }
+        m_size = static_cast<size_t>(size.QuadPart);
+        if (m_size == 0) {
+            return true;
+        }
+
+        m_mapping = CreateFileMappingA(m_file, NULL, PAGE_READONLY, 0, 0, NULL);
+        if (m_mapping == NULL) {
+            RXMESH_ERROR("MappedFile::open() can not map {}", file_name);
+            close();
+            return false;
+        }
+
+        m_data = static_cast<const char*>(
+            MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0));
+        if (m_data == nullptr) {
+            RXMESH_ERROR("MappedFile::open() can not map {}", file_name);
+            close();
+            return false;
+        }
+#else
+        m_fd = ::open(file_name.c_str(), O_RDONLY);
+        if (m_fd < 0) {
+            RXMESH_ERROR("MappedFile::open() can not open {}", file_name);
+            return false;
+        }
+
+        struct stat st;
+        if (fstat(m_fd, &st) != 0) {
+            RXMESH_ERROR("MappedFile::open() can not get the size of {}",
+                         file_name);
+            close();
+            return false;
+        }
+        m_size = static_cast<size_t>(st.st_size);
+        if (m_size == 0) {
+            return true;
+        }
+
+        void* ptr = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, m_fd, 0);
+        if (ptr == MAP_FAILED) {
+            RXMESH_ERROR("MappedFile::open() can not map {}", file_name);
+            close();
+            return false;
+        }
+        m_data = static_cast<const char*>(ptr);
+        madvise(ptr, m_size, MADV_WILLNEED);
+#endif
+        return true;
+    }
+
+    void close()
+    {
+#ifdef _WIN32
+        if (m_data) {
+            UnmapViewOfFile(m_data);
+        }
+        if (m_mapping != NULL) {
+            CloseHandle(m_mapping);
+        }
+        if (m_file != INVALID_HANDLE_VALUE) {
+            CloseHandle(m_file);
+        }
+        m_mapping = NULL;
+        m_file    = INVALID_HANDLE_VALUE;
+#else
+        if (m_data) {
+            munmap(const_cast<char*>(m_data), m_size);
+        }
+        if (m_fd >= 0) {
+            ::close(m_fd);
+        }
+        m_fd = -1;
+#endif
+        m_data = nullptr;
+        m_size = 0;
+    }
+
+    const char* data() const
+    {
+        return m_data;
+    }
+
+    size_t size() const
+    {
+        return m_size;
+    }
+
+    bool is_open() const
+    {
+#ifdef _WIN32
+        return m_file != INVALID_HANDLE_VALUE;
+#else
+        return m_fd >= 0;
+#endif
+    }
+
+   private:
+    const char* m_data = nullptr;
+    size_t      m_size = 0;
+#ifdef _WIN32
+    HANDLE m_file    = INVALID_HANDLE_VALUE;
+    HANDLE m_mapping = NULL;
+#else
+    int m_fd = -1;
+#endif
+};
+}  // namespace rxmesh
@@ -1,7 +1,11 @@
 #pragma once
 #include <tuple>
 
+#ifdef RX_CPU_ONLY
+#include "rxmesh/util/cpu_runtime.h"
+#else
 #include <cuComplex.h>
+#endif
 
 namespace rxmesh {
 namespace detail {
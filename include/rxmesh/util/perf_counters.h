@@ -0,0 +1,297 @@
+#pragma once
+#include <stdint.h>
+#include <string.h>
+#include <algorithm>
+#include <array>
+#include <atomic>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "rxmesh/util/log.h"
+
+namespace rxmesh {
+
+/**
+ * @brief the hardware events counted by PerfCounters
+ */
+enum class PerfEvent : int
+{
+    Cycles        = 0,
+    Instructions  = 1,
+    LLCReferences = 2,
+    LLCMisses     = 3,
+    BranchMisses  = 4,
+    NumPerfEvents = 5,
+};
+
+/**
+ * @brief the (accumulated) value of the hardware events of a region. An event
+ * that is not supported (or could not be opened) on this machine has a
+ * negative value
+ */
+struct PerfCounterValues
+{
+    static constexpr int num_events =
+        static_cast<int>(PerfEvent::NumPerfEvents);
+
+    /**
+     * @brief the size of a cache line used to estimate the memory bandwidth
+     */
+    static constexpr double cache_line_bytes = 64.0;
+
+    PerfCounterValues()
+    {
+        value.fill(-1);
+    }
+
+    int64_t get(const PerfEvent e) const
+    {
+        return value[static_cast<int>(e)];
+    }
+
+    bool has(const PerfEvent e) const
+    {
+        return get(e) >= 0;
+    }
+
+    /**
+     * @brief true if at least one event was counted
+     */
+    bool is_valid() const
+    {
+        for (int i = 0; i < num_events; ++i) {
+            if (value[i] >= 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @brief instructions per cycle (or -1 if not counted)
+     */
+    double ipc() const
+    {
+        if (!has(PerfEvent::Cycles) || !has(PerfEvent::Instructions) ||
+            get(PerfEvent::Cycles) == 0) {
+            return -1;
+        }
+        return double(get(PerfEvent::Instructions)) /
+               double(get(PerfEvent::Cycles));
+    }
+
+    /**
+     * @brief the ratio of last-level cache references that missed (or -1 if
+     * not counted)
+     */
+    double llc_miss_rate() const
+    {
+        if (!has(PerfEvent::LLCReferences) || !has(PerfEvent::LLCMisses) ||
+            get(PerfEvent::LLCReferences) == 0) {
+            return -1;
+        }
+        return double(get(PerfEvent::LLCMisses)) /
+               double(get(PerfEvent::LLCReferences));
+    }
+
+    /**
+     * @brief estimate the DRAM bandwidth (in GB/s) as one cache line
+     * transferred per last-level cache miss over time_ms. This ignores
+     * write-backs and hardware prefetching and so it is a lower bound of the
+     * actual traffic. Returns -1 if not counted
+     */
+    double bandwidth_gb_per_sec(const double time_ms) const
+    {
+        if (!has(PerfEvent::LLCMisses) || time_ms <= 0) {
+            return -1;
+        }
+        return double(get(PerfEvent::LLCMisses)) * cache_line_bytes /
+               (time_ms * 1.0e6);
+    }
+
+    PerfCounterValues& operator+=(const PerfCounterValues& other)
+    {
+        for (int i = 0; i < num_events; ++i) {
+            if (other.value[i] >= 0) {
+                value[i] = std::max<int64_t>(value[i], 0) + other.value[i];
+            }
+        }
+        return *this;
+    }
+
+    std::array<int64_t, num_events> value;
+};
+
+/**
+ * @brief a group of hardware performance counters (cycles, instructions,
+ * last-level cache references and misses, and branch misses) of the calling
+ * thread based on Linux perf_event_open. The counters count only user-space
+ * events of the thread that created them and so every thread should use its
+ * own PerfCounters (similar to how Timers uses one timer per thread). The
+ * events are not opened with inherit since the threads of an OpenMP team
+ * usually exist before the counters are created, so work done by other
+ * threads is not counted. If
+ * perf_event_open is not available (e.g., not Linux, restricted by
+ * /proc/sys/kernel/perf_event_paranoid, or inside a container without
+ * access), the counters are not valid and all operations are no-ops. Events
+ * that are not supported by the CPU are skipped. If the events are
+ * multiplexed (i.e., more events than hardware counters), the values are
+ * scaled by the fraction of time the events were counted
+ */
+class PerfCounters
+{
+   public:
+    PerfCounters() : m_leader(-1), m_time_enabled(0), m_time_running(0)
+    {
+        m_fd.fill(-1);
+        m_index.fill(-1);
+#ifdef __linux__
+        const std::array<std::pair<uint32_t, uint64_t>, num_events> events = {
+            std::make_pair(uint32_t(PERF_TYPE_HARDWARE),
+                           uint64_t(PERF_COUNT_HW_CPU_CYCLES)),
+            std::make_pair(uint32_t(PERF_TYPE_HARDWARE),
+                           uint64_t(PERF_COUNT_HW_INSTRUCTIONS)),
+            std::make_pair(uint32_t(PERF_TYPE_HARDWARE),
+                           uint64_t(PERF_COUNT_HW_CACHE_REFERENCES)),
+            std::make_pair(uint32_t(PERF_TYPE_HARDWARE),
+                           uint64_t(PERF_COUNT_HW_CACHE_MISSES)),
+            std::make_pair(uint32_t(PERF_TYPE_HARDWARE),
+                           uint64_t(PERF_COUNT_HW_BRANCH_MISSES))};
+
+        int num_opened = 0;
+        for (int i = 0; i < num_events; ++i) {
+            perf_event_attr attr;
+            memset(&attr, 0, sizeof(perf_event_attr));
+            attr.size           = sizeof(perf_event_attr);
+            attr.type           = events[i].first;
+            attr.config         = events[i].second;
+            attr.disabled       = (m_leader == -1) ? 1 : 0;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv     = 1;
+            attr.read_format    = PERF_FORMAT_GROUP |
+                               PERF_FORMAT_TOTAL_TIME_ENABLED |
+                               PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+            const int fd = static_cast<int>(
+                syscall(__NR_perf_event_open, &attr, 0, -1, m_leader, 0));
+            if (fd == -1) {
+                continue;
+            }
+            if (m_leader == -1) {
+                m_leader = fd;
+            }
+            m_fd[i]    = fd;
+            m_index[i] = num_opened++;
+        }
+
+        if (!is_valid()) {
+            static std::atomic_bool warned = false;
+            if (!warned.exchange(true)) {
+                RXMESH_WARN(
+                    "PerfCounters::PerfCounters() perf_event_open is not "
+                    "available (check /proc/sys/kernel/perf_event_paranoid). "
+                    "Hardware performance counters will not be recorded");
+            }
+        }
+#endif
+    }
+
+    PerfCounters(const PerfCounters&)            = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    ~PerfCounters()
+    {
+#ifdef __linux__
+        for (int i = 0; i < num_events; ++i) {
+            if (m_fd[i] != -1) {
+                close(m_fd[i]);
+            }
+        }
+#endif
+    }
+
+    /**
+     * @brief true if at least one event could be opened
+     */
+    bool is_valid() const
+    {
+        return m_leader != -1;
+    }
+
+    /**
+     * @brief reset and start counting
+     */
+    void start()
+    {
+#ifdef __linux__
+        if (is_valid()) {
+            ioctl(m_leader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+            ioctl(m_leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+        }
+#endif
+    }
+
+    /**
+     * @brief stop counting and read the counters
+     */
+    void stop()
+    {
+#ifdef __linux__
+        if (!is_valid()) {
+            return;
+        }
+        ioctl(m_leader, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+
+        // nr, time_enabled, time_running, and then one value per event
+        std::array<uint64_t, 3 + num_events> buffer;
+        const ssize_t size = read(m_leader, buffer.data(), sizeof(buffer));
+        if (size < ssize_t(3 * sizeof(uint64_t))) {
+            m_values = PerfCounterValues();
+            return;
+        }
+
+        // reset does not reset the enabled/running time and so we use the
+        // time of this start()/stop() pair only
+        const uint64_t enabled = buffer[1] - m_time_enabled;
+        const uint64_t running = buffer[2] - m_time_running;
+        m_time_enabled         = buffer[1];
+        m_time_running         = buffer[2];
+        const double scale =
+            (running == 0) ? 0.0 : double(enabled) / double(running);
+
+        for (int i = 0; i < num_events; ++i) {
+            if (m_index[i] == -1 || uint64_t(m_index[i]) >= buffer[0]) {
+                m_values.value[i] = -1;
+            } else {
+                const uint64_t v  = buffer[3 + m_index[i]];
+                m_values.value[i] = static_cast<int64_t>(double(v) * scale);
+            }
+        }
+#endif
+    }
+
+    /**
+     * @brief the counters of the last start()/stop() pair
+     */
+    const PerfCounterValues& values() const
+    {
+        return m_values;
+    }
+
+   private:
+    static constexpr int num_events = PerfCounterValues::num_events;
+
+    int                         m_leader;
+    std::array<int, num_events> m_fd;
+    std::array<int, num_events> m_index;
+    uint64_t                    m_time_enabled;
+    uint64_t                    m_time_running;
+    PerfCounterValues           m_values;
+};
+
+}  // namespace rxmesh
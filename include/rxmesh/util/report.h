@@ -1,6 +1,8 @@
 #pragma once
 
+#ifndef RX_CPU_ONLY
 #include <cuda_runtime_api.h>
+#endif
 #include <rapidjson/document.h>
 #include <rapidjson/ostreamwrapper.h>
 #include <rapidjson/prettywriter.h>
@@ -11,6 +13,9 @@
 #include <map>
 #include <sstream>
 #include "rxmesh/rxmesh.h"
+#include "rxmesh/util/benchmark.h"
+#include "rxmesh/util/perf_counters.h"
+#include "rxmesh/util/timer.h"
 #include "rxmesh/util/util.h"
 #ifdef __NVCC__
 #include "cuda.h"
@@ -43,6 +48,9 @@ struct TestData
     int32_t            dyn_smem    = -1;
     int32_t            static_smem = -1;
     int32_t            num_reg     = -1;
+    // the hardware performance counters of the host over all runs (see
+    // PerfCounters). Only written if recorded
+    PerfCounterValues perf_counters;
 };
 
 struct Report
@@ -117,6 +125,10 @@ struct Report
     // GPU
     void device()
     {
+#ifdef RX_CPU_ONLY
+        // CPU-only build: there is no device to report
+        return;
+#else
 
         rapidjson::Document subdoc(&m_doc.GetAllocator());
         subdoc.SetObject();
@@ -186,6 +198,7 @@ struct Report
                    subdoc);
 
         m_doc.AddMember("GPU Device", subdoc, m_doc.GetAllocator());
+#endif
     }
 
     // System
@@ -355,12 +368,88 @@ struct Report
             add_member("time (ms)", test_data.time_ms, subdoc);
         }
 
+        if (test_data.perf_counters.is_valid()) {
+            double total_time = 0;
+            for (float t : test_data.time_ms) {
+                total_time += t;
+            }
+            add_perf_counters(test_data.perf_counters, total_time, subdoc);
+        }
+
         rapidjson::Value key(test_data.test_name.c_str(),
                              subdoc.GetAllocator());
 
         m_doc.AddMember(key, subdoc, m_doc.GetAllocator());
     }
 
+    // add the accumulated time (and the hardware performance counters if
+    // recorded) of every named timer
+    template <typename TimerT>
+    void add_timers(Timers<TimerT>&   timers,
+                    const std::string json_member_name = "Timers")
+    {
+        rapidjson::Document subdoc(&m_doc.GetAllocator());
+        subdoc.SetObject();
+
+        // sorted by name so the output is the same across runs
+        std::map<std::string, float> total_time;
+        for (const auto& t : timers.m_total_time) {
+            total_time.insert(t);
+        }
+
+        for (const auto& t : total_time) {
+            rapidjson::Document timer_doc(&m_doc.GetAllocator());
+            timer_doc.SetObject();
+
+            add_member("time (ms)", double(t.second), timer_doc);
+
+            const PerfCounterValues counters = timers.perf_counters(t.first);
+            if (counters.is_valid()) {
+                add_perf_counters(counters, t.second, timer_doc);
+            }
+
+            rapidjson::Value key(t.first.c_str(), subdoc.GetAllocator());
+            subdoc.AddMember(key, timer_doc, subdoc.GetAllocator());
+        }
+
+        rapidjson::Value key(json_member_name.c_str(), m_doc.GetAllocator());
+        m_doc.AddMember(key, subdoc, m_doc.GetAllocator());
+    }
+
+    // add the timing samples and statistics of every stage of a benchmark.
+    // This is also the format read by Benchmark::load_baseline
+    void add_benchmark(const Benchmark&  benchmark,
+                       const std::string json_member_name = "Benchmark")
+    {
+        rapidjson::Document subdoc(&m_doc.GetAllocator());
+        subdoc.SetObject();
+
+        for (const std::string& stage : benchmark.stages()) {
+            rapidjson::Document stage_doc(&m_doc.GetAllocator());
+            stage_doc.SetObject();
+
+            const BenchmarkStats& stats = benchmark.stats(stage);
+            add_member("time (ms)", benchmark.samples(stage), stage_doc);
+            add_member("num_warmup", benchmark.get_num_warmup(), stage_doc);
+            add_member("median (ms)", stats.median, stage_doc);
+            add_member("mean (ms)", stats.mean, stage_doc);
+            add_member("stddev (ms)", stats.stddev, stage_doc);
+            add_member("min (ms)", stats.min, stage_doc);
+            add_member("max (ms)", stats.max, stage_doc);
+            add_member("p05 (ms)", stats.p05, stage_doc);
+            add_member("p95 (ms)", stats.p95, stage_doc);
+            add_member("confidence", benchmark.get_confidence(), stage_doc);
+            add_member("median CI lower (ms)", stats.ci_lower, stage_doc);
+            add_member("median CI upper (ms)", stats.ci_upper, stage_doc);
+
+            rapidjson::Value key(stage.c_str(), subdoc.GetAllocator());
+            subdoc.AddMember(key, stage_doc, subdoc.GetAllocator());
+        }
+
+        rapidjson::Value key(json_member_name.c_str(), m_doc.GetAllocator());
+        m_doc.AddMember(key, subdoc, m_doc.GetAllocator());
+    }
+
     // add members to the main object
     template <typename T>
     void add_member(std::string member_key, const T member_val)
@@ -376,6 +465,37 @@ struct Report
    protected:
     std::string m_output_name_suffix;
 
+    // write the counted events along with the derived metrics where time_ms
+    // is the time over which the events were counted
+    template <typename docT>
+    void add_perf_counters(const PerfCounterValues& counters,
+                           const double             time_ms,
+                           docT&                    doc)
+    {
+        auto add_event = [&](const std::string& name, const PerfEvent e) {
+            if (counters.has(e)) {
+                add_member(name, size_t(counters.get(e)), doc);
+            }
+        };
+        add_event("cycles", PerfEvent::Cycles);
+        add_event("instructions", PerfEvent::Instructions);
+        add_event("LLC references", PerfEvent::LLCReferences);
+        add_event("LLC misses", PerfEvent::LLCMisses);
+        add_event("branch misses", PerfEvent::BranchMisses);
+
+        if (counters.ipc() >= 0) {
+            add_member("IPC", counters.ipc(), doc);
+        }
+        if (counters.llc_miss_rate() >= 0) {
+            add_member("LLC miss rate", counters.llc_miss_rate(), doc);
+        }
+        if (counters.bandwidth_gb_per_sec(time_ms) >= 0) {
+            add_member("estimated DRAM bandwidth (GB/s)",
+                       counters.bandwidth_gb_per_sec(time_ms),
+                       doc);
+        }
+    }
+
     template <typename docT>
     void add_member(std::string member_key, const int32_t member_val, docT& doc)
     {
@@ -0,0 +1,325 @@
+#pragma once
+#include <stdint.h>
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <streambuf>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "rxmesh/util/log.h"
+#include "rxmesh/util/mapped_file.h"
+
+namespace rxmesh {
+
+/**
+ * @brief path to a snapshot file written by RXMeshStatic::save_snapshot().
+ * Used to select the constructors that load a snapshot instead of building
+ * the mesh from an input file
+ */
+struct SnapshotFile
+{
+    explicit SnapshotFile(const std::string& file_name) : file_name(file_name)
+    {
+    }
+    std::string file_name;
+};
+
+namespace detail {
+
+/**
+ * @brief the snapshot is a flat binary file that starts with SnapshotHeader
+ * followed by a sequence of scalars and arrays. Every array is stored as its
+ * number of elements, its element size, and then the raw elements aligned to
+ * snapshot_alignment bytes (relative to the start of the file) so that arrays
+ * can be used directly from a memory mapping of the file.
+ * snapshot_version should be bumped whenever the content or the order of what
+ * is written changes
+ */
+static constexpr char     snapshot_magic[8]  = "RXMSNAP";
+static constexpr uint32_t snapshot_version   = 1;
+static constexpr uint32_t snapshot_endian    = 0x01020304;
+static constexpr size_t   snapshot_alignment = 8;
+
+struct SnapshotHeader
+{
+    char     magic[8];
+    uint32_t version;
+    uint32_t endian;
+    uint32_t patch_size;
+    uint32_t reserved;
+};
+
+/**
+ * @brief write a snapshot file
+ */
+class SnapshotWriter
+{
+   public:
+    SnapshotWriter(const std::string& file_name, const uint32_t patch_size)
+        : m_file(file_name, std::ios::binary), m_pos(0)
+    {
+        if (!m_file.is_open()) {
+            RXMESH_ERROR("SnapshotWriter can not open {}", file_name);
+            return;
+        }
+        SnapshotHeader header;
+        std::memset(&header, 0, sizeof(SnapshotHeader));
+        memcpy(header.magic, snapshot_magic, sizeof(snapshot_magic));
+        header.version    = snapshot_version;
+        header.endian     = snapshot_endian;
+        header.patch_size = patch_size;
+        write_bytes(&header, sizeof(SnapshotHeader));
+    }
+
+    bool is_ok() const
+    {
+        return m_file.good();
+    }
+
+    /**
+     * @brief write one or more scalars
+     */
+    template <typename... Ts>
+    void operator()(const Ts&... values)
+    {
+        (write_scalar(values), ...);
+    }
+
+    template <typename T>
+    void write_array(const T* data, const size_t count)
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+        const uint64_t c = count;
+        const uint32_t s = sizeof(T);
+        write_bytes(&c, sizeof(uint64_t));
+        write_bytes(&s, sizeof(uint32_t));
+        pad();
+        write_bytes(data, count * sizeof(T));
+    }
+
+    template <typename T>
+    void write_vector(const std::vector<T>& vec)
+    {
+        write_array(vec.data(), vec.size());
+    }
+
+   private:
+    template <typename T>
+    void write_scalar(const T& value)
+    {
+        static_assert(std::is_arithmetic_v<T>);
+        write_bytes(&value, sizeof(T));
+    }
+
+    void write_bytes(const void* data, const size_t num_bytes)
+    {
+        if (num_bytes > 0) {
+            m_file.write(reinterpret_cast<const char*>(data), num_bytes);
+            m_pos += num_bytes;
+        }
+    }
+
+    void pad()
+    {
+        const char zeros[snapshot_alignment] = {0};
+        const size_t rem = m_pos % snapshot_alignment;
+        if (rem != 0) {
+            write_bytes(zeros, snapshot_alignment - rem);
+        }
+    }
+
+    std::ofstream m_file;
+    size_t        m_pos;
+};
+
+/**
+ * @brief read a snapshot file. The file is memory mapped and arrays are
+ * returned as pointers into the mapping (valid as long as the reader is
+ * alive). Any mismatch (e.g., truncated file or different element size) sets
+ * the reader to a failed state which is checked via is_ok()
+ */
+class SnapshotReader
+{
+   public:
+    explicit SnapshotReader(const std::string& file_name)
+        : m_pos(0), m_ok(false)
+    {
+        if (!m_file.open(file_name)) {
+            return;
+        }
+        SnapshotHeader header;
+        if (m_file.size() < sizeof(SnapshotHeader)) {
+            RXMESH_ERROR("SnapshotReader {} is not a snapshot file",
+                         file_name);
+            return;
+        }
+        memcpy(&header, m_file.data(), sizeof(SnapshotHeader));
+        if (memcmp(header.magic, snapshot_magic, sizeof(snapshot_magic)) !=
+            0) {
+            RXMESH_ERROR("SnapshotReader {} is not a snapshot file",
+                         file_name);
+            return;
+        }
+        if (header.endian != snapshot_endian) {
+            RXMESH_ERROR(
+                "SnapshotReader {} was written on a machine with different "
+                "endianness",
+                file_name);
+            return;
+        }
+        if (header.version != snapshot_version) {
+            RXMESH_ERROR(
+                "SnapshotReader {} has version {} while the supported version "
+                "is {}. Please re-create the snapshot",
+                file_name,
+                header.version,
+                snapshot_version);
+            return;
+        }
+        m_patch_size = header.patch_size;
+        m_pos        = sizeof(SnapshotHeader);
+        m_ok         = true;
+    }
+
+    bool is_ok() const
+    {
+        return m_ok;
+    }
+
+    uint32_t get_patch_size() const
+    {
+        return m_patch_size;
+    }
+
+    /**
+     * @brief read one or more scalars
+     */
+    template <typename... Ts>
+    void operator()(Ts&... values)
+    {
+        (read_scalar(values), ...);
+    }
+
+    /**
+     * @brief return a pointer to the next array in the file and its number of
+     * elements in count. Return nullptr if the reader has failed
+     */
+    template <typename T>
+    const T* read_array(size_t& count)
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+        static_assert(alignof(T) <= snapshot_alignment);
+        uint64_t c = 0;
+        uint32_t s = 0;
+        read_bytes(&c, sizeof(uint64_t));
+        read_bytes(&s, sizeof(uint32_t));
+        if (m_ok && s != sizeof(T)) {
+            RXMESH_ERROR(
+                "SnapshotReader element size mismatch (expected {}, found {})",
+                sizeof(T),
+                s);
+            m_ok = false;
+        }
+        m_pos = (m_pos + snapshot_alignment - 1) / snapshot_alignment *
+                snapshot_alignment;
+        if (!m_ok || c > (m_file.size() - std::min(m_pos, m_file.size())) /
+                             sizeof(T)) {
+            fail();
+            count = 0;
+            return nullptr;
+        }
+        const T* ptr = reinterpret_cast<const T*>(m_file.data() + m_pos);
+        m_pos += c * sizeof(T);
+        count = c;
+        return ptr;
+    }
+
+    /**
+     * @brief read the next array into a vector
+     */
+    template <typename T>
+    void read_vector(std::vector<T>& vec)
+    {
+        size_t   count = 0;
+        const T* ptr   = read_array<T>(count);
+        if (ptr != nullptr) {
+            vec.assign(ptr, ptr + count);
+        } else {
+            vec.clear();
+        }
+    }
+
+    /**
+     * @brief read the next array into a pre-allocated buffer that should have
+     * the given number of elements
+     */
+    template <typename T>
+    void read_into(T* dst, const size_t expected_count)
+    {
+        size_t   count = 0;
+        const T* ptr   = read_array<T>(count);
+        if (ptr != nullptr && count != expected_count) {
+            RXMESH_ERROR(
+                "SnapshotReader array size mismatch (expected {}, found {})",
+                expected_count,
+                count);
+            m_ok = false;
+        }
+        if (m_ok && count > 0) {
+            memcpy(dst, ptr, count * sizeof(T));
+        }
+    }
+
+   private:
+    template <typename T>
+    void read_scalar(T& value)
+    {
+        static_assert(std::is_arithmetic_v<T>);
+        read_bytes(&value, sizeof(T));
+    }
+
+    void read_bytes(void* dst, const size_t num_bytes)
+    {
+        if (!m_ok) {
+            return;
+        }
+        if (m_pos + num_bytes > m_file.size()) {
+            fail();
+            return;
+        }
+        memcpy(dst, m_file.data() + m_pos, num_bytes);
+        m_pos += num_bytes;
+    }
+
+    void fail()
+    {
+        if (m_ok) {
+            RXMESH_ERROR("SnapshotReader unexpected end of file");
+        }
+        m_ok = false;
+    }
+
+    MappedFile m_file;
+    size_t     m_pos;
+    bool       m_ok;
+    uint32_t   m_patch_size = 0;
+};
+
+/**
+ * @brief read-only std::streambuf over a memory buffer so that a std::istream
+ * could read directly from a memory mapped file
+ */
+class MemoryStreamBuf : public std::streambuf
+{
+   public:
+    MemoryStreamBuf(const char* data, const size_t size)
+    {
+        char* p = const_cast<char*>(data);
+        setg(p, p, p + size);
+    }
+};
+
+}  // namespace detail
+}  // namespace rxmesh
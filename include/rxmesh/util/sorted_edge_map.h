@@ -0,0 +1,112 @@
+#pragma once
+#include <assert.h>
+#include <stdint.h>
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace rxmesh {
+
+namespace detail {
+
+/**
+ * @brief read-only map from an edge key (see edge_key()) to the edge id. The
+ * entries are stored in a flat array sorted by the key and lookups are done
+ * using binary search. This is cheaper to build (in parallel) and to store than
+ * a hash map since it is built once from the sorted half-edges. The interface
+ * follows std::map (begin/end/find/at/count/size) so it could be iterated over
+ * in the same way
+ */
+class SortedEdgeMap
+{
+   public:
+    using key_type       = std::pair<uint32_t, uint32_t>;
+    using mapped_type    = uint32_t;
+    using value_type     = std::pair<key_type, mapped_type>;
+    using const_iterator = std::vector<value_type>::const_iterator;
+    using iterator       = const_iterator;
+
+    SortedEdgeMap() = default;
+
+    /**
+     * @brief take over the entries. entries should be sorted by the key and
+     * with no duplicate keys
+     */
+    void assign(std::vector<value_type>&& entries)
+    {
+        m_entries = std::move(entries);
+        assert(std::is_sorted(
+            m_entries.begin(),
+            m_entries.end(),
+            [](const value_type& a, const value_type& b) {
+                return a.first < b.first;
+            }));
+    }
+
+    void clear()
+    {
+        m_entries.clear();
+        m_entries.shrink_to_fit();
+    }
+
+    size_t size() const
+    {
+        return m_entries.size();
+    }
+
+    bool empty() const
+    {
+        return m_entries.empty();
+    }
+
+    const_iterator begin() const
+    {
+        return m_entries.cbegin();
+    }
+
+    const_iterator end() const
+    {
+        return m_entries.cend();
+    }
+
+    /**
+     * @brief return an iterator to the entry with the given key or end() if
+     * the key does not exist
+     */
+    const_iterator find(const key_type& key) const
+    {
+        auto it = std::lower_bound(
+            m_entries.cbegin(),
+            m_entries.cend(),
+            key,
+            [](const value_type& a, const key_type& k) { return a.first < k; });
+        if (it != m_entries.cend() && it->first == key) {
+            return it;
+        }
+        return m_entries.cend();
+    }
+
+    size_t count(const key_type& key) const
+    {
+        return (find(key) == end()) ? 0 : 1;
+    }
+
+    /**
+     * @brief return the edge id of the given key. Throws std::out_of_range if
+     * the key does not exist
+     */
+    const mapped_type& at(const key_type& key) const
+    {
+        auto it = find(key);
+        if (it == end()) {
+            throw std::out_of_range("SortedEdgeMap::at() key does not exist");
+        }
+        return it->second;
+    }
+
+   private:
+    std::vector<value_type> m_entries;
+};
+}  // namespace detail
+}  // namespace rxmesh
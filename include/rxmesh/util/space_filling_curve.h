@@ -0,0 +1,81 @@
+#pragma once
+#include <stdint.h>
+
+namespace rxmesh {
+
+namespace detail {
+
+/**
+ * @brief spread the lower 21 bits of x such that there are two zero bits
+ * between every two consecutive bits
+ */
+inline uint64_t morton_spread_bits(uint64_t x)
+{
+    x &= 0x1FFFFF;
+    x = (x | x << 32) & 0x1F00000000FFFF;
+    x = (x | x << 16) & 0x1F0000FF0000FF;
+    x = (x | x << 8) & 0x100F00F00F00F00F;
+    x = (x | x << 4) & 0x10C30C30C30C30C3;
+    x = (x | x << 2) & 0x1249249249249249;
+    return x;
+}
+
+/**
+ * @brief Morton (Z-order) code of a 3D point with integer coordinates. Every
+ * coordinate should fit in 21 bits
+ */
+inline uint64_t morton_code_3d(const uint32_t x,
+                               const uint32_t y,
+                               const uint32_t z)
+{
+    return (morton_spread_bits(x) << 2) | (morton_spread_bits(y) << 1) |
+           morton_spread_bits(z);
+}
+
+/**
+ * @brief Hilbert code of a 3D point with integer coordinates where every
+ * coordinate uses num_bits bits (at most 21). Taken from J. Skilling,
+ * "Programming the Hilbert curve", AIP Conference Proceedings 2004 i.e.,
+ * transform the coordinates to the transposed Hilbert index and then
+ * interleave its bits
+ */
+inline uint64_t hilbert_code_3d(const uint32_t x,
+                                const uint32_t y,
+                                const uint32_t z,
+                                const int      num_bits)
+{
+    uint32_t X[3] = {x, y, z};
+
+    const uint32_t M = uint32_t(1) << (num_bits - 1);
+
+    // inverse undo
+    for (uint32_t Q = M; Q > 1; Q >>= 1) {
+        const uint32_t P = Q - 1;
+        for (int i = 0; i < 3; ++i) {
+            if (X[i] & Q) {
+                X[0] ^= P;
+            } else {
+                const uint32_t t = (X[0] ^ X[i]) & P;
+                X[0] ^= t;
+                X[i] ^= t;
+            }
+        }
+    }
+
+    // gray encode
+    X[1] ^= X[0];
+    X[2] ^= X[1];
+    uint32_t t = 0;
+    for (uint32_t Q = M; Q > 1; Q >>= 1) {
+        if (X[2] & Q) {
+            t ^= Q - 1;
+        }
+    }
+    for (int i = 0; i < 3; ++i) {
+        X[i] ^= t;
+    }
+
+    return morton_code_3d(X[0], X[1], X[2]);
+}
+}  // namespace detail
+}  // namespace rxmesh
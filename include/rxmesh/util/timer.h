@@ -1,12 +1,107 @@
 #pragma once
 
+#include <omp.h>
+#include <algorithm>
 #include <chrono>
 #include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#ifdef __linux__
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
 #include "rxmesh/util/macros.h"
+#include "rxmesh/util/perf_counters.h"
+#include "rxmesh/util/trace.h"
 
 
 namespace rxmesh {
 
+namespace detail {
+/**
+ * @brief an id of the calling OS thread. Unlike omp_get_thread_num(), it is
+ * unique across std::threads and nested OpenMP teams. On Linux, this is the
+ * kernel thread id which (unlike std::thread::id) is not reused as soon as a
+ * thread exits. It is cached per thread since Timers asks for it on every
+ * start()
+ */
+inline uint64_t os_thread_id()
+{
+#ifdef __linux__
+    static thread_local const uint64_t tid =
+        static_cast<uint64_t>(syscall(SYS_gettid));
+#else
+    static thread_local const uint64_t tid = static_cast<uint64_t>(
+        std::hash<std::thread::id>()(std::this_thread::get_id()));
+#endif
+    return tid;
+}
+
+/**
+ * @brief an object that keeps state for every host thread that uses it. The
+ * state of a thread is released by release_thread() when the thread exits
+ * (see ThreadExitHooks)
+ */
+struct PerThreadOwner
+{
+    virtual ~PerThreadOwner() = default;
+
+    virtual void release_thread(uint64_t tid) = 0;
+};
+
+/**
+ * @brief notifies the owners registered by the calling thread when the thread
+ * exits so that the state kept for short-lived threads (e.g., std::threads)
+ * does not accumulate. Owners that are destroyed before the thread exits are
+ * skipped
+ */
+class ThreadExitHooks
+{
+   public:
+    static ThreadExitHooks& get()
+    {
+        static thread_local ThreadExitHooks hooks;
+        return hooks;
+    }
+
+    void add(std::weak_ptr<PerThreadOwner> owner)
+    {
+        m_owners.erase(
+            std::remove_if(m_owners.begin(),
+                           m_owners.end(),
+                           [](const std::weak_ptr<PerThreadOwner>& o) {
+                               return o.expired();
+                           }),
+            m_owners.end());
+        m_owners.push_back(std::move(owner));
+    }
+
+    ~ThreadExitHooks()
+    {
+        for (const std::weak_ptr<PerThreadOwner>& o : m_owners) {
+            if (std::shared_ptr<PerThreadOwner> owner = o.lock()) {
+                owner->release_thread(m_tid);
+            }
+        }
+    }
+
+   private:
+    ThreadExitHooks() : m_tid(os_thread_id())
+    {
+    }
+
+    const uint64_t                             m_tid;
+    std::vector<std::weak_ptr<PerThreadOwner>> m_owners;
+};
+}  // namespace detail
+
 struct GPUTimer
 {
     GPUTimer(cudaStream_t stream = NULL) : m_stream(stream)
@@ -68,40 +163,267 @@ struct CPUTimer
     std::chrono::high_resolution_clock::time_point m_stop;
 };
 
+/**
+ * @brief a collection of named timers that accumulate the elapsed time of
+ * every start()/stop() pair. Timers could be started and stopped from
+ * multiple host threads (e.g., inside OpenMP parallel regions or from
+ * std::threads) where every OS thread uses its own timer and the time of all
+ * threads is added to the same total (i.e., for parallel regions, the total
+ * is the sum of the time spent by all threads). A timer could also record the
+ * hardware performance counters (see PerfCounters) between start() and stop()
+ * which are accumulated the same way. The counters of a thread only count
+ * that thread and so the work of a parallel region is counted only if the
+ * timer is started and stopped by every thread of the region.
+ * While the global Tracer is enabled, every start()/stop() pair is also
+ * recorded as one region (with the timer's elapsed time as its duration) on
+ * the timeline of the calling thread. The timers (and counters) of a thread are
+ * released when the thread exits
+ */
 template <typename TimerT>
 struct Timers
 {
-    Timers()  = default;
+    Timers() : m_registry(std::make_shared<Registry>())
+    {
+    }
     ~Timers() = default;
 
-    void add(std::string name)
+    /**
+     * @brief add a named timer
+     * @param name the timer name
+     * @param with_perf_counters also record the hardware performance counters
+     * of the host thread(s) that start/stop the timer (only the work done by
+     * these threads is counted)
+     */
+    void add(std::string name, bool with_perf_counters = false)
     {
-        m_timers.insert(std::make_pair(name, std::make_shared<TimerT>()));
+        std::lock_guard<std::mutex> lock(m_registry->mutex);
+        Timer& timer = m_registry->timers[name];
+        if (with_perf_counters) {
+            timer.with_perf_counters = true;
+        }
         m_total_time.insert(std::make_pair(name, 0));
+        if (with_perf_counters) {
+            m_total_perf_counters.insert(
+                std::make_pair(name, PerfCounterValues()));
+        }
     }
 
-    void start(std::string name)
+    void start(const std::string& name)
     {
-        m_timers.at(name)->start();
+        ThreadState* state = m_registry->acquire(name);
+        if (state == nullptr) {
+            RXMESH_ERROR("Timers::start() unknown timer {}", name);
+            return;
+        }
+        open_regions().push_back({m_registry.get(), state});
+
+        Tracer& tracer = Tracer::get();
+        if (tracer.is_enabled()) {
+            if (state->trace.name == nullptr) {
+                state->trace.name = tracer.intern(name);
+            }
+            state->trace.depth    = tracer.begin();
+            state->trace.begin_ns = tracer.now();
+        }
+
+        if (state->counters) {
+            state->counters->start();
+        }
+        state->timer.start();
     }
 
-    void stop(std::string name)
+    void stop(const std::string& name)
     {
-        m_timers.at(name)->stop();
+        ThreadState* state = close_region(name);
+        if (state == nullptr) {
+            RXMESH_ERROR(
+                "Timers::stop() timer {} was not started by this thread", name);
+            return;
+        }
 
-        float new_time =
-            m_total_time.at(name) + m_timers.at(name)->elapsed_millis();
+        state->timer.stop();
+        if (state->counters) {
+            state->counters->stop();
+        }
 
-        m_total_time.insert_or_assign(name, new_time);
+        const float elapsed = state->timer.elapsed_millis();
 
+        // the region is recorded only if it started while tracing
+        if (state->trace.begin_ns >= 0) {
+            Tracer::get().end(
+                state->trace.name,
+                state->trace.begin_ns,
+                state->trace.begin_ns + static_cast<int64_t>(elapsed * 1.0e6),
+                state->trace.depth);
+            state->trace.begin_ns = -1;
+        }
+
+        std::lock_guard<std::mutex> lock(m_registry->mutex);
+        m_total_time.at(name) += elapsed;
+        if (state->counters) {
+            m_total_perf_counters.at(name) += state->counters->values();
+        }
     }
 
-    float elapsed_millis(std::string name)
+    float elapsed_millis(const std::string& name)
     {
+        std::lock_guard<std::mutex> lock(m_registry->mutex);
         return m_total_time.at(name);
     }
 
-    std::unordered_map<std::string, std::shared_ptr<TimerT>> m_timers;
-    std::unordered_map<std::string, float>                   m_total_time;
+    /**
+     * @brief check if the timer records hardware performance counters
+     */
+    bool has_perf_counters(const std::string& name)
+    {
+        std::lock_guard<std::mutex> lock(m_registry->mutex);
+        return m_total_perf_counters.find(name) != m_total_perf_counters.end();
+    }
+
+    /**
+     * @brief the accumulated hardware performance counters of the timer. All
+     * values are negative if the timer does not record counters or if they
+     * are not available on this machine
+     */
+    PerfCounterValues perf_counters(const std::string& name)
+    {
+        std::lock_guard<std::mutex> lock(m_registry->mutex);
+        auto it = m_total_perf_counters.find(name);
+        if (it == m_total_perf_counters.end()) {
+            return PerfCounterValues();
+        }
+        return it->second;
+    }
+
+    /**
+     * @brief the number of live threads that have used the timer. The state
+     * of a thread is released when the thread exits
+     */
+    size_t num_threads(const std::string& name)
+    {
+        std::lock_guard<std::mutex> lock(m_registry->mutex);
+        return m_registry->timers.at(name).threads.size();
+    }
+
+    std::unordered_map<std::string, float>             m_total_time;
+    std::unordered_map<std::string, PerfCounterValues> m_total_perf_counters;
+
+   private:
+    /**
+     * @brief the start of the traced region of one thread
+     */
+    struct TraceBegin
+    {
+        const char* name     = nullptr;
+        int64_t     begin_ns = -1;
+        uint32_t    depth    = 0;
+    };
+
+    /**
+     * @brief the state of one timer in one thread. Since the counters of a
+     * thread count only the thread that opened them, they are created by the
+     * calling thread on its first start()
+     */
+    struct ThreadState
+    {
+        const std::string*            name = nullptr;
+        TimerT                        timer;
+        std::unique_ptr<PerfCounters> counters;
+        TraceBegin                    trace;
+    };
+
+    struct Timer
+    {
+        bool with_perf_counters = false;
+
+        std::unordered_map<uint64_t, std::unique_ptr<ThreadState>> threads;
+    };
+
+    /**
+     * @brief the per-thread state of all timers keyed by the OS thread id (see
+     * detail::os_thread_id). It is shared with the threads' exit hooks so
+     * that it can outlive the Timers
+     */
+    struct Registry : public detail::PerThreadOwner,
+                      public std::enable_shared_from_this<Registry>
+    {
+        /**
+         * @brief return the state of the calling thread (or nullptr if there
+         * is no such timer)
+         */
+        ThreadState* acquire(const std::string& name)
+        {
+            const uint64_t tid = detail::os_thread_id();
+
+            std::lock_guard<std::mutex> lock(mutex);
+
+            auto it = timers.find(name);
+            if (it == timers.end()) {
+                return nullptr;
+            }
+
+            std::unique_ptr<ThreadState>& state = it->second.threads[tid];
+            if (state == nullptr) {
+                state       = std::make_unique<ThreadState>();
+                state->name = &it->first;
+                if (it->second.with_perf_counters) {
+                    state->counters = std::make_unique<PerfCounters>();
+                }
+                if (threads.insert(tid).second) {
+                    detail::ThreadExitHooks::get().add(this->weak_from_this());
+                }
+            }
+            return state.get();
+        }
+
+        void release_thread(uint64_t tid) override
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (threads.erase(tid) == 0) {
+                return;
+            }
+            for (auto& t : timers) {
+                t.second.threads.erase(tid);
+            }
+        }
+
+        std::unordered_map<std::string, Timer> timers;
+        std::unordered_set<uint64_t>           threads;
+        std::mutex                             mutex;
+    };
+
+    /**
+     * @brief a started timer of the calling thread
+     */
+    struct OpenRegion
+    {
+        const Registry* registry;
+        ThreadState*    state;
+    };
+
+    /**
+     * @brief the timers started (and not yet stopped) by the calling thread.
+     * stop() finds the state of the thread here without taking the lock
+     */
+    static std::vector<OpenRegion>& open_regions()
+    {
+        static thread_local std::vector<OpenRegion> regions;
+        return regions;
+    }
+
+    ThreadState* close_region(const std::string& name)
+    {
+        std::vector<OpenRegion>& regions = open_regions();
+        for (auto it = regions.rbegin(); it != regions.rend(); ++it) {
+            if (it->registry == m_registry.get() && *it->state->name == name) {
+                ThreadState* state = it->state;
+                regions.erase(std::next(it).base());
+                return state;
+            }
+        }
+        return nullptr;
+    }
+
+    std::shared_ptr<Registry> m_registry;
 };
 }  // namespace rxmesh
\ No newline at end of file
@@ -0,0 +1,332 @@
+#pragma once
+#include <stdint.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "rxmesh/util/log.h"
+
+namespace rxmesh {
+
+/**
+ * @brief one (complete) region recorded by the Tracer. Times are in
+ * nanoseconds since the Tracer was created
+ */
+struct TraceEvent
+{
+    const char* name;
+    int64_t     begin_ns;
+    int64_t     end_ns;
+    uint32_t    depth;
+};
+
+/**
+ * @brief a global, low-overhead timeline tracer that records named regions
+ * (with their thread and nesting depth) and writes them as a Chrome trace
+ * JSON that can be opened in chrome://tracing or https://ui.perfetto.dev.
+ * Regions are recorded with TraceScope (or RXMESH_TRACE_SCOPE) and every
+ * region of Timers is recorded as well. Every thread writes to its own ring
+ * buffer (without locking) that keeps the most recent events_per_thread
+ * events. The tracer is disabled by default in which case a region costs one
+ * relaxed atomic load. Region names are not copied and so they should be
+ * string literals (or interned with intern()). write() and clear() should be
+ * called while no region is being recorded
+ */
+class Tracer
+{
+   public:
+    /**
+     * @brief the global tracer
+     */
+    static Tracer& get()
+    {
+        static Tracer tracer;
+        return tracer;
+    }
+
+    Tracer(const Tracer&)            = delete;
+    Tracer& operator=(const Tracer&) = delete;
+
+    /**
+     * @brief start recording and drop previously recorded events
+     * @param events_per_thread the capacity of the ring buffer of every thread
+     */
+    void enable(const uint32_t events_per_thread = 1 << 16)
+    {
+        m_capacity = std::max(1u, events_per_thread);
+        clear();
+        m_enabled.store(true, std::memory_order_release);
+    }
+
+    /**
+     * @brief stop recording. Recorded events are kept until clear() or
+     * enable()
+     */
+    void disable()
+    {
+        m_enabled.store(false, std::memory_order_release);
+    }
+
+    bool is_enabled() const
+    {
+        return m_enabled.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief the current time (in nanoseconds) since the tracer was created
+     */
+    int64_t now() const
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   std::chrono::steady_clock::now() - m_epoch)
+            .count();
+    }
+
+    /**
+     * @brief mark the beginning of a region on the calling thread
+     * @return the nesting depth of the region that should be passed to end()
+     */
+    uint32_t begin()
+    {
+        ThreadBuffer& buffer = thread_buffer();
+        return buffer.depth++;
+    }
+
+    /**
+     * @brief record a region on the calling thread that started with begin()
+     * @param name the region name (should outlive the tracer)
+     * @param begin_ns the start time of the region (see now())
+     * @param end_ns the end time of the region (see now())
+     * @param depth the depth returned by begin()
+     */
+    void end(const char*    name,
+             const int64_t  begin_ns,
+             const int64_t  end_ns,
+             const uint32_t depth)
+    {
+        ThreadBuffer& buffer = thread_buffer();
+        buffer.depth         = depth;
+
+        if (buffer.events.size() != m_capacity) {
+            buffer.events.resize(m_capacity);
+            buffer.count = 0;
+        }
+        buffer.events[buffer.count % m_capacity] = {
+            name, begin_ns, end_ns, depth};
+        buffer.count++;
+    }
+
+    /**
+     * @brief return a pointer to a copy of name that lives as long as the
+     * tracer. Used for region names that are not string literals
+     */
+    const char* intern(const std::string& name)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_names.insert(name).first->c_str();
+    }
+
+    /**
+     * @brief drop all recorded events
+     */
+    void clear()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (auto& buffer : m_buffers) {
+            buffer->count = 0;
+        }
+    }
+
+    /**
+     * @brief the number of recorded events (that are still in the buffers)
+     */
+    size_t num_events()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        size_t num = 0;
+        for (auto& buffer : m_buffers) {
+            num += std::min<uint64_t>(buffer->count, buffer->events.size());
+        }
+        return num;
+    }
+
+    /**
+     * @brief the recorded events of every thread (indexed by the tracer's
+     * thread id) sorted by their start time
+     */
+    std::vector<std::vector<TraceEvent>> events()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        std::vector<std::vector<TraceEvent>> ret(m_buffers.size());
+        for (size_t t = 0; t < m_buffers.size(); ++t) {
+            const ThreadBuffer& buffer = *m_buffers[t];
+            const uint64_t      num =
+                std::min<uint64_t>(buffer.count, buffer.events.size());
+            for (uint64_t i = buffer.count - num; i < buffer.count; ++i) {
+                ret[t].push_back(buffer.events[i % buffer.events.size()]);
+            }
+            // an enclosing region ends (and is recorded) after its children
+            std::stable_sort(ret[t].begin(),
+                             ret[t].end(),
+                             [](const TraceEvent& a, const TraceEvent& b) {
+                                 return a.begin_ns < b.begin_ns ||
+                                        (a.begin_ns == b.begin_ns &&
+                                         a.depth < b.depth);
+                             });
+        }
+        return ret;
+    }
+
+    /**
+     * @brief write the recorded events as a Chrome trace JSON (in the JSON
+     * object format with complete "X" events) where every thread is one track
+     * @param file_name the output file (its folder is created if it does not
+     * exist)
+     * @return true if the file was written
+     */
+    bool write(const std::string& file_name)
+    {
+        const std::filesystem::path folder =
+            std::filesystem::path(file_name).parent_path();
+        if (!folder.empty() && !std::filesystem::exists(folder)) {
+            std::filesystem::create_directories(folder);
+        }
+
+        std::ofstream file(file_name);
+        if (!file.is_open()) {
+            RXMESH_ERROR("Tracer::write() can not open {}", file_name);
+            return false;
+        }
+
+        const std::vector<std::vector<TraceEvent>> all_events = events();
+
+        // timestamps are in microseconds with nanosecond precision
+        file << std::fixed << std::setprecision(3);
+        file << "{\"displayTimeUnit\": \"ms\",\n\"traceEvents\": [\n";
+        bool first = true;
+        for (size_t t = 0; t < all_events.size(); ++t) {
+            file << (first ? "" : ",\n")
+                 << "{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 0, "
+                 << "\"tid\": " << t << ", \"args\": {\"name\": \"thread "
+                 << t << "\"}}";
+            first = false;
+
+            for (const TraceEvent& e : all_events[t]) {
+                file << ",\n{\"name\": \"" << escape(e.name)
+                     << "\", \"ph\": \"X\", \"pid\": 0, \"tid\": " << t
+                     << ", \"ts\": " << double(e.begin_ns) / 1000.0
+                     << ", \"dur\": " << double(e.end_ns - e.begin_ns) / 1000.0
+                     << ", \"args\": {\"depth\": " << e.depth << "}}";
+            }
+        }
+        file << "\n]}\n";
+        return file.good();
+    }
+
+   private:
+    Tracer()
+        : m_enabled(false),
+          m_capacity(1 << 16),
+          m_epoch(std::chrono::steady_clock::now())
+    {
+    }
+
+    struct ThreadBuffer
+    {
+        std::vector<TraceEvent> events;
+        uint64_t                count = 0;
+        uint32_t                depth = 0;
+    };
+
+    /**
+     * @brief the buffer of the calling thread which is registered on the
+     * first use. Buffers are never released so they outlive their threads
+     * (and so their events could still be written)
+     */
+    ThreadBuffer& thread_buffer()
+    {
+        thread_local ThreadBuffer* buffer = nullptr;
+        if (buffer == nullptr) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_buffers.push_back(std::make_unique<ThreadBuffer>());
+            buffer = m_buffers.back().get();
+        }
+        return *buffer;
+    }
+
+    static std::string escape(const char* name)
+    {
+        std::string ret;
+        for (const char* c = name; *c != '\0'; ++c) {
+            if (*c == '"' || *c == '\\') {
+                ret.push_back('\\');
+            }
+            if (static_cast<unsigned char>(*c) >= 0x20) {
+                ret.push_back(*c);
+            }
+        }
+        return ret;
+    }
+
+    std::atomic_bool                           m_enabled;
+    uint32_t                                   m_capacity;
+    std::chrono::steady_clock::time_point      m_epoch;
+    std::mutex                                 m_mutex;
+    std::vector<std::unique_ptr<ThreadBuffer>> m_buffers;
+    std::unordered_set<std::string>            m_names;
+};
+
+/**
+ * @brief record the enclosing scope as one region in the global Tracer
+ */
+class TraceScope
+{
+   public:
+    explicit TraceScope(const char* name) : m_name(nullptr)
+    {
+        Tracer& tracer = Tracer::get();
+        if (tracer.is_enabled()) {
+            m_name     = name;
+            m_depth    = tracer.begin();
+            m_begin_ns = tracer.now();
+        }
+    }
+
+    TraceScope(const TraceScope&)            = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+
+    ~TraceScope()
+    {
+        if (m_name != nullptr) {
+            Tracer& tracer = Tracer::get();
+            tracer.end(m_name, m_begin_ns, tracer.now(), m_depth);
+        }
+    }
+
+   private:
+    const char* m_name;
+    int64_t     m_begin_ns;
+    uint32_t    m_depth;
+};
+
+}  // namespace rxmesh
+
+#define RXMESH_TRACE_SCOPE_CONCAT_(a, b) a##b
+#define RXMESH_TRACE_SCOPE_CONCAT(a, b) RXMESH_TRACE_SCOPE_CONCAT_(a, b)
+
+/**
+ * @brief record the enclosing scope (with name as a string literal) in the
+ * global Tracer
+ */
+#define RXMESH_TRACE_SCOPE(name)                                        \
+    ::rxmesh::TraceScope RXMESH_TRACE_SCOPE_CONCAT(rxmesh_trace_scope_, \
+                                                   __LINE__)(name)
@@ -0,0 +1,234 @@
+#pragma once
+#include <stdint.h>
+#include <algorithm>
+#include <mutex>
+
+#ifndef RX_CPU_ONLY
+#include <cuda_runtime_api.h>
+#endif
+
+#include "rxmesh/util/cuda_query.h"
+#include "rxmesh/util/host_parallel.h"
+#include "rxmesh/util/log.h"
+#include "rxmesh/util/macros.h"
+
+namespace rxmesh {
+
+/**
+ * @brief copy large buffers between pageable host memory and the device by
+ * staging them through a reusable pinned buffer. The pinned buffer is split
+ * into two halves such that copying the next chunk into (or out of) the
+ * pinned memory on the host overlaps with the DMA of the current chunk. All
+ * DMAs are enqueued on the given stream and so they are ordered with respect
+ * to the work on that stream and overlap with work on other streams.
+ * If there is no CUDA device (or use_device is false), the "device" pointers
+ * are treated as host pointers and the copies are done using a parallel host
+ * memcpy so the same code path could run on CPU-only machines.
+ * TransferEngine::get_default() returns the engine used by Attribute
+ */
+class TransferEngine
+{
+   public:
+    /**
+     * @param chunk_bytes size of every half of the pinned staging buffer
+     * @param use_device if false, all copies are host copies
+     */
+    explicit TransferEngine(const size_t chunk_bytes = size_t(8) << 20,
+                            const bool   use_device  = has_cuda_device())
+        : m_chunk_bytes(std::max(chunk_bytes, size_t(1))),
+          m_use_device(use_device),
+          m_num_transfers(0),
+          m_transferred_bytes(0)
+    {
+        m_pinned[0] = nullptr;
+        m_pinned[1] = nullptr;
+        m_event[0]  = nullptr;
+        m_event[1]  = nullptr;
+    }
+
+    TransferEngine(const TransferEngine&)            = delete;
+    TransferEngine& operator=(const TransferEngine&) = delete;
+
+    ~TransferEngine()
+    {
+        // the default engine is destroyed at exit where the CUDA context
+        // might be already gone and so errors here are ignored
+        if (m_pinned[0] != nullptr) {
+            cudaFreeHost(m_pinned[0]);
+        }
+        for (int i = 0; i < 2; ++i) {
+            if (m_event[i] != nullptr) {
+                cudaEventDestroy(m_event[i]);
+            }
+        }
+    }
+
+    /**
+     * @brief the engine shared by all attributes
+     */
+    static TransferEngine& get_default()
+    {
+        static TransferEngine engine;
+        return engine;
+    }
+
+    /**
+     * @brief true if copies go to a CUDA device and false if the engine
+     * degrades to host copies
+     */
+    bool is_device() const
+    {
+        return m_use_device;
+    }
+
+    /**
+     * @brief copy num_bytes from (pageable) host memory to device memory.
+     * The call returns once the whole source has been staged, i.e., the
+     * source can be modified right after while the last DMAs are still in
+     * flight on stream
+     */
+    void to_device(void*        d_dst,
+                   const void*  h_src,
+                   const size_t num_bytes,
+                   cudaStream_t stream = NULL)
+    {
+        if (num_bytes == 0) {
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_num_transfers++;
+        m_transferred_bytes += num_bytes;
+
+        if (!m_use_device) {
+            detail::host_parallel_memcpy(d_dst, h_src, num_bytes);
+            return;
+        }
+
+        init_staging();
+
+        for (size_t offset = 0, k = 0; offset < num_bytes;
+             offset += m_chunk_bytes, ++k) {
+            const int    i     = k & 1;
+            const size_t bytes = std::min(m_chunk_bytes, num_bytes - offset);
+
+            // wait for the previous DMA that used this half
+            CUDA_ERROR(cudaEventSynchronize(m_event[i]));
+
+            detail::host_parallel_memcpy(
+                m_pinned[i], static_cast<const char*>(h_src) + offset, bytes);
+
+            CUDA_ERROR(cudaMemcpyAsync(static_cast<char*>(d_dst) + offset,
+                                       m_pinned[i],
+                                       bytes,
+                                       cudaMemcpyHostToDevice,
+                                       stream));
+            CUDA_ERROR(cudaEventRecord(m_event[i], stream));
+        }
+    }
+
+    /**
+     * @brief copy num_bytes from device memory to (pageable) host memory. The
+     * call returns once the destination holds the data, i.e., all the work
+     * enqueued on stream before this call is done
+     */
+    void to_host(void*        h_dst,
+                 const void*  d_src,
+                 const size_t num_bytes,
+                 cudaStream_t stream = NULL)
+    {
+        if (num_bytes == 0) {
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_num_transfers++;
+        m_transferred_bytes += num_bytes;
+
+        if (!m_use_device) {
+            detail::host_parallel_memcpy(h_dst, d_src, num_bytes);
+            return;
+        }
+
+        init_staging();
+
+        const size_t num_chunks = DIVIDE_UP(num_bytes, m_chunk_bytes);
+
+        auto chunk_bytes = [&](const size_t k) {
+            return std::min(m_chunk_bytes, num_bytes - k * m_chunk_bytes);
+        };
+
+        // enqueue the DMA of chunk k into the pinned buffer
+        auto issue = [&](const size_t k) {
+            const int i = k & 1;
+            CUDA_ERROR(cudaEventSynchronize(m_event[i]));
+            CUDA_ERROR(cudaMemcpyAsync(
+                m_pinned[i],
+                static_cast<const char*>(d_src) + k * m_chunk_bytes,
+                chunk_bytes(k),
+                cudaMemcpyDeviceToHost,
+                stream));
+            CUDA_ERROR(cudaEventRecord(m_event[i], stream));
+        };
+
+        // wait for chunk k and copy it out of the pinned buffer
+        auto drain = [&](const size_t k) {
+            const int i = k & 1;
+            CUDA_ERROR(cudaEventSynchronize(m_event[i]));
+            detail::host_parallel_memcpy(
+                static_cast<char*>(h_dst) + k * m_chunk_bytes,
+                m_pinned[i],
+                chunk_bytes(k));
+        };
+
+        issue(0);
+        for (size_t k = 1; k < num_chunks; ++k) {
+            issue(k);
+            drain(k - 1);
+        }
+        drain(num_chunks - 1);
+    }
+
+    /**
+     * @brief number of calls to to_device() and to_host() so far
+     */
+    size_t get_num_transfers() const
+    {
+        return m_num_transfers;
+    }
+
+    /**
+     * @brief total number of bytes copied by to_device() and to_host() so far
+     */
+    size_t get_transferred_bytes() const
+    {
+        return m_transferred_bytes;
+    }
+
+   private:
+    /**
+     * @brief allocate the pinned buffer and the events on first use so that
+     * an unused engine does not hold pinned memory
+     */
+    void init_staging()
+    {
+        if (m_pinned[0] != nullptr) {
+            return;
+        }
+        CUDA_ERROR(cudaMallocHost((void**)&m_pinned[0], 2 * m_chunk_bytes));
+        m_pinned[1] = m_pinned[0] + m_chunk_bytes;
+        for (int i = 0; i < 2; ++i) {
+            CUDA_ERROR(
+                cudaEventCreateWithFlags(&m_event[i], cudaEventDisableTiming));
+        }
+    }
+
+    std::mutex  m_mutex;
+    char*       m_pinned[2];
+    cudaEvent_t m_event[2];
+    size_t      m_chunk_bytes;
+    bool        m_use_device;
+    size_t      m_num_transfers;
+    size_t      m_transferred_bytes;
+};
+}  // namespace rxmesh
@@ -1,5 +1,7 @@
 #pragma once
+#ifndef RX_CPU_ONLY
 #include <cuda_runtime.h>
+#endif
 #include <algorithm>
 #include <numeric>
 #include <random>
@@ -437,6 +439,7 @@ __device__ __host__ __inline__ void align(const std::size_t byte_alignment,
     ptr                    = reinterpret_cast<T*>(aligned);
 }
 
+#ifndef RX_CPU_ONLY
 /**
  * @brief get cuSparse/cuSolver data type for T
  */
@@ -476,4 +479,5 @@ __host__ __inline__ cudaDataType_t cuda_type()
         return CUDA_R_32F;    
     }
 }
+#endif
 }  // namespace rxmesh
\ No newline at end of file
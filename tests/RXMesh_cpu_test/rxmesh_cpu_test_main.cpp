@@ -0,0 +1,12 @@
+#include "gtest/gtest.h"
+#include "rxmesh/util/log.h"
+
+int main(int argc, char** argv)
+{
+    using namespace rxmesh;
+    Log::init();
+
+    ::testing::InitGoogleTest(&argc, argv);
+
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,264 @@
+#include <atomic>
+
+#include "gtest/gtest.h"
+
+#include "rxmesh/reduce_handle.h"
+#include "rxmesh/rxmesh_static.h"
+#include "rxmesh/util/import_obj.h"
+
+#include "rxmesh_test.h"
+
+TEST(RXMeshCPU, ForEach)
+{
+    using namespace rxmesh;
+
+    RXMeshStatic rx(STRINGIFY(INPUT_DIR) "cube.obj");
+
+    std::atomic_uint32_t num_v = 0;
+    std::atomic_uint32_t num_e = 0;
+    std::atomic_uint32_t num_f = 0;
+
+    // DEVICE runs on the host in a CPU-only build
+    rx.for_each_vertex(DEVICE, [&](const VertexHandle vh) { num_v++; });
+
+    rx.for_each_edge(LOCATION_ALL, [&](const EdgeHandle eh) { num_e++; });
+
+    rx.for_each_face(HOST, [&](const FaceHandle fh) { num_f++; });
+
+    EXPECT_EQ(num_v, rx.get_num_vertices());
+
+    EXPECT_EQ(num_e, rx.get_num_edges());
+
+    EXPECT_EQ(num_f, rx.get_num_faces());
+}
+
+TEST(RXMeshCPU, Attribute)
+{
+    using namespace rxmesh;
+
+    RXMeshStatic rx(STRINGIFY(INPUT_DIR) "sphere3.obj");
+
+    auto attr = rx.add_vertex_attribute<float>("attr", 3, LOCATION_ALL);
+
+    attr->reset(1.f, DEVICE);
+
+    // host and device share the same memory
+    rx.for_each_vertex(HOST, [&](const VertexHandle vh) {
+        for (uint32_t i = 0; i < 3; ++i) {
+            EXPECT_EQ((*attr)(vh, i), 1.f);
+        }
+        (*attr)(vh, 0) = 2.f;
+    });
+
+    attr->move(HOST, DEVICE);
+    attr->move(DEVICE, HOST);
+
+    rx.for_each_vertex(HOST, [&](const VertexHandle vh) {
+        EXPECT_EQ((*attr)(vh, 0), 2.f);
+    });
+
+    attr->release(DEVICE);
+    EXPECT_TRUE(attr->is_host_allocated());
+
+    rx.remove_attribute("attr");
+}
+
+TEST(RXMeshCPU, DenseMatrix)
+{
+    using namespace rxmesh;
+
+    RXMeshStatic rx(STRINGIFY(INPUT_DIR) "sphere3.obj");
+
+    auto attr = rx.add_vertex_attribute<float>("attr", 3, LOCATION_ALL);
+
+    rx.for_each_vertex(HOST, [&](const VertexHandle vh) {
+        for (uint32_t i = 0; i < 3; ++i) {
+            (*attr)(vh, i) = float(rx.map_to_global(vh) + i);
+        }
+    });
+
+    auto mat = attr->to_matrix();
+
+    EXPECT_EQ(mat->rows(), rx.get_num_vertices());
+    EXPECT_EQ(mat->cols(), 3);
+
+    // host and device share the same buffer
+    EXPECT_EQ(mat->data(HOST), mat->data(DEVICE));
+
+    rx.for_each_vertex(HOST, [&](const VertexHandle vh) {
+        for (uint32_t i = 0; i < 3; ++i) {
+            EXPECT_EQ((*mat)(vh, i), (*attr)(vh, i));
+        }
+    });
+
+    DenseMatrix<float> ones(rx, rx.get_num_vertices(), 3);
+    ones.reset(1.f, DEVICE);
+
+    const float sum = mat->to_eigen().sum();
+    EXPECT_FLOAT_EQ(mat->dot(ones), sum);
+    EXPECT_FLOAT_EQ(mat->abs_sum(), sum);
+    EXPECT_FLOAT_EQ(ones.norm2(), std::sqrt(3.f * rx.get_num_vertices()));
+    EXPECT_FLOAT_EQ(mat->abs_min(), 0.f);
+    EXPECT_FLOAT_EQ(mat->abs_max(), float(rx.get_num_vertices() + 1));
+
+    // mat = 2 * (mat + 1)
+    mat->axpy(ones, 1.f);
+    mat->multiply(2.f);
+
+    attr->reset(0.f, HOST);
+    attr->from_matrix(mat.get());
+
+    rx.for_each_vertex(HOST, [&](const VertexHandle vh) {
+        for (uint32_t i = 0; i < 3; ++i) {
+            EXPECT_EQ((*attr)(vh, i),
+                      2.f * float(rx.map_to_global(vh) + i + 1));
+        }
+    });
+
+    mat->release();
+    ones.release();
+
+    rx.remove_attribute("attr");
+}
+
+TEST(RXMeshCPU, ReduceHandle)
+{
+    using namespace rxmesh;
+
+    RXMeshStatic rx(STRINGIFY(INPUT_DIR) "sphere3.obj");
+
+    auto attr = rx.add_vertex_attribute<float>("attr", 3, LOCATION_ALL);
+    attr->reset(2.f, DEVICE);
+
+    // DEVICE reductions run on the host in a CPU-only build
+    ReduceHandle reduce_handle(*attr);
+
+    EXPECT_FLOAT_EQ(reduce_handle.dot(*attr, *attr),
+                    3 * 4.f * rx.get_num_vertices());
+
+    EXPECT_FLOAT_EQ(reduce_handle.norm2(*attr),
+                    std::sqrt(3 * 4.f * rx.get_num_vertices()));
+
+    EXPECT_EQ(reduce_handle.arg_min(*attr).value, 2.f);
+
+    rx.remove_attribute("attr");
+}
+
+TEST(RXMeshCPU, Queries)
+{
+    using namespace rxmesh;
+
+    std::vector<std::vector<float>>    Verts;
+    std::vector<std::vector<uint32_t>> Faces;
+
+    ASSERT_TRUE(
+        import_obj(STRINGIFY(INPUT_DIR) "sphere3.obj", Verts, Faces));
+
+    RXMeshStatic rx(Faces);
+
+    ::RXMeshTest tester(rx, Faces);
+
+    auto input  = rx.add_vertex_attribute<VertexHandle>("input", 1);
+    auto output = rx.add_vertex_attribute<VertexHandle>(
+        "output", rx.get_input_max_valence());
+
+    input->reset(VertexHandle(), HOST);
+    output->reset(VertexHandle(), HOST);
+
+    rx.run_query_kernel<Op::VV, 256>(
+        DEVICE, [&](const VertexHandle& vh, const VertexIterator& iter) {
+            (*input)(vh) = vh;
+            for (uint32_t i = 0; i < iter.size(); ++i) {
+                (*output)(vh, i) = iter[i];
+            }
+        });
+
+    EXPECT_TRUE(tester.run_test(rx, Faces, *input, *output));
+}
+
+TEST(RXMeshCPU, AdjacencyCache)
+{
+    using namespace rxmesh;
+
+    std::vector<std::vector<float>>    Verts;
+    std::vector<std::vector<uint32_t>> Faces;
+
+    ASSERT_TRUE(
+        import_obj(STRINGIFY(INPUT_DIR) "sphere3.obj", Verts, Faces));
+
+    RXMeshStatic rx(Faces);
+
+    ::RXMeshTest tester(rx, Faces);
+
+    auto input  = rx.add_face_attribute<FaceHandle>("input", 1);
+    auto output = rx.add_face_attribute<FaceHandle>(
+        "output", rx.get_input_max_face_adjacent_faces() + 2);
+
+    auto run = [&]() {
+        input->reset(FaceHandle(), HOST);
+        output->reset(FaceHandle(), HOST);
+
+        rx.run_query_kernel<Op::FF, 256>(
+            DEVICE, [&](const FaceHandle& fh, const FaceIterator& iter) {
+                (*input)(fh) = fh;
+                for (uint32_t i = 0; i < iter.size(); ++i) {
+                    (*output)(fh, i) = iter[i];
+                }
+            });
+        return tester.run_test(rx, Faces, *input, *output);
+    };
+
+    EXPECT_FALSE(rx.has_adjacency_cache(Op::FF));
+    EXPECT_TRUE(run());
+
+    rx.build_adjacency_cache(Op::FF);
+    EXPECT_TRUE(rx.has_adjacency_cache(Op::FF));
+    EXPECT_NE(rx.get_context().adjacency_cache<Op::FF>(false), nullptr);
+    EXPECT_TRUE(run());
+
+    rx.release_adjacency_cache(Op::FF);
+    EXPECT_FALSE(rx.has_adjacency_cache(Op::FF));
+    EXPECT_TRUE(run());
+}
+
+TEST(RXMeshCPU, KRing)
+{
+    using namespace rxmesh;
+
+    std::vector<std::vector<float>>    Verts;
+    std::vector<std::vector<uint32_t>> Faces;
+
+    ASSERT_TRUE(
+        import_obj(STRINGIFY(INPUT_DIR) "sphere3.obj", Verts, Faces));
+
+    RXMeshStatic rx(Faces);
+
+    ::RXMeshTest tester(rx, Faces);
+
+    EXPECT_FALSE(rx.has_k_ring(2));
+
+    // a 3-ring also serves the 2-ring
+    rx.build_k_ring(3);
+    KRing k_ring = rx.build_k_ring(2);
+    EXPECT_TRUE(rx.has_k_ring(2));
+    EXPECT_EQ(k_ring.get_k(), 2u);
+
+    auto input = rx.add_vertex_attribute<VertexHandle>("input", 1);
+    auto output =
+        rx.add_vertex_attribute<VertexHandle>("output", rx.get_num_vertices());
+    input->reset(VertexHandle(), HOST);
+    output->reset(VertexHandle(), HOST);
+
+    rx.for_each_vertex(DEVICE, [&](const VertexHandle vh) {
+        const KRingIterator iter = k_ring(vh);
+        EXPECT_EQ(iter.size(), k_ring(vh, 1).size() + k_ring(vh, 2).size());
+        (*input)(vh) = vh;
+        for (uint32_t i = 0; i < iter.size(); ++i) {
+            (*output)(vh, i) = iter[i];
+        }
+    });
+    EXPECT_TRUE(tester.run_test(rx, Faces, *input, *output, true));
+
+    rx.release_k_ring();
+    EXPECT_FALSE(rx.has_k_ring(1));
+}
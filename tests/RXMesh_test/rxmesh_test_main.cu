@@ -16,10 +16,12 @@ struct RXMeshTestArg
 
 // clang-format off
 #include "test_queries.h"
+#include "test_patch_reorder.h"
 #include "test_patch_scheduler.cuh"
 #include "test_patch_lock.cuh"
 #include "test_wasted_work.cuh"
 #include "test_grad.h"
+#include "test_adjacency_cache.cuh"
 // clang-format on
 
 int main(int argc, char** argv)
@@ -0,0 +1,166 @@
+#include "gtest/gtest.h"
+
+#include "rxmesh/rxmesh_static.h"
+#include "rxmesh/util/import_obj.h"
+#include "rxmesh/util/report.h"
+#include "rxmesh_test.h"
+
+#include "query_kernel.cuh"
+
+/**
+ * @brief run the query op (recomputed and then cached) num_run times on the
+ * device, verify its output, and add the timing of both to the report
+ */
+template <rxmesh::Op op,
+          typename InputHandleT,
+          typename OutputHandleT,
+          typename InputAttributeT,
+          typename OutputAttributeT>
+void adjacency_cache_launcher(const std::vector<std::vector<uint32_t>>& Faces,
+                              rxmesh::RXMeshStatic&                     rx,
+                              InputAttributeT&                          input,
+                              OutputAttributeT&                         output,
+                              RXMeshTest&                               tester,
+                              rxmesh::Report&                           report)
+{
+    using namespace rxmesh;
+
+    constexpr uint32_t      blockThreads = 320;
+    LaunchBox<blockThreads> launch_box;
+    rx.prepare_launch_box({op},
+                          launch_box,
+                          (void*)query_kernel<blockThreads,
+                                              op,
+                                              InputHandleT,
+                                              OutputHandleT,
+                                              InputAttributeT,
+                                              OutputAttributeT>);
+
+    auto run = [&](const bool cached) {
+        if (cached) {
+            rx.build_adjacency_cache(op);
+        } else {
+            rx.release_adjacency_cache(op);
+        }
+        EXPECT_EQ(rx.has_adjacency_cache(op), cached);
+
+        TestData td;
+        td.test_name   = op_to_string(op) + (cached ? "_cached" : "");
+        td.num_threads = launch_box.num_threads;
+        td.num_blocks  = launch_box.blocks;
+        td.dyn_smem    = launch_box.smem_bytes_dyn;
+        td.static_smem = launch_box.smem_bytes_static;
+        td.num_reg     = launch_box.num_registers_per_thread;
+
+        float total_time = 0;
+
+        for (uint32_t itr = 0; itr < rxmesh_args.num_run; itr++) {
+            input.reset(InputHandleT(), DEVICE);
+            output.reset(OutputHandleT(), DEVICE);
+            CUDA_ERROR(cudaDeviceSynchronize());
+
+            GPUTimer timer;
+            timer.start();
+            query_kernel<blockThreads, op, InputHandleT, OutputHandleT>
+                <<<launch_box.blocks,
+                   blockThreads,
+                   launch_box.smem_bytes_dyn>>>(
+                    rx.get_context(), input, output, false);
+            timer.stop();
+            CUDA_ERROR(cudaDeviceSynchronize());
+            CUDA_ERROR(cudaGetLastError());
+
+            total_time += timer.elapsed_millis();
+            td.time_ms.push_back(timer.elapsed_millis());
+        }
+
+        output.move(DEVICE, HOST);
+        input.move(DEVICE, HOST);
+
+        bool passed = tester.run_test(rx, Faces, input, output);
+
+        // the host query reads the same cache
+        input.reset(InputHandleT(), HOST);
+        output.reset(OutputHandleT(), HOST);
+        rx.run_query_kernel<op, blockThreads>(
+            HOST,
+            [&](const InputHandleT& id, const Iterator<OutputHandleT>& iter) {
+                input(id) = id;
+                for (uint32_t i = 0; i < iter.size(); ++i) {
+                    output(id, i) = iter[i];
+                }
+            });
+        passed = passed && tester.run_test(rx, Faces, input, output);
+
+        td.passed.push_back(passed);
+        EXPECT_TRUE(passed) << "Testing: " << td.test_name;
+
+        report.add_test(td);
+
+        RXMESH_INFO(" {} {} time = {} (ms), throughput = {} (M elements/s)",
+                    td.test_name.c_str(),
+                    (passed ? " passed " : " failed "),
+                    total_time / float(rxmesh_args.num_run),
+                    double(input.size()) * rxmesh_args.num_run /
+                        (1000.0 * total_time));
+    };
+
+    run(false);
+    run(true);
+
+    rx.release_adjacency_cache(op);
+}
+
+TEST(RXMeshStatic, AdjacencyCache)
+{
+    using namespace rxmesh;
+
+    std::vector<std::vector<float>>    Verts;
+    std::vector<std::vector<uint32_t>> Faces;
+
+    ASSERT_TRUE(import_obj(rxmesh_args.obj_file_name, Verts, Faces));
+
+    RXMeshStatic rx(Faces);
+
+    Report report("AdjacencyCache_RXMesh");
+    report.command_line(rxmesh_args.argc, rxmesh_args.argv);
+    report.device();
+    report.system();
+    report.model_data(rxmesh_args.obj_file_name, rx);
+    report.add_member("method", std::string("RXMesh"));
+
+    ::RXMeshTest tester(rx, Faces);
+
+    {
+        // VV
+        auto input  = rx.add_vertex_attribute<VertexHandle>("input", 1);
+        auto output = rx.add_vertex_attribute<VertexHandle>(
+            "output", rx.get_input_max_valence());
+        adjacency_cache_launcher<Op::VV, VertexHandle, VertexHandle>(
+            Faces, rx, *input, *output, tester, report);
+        rx.remove_attribute("input");
+        rx.remove_attribute("output");
+    }
+
+    {
+        // FF
+        auto input  = rx.add_face_attribute<FaceHandle>("input", 1);
+        auto output = rx.add_face_attribute<FaceHandle>(
+            "output", rx.get_input_max_face_adjacent_faces() + 2);
+        adjacency_cache_launcher<Op::FF, FaceHandle, FaceHandle>(
+            Faces, rx, *input, *output, tester, report);
+        rx.remove_attribute("input");
+        rx.remove_attribute("output");
+    }
+
+    // an oriented query is not served by an unoriented cache
+    rx.build_adjacency_cache(Op::VV);
+    EXPECT_TRUE(rx.has_adjacency_cache(Op::VV));
+    EXPECT_FALSE(rx.has_adjacency_cache(Op::VV, true));
+    rx.release_adjacency_cache();
+    EXPECT_FALSE(rx.has_adjacency_cache(Op::VV));
+
+    report.write(rxmesh_args.output_folder + "/rxmesh",
+                 "AdjacencyCache_RXMesh_" +
+                     extract_file_name(rxmesh_args.obj_file_name));
+}
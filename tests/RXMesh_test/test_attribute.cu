@@ -1,5 +1,6 @@
 #include "gtest/gtest.h"
 #include "rxmesh/attribute.h"
+#include "rxmesh/attribute_expr.h"
 #include "rxmesh/reduce_handle.h"
 #include "rxmesh/rxmesh_static.h"
 #include "rxmesh/util/macros.h"
@@ -182,6 +183,209 @@ TEST(Attribute, ArgMax)
 }
 
 
+TEST(Attribute, HostReduce)
+{
+    using namespace rxmesh;
+
+    RXMeshStatic rx(STRINGIFY(INPUT_DIR) "bumpy-cube.obj");
+
+    auto x = *rx.add_vertex_attribute<float>("x", 3, HOST);
+    auto y = *rx.add_vertex_attribute<float>("y", 3, HOST);
+
+    // values of different magnitude so that the order of the additions
+    // matters in float
+    rx.for_each_vertex(HOST, [&](const VertexHandle vh) {
+        const uint32_t id = rx.linear_id(vh);
+        for (uint32_t i = 0; i < 3; ++i) {
+            x(vh, i) = std::sin(float(id + i)) * float(1 + id % 1000);
+            y(vh, i) = std::cos(float(id * 3 + i));
+        }
+    });
+
+    double   dot      = 0;
+    double   norm     = 0;
+    float    max_val  = std::numeric_limits<float>::lowest();
+    uint32_t max_id   = INVALID32;
+    float    sum_attr = 0;
+    rx.for_each_vertex(
+        HOST,
+        [&](const VertexHandle vh) {
+            for (uint32_t i = 0; i < 3; ++i) {
+                dot += double(x(vh, i)) * double(y(vh, i));
+                norm += double(x(vh, i)) * double(x(vh, i));
+                // arg_max follows patch (i.e., for_each) order on ties
+                if (x(vh, i) > max_val) {
+                    max_val = x(vh, i);
+                    max_id  = rx.linear_id(vh);
+                }
+            }
+            sum_attr += std::abs(y(vh, 1));
+        },
+        NULL,
+        false);
+
+    ReduceHandle reduce_handle(x);
+
+    const float h_dot = reduce_handle.dot(x, y, INVALID32, NULL, HOST);
+    EXPECT_NEAR(h_dot, dot, 1e-4 * std::abs(dot));
+
+    const float h_norm = reduce_handle.norm2(x, INVALID32, NULL, HOST);
+    EXPECT_NEAR(h_norm, std::sqrt(norm), 1e-4 * std::sqrt(norm));
+
+    auto h_max = reduce_handle.arg_max(x, INVALID32, NULL, HOST);
+    EXPECT_EQ(h_max.value, max_val);
+    EXPECT_EQ(rx.linear_id(h_max.key), max_id);
+
+    const float h_sum = reduce_handle.reduce(
+        y,
+        [](float a, float b) { return std::abs(a) + std::abs(b); },
+        0.f,
+        1,
+        NULL,
+        HOST);
+    EXPECT_NEAR(h_sum, sum_attr, 1e-4 * sum_attr);
+
+    // the same bits no matter how many threads are used
+    const int num_threads = omp_get_max_threads();
+    for (int t : {1, 2, 3, num_threads}) {
+        omp_set_num_threads(t);
+        EXPECT_EQ(reduce_handle.dot(x, y, INVALID32, NULL, HOST), h_dot);
+        EXPECT_EQ(reduce_handle.norm2(x, INVALID32, NULL, HOST), h_norm);
+        EXPECT_EQ(reduce_handle.dot(x, y, 2, NULL, HOST),
+                  reduce_handle.dot(x, y, 2, NULL, HOST));
+    }
+    omp_set_num_threads(num_threads);
+}
+
+TEST(Attribute, FusedExpression)
+{
+    using namespace rxmesh;
+
+    RXMeshStatic rx(STRINGIFY(INPUT_DIR) "sphere3.obj");
+
+    auto x = *rx.add_vertex_attribute<float>("x", 3, HOST);
+    auto p = *rx.add_vertex_attribute<float>("p", 3, HOST);
+    auto r = *rx.add_vertex_attribute<float>("r", 3, HOST);
+    auto s = *rx.add_vertex_attribute<float>("s", 3, HOST);
+
+    auto init = [&]() {
+        rx.for_each_vertex(HOST, [&](const VertexHandle vh) {
+            const float id = float(rx.linear_id(vh));
+            for (uint32_t i = 0; i < 3; ++i) {
+                x(vh, i) = id + i;
+                p(vh, i) = 1.f / (id + i + 1.f);
+                r(vh, i) = 2.f * id - i;
+                s(vh, i) = 0.5f * i;
+            }
+        });
+    };
+
+    const float alpha = 0.25f;
+
+    // expected values with separate passes
+    init();
+    float rr = 0;
+    rx.for_each_vertex(
+        HOST,
+        [&](const VertexHandle vh) {
+            for (uint32_t i = 0; i < 3; ++i) {
+                x(vh, i) = x(vh, i) + alpha * p(vh, i);
+                r(vh, i) = r(vh, i) - alpha * s(vh, i);
+                rr += r(vh, i) * r(vh, i);
+            }
+        },
+        NULL,
+        false);
+    auto x_expected = *rx.add_vertex_attribute<float>("xe", 3, HOST);
+    auto r_expected = *rx.add_vertex_attribute<float>("re", 3, HOST);
+    x_expected.copy_from(x, HOST, HOST);
+    r_expected.copy_from(r, HOST, HOST);
+
+    // one fused pass
+    init();
+    ReduceHandle reduce_handle(x);
+
+    const float h_rr = reduce_handle.evaluate(rx,
+                                              HOST,
+                                              NULL,
+                                              assign(x, x + alpha * p),
+                                              assign(r, r - alpha * s),
+                                              reduce_sum(r * r));
+
+    EXPECT_NEAR(h_rr, rr, 1e-5 * rr);
+
+    rx.for_each_vertex(HOST, [&](const VertexHandle vh) {
+        for (uint32_t i = 0; i < 3; ++i) {
+            EXPECT_EQ(x(vh, i), x_expected(vh, i));
+            EXPECT_EQ(r(vh, i), r_expected(vh, i));
+        }
+    });
+
+    // the fused reduction matches ReduceHandle::dot() bit by bit
+    EXPECT_EQ(h_rr, reduce_handle.dot(r, r, INVALID32, NULL, HOST));
+
+    // assignments only, scalars on both sides, and unary minus
+    evaluate(rx, HOST, NULL, assign(s, -(2.f * x - p) / 2), assign(p, 1));
+
+    rx.for_each_vertex(HOST, [&](const VertexHandle vh) {
+        const float id = float(rx.linear_id(vh));
+        for (uint32_t i = 0; i < 3; ++i) {
+            const float old_p = 1.f / (id + i + 1.f);
+            EXPECT_EQ(s(vh, i), -(2.f * x(vh, i) - old_p) / 2);
+            EXPECT_EQ(p(vh, i), 1.f);
+        }
+    });
+}
+
+TEST(Attribute, PingPong)
+{
+    using namespace rxmesh;
+
+    RXMeshStatic rx(STRINGIFY(INPUT_DIR) "sphere3.obj");
+
+    auto pp = rx.add_ping_pong_attribute<uint32_t, VertexHandle>("pp", 2);
+
+    EXPECT_TRUE(rx.does_attribute_exist("pp"));
+    EXPECT_TRUE(rx.does_attribute_exist("pp:back"));
+
+    Attribute<uint32_t, VertexHandle>& front = pp.front();
+
+    front.reset(1, LOCATION_ALL);
+    pp.back().reset(2, LOCATION_ALL);
+
+    // swapping exchanges the memory without copying so the front attribute
+    // (and anything that refers to it) sees the back data
+    const uint32_t* front_ptr = &front(VertexHandle(0, 0));
+    const uint32_t* back_ptr  = &pp.back()(VertexHandle(0, 0));
+
+    pp.swap();
+
+    EXPECT_EQ(&pp.front(), &front);
+    EXPECT_EQ(&front(VertexHandle(0, 0)), back_ptr);
+    EXPECT_EQ(&pp.back()(VertexHandle(0, 0)), front_ptr);
+
+    auto out = rx.add_vertex_attribute<uint32_t>("out", 2);
+    out->copy_from(front, DEVICE, HOST);
+    ASSERT_EQ(cudaDeviceSynchronize(), cudaSuccess);
+
+    rx.for_each_vertex(HOST, [&](const VertexHandle vh) {
+        EXPECT_EQ(front(vh, 0), 2u);
+        EXPECT_EQ(pp.back()(vh, 1), 1u);
+        EXPECT_EQ((*out)(vh, 1), 2u);
+    });
+
+    // Jacobi-style iterations
+    for (int i = 0; i < 5; ++i) {
+        rx.for_each_vertex(HOST, [&](const VertexHandle vh) {
+            pp.back()(vh, 0) = pp.front()(vh, 0) + 1;
+        });
+        pp.swap();
+    }
+
+    rx.for_each_vertex(
+        HOST, [&](const VertexHandle vh) { EXPECT_EQ(front(vh, 0), 7u); });
+}
+
 TEST(Attribute, CopyFrom)
 {
     using namespace rxmesh;
@@ -223,4 +427,77 @@ TEST(Attribute, AddingAndRemoving)
     // this is not neccessary in general but we are just testing the
     // functionality here
     rx.remove_attribute(attr_name);
-}
\ No newline at end of file
+}
+
+TEST(Attribute, SlabMove)
+{
+    using namespace rxmesh;
+
+    RXMeshStatic rx(STRINGIFY(INPUT_DIR) "sphere3.obj");
+
+    auto attr = rx.add_vertex_attribute<uint32_t>("v", 3, LOCATION_ALL, SoA);
+
+    EXPECT_GT(attr->get_memory_mg(), 0);
+    EXPECT_GE(attr->get_allocation_time(), 0);
+
+    rx.for_each_vertex(HOST, [&](const VertexHandle vh) {
+        for (uint32_t i = 0; i < 3; ++i) {
+            (*attr)(vh, i) = 3 * rx.map_to_global(vh) + i;
+        }
+    });
+
+    // all patches should be moved by the bulk copy of the slab
+    attr->move(HOST, DEVICE);
+    attr->reset(0, HOST);
+    attr->move(DEVICE, HOST);
+
+    ASSERT_EQ(cudaDeviceSynchronize(), cudaSuccess);
+
+    rx.for_each_vertex(HOST, [&](const VertexHandle vh) {
+        for (uint32_t i = 0; i < 3; ++i) {
+            EXPECT_EQ((*attr)(vh, i), 3 * rx.map_to_global(vh) + i);
+        }
+    });
+
+    EXPECT_GE(attr->get_transfer_time(), 0);
+}
+
+TEST(Attribute, GatherScatter)
+{
+    using namespace rxmesh;
+
+    RXMeshStatic rx(STRINGIFY(INPUT_DIR) "sphere3.obj");
+
+    auto attr = rx.add_face_attribute<float>("f", 2, LOCATION_ALL, AoS);
+
+    const uint32_t num_faces = rx.get_num_faces();
+
+    // every global index maps to a distinct face
+    rx.for_each_face(HOST, [&](const FaceHandle fh) {
+        (*attr)(fh, 0) = 0;
+        (*attr)(fh, 1) = 0;
+    });
+    for (uint32_t i = 0; i < num_faces; ++i) {
+        const FaceHandle fh = rx.map_to_local_face(i);
+        ASSERT_TRUE(fh.is_valid());
+        EXPECT_EQ((*attr)(fh, 0), 0);
+        (*attr)(fh, 0) = 1;
+    }
+
+    std::vector<float> in(2 * size_t(num_faces));
+    for (size_t i = 0; i < in.size(); ++i) {
+        in[i] = float(i);
+    }
+
+    attr->scatter(in.data());
+
+    for (uint32_t i = 0; i < num_faces; ++i) {
+        EXPECT_EQ((*attr)(i, 0), in[2 * i]);
+        EXPECT_EQ((*attr)(i, 1), in[2 * i + 1]);
+    }
+
+    std::vector<float> out(in.size(), -1);
+    attr->gather(out.data());
+
+    EXPECT_EQ(in, out);
+}
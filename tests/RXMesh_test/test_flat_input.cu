@@ -0,0 +1,86 @@
+#include "gtest/gtest.h"
+
+#include "rxmesh/rxmesh_static.h"
+#include "rxmesh/util/import_obj.h"
+
+#include "rxmesh_test.h"
+
+TEST(RXMeshStatic, FlatInput)
+{
+    using namespace rxmesh;
+
+    std::vector<std::vector<float>>    Verts;
+    std::vector<std::vector<uint32_t>> Faces;
+
+    ASSERT_TRUE(
+        import_obj(STRINGIFY(INPUT_DIR) "sphere3.obj", Verts, Faces));
+
+    std::vector<uint32_t> fv;
+    std::vector<float>    coords;
+    for (const auto& f : Faces) {
+        fv.insert(fv.end(), f.begin(), f.end());
+    }
+    for (const auto& v : Verts) {
+        coords.insert(coords.end(), v.begin(), v.end());
+    }
+
+    RXMeshStatic rx_flat(fv.data(),
+                         static_cast<uint32_t>(Faces.size()),
+                         coords.data(),
+                         static_cast<uint32_t>(Verts.size()));
+
+    RXMeshStatic rx(Faces);
+
+    EXPECT_EQ(rx_flat.get_num_vertices(), rx.get_num_vertices());
+    EXPECT_EQ(rx_flat.get_num_edges(), rx.get_num_edges());
+    EXPECT_EQ(rx_flat.get_num_faces(), rx.get_num_faces());
+    EXPECT_EQ(rx_flat.get_num_patches(), rx.get_num_patches());
+    EXPECT_EQ(rx_flat.get_input_max_valence(), rx.get_input_max_valence());
+
+    ::RXMeshTest tester(rx_flat, Faces);
+    EXPECT_TRUE(tester.run_ltog_mapping_test(rx_flat, Faces));
+
+    auto coord = *rx_flat.get_input_vertex_coordinates();
+
+    rx_flat.for_each_vertex(HOST, [&](const VertexHandle& vh) {
+        uint32_t v = rx_flat.map_to_global(vh);
+        for (uint32_t i = 0; i < 3; ++i) {
+            EXPECT_EQ(coord(vh, i), Verts[v][i]);
+        }
+    });
+}
+
+
+TEST(RXMeshStatic, FlatInputSizeMismatch)
+{
+    using namespace rxmesh;
+
+    RXMeshStatic rx(STRINGIFY(INPUT_DIR) "sphere3.obj");
+
+    // a buffer with fewer vertices than the mesh should be rejected without
+    // reading past its end
+    std::vector<float> attr(rx.get_num_vertices() - 1, 1.f);
+
+    auto bad = rx.add_vertex_attribute<float>(
+        attr.data(), static_cast<uint32_t>(attr.size()), 1, "bad");
+    EXPECT_EQ(bad, nullptr);
+    EXPECT_FALSE(rx.does_attribute_exist("bad"));
+
+    attr.push_back(1.f);
+    auto good = rx.add_vertex_attribute<float>(
+        attr.data(), static_cast<uint32_t>(attr.size()), 1, "good");
+    ASSERT_NE(good, nullptr);
+
+    rx.for_each_vertex(
+        HOST, [&](const VertexHandle& vh) { EXPECT_EQ((*good)(vh), 1.f); });
+
+    // extra values (e.g., unreferenced vertices in the input file) are
+    // ignored
+    attr.push_back(2.f);
+    auto extra = rx.add_vertex_attribute<float>(
+        attr.data(), static_cast<uint32_t>(attr.size()), 1, "extra");
+    ASSERT_NE(extra, nullptr);
+
+    rx.for_each_vertex(
+        HOST, [&](const VertexHandle& vh) { EXPECT_EQ((*extra)(vh), 1.f); });
+}
@@ -0,0 +1,104 @@
+#include <atomic>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "rxmesh/rxmesh_static.h"
+#include "rxmesh/util/host_affinity.h"
+#include "rxmesh/util/import_obj.h"
+
+#include "rxmesh_test.h"
+
+TEST(HostAffinity, RunsEveryPatchOnItsHome)
+{
+    using namespace rxmesh;
+
+    const uint32_t num_patches = 1000;
+
+    detail::HostAffinity affinity(
+        num_patches, [](uint32_t p) { return (p % 10 == 0) ? 5000 : 100; }, 4);
+
+    EXPECT_TRUE(affinity.is_valid());
+    EXPECT_EQ(affinity.get_num_threads(), 4);
+
+    // homes are contiguous ranges
+    for (uint32_t p = 1; p < num_patches; ++p) {
+        EXPECT_GE(affinity.home(p), affinity.home(p - 1));
+    }
+
+    // every patch (including the ones added after the affinity was computed)
+    // is visited once and the thread that visits it is the same every pass
+    const uint32_t        num_run = num_patches + 10;
+    std::vector<int>      first_tid(num_run, -1);
+    std::vector<uint32_t> visits(num_run, 0);
+
+    for (int pass = 0; pass < 3; ++pass) {
+        affinity.run(num_run, [&](uint32_t p) {
+            visits[p]++;
+            const int tid = omp_get_thread_num();
+            if (pass == 0) {
+                first_tid[p] = tid;
+            } else {
+                EXPECT_EQ(first_tid[p], tid);
+            }
+        });
+    }
+
+    for (uint32_t p = 0; p < num_run; ++p) {
+        EXPECT_EQ(visits[p], 3u);
+    }
+}
+
+TEST(HostAffinity, RXMeshStatic)
+{
+    using namespace rxmesh;
+
+    std::vector<std::vector<float>>    Verts;
+    std::vector<std::vector<uint32_t>> Faces;
+
+    ASSERT_TRUE(import_obj(STRINGIFY(INPUT_DIR) "sphere3.obj", Verts, Faces));
+
+    RXMeshStatic rx(Faces,
+                    "",
+                    64,
+                    1.0,
+                    1.0,
+                    0.8,
+                    PatchingMethod::Lloyd,
+                    false,
+                    true);
+
+    ASSERT_NE(rx.get_host_affinity(), nullptr);
+
+    // attributes are allocated through the affinity and reset on the host
+    auto v_attr = *rx.add_vertex_attribute<uint32_t>("v", 1, HOST);
+    v_attr.reset(0, HOST);
+
+    rx.for_each_vertex(HOST, [&](const VertexHandle vh) { v_attr(vh)++; });
+
+    std::atomic_uint32_t num_v = 0;
+    rx.for_each_vertex(HOST, [&](const VertexHandle vh) {
+        EXPECT_EQ(v_attr(vh), 1u);
+        num_v++;
+    });
+    EXPECT_EQ(num_v, rx.get_num_vertices());
+
+    ::RXMeshTest tester(rx, Faces);
+
+    auto input  = rx.add_vertex_attribute<VertexHandle>("input", 1, HOST);
+    auto output = rx.add_vertex_attribute<VertexHandle>(
+        "output", rx.get_input_max_valence(), HOST);
+
+    input->reset(VertexHandle(), HOST);
+    output->reset(VertexHandle(), HOST);
+
+    rx.run_query_kernel<Op::VV, 256>(
+        HOST, [&](const VertexHandle& vh, const VertexIterator& iter) {
+            (*input)(vh) = vh;
+            for (uint32_t i = 0; i < iter.size(); ++i) {
+                (*output)(vh, i) = iter[i];
+            }
+        });
+
+    EXPECT_TRUE(tester.run_test(rx, Faces, *input, *output));
+}
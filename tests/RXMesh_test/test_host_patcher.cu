@@ -0,0 +1,72 @@
+#include "gtest/gtest.h"
+
+#include "rxmesh/rxmesh_static.h"
+#include "rxmesh/util/import_obj.h"
+
+#include "rxmesh_test.h"
+
+TEST(RXMeshStatic, HostLloydPatcher)
+{
+    using namespace rxmesh;
+
+    std::vector<std::vector<float>>    Verts;
+    std::vector<std::vector<uint32_t>> Faces;
+
+    ASSERT_TRUE(import_obj(STRINGIFY(INPUT_DIR) "dragon.obj", Verts, Faces));
+
+    const uint32_t patch_size = 512;
+
+    RXMeshStatic rx(Faces,
+                    "",
+                    patch_size,
+                    1.0,
+                    1.0,
+                    0.8,
+                    PatchingMethod::HostLloyd);
+
+    EXPECT_EQ(rx.get_num_faces(), Faces.size());
+    EXPECT_GE(rx.get_num_patches(),
+              DIVIDE_UP(static_cast<uint32_t>(Faces.size()), patch_size));
+
+    ::RXMeshTest tester(rx, Faces);
+    EXPECT_TRUE(tester.run_ltog_mapping_test(rx, Faces));
+}
+
+TEST(RXMeshStatic, SpaceFillingCurvePatcher)
+{
+    using namespace rxmesh;
+
+    std::vector<std::vector<float>>    Verts;
+    std::vector<std::vector<uint32_t>> Faces;
+
+    ASSERT_TRUE(import_obj(STRINGIFY(INPUT_DIR) "dragon.obj", Verts, Faces));
+
+    const std::string file = STRINGIFY(INPUT_DIR) "dragon.obj";
+
+    RXMeshStatic rx_lloyd(file,
+                          "",
+                          512,
+                          1.0,
+                          1.0,
+                          0.8,
+                          PatchingMethod::HostLloyd);
+
+    for (auto method : {PatchingMethod::Morton, PatchingMethod::Hilbert}) {
+        RXMeshStatic rx(file, "", 512, 1.0, 1.0, 0.8, method);
+
+        EXPECT_EQ(rx.get_num_faces(), Faces.size());
+
+        ::RXMeshTest tester(rx, Faces);
+        EXPECT_TRUE(tester.run_ltog_mapping_test(rx, Faces));
+
+        // the trade-off against Lloyd: faster patching but more ribbons
+        RXMESH_INFO(
+            "SpaceFillingCurvePatcher: {} patching time = {} (ms) vs. {} (ms), "
+            "ribbon overhead = {:02.2f}% vs. {:02.2f}%",
+            (method == PatchingMethod::Morton) ? "Morton" : "Hilbert",
+            rx.get_patching_time(),
+            rx_lloyd.get_patching_time(),
+            rx.get_ribbon_overhead(),
+            rx_lloyd.get_ribbon_overhead());
+    }
+}
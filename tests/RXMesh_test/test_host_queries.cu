@@ -0,0 +1,251 @@
+#include "gtest/gtest.h"
+
+#include "rxmesh/rxmesh_static.h"
+#include "rxmesh/util/import_obj.h"
+
+#include "query_kernel.cuh"
+#include "rxmesh_test.h"
+
+template <rxmesh::Op op,
+          typename InputHandleT,
+          typename OutputHandleT,
+          typename InputAttributeT,
+          typename OutputAttributeT>
+void host_launcher(const std::vector<std::vector<uint32_t>>& Faces,
+                   rxmesh::RXMeshStatic&                     rx,
+                   InputAttributeT&                          input,
+                   OutputAttributeT&                         output,
+                   RXMeshTest&                               tester)
+{
+    using namespace rxmesh;
+
+    input.reset(InputHandleT(), HOST);
+    output.reset(OutputHandleT(), HOST);
+
+    rx.run_query_kernel<op, 256>(
+        HOST,
+        [&](const InputHandleT& id, const Iterator<OutputHandleT>& iter) {
+            input(id) = id;
+            for (uint32_t i = 0; i < iter.size(); ++i) {
+                output(id, i) = iter[i];
+            }
+        });
+
+    EXPECT_TRUE(tester.run_test(rx, Faces, input, output))
+        << "Testing: " << op_to_string(op);
+}
+
+TEST(RXMeshStatic, HostQueries)
+{
+    using namespace rxmesh;
+
+    std::vector<std::vector<float>>    Verts;
+    std::vector<std::vector<uint32_t>> Faces;
+
+    ASSERT_TRUE(
+        import_obj(STRINGIFY(INPUT_DIR) "sphere3.obj", Verts, Faces));
+
+    RXMeshStatic rx(Faces);
+
+    ::RXMeshTest tester(rx, Faces);
+
+    {
+        // VV
+        auto input  = rx.add_vertex_attribute<VertexHandle>("input", 1);
+        auto output = rx.add_vertex_attribute<VertexHandle>(
+            "output", rx.get_input_max_valence());
+        host_launcher<Op::VV, VertexHandle, VertexHandle>(
+            Faces, rx, *input, *output, tester);
+        rx.remove_attribute("input");
+        rx.remove_attribute("output");
+    }
+
+    {
+        // VE
+        auto input  = rx.add_vertex_attribute<VertexHandle>("input", 1);
+        auto output = rx.add_vertex_attribute<EdgeHandle>(
+            "output", rx.get_input_max_valence());
+        host_launcher<Op::VE, VertexHandle, EdgeHandle>(
+            Faces, rx, *input, *output, tester);
+        rx.remove_attribute("input");
+        rx.remove_attribute("output");
+    }
+
+    {
+        // VF
+        auto input  = rx.add_vertex_attribute<VertexHandle>("input", 1);
+        auto output = rx.add_vertex_attribute<FaceHandle>(
+            "output", rx.get_input_max_valence());
+        host_launcher<Op::VF, VertexHandle, FaceHandle>(
+            Faces, rx, *input, *output, tester);
+        rx.remove_attribute("input");
+        rx.remove_attribute("output");
+    }
+
+    {
+        // EV
+        auto input  = rx.add_edge_attribute<EdgeHandle>("input", 1);
+        auto output = rx.add_edge_attribute<VertexHandle>("output", 2);
+        host_launcher<Op::EV, EdgeHandle, VertexHandle>(
+            Faces, rx, *input, *output, tester);
+        rx.remove_attribute("input");
+        rx.remove_attribute("output");
+    }
+
+    {
+        // EF
+        auto input  = rx.add_edge_attribute<EdgeHandle>("input", 1);
+        auto output = rx.add_edge_attribute<FaceHandle>(
+            "output", rx.get_input_max_edge_incident_faces());
+        host_launcher<Op::EF, EdgeHandle, FaceHandle>(
+            Faces, rx, *input, *output, tester);
+        rx.remove_attribute("input");
+        rx.remove_attribute("output");
+    }
+
+    {
+        // FV
+        auto input  = rx.add_face_attribute<FaceHandle>("input", 1);
+        auto output = rx.add_face_attribute<VertexHandle>("output", 3);
+        host_launcher<Op::FV, FaceHandle, VertexHandle>(
+            Faces, rx, *input, *output, tester);
+        rx.remove_attribute("input");
+        rx.remove_attribute("output");
+    }
+
+    {
+        // FE
+        auto input  = rx.add_face_attribute<FaceHandle>("input", 1);
+        auto output = rx.add_face_attribute<EdgeHandle>("output", 3);
+        host_launcher<Op::FE, FaceHandle, EdgeHandle>(
+            Faces, rx, *input, *output, tester);
+        rx.remove_attribute("input");
+        rx.remove_attribute("output");
+    }
+
+    {
+        // FF
+        auto input  = rx.add_face_attribute<FaceHandle>("input", 1);
+        auto output = rx.add_face_attribute<FaceHandle>(
+            "output", rx.get_input_max_face_adjacent_faces() + 2);
+        host_launcher<Op::FF, FaceHandle, FaceHandle>(
+            Faces, rx, *input, *output, tester);
+        rx.remove_attribute("input");
+        rx.remove_attribute("output");
+    }
+}
+
+
+TEST(RXMeshStatic, HostQueriesMatchDevice)
+{
+    using namespace rxmesh;
+
+    RXMeshStatic rx(STRINGIFY(INPUT_DIR) "plane_5.obj");
+
+    // EVDiamond and EE have a fixed layout so the host and device output
+    // should match exactly
+    auto d_diamond = *rx.add_edge_attribute<VertexHandle>("d_diamond", 4);
+    auto h_diamond = *rx.add_edge_attribute<VertexHandle>("h_diamond", 4);
+    auto d_ee      = *rx.add_edge_attribute<EdgeHandle>("d_ee", 4);
+    auto h_ee      = *rx.add_edge_attribute<EdgeHandle>("h_ee", 4);
+
+    d_diamond.reset(VertexHandle(), LOCATION_ALL);
+    h_diamond.reset(VertexHandle(), LOCATION_ALL);
+    d_ee.reset(EdgeHandle(), LOCATION_ALL);
+    h_ee.reset(EdgeHandle(), LOCATION_ALL);
+
+    rx.run_query_kernel<Op::EVDiamond, 256>(
+        DEVICE,
+        [=] __device__(const EdgeHandle& eh, const VertexIterator& iter) {
+            for (uint16_t i = 0; i < iter.size(); ++i) {
+                d_diamond(eh, i) = iter[i];
+            }
+        });
+
+    rx.run_query_kernel<Op::EE, 256>(
+        DEVICE,
+        [=] __device__(const EdgeHandle& eh, const EdgeIterator& iter) {
+            for (uint16_t i = 0; i < iter.size(); ++i) {
+                d_ee(eh, i) = iter[i];
+            }
+        });
+
+    rx.run_query_kernel<Op::EVDiamond, 256>(
+        HOST, [&](const EdgeHandle& eh, const VertexIterator& iter) {
+            for (uint16_t i = 0; i < iter.size(); ++i) {
+                h_diamond(eh, i) = iter[i];
+            }
+        });
+
+    rx.run_query_kernel<Op::EE, 256>(
+        HOST, [&](const EdgeHandle& eh, const EdgeIterator& iter) {
+            for (uint16_t i = 0; i < iter.size(); ++i) {
+                h_ee(eh, i) = iter[i];
+            }
+        });
+
+    CUDA_ERROR(cudaDeviceSynchronize());
+
+    d_diamond.move(DEVICE, HOST);
+    d_ee.move(DEVICE, HOST);
+
+    rx.for_each_edge(HOST, [&](const EdgeHandle& eh) {
+        for (uint32_t i = 0; i < 4; ++i) {
+            EXPECT_EQ(d_diamond(eh, i), h_diamond(eh, i));
+            EXPECT_EQ(d_ee(eh, i), h_ee(eh, i));
+        }
+    });
+}
+
+
+TEST(RXMeshStatic, BlockQueryEE)
+{
+    using namespace rxmesh;
+
+    RXMeshStatic rx(STRINGIFY(INPUT_DIR) "plane_5.obj");
+
+    // EE goes through Query::dispatch and Query::get_iterator here (not
+    // run_query_kernel) so the iterator has to use the fixed stride of four
+    auto input  = *rx.add_edge_attribute<EdgeHandle>("input", 1);
+    auto d_ee   = *rx.add_edge_attribute<EdgeHandle>("d_ee", 4);
+    auto h_ee   = *rx.add_edge_attribute<EdgeHandle>("h_ee", 4);
+
+    input.reset(EdgeHandle(), LOCATION_ALL);
+    d_ee.reset(EdgeHandle(), LOCATION_ALL);
+    h_ee.reset(EdgeHandle(), LOCATION_ALL);
+
+    constexpr uint32_t      blockThreads = 256;
+    LaunchBox<blockThreads> launch_box;
+    rx.prepare_launch_box({Op::EE},
+                          launch_box,
+                          (void*)query_kernel<blockThreads,
+                                              Op::EE,
+                                              EdgeHandle,
+                                              EdgeHandle,
+                                              EdgeAttribute<EdgeHandle>,
+                                              EdgeAttribute<EdgeHandle>>);
+
+    query_kernel<blockThreads, Op::EE, EdgeHandle, EdgeHandle>
+        <<<launch_box.blocks, blockThreads, launch_box.smem_bytes_dyn>>>(
+            rx.get_context(), input, d_ee);
+
+    CUDA_ERROR(cudaDeviceSynchronize());
+
+    rx.run_query_kernel<Op::EE, blockThreads>(
+        HOST, [&](const EdgeHandle& eh, const EdgeIterator& iter) {
+            EXPECT_EQ(iter.size(), 4);
+            for (uint16_t i = 0; i < iter.size(); ++i) {
+                h_ee(eh, i) = iter[i];
+            }
+        });
+
+    input.move(DEVICE, HOST);
+    d_ee.move(DEVICE, HOST);
+
+    rx.for_each_edge(HOST, [&](const EdgeHandle& eh) {
+        EXPECT_EQ(input(eh), eh);
+        for (uint32_t i = 0; i < 4; ++i) {
+            EXPECT_EQ(d_ee(eh, i), h_ee(eh, i));
+        }
+    });
+}
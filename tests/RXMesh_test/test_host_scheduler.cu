@@ -0,0 +1,187 @@
+#include <atomic>
+#include <cmath>
+#include <numeric>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "rxmesh/rxmesh_static.h"
+#include "rxmesh/util/host_scheduler.h"
+#include "rxmesh/util/log.h"
+#include "rxmesh/util/timer.h"
+
+namespace {
+// a few huge patches among many small ones similar to what patch slicing
+// could produce
+std::vector<uint32_t> skewed_patch_sizes(const uint32_t num_patches)
+{
+    std::vector<uint32_t> sizes(num_patches);
+    for (uint32_t p = 0; p < num_patches; ++p) {
+        sizes[p] = (p % 64 == 0) ? 60000 : 16 + (p * 7919) % 256;
+    }
+    return sizes;
+}
+
+// some work per element so that the cost of a patch is proportional to its
+// size
+inline double element_work(const uint32_t p, const uint32_t e)
+{
+    double r = double(p + e);
+    for (int i = 0; i < 32; ++i) {
+        r = std::sqrt(r + double(i));
+    }
+    return r;
+}
+}  // namespace
+
+TEST(HostScheduler, VisitsEveryElementOnce)
+{
+    using namespace rxmesh;
+
+    const std::vector<uint32_t> sizes = skewed_patch_sizes(256);
+
+    std::vector<uint32_t> offset(sizes.size() + 1, 0);
+    std::inclusive_scan(sizes.begin(), sizes.end(), offset.begin() + 1);
+
+    for (uint32_t split_size : {0u, 1000u}) {
+        detail::HostScheduler scheduler(
+            sizes.size(), [&](uint32_t p) { return sizes[p]; }, split_size);
+
+        std::vector<std::atomic<uint32_t>> visits(offset.back());
+        for (auto& v : visits) {
+            v = 0;
+        }
+
+        scheduler.run([&](const detail::HostTask& task, int tid) {
+            EXPECT_LT(tid, scheduler.get_num_threads());
+            EXPECT_LE(task.end, sizes[task.patch_id]);
+            if (split_size != 0) {
+                EXPECT_LE(uint32_t(task.end - task.begin), split_size);
+            }
+            for (uint32_t e = task.begin; e < task.end; ++e) {
+                visits[offset[task.patch_id] + e]++;
+            }
+        });
+
+        for (const auto& v : visits) {
+            EXPECT_EQ(v, 1u);
+        }
+
+        EXPECT_EQ(scheduler.stats().num_tasks, scheduler.get_num_tasks());
+        if (split_size == 0) {
+            EXPECT_EQ(scheduler.get_num_tasks(), sizes.size());
+        } else {
+            EXPECT_GT(scheduler.get_num_tasks(), sizes.size());
+        }
+    }
+}
+
+TEST(HostScheduler, ForEachAndQuery)
+{
+    using namespace rxmesh;
+
+    RXMeshStatic rx(STRINGIFY(INPUT_DIR) "sphere3.obj");
+
+    // with and without the scheduler should see the same elements
+    auto v_attr = *rx.add_vertex_attribute<uint32_t>("v", 1);
+    v_attr.reset(0, HOST);
+
+    rx.for_each_vertex(HOST, [&](const VertexHandle vh) { v_attr(vh)++; });
+    rx.for_each_vertex(
+        HOST, [&](const VertexHandle vh) { v_attr(vh)++; }, NULL, false);
+
+    std::atomic_uint32_t num_v = 0;
+    rx.for_each_vertex(HOST, [&](const VertexHandle vh) {
+        EXPECT_EQ(v_attr(vh), 2u);
+        num_v++;
+    });
+    EXPECT_EQ(num_v, rx.get_num_vertices());
+
+    std::atomic_uint32_t num_ev = 0;
+    rx.run_query_kernel<Op::EV, 256>(
+        HOST, [&](const EdgeHandle& eh, const VertexIterator& iter) {
+            num_ev += iter.size();
+        });
+    EXPECT_EQ(num_ev, 2 * rx.get_num_edges());
+}
+
+TEST(HostScheduler, SkewedBenchmark)
+{
+    using namespace rxmesh;
+
+    const std::vector<uint32_t> sizes = skewed_patch_sizes(1024);
+    const int                   num_patches = static_cast<int>(sizes.size());
+
+    const size_t num_elements =
+        std::accumulate(sizes.begin(), sizes.end(), size_t(0));
+
+    // baseline: one patch per OpenMP iteration as for_each used to do
+    std::vector<double> busy_ms(omp_get_max_threads(), 0);
+    double              omp_sum = 0;
+
+    CPUTimer timer;
+    timer.start();
+#pragma omp parallel reduction(+ : omp_sum)
+    {
+        const auto start = std::chrono::high_resolution_clock::now();
+#pragma omp for nowait
+        for (int p = 0; p < num_patches; ++p) {
+            for (uint32_t e = 0; e < sizes[p]; ++e) {
+                omp_sum += element_work(p, e);
+            }
+        }
+        busy_ms[omp_get_thread_num()] =
+            std::chrono::duration<double, std::milli>(
+                std::chrono::high_resolution_clock::now() - start)
+                .count();
+    }
+    timer.stop();
+    const float omp_ms = timer.elapsed_millis();
+
+    const double omp_imbalance =
+        *std::max_element(busy_ms.begin(), busy_ms.end()) /
+        std::max(1e-9,
+                 std::accumulate(busy_ms.begin(), busy_ms.end(), 0.0) /
+                     double(busy_ms.size()));
+
+    // work-stealing with split patches
+    detail::HostScheduler scheduler(
+        num_patches,
+        [&](uint32_t p) { return sizes[p]; },
+        detail::HostScheduler::default_split_size(num_elements,
+                                                  omp_get_max_threads()));
+
+    std::vector<double> thread_sum(scheduler.get_num_threads(), 0);
+
+    timer.start();
+    scheduler.run([&](const detail::HostTask& task, int tid) {
+        double sum = 0;
+        for (uint32_t e = task.begin; e < task.end; ++e) {
+            sum += element_work(task.patch_id, e);
+        }
+        thread_sum[tid] += sum;
+    });
+    timer.stop();
+    const float ws_ms = timer.elapsed_millis();
+
+    const double ws_sum =
+        std::accumulate(thread_sum.begin(), thread_sum.end(), 0.0);
+    EXPECT_NEAR(ws_sum, omp_sum, 1e-6 * std::abs(omp_sum));
+
+    RXMESH_INFO(
+        "HostScheduler: #patches= {}, #elements= {}, #threads= {}, "
+        "#tasks= {}, #steals= {}",
+        num_patches,
+        num_elements,
+        scheduler.get_num_threads(),
+        scheduler.stats().num_tasks,
+        scheduler.stats().num_steals);
+    RXMESH_INFO(
+        "HostScheduler: omp parallel for = {} (ms), imbalance = {}; "
+        "work-stealing = {} (ms), imbalance = {}; speedup = {}",
+        omp_ms,
+        omp_imbalance,
+        ws_ms,
+        scheduler.stats().imbalance(),
+        omp_ms / std::max(ws_ms, 1e-6f));
+}
@@ -0,0 +1,140 @@
+#include "gtest/gtest.h"
+
+#include <fstream>
+
+#include "rxmesh/rxmesh_static.h"
+#include "rxmesh/util/import_mesh.h"
+#include "rxmesh/util/import_obj.h"
+
+TEST(Util, ImportMesh)
+{
+    using namespace rxmesh;
+
+    std::vector<std::vector<float>>    Verts;
+    std::vector<std::vector<uint32_t>> Faces;
+
+    ASSERT_TRUE(
+        import_obj(STRINGIFY(INPUT_DIR) "sphere3.obj", Verts, Faces));
+
+    // obj
+    std::vector<float>    vertices;
+    std::vector<uint32_t> faces;
+    ASSERT_TRUE(
+        fast_import_obj(STRINGIFY(INPUT_DIR) "sphere3.obj", vertices, faces));
+
+    ASSERT_EQ(vertices.size(), 3 * Verts.size());
+    ASSERT_EQ(faces.size(), 3 * Faces.size());
+    for (size_t v = 0; v < Verts.size(); ++v) {
+        for (size_t i = 0; i < 3; ++i) {
+            EXPECT_EQ(vertices[3 * v + i], Verts[v][i]);
+        }
+    }
+    for (size_t f = 0; f < Faces.size(); ++f) {
+        for (size_t i = 0; i < 3; ++i) {
+            EXPECT_EQ(faces[3 * f + i], Faces[f][i]);
+        }
+    }
+
+    // binary stl i.e., a triangle soup that should be welded back to the same
+    // vertices since the obj vertices are numbered in the order they are first
+    // used by the faces
+    {
+        std::ofstream file("sphere3.stl", std::ios::binary);
+        char          header[80] = {0};
+        uint32_t      num_faces  = static_cast<uint32_t>(Faces.size());
+        file.write(header, 80);
+        file.write(reinterpret_cast<char*>(&num_faces), sizeof(uint32_t));
+        for (const auto& f : Faces) {
+            float normal[3] = {0, 0, 0};
+            file.write(reinterpret_cast<char*>(normal), 3 * sizeof(float));
+            for (uint32_t v : f) {
+                file.write(reinterpret_cast<char*>(Verts[v].data()),
+                           3 * sizeof(float));
+            }
+            uint16_t attr = 0;
+            file.write(reinterpret_cast<char*>(&attr), sizeof(uint16_t));
+        }
+    }
+
+    std::vector<float>    stl_vertices;
+    std::vector<uint32_t> stl_faces;
+    ASSERT_TRUE(import_stl("sphere3.stl", stl_vertices, stl_faces));
+    EXPECT_EQ(stl_vertices.size(), vertices.size());
+    EXPECT_EQ(stl_faces.size(), faces.size());
+    for (size_t c = 0; c < stl_faces.size(); ++c) {
+        for (size_t i = 0; i < 3; ++i) {
+            EXPECT_EQ(stl_vertices[3 * stl_faces[c] + i],
+                      vertices[3 * faces[c] + i]);
+        }
+    }
+
+    ASSERT_TRUE(import_stl("sphere3.stl", stl_vertices, stl_faces, false));
+    EXPECT_EQ(stl_vertices.size(), 3 * faces.size());
+
+    // binary ply
+    {
+        std::ofstream file("sphere3.ply", std::ios::binary);
+        file << "ply\nformat binary_little_endian 1.0\n"
+             << "element vertex " << Verts.size() << "\n"
+             << "property float x\nproperty float y\nproperty float z\n"
+             << "element face " << Faces.size() << "\n"
+             << "property list uchar int vertex_indices\nend_header\n";
+        file.write(reinterpret_cast<char*>(vertices.data()),
+                   vertices.size() * sizeof(float));
+        for (const auto& f : Faces) {
+            uint8_t count = 3;
+            file.write(reinterpret_cast<char*>(&count), sizeof(uint8_t));
+            for (uint32_t v : f) {
+                int32_t id = static_cast<int32_t>(v);
+                file.write(reinterpret_cast<char*>(&id), sizeof(int32_t));
+            }
+        }
+    }
+
+    std::vector<float>    ply_vertices;
+    std::vector<uint32_t> ply_faces;
+    ASSERT_TRUE(import_ply("sphere3.ply", ply_vertices, ply_faces));
+    EXPECT_EQ(ply_vertices, vertices);
+    EXPECT_EQ(ply_faces, faces);
+
+    // binary ply where the vertex element has a list property and so its
+    // records do not have a fixed size
+    {
+        std::ofstream file("sphere3_list.ply", std::ios::binary);
+        file << "ply\nformat binary_little_endian 1.0\n"
+             << "element vertex " << Verts.size() << "\n"
+             << "property float x\nproperty list uchar float extra\n"
+             << "property float y\nproperty float z\n"
+             << "element face " << Faces.size() << "\n"
+             << "property list uchar int vertex_indices\nend_header\n";
+        for (size_t v = 0; v < Verts.size(); ++v) {
+            uint8_t count    = static_cast<uint8_t>(v % 3);
+            float   extra[2] = {-1.f, -2.f};
+            file.write(reinterpret_cast<char*>(&vertices[3 * v]),
+                       sizeof(float));
+            file.write(reinterpret_cast<char*>(&count), sizeof(uint8_t));
+            file.write(reinterpret_cast<char*>(extra), count * sizeof(float));
+            file.write(reinterpret_cast<char*>(&vertices[3 * v + 1]),
+                       2 * sizeof(float));
+        }
+        for (const auto& f : Faces) {
+            uint8_t count = 3;
+            file.write(reinterpret_cast<char*>(&count), sizeof(uint8_t));
+            for (uint32_t v : f) {
+                int32_t id = static_cast<int32_t>(v);
+                file.write(reinterpret_cast<char*>(&id), sizeof(int32_t));
+            }
+        }
+    }
+
+    ASSERT_TRUE(import_ply("sphere3_list.ply", ply_vertices, ply_faces));
+    EXPECT_EQ(ply_vertices, vertices);
+    EXPECT_EQ(ply_faces, faces);
+
+    // the mesh constructor dispatches on the extension
+    RXMeshStatic rx_obj(STRINGIFY(INPUT_DIR) "sphere3.obj");
+    RXMeshStatic rx_stl("sphere3.stl");
+    EXPECT_EQ(rx_stl.get_num_vertices(), rx_obj.get_num_vertices());
+    EXPECT_EQ(rx_stl.get_num_edges(), rx_obj.get_num_edges());
+    EXPECT_EQ(rx_stl.get_num_faces(), rx_obj.get_num_faces());
+}
@@ -0,0 +1,113 @@
+#include <algorithm>
+#include <map>
+
+#include "gtest/gtest.h"
+#include "rxmesh/attribute.h"
+#include "rxmesh/rxmesh_static.h"
+#include "rxmesh/util/import_obj.h"
+#include "rxmesh_test.h"
+
+TEST(RXMeshStatic, KRing)
+{
+    using namespace rxmesh;
+
+    std::vector<std::vector<float>>    Verts;
+    std::vector<std::vector<uint32_t>> Faces;
+    ASSERT_TRUE(import_obj(STRINGIFY(INPUT_DIR) "sphere3.obj", Verts, Faces));
+
+    // small patches so that the rings cross many patches
+    RXMeshStatic rx(Faces, "", 64);
+    ASSERT_GT(rx.get_num_patches(), 1u);
+
+    constexpr uint32_t k = 3;
+
+    EXPECT_FALSE(rx.has_k_ring(k));
+    const KRing k_ring = rx.build_k_ring(k);
+    EXPECT_TRUE(rx.has_k_ring(k));
+    EXPECT_EQ(k_ring.get_k(), k);
+
+    // ground truth 1-ring from the input faces
+    std::vector<std::vector<uint32_t>> v_v(rx.get_num_vertices());
+    for (const auto& f : Faces) {
+        for (uint32_t i = 0; i < f.size(); ++i) {
+            const uint32_t a = f[i];
+            const uint32_t b = f[(i + 1) % f.size()];
+            if (std::find(v_v[a].begin(), v_v[a].end(), b) == v_v[a].end()) {
+                v_v[a].push_back(b);
+                v_v[b].push_back(a);
+            }
+        }
+    }
+
+    // verify every ring on the host against a breadth-first search
+    rx.for_each_vertex(
+        HOST,
+        [&](const VertexHandle vh) {
+            const uint32_t v = rx.map_to_global(vh);
+
+            std::map<uint32_t, uint32_t> dist;
+            std::vector<uint32_t>        frontier = {v};
+            dist[v]                               = 0;
+            for (uint32_t r = 1; r <= k; ++r) {
+                std::vector<uint32_t> next;
+                for (uint32_t u : frontier) {
+                    for (uint32_t n : v_v[u]) {
+                        if (dist.find(n) == dist.end()) {
+                            dist[n] = r;
+                            next.push_back(n);
+                        }
+                    }
+                }
+                std::sort(next.begin(), next.end());
+
+                std::vector<uint32_t> ring;
+                for (const VertexHandle& n : k_ring(vh, r)) {
+                    ring.push_back(rx.map_to_global(n));
+                }
+                std::sort(ring.begin(), ring.end());
+
+                EXPECT_EQ(ring, next) << " vertex= " << v << " ring= " << r;
+
+                frontier = next;
+            }
+            EXPECT_EQ(k_ring(vh).size(), dist.size() - 1);
+        },
+        NULL,
+        false);
+
+
+    // the 3-ring serves the 2-ring which is verified on the device
+    const KRing two_ring = rx.build_k_ring(2);
+    EXPECT_EQ(two_ring.get_k(), 2u);
+
+    ::RXMeshTest tester(rx, Faces);
+
+    auto input = rx.add_vertex_attribute<VertexHandle>("input", 1);
+    input->reset(VertexHandle(), DEVICE);
+
+    auto output =
+        rx.add_vertex_attribute<VertexHandle>("output", rx.get_num_vertices());
+    output->reset(VertexHandle(), DEVICE);
+
+    rx.for_each_vertex(
+        DEVICE,
+        [two_ring, input = *input, output = *output] __device__(
+            const VertexHandle vh) {
+            input(vh) = vh;
+
+            const KRingIterator iter = two_ring(vh);
+            for (uint32_t i = 0; i < iter.size(); ++i) {
+                output(vh, i) = iter[i];
+            }
+        });
+
+    CUDA_ERROR(cudaDeviceSynchronize());
+
+    output->move(DEVICE, HOST);
+    input->move(DEVICE, HOST);
+
+    EXPECT_TRUE(tester.run_test(rx, Faces, *input, *output, true));
+
+    rx.release_k_ring();
+    EXPECT_FALSE(rx.has_k_ring(1));
+}
@@ -0,0 +1,75 @@
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "rxmesh/rxmesh_static.h"
+#include "rxmesh/util/import_obj.h"
+#include "rxmesh/util/report.h"
+#include "rxmesh_test.h"
+
+// Compare VV and FV query throughput with and without renumbering the
+// elements inside every patch (RXMeshStatic's reorder_patch_elements). The
+// queries are verified against the input in both cases
+TEST(RXMeshStatic, PatchReorder)
+{
+    using namespace rxmesh;
+
+    bool oriented = false;
+
+    std::vector<std::vector<float>>    Verts;
+    std::vector<std::vector<uint32_t>> Faces;
+
+    ASSERT_TRUE(import_obj(rxmesh_args.obj_file_name, Verts, Faces));
+
+    for (bool reorder : {false, true}) {
+        RXMeshStatic rx(Faces,
+                        "",
+                        512,
+                        1.0,
+                        1.0,
+                        0.8,
+                        PatchingMethod::Lloyd,
+                        reorder);
+
+        Report report;
+        report = Report("PatchReorder_RXMesh");
+        report.command_line(rxmesh_args.argc, rxmesh_args.argv);
+        report.device();
+        report.system();
+        report.model_data(rxmesh_args.obj_file_name, rx);
+        report.add_member("method", std::string("RXMesh"));
+        report.add_member("reorder_patch_elements", reorder);
+
+        RXMESH_INFO("PatchReorder: reorder_patch_elements = {}", reorder);
+
+        ::RXMeshTest tester(rx, Faces);
+        EXPECT_TRUE(tester.run_ltog_mapping_test(rx, Faces))
+            << "Local-to-global mapping test failed";
+
+        {
+            // VV
+            auto input  = rx.add_vertex_attribute<VertexHandle>("input", 1);
+            auto output = rx.add_vertex_attribute<VertexHandle>(
+                "output", rx.get_input_max_valence());
+            launcher<Op::VV, VertexHandle, VertexHandle>(
+                Faces, rx, *input, *output, tester, report, oriented);
+            rx.remove_attribute("input");
+            rx.remove_attribute("output");
+        }
+
+        {
+            // FV
+            auto input  = rx.add_face_attribute<FaceHandle>("input", 1);
+            auto output = rx.add_face_attribute<VertexHandle>("output", 3);
+            launcher<Op::FV, FaceHandle, VertexHandle>(
+                Faces, rx, *input, *output, tester, report, oriented);
+            rx.remove_attribute("input");
+            rx.remove_attribute("output");
+        }
+
+        report.write(rxmesh_args.output_folder + "/rxmesh",
+                     "PatchReorder_RXMesh_" +
+                         std::string(reorder ? "reorder_" : "") +
+                         extract_file_name(rxmesh_args.obj_file_name));
+    }
+}
@@ -0,0 +1,167 @@
+#include <algorithm>
+#include <array>
+#include <filesystem>
+
+#include "gtest/gtest.h"
+
+#include "rxmesh/patch_store.h"
+#include "rxmesh/rxmesh_static.h"
+#include "rxmesh/util/import_obj.h"
+
+TEST(RXMeshStatic, PatchStore)
+{
+    using namespace rxmesh;
+
+    std::vector<std::vector<float>>    Verts;
+    std::vector<std::vector<uint32_t>> Faces;
+
+    ASSERT_TRUE(
+        import_obj(STRINGIFY(INPUT_DIR) "sphere3.obj", Verts, Faces));
+
+    RXMeshStatic rx(STRINGIFY(INPUT_DIR) "sphere3.obj");
+
+    const std::string store_file = STRINGIFY(OUTPUT_DIR) "sphere3.rxp";
+    rx.save_patch_store(store_file);
+
+    // a tiny cache so that patches are evicted and re-loaded
+    PatchStore store(store_file, 0.01);
+    ASSERT_TRUE(store.is_ok());
+
+    EXPECT_EQ(store.get_num_patches(), rx.get_num_patches());
+    EXPECT_EQ(store.get_num_vertices(), rx.get_num_vertices());
+    EXPECT_EQ(store.get_num_edges(), rx.get_num_edges());
+    EXPECT_EQ(store.get_num_faces(), rx.get_num_faces());
+
+    uint32_t num_vertices = 0;
+    store.for_each_vertex([&](const PatchRecord&, const VertexHandle) {
+        num_vertices++;
+    });
+    EXPECT_EQ(num_vertices, rx.get_num_vertices());
+
+    // every owned face has the same vertices as the input
+    uint32_t num_faces = 0;
+    store.for_each_face([&](const PatchRecord& rec, const FaceHandle fh) {
+        num_faces++;
+        uint16_t fv[3];
+        rec.get_fv(fh.local_id(), fv);
+
+        std::array<uint32_t, 3> actual;
+        for (int i = 0; i < 3; ++i) {
+            actual[i] = rec.get_global_id<VertexHandle>(fv[i]);
+        }
+        const uint32_t f = rec.get_global_id<FaceHandle>(fh.local_id());
+
+        std::array<uint32_t, 3> expected = {
+            Faces[f][0], Faces[f][1], Faces[f][2]};
+        std::sort(actual.begin(), actual.end());
+        std::sort(expected.begin(), expected.end());
+        EXPECT_EQ(actual, expected);
+    });
+    EXPECT_EQ(num_faces, rx.get_num_faces());
+
+    // the owners in the store match RXMesh
+    store.for_each_patch([&](const PatchRecord& rec) {
+        for (uint16_t v = 0; v < rec.num_vertices; ++v) {
+            const VertexHandle vh(rec.patch_id, v);
+            EXPECT_EQ(rec.get_owner_handle<VertexHandle>(v),
+                      rx.get_owner_handle(vh));
+        }
+    });
+
+    // only the owner patch stores a vertex attribute value. Reading it
+    // through a not-owned copy loads the owner patch on demand
+    ASSERT_TRUE((store.add_attribute<uint32_t, VertexHandle>("id", 1)));
+    for (uint32_t p = 0; p < store.get_num_patches(); ++p) {
+        auto                  rec = store.get_patch(p);
+        std::vector<uint32_t> id(rec->num_vertices, INVALID32);
+        for (uint16_t v = 0; v < rec->num_vertices; ++v) {
+            if (rec->is_owned<VertexHandle>(v)) {
+                id[v] = rec->get_global_id<VertexHandle>(v);
+            }
+        }
+        ASSERT_TRUE(store.write_attribute("id", p, id.data()));
+    }
+
+    store.for_each_patch([&](const PatchRecord& rec) {
+        for (uint16_t v = 0; v < rec.num_vertices; ++v) {
+            EXPECT_EQ(store.get_attribute<uint32_t>(
+                          "id", VertexHandle(rec.patch_id, v), 0),
+                      rec.get_global_id<VertexHandle>(v));
+        }
+    });
+
+    EXPECT_GT(store.get_patch_cache().get_num_evictions(), 0);
+
+    std::filesystem::remove(store_file);
+    std::filesystem::remove(store_file + ".id.attr");
+}
+
+
+TEST(RXMeshStatic, PatchStoreQueries)
+{
+    using namespace rxmesh;
+
+    RXMeshStatic rx(STRINGIFY(INPUT_DIR) "sphere3.obj");
+
+    const std::string store_file =
+        STRINGIFY(OUTPUT_DIR) "sphere3_queries.rxp";
+    rx.save_patch_store(store_file);
+
+    PatchStore store(store_file, 0.01);
+    ASSERT_TRUE(store.is_ok());
+
+    // the store query returns the same (owner) handles as the host query of
+    // RXMeshStatic
+    auto vv = *rx.add_vertex_attribute<VertexHandle>(
+        "vv", rx.get_input_max_valence());
+    auto ef = *rx.add_edge_attribute<FaceHandle>("ef", 2);
+
+    vv.reset(VertexHandle(), HOST);
+    ef.reset(FaceHandle(), HOST);
+
+    rx.run_query_kernel<Op::VV, 256>(
+        HOST, [&](const VertexHandle& vh, const VertexIterator& iter) {
+            for (uint16_t i = 0; i < iter.size(); ++i) {
+                vv(vh, i) = iter[i];
+            }
+        });
+
+    rx.run_query_kernel<Op::EF, 256>(
+        HOST, [&](const EdgeHandle& eh, const FaceIterator& iter) {
+            for (uint16_t i = 0; i < iter.size(); ++i) {
+                ef(eh, i) = iter[i];
+            }
+        });
+
+    uint32_t num_vertices = 0;
+    store.run_query<Op::VV>(
+        [&](const PatchRecord&                       rec,
+            const VertexHandle&                      vh,
+            const PatchRecordIterator<VertexHandle>& iter) {
+            num_vertices++;
+            EXPECT_EQ(rec.patch_id, vh.patch_id());
+            for (uint16_t i = 0; i < iter.size(); ++i) {
+                EXPECT_EQ(iter[i], vv(vh, i));
+                EXPECT_EQ(rec.get_global_id<VertexHandle>(iter.local(i)),
+                          rx.map_to_global(iter[i]));
+            }
+        });
+    EXPECT_EQ(num_vertices, rx.get_num_vertices());
+
+    uint32_t num_edges = 0;
+    store.run_query<Op::EF>(
+        [&](const PatchRecord&,
+            const EdgeHandle&                      eh,
+            const PatchRecordIterator<FaceHandle>& iter) {
+            num_edges++;
+            EXPECT_EQ(iter.size(), 2);
+            for (uint16_t i = 0; i < iter.size(); ++i) {
+                EXPECT_EQ(iter[i], ef(eh, i));
+            }
+        },
+        false,
+        true);
+    EXPECT_EQ(num_edges, rx.get_num_edges());
+
+    std::filesystem::remove(store_file);
+}
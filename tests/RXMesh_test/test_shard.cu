@@ -0,0 +1,191 @@
+#include <filesystem>
+#include <thread>
+
+#ifdef __linux__
+#include <spawn.h>
+#include <sys/wait.h>
+#include <unistd.h>
+extern char** environ;
+#endif
+
+#include "gtest/gtest.h"
+
+#include "rxmesh/rxmesh_static.h"
+#include "rxmesh/shard/shard.h"
+
+// the patch store shared by all shards of a test
+static const std::string shard_store_file =
+    STRINGIFY(OUTPUT_DIR) "sphere3_shard.rxp";
+
+// every shard writes the global index of its owned vertices and faces, runs
+// a halo exchange, and returns the number of local elements (owned and
+// ribbon) whose value does not match. Also counts the owned vertices
+int run_shard(const std::string& store_file,
+              rxmesh::Transport& transport,
+              uint32_t&          num_owned_vertices)
+{
+    using namespace rxmesh;
+
+    PatchStore store(store_file);
+    Shard      shard(store, transport);
+
+    auto v_attr = shard.add_attribute<uint32_t, VertexHandle>(2, INVALID32);
+    auto f_attr = shard.add_attribute<uint32_t, FaceHandle>(1, INVALID32);
+
+    num_owned_vertices = 0;
+    shard.for_each_vertex([&](const PatchRecord& rec, const VertexHandle vh) {
+        v_attr(vh, 0) = rec.get_global_id<VertexHandle>(vh.local_id());
+        v_attr(vh, 1) = shard.rank();
+        num_owned_vertices++;
+    });
+    shard.for_each_face([&](const PatchRecord& rec, const FaceHandle fh) {
+        f_attr(fh) = rec.get_global_id<FaceHandle>(fh.local_id());
+    });
+
+    shard.halo_exchange(v_attr);
+    shard.halo_exchange(f_attr);
+
+    int num_errors = 0;
+    for (uint32_t i = 0; i < shard.get_num_local_patches(); ++i) {
+        const PatchRecord& rec = shard.get_local_patch(i);
+        for (uint16_t v = 0; v < rec.num_vertices; ++v) {
+            const VertexHandle vh(rec.patch_id, v);
+            const VertexHandle owner = rec.get_owner_handle<VertexHandle>(v);
+            if (v_attr(vh, 0) != rec.get_global_id<VertexHandle>(v) ||
+                v_attr(vh, 1) != uint32_t(shard.get_shard(owner.patch_id()))) {
+                num_errors++;
+            }
+        }
+        for (uint16_t f = 0; f < rec.num_faces; ++f) {
+            if (f_attr(FaceHandle(rec.patch_id, f)) !=
+                rec.get_global_id<FaceHandle>(f)) {
+                num_errors++;
+            }
+        }
+    }
+
+    transport.barrier();
+    return num_errors;
+}
+
+TEST(Shard, LocalTransport)
+{
+    using namespace rxmesh;
+
+    RXMeshStatic rx(STRINGIFY(INPUT_DIR) "sphere3.obj");
+    rx.save_patch_store(shard_store_file);
+
+    const int num_shards = 3;
+
+    auto transports = LocalTransport::create(num_shards);
+
+    std::vector<int>         num_errors(num_shards, 0);
+    std::vector<uint32_t>    num_owned(num_shards, 0);
+    std::vector<std::thread> threads;
+    for (int r = 0; r < num_shards; ++r) {
+        threads.emplace_back([&, r]() {
+            num_errors[r] =
+                run_shard(shard_store_file, *transports[r], num_owned[r]);
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    uint32_t total_owned = 0;
+    for (int r = 0; r < num_shards; ++r) {
+        EXPECT_EQ(num_errors[r], 0);
+        total_owned += num_owned[r];
+    }
+    EXPECT_EQ(total_owned, rx.get_num_vertices());
+
+    std::filesystem::remove(shard_store_file);
+}
+
+#ifdef __linux__
+// one shard of Shard.UnixSocketTransport. It only runs when this test binary
+// is re-executed by Shard.UnixSocketTransport, which passes the rank and the
+// number of shards through the environment
+TEST(Shard, UnixSocketTransportRank)
+{
+    using namespace rxmesh;
+
+    const char* rank       = getenv("RXMESH_SHARD_RANK");
+    const char* num_shards = getenv("RXMESH_SHARD_NUM");
+    if (rank == nullptr || num_shards == nullptr) {
+        GTEST_SKIP() << "only runs as a shard of Shard.UnixSocketTransport";
+    }
+
+    // the socket files go to the temp directory since the path of a Unix
+    // socket is limited to ~100 characters
+    const std::string prefix =
+        (std::filesystem::temp_directory_path() / "rxmesh_shard_test").string();
+
+    UnixSocketTransport transport(prefix, atoi(rank), atoi(num_shards));
+    ASSERT_TRUE(transport.is_ok());
+
+    uint32_t num_owned = 0;
+    EXPECT_EQ(run_shard(shard_store_file, transport, num_owned), 0);
+}
+
+TEST(Shard, UnixSocketTransport)
+{
+    using namespace rxmesh;
+
+    RXMeshStatic rx(STRINGIFY(INPUT_DIR) "sphere3.obj");
+    rx.save_patch_store(shard_store_file);
+
+    const int num_shards = 4;
+
+    // every shard is a separate process that only runs host code. Shards are
+    // started by re-executing this binary (rather than a plain fork()) so
+    // that they do not inherit the CUDA context of this process
+    std::vector<std::string> env_str;
+    for (char** e = environ; *e != nullptr; ++e) {
+        env_str.push_back(*e);
+    }
+    env_str.push_back("RXMESH_SHARD_NUM=" + std::to_string(num_shards));
+    env_str.push_back("");
+
+    std::string exe    = "/proc/self/exe";
+    std::string filter = "--gtest_filter=Shard.UnixSocketTransportRank";
+    char*       argv[] = {exe.data(), filter.data(), nullptr};
+
+    std::vector<pid_t> pids;
+    int                num_failed_spawns = 0;
+    for (int r = 0; r < num_shards; ++r) {
+        env_str.back() = "RXMESH_SHARD_RANK=" + std::to_string(r);
+        std::vector<char*> envp;
+        for (auto& e : env_str) {
+            envp.push_back(e.data());
+        }
+        envp.push_back(nullptr);
+
+        pid_t     pid = -1;
+        const int err = posix_spawn(
+            &pid, exe.c_str(), nullptr, nullptr, argv, envp.data());
+        if (err != 0) {
+            num_failed_spawns++;
+            continue;
+        }
+        pids.push_back(pid);
+    }
+
+    // reap every shard before checking anything so that no process is left
+    // behind if one of them fails
+    std::vector<int> status(pids.size(), -1);
+    for (size_t i = 0; i < pids.size(); ++i) {
+        int s = 0;
+        if (waitpid(pids[i], &s, 0) == pids[i] && WIFEXITED(s)) {
+            status[i] = WEXITSTATUS(s);
+        }
+    }
+
+    EXPECT_EQ(num_failed_spawns, 0);
+    for (size_t i = 0; i < pids.size(); ++i) {
+        EXPECT_EQ(status[i], 0) << "shard " << i;
+    }
+
+    std::filesystem::remove(shard_store_file);
+}
+#endif
@@ -0,0 +1,65 @@
+#include "gtest/gtest.h"
+
+#include "rxmesh/rxmesh_static.h"
+#include "rxmesh/util/import_obj.h"
+
+#include "rxmesh_test.h"
+
+TEST(RXMeshStatic, Snapshot)
+{
+    using namespace rxmesh;
+
+    std::vector<std::vector<float>>    Verts;
+    std::vector<std::vector<uint32_t>> Faces;
+
+    ASSERT_TRUE(
+        import_obj(STRINGIFY(INPUT_DIR) "sphere3.obj", Verts, Faces));
+
+    RXMeshStatic rx(STRINGIFY(INPUT_DIR) "sphere3.obj");
+    rx.save_snapshot("sphere3.rxs");
+
+    RXMeshStatic rx_snap(SnapshotFile("sphere3.rxs"));
+
+    EXPECT_EQ(rx_snap.get_num_vertices(), rx.get_num_vertices());
+    EXPECT_EQ(rx_snap.get_num_edges(), rx.get_num_edges());
+    EXPECT_EQ(rx_snap.get_num_faces(), rx.get_num_faces());
+    EXPECT_EQ(rx_snap.get_num_patches(), rx.get_num_patches());
+    EXPECT_EQ(rx_snap.get_input_max_valence(), rx.get_input_max_valence());
+    EXPECT_EQ(rx_snap.get_num_colors(), rx.get_num_colors());
+
+    for (const auto& f : Faces) {
+        for (uint32_t i = 0; i < 3; ++i) {
+            EXPECT_EQ(rx_snap.get_edge_id(f[i], f[(i + 1) % 3]),
+                      rx.get_edge_id(f[i], f[(i + 1) % 3]));
+        }
+    }
+
+    ::RXMeshTest tester(rx_snap, Faces);
+    EXPECT_TRUE(tester.run_ltog_mapping_test(rx_snap, Faces));
+
+    auto coord = *rx_snap.get_input_vertex_coordinates();
+    rx_snap.for_each_vertex(HOST, [&](const VertexHandle& vh) {
+        uint32_t v = rx_snap.map_to_global(vh);
+        for (uint32_t i = 0; i < 3; ++i) {
+            EXPECT_EQ(coord(vh, i), Verts[v][i]);
+        }
+    });
+
+    // the queries go through the loaded topology and hashtables
+    auto input  = rx_snap.add_vertex_attribute<VertexHandle>("input", 1);
+    auto output = rx_snap.add_vertex_attribute<VertexHandle>(
+        "output", rx_snap.get_input_max_valence());
+    input->reset(VertexHandle(), HOST);
+    output->reset(VertexHandle(), HOST);
+
+    rx_snap.run_query_kernel<Op::VV, 256>(
+        HOST,
+        [&](const VertexHandle& vh, const VertexIterator& iter) {
+            (*input)(vh) = vh;
+            for (uint32_t i = 0; i < iter.size(); ++i) {
+                (*output)(vh, i) = iter[i];
+            }
+        });
+
+    EXPECT_TRUE(tester.run_test(rx_snap, Faces, *input, *output));
+}
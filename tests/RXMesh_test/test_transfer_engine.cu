@@ -0,0 +1,67 @@
+#include <numeric>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "rxmesh/util/macros.h"
+#include "rxmesh/util/transfer_engine.h"
+
+TEST(TransferEngine, HostFallback)
+{
+    using namespace rxmesh;
+
+    // without a device, "device" pointers are host pointers
+    TransferEngine engine(1024, false);
+    EXPECT_FALSE(engine.is_device());
+
+    std::vector<uint32_t> src(100000), mid(100000), dst(100000);
+    std::iota(src.begin(), src.end(), 0);
+
+    engine.to_device(mid.data(), src.data(), src.size() * sizeof(uint32_t));
+    engine.to_host(dst.data(), mid.data(), mid.size() * sizeof(uint32_t));
+
+    EXPECT_EQ(src, dst);
+    EXPECT_EQ(engine.get_num_transfers(), size_t(2));
+    EXPECT_EQ(engine.get_transferred_bytes(),
+              2 * src.size() * sizeof(uint32_t));
+}
+
+TEST(TransferEngine, Device)
+{
+    using namespace rxmesh;
+
+    if (!has_cuda_device()) {
+        GTEST_SKIP() << "No CUDA device";
+    }
+
+    // small chunk size so the buffer goes through many chunks with the two
+    // halves of the staging buffer in use at the same time
+    TransferEngine engine(4096);
+
+    // not a multiple of the chunk size
+    const size_t num_elements = 1000003;
+    const size_t num_bytes    = num_elements * sizeof(uint32_t);
+
+    std::vector<uint32_t> src(num_elements), dst(num_elements, 0);
+    std::iota(src.begin(), src.end(), 0);
+
+    cudaStream_t stream;
+    CUDA_ERROR(cudaStreamCreate(&stream));
+
+    uint32_t* d_buf;
+    CUDA_ERROR(cudaMalloc((void**)&d_buf, num_bytes));
+
+    engine.to_device(d_buf, src.data(), num_bytes, stream);
+
+    // the source could be modified once to_device() returns
+    std::fill(src.begin(), src.end(), 0);
+
+    engine.to_host(dst.data(), d_buf, num_bytes, stream);
+
+    for (size_t i = 0; i < num_elements; ++i) {
+        ASSERT_EQ(dst[i], i);
+    }
+
+    GPU_FREE(d_buf);
+    CUDA_ERROR(cudaStreamDestroy(stream));
+}
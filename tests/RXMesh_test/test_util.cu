@@ -1,12 +1,24 @@
 #include "gtest/gtest.h"
 
 #include <algorithm>
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <numeric>
+#include <sstream>
+#include <thread>
 
 #include "rxmesh/kernels/collective.cuh"
 #include "rxmesh/kernels/rxmesh_queries.cuh"
 #include "rxmesh/kernels/shmem_allocator.cuh"
 #include "rxmesh/kernels/util.cuh"
+#include "rxmesh/util/benchmark.h"
+#include "rxmesh/util/host_parallel.h"
 #include "rxmesh/util/macros.h"
+#include "rxmesh/util/perf_counters.h"
+#include "rxmesh/util/report.h"
+#include "rxmesh/util/timer.h"
+#include "rxmesh/util/trace.h"
 #include "rxmesh/util/util.h"
 
 template <uint32_t rowOffset, uint32_t blockThreads, uint32_t itemPerThread>
@@ -356,4 +368,329 @@ TEST(Util, BlockMatrixTranspose)
 
     EXPECT_TRUE(is_offset_okay);
     EXPECT_TRUE(is_value_okay);
-}
\ No newline at end of file
+}
+
+TEST(Util, HostScan)
+{
+    using namespace rxmesh;
+
+    uint32_t              size = 100003;
+    std::vector<uint32_t> h_src(size, 1);
+
+    uint32_t sum =
+        detail::host_exclusive_scan(h_src.data(), h_src.data(), h_src.size());
+
+    EXPECT_EQ(sum, size);
+    for (uint32_t i = 0; i < h_src.size(); ++i) {
+        EXPECT_EQ(h_src[i], i);
+    }
+}
+
+TEST(Util, HostRadixSort)
+{
+    using namespace rxmesh;
+
+    constexpr int num_bits = 40;
+
+    uint32_t              size = 100003;
+    std::vector<uint64_t> keys(size);
+    std::vector<uint32_t> values(size);
+
+    std::mt19937_64 rng(0);
+    for (uint32_t i = 0; i < size; ++i) {
+        // few distinct keys so there are many duplicates to check stability
+        keys[i]   = (rng() % 1024) << (num_bits - 10);
+        values[i] = i;
+    }
+
+    std::vector<std::pair<uint64_t, uint32_t>> gold(size);
+    for (uint32_t i = 0; i < size; ++i) {
+        gold[i] = {keys[i], values[i]};
+    }
+    std::stable_sort(gold.begin(), gold.end(), [](auto& a, auto& b) {
+        return a.first < b.first;
+    });
+
+    detail::host_radix_sort_pairs(keys, values, num_bits);
+
+    for (uint32_t i = 0; i < size; ++i) {
+        EXPECT_EQ(keys[i], gold[i].first);
+        EXPECT_EQ(values[i], gold[i].second);
+    }
+}
+
+TEST(Util, PerfCounters)
+{
+    using namespace rxmesh;
+
+    Timers<CPUTimer> timers;
+    timers.add("sum", true);
+    timers.add("no_counters");
+    EXPECT_TRUE(timers.has_perf_counters("sum"));
+    EXPECT_FALSE(timers.has_perf_counters("no_counters"));
+
+    std::vector<double> data(1 << 20, 1.0);
+
+    double sum = 0;
+    for (int r = 0; r < 3; ++r) {
+        timers.start("sum");
+        for (double d : data) {
+            sum += d;
+        }
+        timers.stop("sum");
+    }
+    EXPECT_EQ(sum, 3.0 * data.size());
+
+    timers.start("no_counters");
+    timers.stop("no_counters");
+    EXPECT_FALSE(timers.perf_counters("no_counters").is_valid());
+
+    // the counters may not be available on this machine (e.g., restricted
+    // by perf_event_paranoid) in which case they are not recorded
+    const PerfCounterValues counters = timers.perf_counters("sum");
+    if (PerfCounters().is_valid()) {
+        EXPECT_TRUE(counters.is_valid());
+        if (counters.has(PerfEvent::Instructions)) {
+            EXPECT_GT(counters.get(PerfEvent::Instructions), 0);
+        }
+    } else {
+        EXPECT_FALSE(counters.is_valid());
+    }
+
+    Report report("PerfCounters");
+    report.add_timers(timers);
+    ASSERT_TRUE(report.m_doc.HasMember("Timers"));
+
+    const auto& t = report.m_doc["Timers"];
+    ASSERT_TRUE(t.HasMember("sum"));
+    ASSERT_TRUE(t.HasMember("no_counters"));
+    EXPECT_TRUE(t["sum"].HasMember("time (ms)"));
+    EXPECT_EQ(t["sum"].HasMember("cycles"), counters.has(PerfEvent::Cycles));
+    EXPECT_EQ(t["sum"].HasMember("instructions"),
+              counters.has(PerfEvent::Instructions));
+    EXPECT_FALSE(t["no_counters"].HasMember("cycles"));
+}
+
+TEST(Util, TimersThreads)
+{
+    using namespace rxmesh;
+
+    // std::threads all have omp_get_thread_num() == 0 but should still get
+    // their own timer
+    Timers<CPUTimer> timers;
+    timers.add("work", true);
+
+    const int                num_threads = 4;
+    std::atomic_int          num_started = 0;
+    std::atomic_bool         release     = false;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < num_threads; ++t) {
+        threads.emplace_back([&]() {
+            for (int r = 0; r < 10; ++r) {
+                timers.start("work");
+                timers.stop("work");
+            }
+            timers.start("work");
+            num_started++;
+            while (!release) {
+                std::this_thread::yield();
+            }
+            timers.stop("work");
+        });
+    }
+    while (num_started < num_threads) {
+        std::this_thread::yield();
+    }
+    EXPECT_EQ(timers.num_threads("work"), size_t(num_threads));
+
+    release = true;
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    // the timers of the threads are released when they exit
+    EXPECT_EQ(timers.num_threads("work"), size_t(0));
+    EXPECT_GE(timers.elapsed_millis("work"), 0.f);
+}
+
+TEST(Util, Trace)
+{
+    using namespace rxmesh;
+
+    Tracer& tracer = Tracer::get();
+
+    // nothing is recorded while the tracer is disabled
+    tracer.disable();
+    tracer.clear();
+    {
+        RXMESH_TRACE_SCOPE("disabled");
+    }
+    EXPECT_EQ(tracer.num_events(), 0u);
+
+    tracer.enable();
+
+    Timers<CPUTimer> timers;
+    timers.add("timer");
+    {
+        RXMESH_TRACE_SCOPE("outer");
+        timers.start("timer");
+#pragma omp parallel
+        {
+            RXMESH_TRACE_SCOPE("inner");
+        }
+        timers.stop("timer");
+    }
+    tracer.disable();
+
+    const int num_threads = omp_get_max_threads();
+    EXPECT_EQ(tracer.num_events(), size_t(num_threads + 2));
+
+    int num_inner = 0;
+    for (const auto& thread_events : tracer.events()) {
+        for (size_t i = 0; i < thread_events.size(); ++i) {
+            const TraceEvent& e    = thread_events[i];
+            const std::string name = e.name;
+            EXPECT_LE(e.begin_ns, e.end_ns);
+            if (name == "outer") {
+                // sorted by start time and nested in the same thread
+                ASSERT_EQ(thread_events.size(), 3u);
+                EXPECT_EQ(e.depth, 0u);
+                EXPECT_EQ(std::string(thread_events[1].name), "timer");
+                EXPECT_EQ(thread_events[1].depth, 1u);
+                EXPECT_GE(thread_events[1].begin_ns, e.begin_ns);
+                EXPECT_LE(thread_events[1].end_ns, e.end_ns);
+                EXPECT_EQ(thread_events[2].depth, 2u);
+            }
+            if (name == "inner") {
+                num_inner++;
+            }
+        }
+    }
+    EXPECT_EQ(num_inner, num_threads);
+
+    const std::string file_name = STRINGIFY(OUTPUT_DIR) "trace_test.json";
+    ASSERT_TRUE(tracer.write(file_name));
+    {
+        std::ifstream     file(file_name);
+        std::stringstream ss;
+        ss << file.rdbuf();
+        const std::string json = ss.str();
+        EXPECT_NE(json.find("\"traceEvents\""), std::string::npos);
+        EXPECT_NE(json.find("\"name\": \"outer\", \"ph\": \"X\""),
+                  std::string::npos);
+    }
+    std::filesystem::remove(file_name);
+
+    // the ring buffer keeps the most recent events
+    tracer.enable(4);
+    for (int i = 0; i < 10; ++i) {
+        RXMESH_TRACE_SCOPE("ring");
+    }
+    tracer.disable();
+    EXPECT_EQ(tracer.num_events(), 4u);
+
+    tracer.clear();
+    EXPECT_EQ(tracer.num_events(), 0u);
+}
+
+TEST(Util, Benchmark)
+{
+    using namespace rxmesh;
+
+    // 20, 19, ..., 1
+    std::vector<float> samples(20);
+    std::iota(samples.rbegin(), samples.rend(), 1.0f);
+
+    const BenchmarkStats stats = compute_benchmark_stats(samples, 0.95);
+    EXPECT_EQ(stats.num_samples, 20u);
+    EXPECT_DOUBLE_EQ(stats.min, 1.0);
+    EXPECT_DOUBLE_EQ(stats.max, 20.0);
+    EXPECT_DOUBLE_EQ(stats.median, 10.5);
+    EXPECT_DOUBLE_EQ(stats.mean, 10.5);
+    EXPECT_NEAR(stats.stddev, std::sqrt(35.0), 1e-9);
+    EXPECT_NEAR(stats.p05, 1.95, 1e-6);
+    EXPECT_NEAR(stats.p95, 19.05, 1e-6);
+    // the 6th and 15th order statistics for n = 20 at 95%
+    EXPECT_DOUBLE_EQ(stats.ci_lower, 6.0);
+    EXPECT_DOUBLE_EQ(stats.ci_upper, 15.0);
+
+    // too few samples for a confidence interval narrower than [min, max]
+    const BenchmarkStats few = compute_benchmark_stats({2.f, 1.f, 3.f});
+    EXPECT_DOUBLE_EQ(few.median, 2.0);
+    EXPECT_DOUBLE_EQ(few.ci_lower, 1.0);
+    EXPECT_DOUBLE_EQ(few.ci_upper, 3.0);
+
+    // warm-up runs are not timed
+    Benchmark bench(2, 5);
+    int       num_calls = 0;
+    bench.run("host", [&]() { num_calls++; });
+    EXPECT_EQ(num_calls, 7);
+    EXPECT_EQ(bench.samples("host").size(), 5u);
+
+    const BenchmarkStats& timed = bench.run("timed", []() { return 3.f; });
+    EXPECT_DOUBLE_EQ(timed.median, 3.0);
+
+    // the baseline takes ~10 ms
+    std::map<std::string, std::vector<float>> baseline;
+    for (int i = 0; i < 20; ++i) {
+        baseline["slower"].push_back(10.f + 0.01f * i);
+        baseline["same"].push_back(10.f + 0.01f * i);
+        baseline["noisy"].push_back(10.f + 0.01f * i);
+        baseline["timed"].push_back(6.f + 0.01f * i);
+        baseline["removed"].push_back(1.f + 0.01f * i);
+    }
+
+    std::vector<float> slower, same, noisy;
+    for (int i = 0; i < 20; ++i) {
+        slower.push_back(12.f + 0.01f * i);
+        same.push_back(10.2f + 0.01f * i);
+        // slower median but a wide spread that overlaps the baseline
+        noisy.push_back((i % 2 == 0) ? 9.f + 0.01f * i : 20.f + 0.01f * i);
+    }
+    bench.add("slower", slower);
+    bench.add("same", same);
+    bench.add("noisy", noisy);
+
+    auto find = [](const std::vector<BenchmarkComparison>& cmp,
+                   const std::string&                      stage) {
+        return *std::find_if(
+            cmp.begin(), cmp.end(), [&](const BenchmarkComparison& c) {
+                return c.stage == stage;
+            });
+    };
+
+    // "host" is not in the baseline and so it is skipped while "removed" was
+    // not run and so it is missing
+    const std::vector<BenchmarkComparison> cmp = bench.compare(baseline, 0.05);
+    EXPECT_EQ(cmp.size(), 5u);
+    EXPECT_TRUE(find(cmp, "removed").missing);
+    EXPECT_FALSE(find(cmp, "removed").regressed);
+    EXPECT_FALSE(find(cmp, "slower").missing);
+    EXPECT_TRUE(find(cmp, "slower").regressed);
+    EXPECT_GT(find(cmp, "slower").ratio, 1.15);
+    EXPECT_FALSE(find(cmp, "same").regressed);
+    EXPECT_FALSE(find(cmp, "noisy").regressed);
+    EXPECT_FALSE(find(cmp, "timed").regressed);
+    EXPECT_TRUE(find(cmp, "timed").improved);
+
+    // a larger threshold tolerates the slowdown
+    EXPECT_FALSE(find(bench.compare(baseline, 0.5), "slower").regressed);
+
+    // the report is the baseline format
+    Report report("Benchmark_test");
+    report.add_benchmark(bench);
+    report.write(STRINGIFY(OUTPUT_DIR), "benchmark_test", false);
+
+    const std::string file_name = STRINGIFY(OUTPUT_DIR) "benchmark_test.json";
+    std::map<std::string, std::vector<float>> loaded;
+    ASSERT_TRUE(Benchmark::load_baseline(file_name, loaded));
+    EXPECT_EQ(loaded.size(), bench.stages().size());
+    EXPECT_EQ(loaded["slower"], slower);
+
+    // a run against itself does not regress
+    for (const BenchmarkComparison& c : bench.compare(loaded, 0.0)) {
+        EXPECT_FALSE(c.regressed) << c.stage;
+        EXPECT_FALSE(c.missing) << c.stage;
+    }
+    std::filesystem::remove(file_name);
+}